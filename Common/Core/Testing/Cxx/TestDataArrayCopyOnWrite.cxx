@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayCopyOnWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks vtkDataArray::HasSharedStorage/DetachStorage and the writable
+// range functions for AOS and SOA arrays.
+
+#include "vtkDataArrayRange.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+namespace
+{
+
+template <typename ArrayT>
+int TestCopyOnWrite(const char* name)
+{
+  int errors = 0;
+
+  vtkNew<ArrayT> source;
+  source->SetNumberOfComponents(2);
+  source->SetNumberOfTuples(10);
+  for (vtkIdType i = 0; i < 10; ++i)
+  {
+    source->SetTypedComponent(i, 0, static_cast<float>(i));
+    source->SetTypedComponent(i, 1, static_cast<float>(-i));
+  }
+  if (source->HasSharedStorage())
+  {
+    std::cerr << name << ": new array reports shared storage.\n";
+    ++errors;
+  }
+
+  vtkNew<ArrayT> copy;
+  copy->ShallowCopy(source);
+  if (!source->HasSharedStorage() || !copy->HasSharedStorage())
+  {
+    std::cerr << name << ": shallow copies must report shared storage.\n";
+    ++errors;
+  }
+
+  // Writing through the writable range detaches the copy only.
+  for (auto&& tuple : vtk::DataArrayWritableTupleRange<2>(copy))
+  {
+    auto comp = tuple.begin();
+    *comp = *comp + 100.f;
+  }
+  if (copy->HasSharedStorage() || source->HasSharedStorage())
+  {
+    std::cerr << name << ": storage still shared after writing.\n";
+    ++errors;
+  }
+  for (vtkIdType i = 0; i < 10; ++i)
+  {
+    if (source->GetTypedComponent(i, 0) != static_cast<float>(i) ||
+      copy->GetTypedComponent(i, 0) != static_cast<float>(i) + 100.f ||
+      copy->GetTypedComponent(i, 1) != static_cast<float>(-i))
+    {
+      std::cerr << name << ": unexpected values at tuple " << i << ".\n";
+      ++errors;
+      break;
+    }
+  }
+
+  // Detaching an array that is not shared is a no-op.
+  copy->DetachStorage();
+  if (copy->GetTypedComponent(9, 0) != 109.f)
+  {
+    std::cerr << name << ": detaching unshared storage changed values.\n";
+    ++errors;
+  }
+
+  // Same with the value range, this time detaching the source.
+  copy->ShallowCopy(source);
+  for (auto&& value : vtk::DataArrayWritableValueRange(source))
+  {
+    value = 0.f;
+  }
+  if (copy->GetTypedComponent(3, 1) != -3.f || source->GetTypedComponent(3, 1) != 0.f)
+  {
+    std::cerr << name << ": writable value range modified shared storage.\n";
+    ++errors;
+  }
+
+  return errors;
+}
+
+} // end anon namespace
+
+int TestDataArrayCopyOnWrite(int, char*[])
+{
+  int errors = 0;
+  errors += TestCopyOnWrite<vtkFloatArray>("vtkFloatArray");
+  errors += TestCopyOnWrite<vtkSOADataArrayTemplate<float> >("vtkSOADataArrayTemplate<float>");
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
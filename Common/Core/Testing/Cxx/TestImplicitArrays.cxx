@@ -0,0 +1,360 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitArrays.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Checks the values of the constant, affine, composite and indexed arrays
+// through the vtkDataArray API, vtkDataArrayRange and vtkArrayDispatch, and
+// their copy and materialization behavior.
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkAffineArray.h"
+#include "vtkArrayDispatch.h"
+#include "vtkCompositeArray.h"
+#include "vtkConstantArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIndexedArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+
+// Compare all values of an array with those of an explicit reference.
+int CompareValues(vtkDataArray* array, vtkDataArray* expected, const char* name)
+{
+  int errors = 0;
+  if (array->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    std::cerr << name << ": wrong dimensions\n";
+    return 1;
+  }
+  const int numComps = array->GetNumberOfComponents();
+  std::vector<double> tuple(numComps);
+  for (vtkIdType t = 0; t < array->GetNumberOfTuples(); ++t)
+  {
+    array->GetTuple(t, tuple.data());
+    for (int c = 0; c < numComps; ++c)
+    {
+      if (tuple[c] != expected->GetComponent(t, c) ||
+        array->GetComponent(t, c) != expected->GetComponent(t, c))
+      {
+        ++errors;
+      }
+    }
+  }
+  if (errors)
+  {
+    std::cerr << name << ": " << errors << " wrong values\n";
+  }
+  return errors;
+}
+
+// Sums the values with the ranges, on the concrete array type.
+struct SumWorker
+{
+  double Sum = 0.0;
+  double TupleSum = 0.0;
+
+  template <typename ArrayT>
+  void operator()(ArrayT* array)
+  {
+    for (auto value : vtk::DataArrayValueRange(array))
+    {
+      this->Sum += value;
+    }
+    const auto tuples = vtk::DataArrayTupleRange(array);
+    for (const auto& tuple : tuples)
+    {
+      for (auto comp : tuple)
+      {
+        this->TupleSum += comp;
+      }
+    }
+  }
+};
+
+template <typename ArrayT>
+int TestDispatch(ArrayT* array, double expectedSum, const char* name)
+{
+  typedef vtkTypeList_Create_4(vtkConstantArray<double>, vtkAffineArray<vtkIdType>,
+    vtkCompositeArray<float>, vtkIndexedArray<double>) Arrays;
+  SumWorker worker;
+  if (!vtkArrayDispatch::DispatchByArray<Arrays>::Execute(array, worker))
+  {
+    std::cerr << name << ": dispatch failed\n";
+    return 1;
+  }
+  if (worker.Sum != expectedSum || worker.TupleSum != expectedSum)
+  {
+    std::cerr << name << ": sum is " << worker.Sum << " / " << worker.TupleSum << " instead of "
+              << expectedSum << "\n";
+    return 1;
+  }
+  return 0;
+}
+
+// NewInstance, copies and materialization.
+template <typename ArrayT>
+int TestCopies(ArrayT* array, const char* name)
+{
+  int errors = 0;
+  vtkSmartPointer<vtkDataArray> instance = vtkSmartPointer<vtkDataArray>::Take(array->NewInstance());
+  if (!vtkArrayDownCast<vtkAOSDataArrayTemplate<typename ArrayT::ValueType> >(instance))
+  {
+    std::cerr << name << ": NewInstance is a " << instance->GetClassName() << "\n";
+    ++errors;
+  }
+  instance->DeepCopy(array);
+  errors += CompareValues(instance, array, name);
+
+  vtkNew<ArrayT> shallow;
+  shallow->ShallowCopy(array);
+  vtkNew<ArrayT> deep;
+  deep->DeepCopy(array);
+  if (shallow->GetBackend() != array->GetBackend() || deep->GetBackend() != array->GetBackend())
+  {
+    std::cerr << name << ": backend not shared by the copies\n";
+    ++errors;
+  }
+  errors += CompareValues(shallow, array, name);
+  errors += CompareValues(deep, array, name);
+
+  std::vector<typename ArrayT::ValueType> exported(array->GetNumberOfValues());
+  array->ExportToVoidPointer(exported.data());
+  auto voidPointer = static_cast<typename ArrayT::ValueType*>(array->GetVoidPointer(0));
+  for (vtkIdType i = 0; i < array->GetNumberOfValues(); ++i)
+  {
+    if (exported[i] != array->GetValue(i) || voidPointer[i] != array->GetValue(i))
+    {
+      std::cerr << name << ": wrong exported value " << i << "\n";
+      ++errors;
+      break;
+    }
+  }
+  return errors;
+}
+
+int TestConstant()
+{
+  vtkNew<vtkConstantArray<double> > array;
+  array->ConstructBackend(2.5);
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000);
+  vtkNew<vtkDoubleArray> expected;
+  expected->SetNumberOfComponents(3);
+  expected->SetNumberOfTuples(1000);
+  expected->FillValue(2.5);
+
+  int errors = CompareValues(array, expected, "vtkConstantArray");
+  errors += TestDispatch(array.GetPointer(), 7500.0, "vtkConstantArray");
+  if (array->GetActualMemorySize() > 1)
+  {
+    std::cerr << "vtkConstantArray: " << array->GetActualMemorySize() << " KiB\n";
+    ++errors;
+  }
+
+  // Writes and insertions materialize the array.
+  vtkNew<vtkConstantArray<double> > written;
+  written->ShallowCopy(array);
+  written->SetValue(3, 1.0);
+  expected->SetValue(3, 1.0);
+  written->InsertNextTuple3(4.0, 5.0, 6.0);
+  expected->InsertNextTuple3(4.0, 5.0, 6.0);
+  if (!written->IsMaterialized() || written->GetBackend())
+  {
+    std::cerr << "vtkConstantArray: not materialized by a write\n";
+    ++errors;
+  }
+  errors += CompareValues(written, expected, "Written vtkConstantArray");
+  if (array->IsMaterialized() || array->GetValue(3) != 2.5)
+  {
+    std::cerr << "vtkConstantArray: shallow copy modified by a write\n";
+    ++errors;
+  }
+  errors += TestCopies(array.GetPointer(), "vtkConstantArray");
+  return errors;
+}
+
+int TestAffine()
+{
+  vtkNew<vtkAffineArray<vtkIdType> > array;
+  array->ConstructBackend(3, -7);
+  array->SetNumberOfTuples(500);
+  vtkNew<vtkIdTypeArray> expected;
+  expected->SetNumberOfTuples(500);
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < 500; ++i)
+  {
+    expected->SetValue(i, 3 * i - 7);
+    sum += 3 * i - 7;
+  }
+
+  int errors = CompareValues(array, expected, "vtkAffineArray");
+  errors += TestDispatch(array.GetPointer(), sum, "vtkAffineArray");
+  errors += TestCopies(array.GetPointer(), "vtkAffineArray");
+  return errors;
+}
+
+int TestComposite()
+{
+  // An AOS array and a SOA array.
+  vtkNew<vtkFloatArray> first;
+  first->SetNumberOfComponents(2);
+  first->SetNumberOfTuples(10);
+  vtkNew<vtkSOADataArrayTemplate<float> > second;
+  second->SetNumberOfComponents(2);
+  second->SetNumberOfTuples(7);
+  vtkNew<vtkFloatArray> expected;
+  expected->SetNumberOfComponents(2);
+  expected->SetNumberOfTuples(17);
+  double sum = 0.0;
+  for (vtkIdType t = 0; t < 17; ++t)
+  {
+    for (int c = 0; c < 2; ++c)
+    {
+      float value = static_cast<float>(t * 10 + c);
+      (t < 10 ? static_cast<vtkDataArray*>(first) : static_cast<vtkDataArray*>(second))
+        ->SetComponent(t < 10 ? t : t - 10, c, value);
+      expected->SetComponent(t, c, value);
+      sum += value;
+    }
+  }
+
+  vtkNew<vtkCompositeArray<float> > array;
+  array->ConstructBackend(std::vector<vtkDataArray*>{ first, second });
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(17);
+
+  int errors = CompareValues(array, expected, "vtkCompositeArray");
+  errors += TestDispatch(array.GetPointer(), sum, "vtkCompositeArray");
+  errors += TestCopies(array.GetPointer(), "vtkCompositeArray");
+  return errors;
+}
+
+int TestIndexed()
+{
+  vtkNew<vtkDoubleArray> source;
+  source->SetNumberOfComponents(3);
+  source->SetNumberOfTuples(20);
+  for (vtkIdType i = 0; i < 60; ++i)
+  {
+    source->SetValue(i, 0.5 * i);
+  }
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetNumberOfTuples(20);
+  for (vtkIdType i = 0; i < 20; ++i)
+  {
+    scalars->SetValue(i, i * i);
+  }
+
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdTypeArray> idArray;
+  for (vtkIdType id : { 19, 3, 3, 0, 11, 7 })
+  {
+    ids->InsertNextId(id);
+    idArray->InsertNextValue(id);
+  }
+  vtkNew<vtkDoubleArray> expected;
+  expected->SetNumberOfComponents(3);
+  vtkNew<vtkDoubleArray> expectedScalars;
+  double sum = 0.0, scalarSum = 0.0;
+  for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+  {
+    expected->InsertNextTuple(source->GetTuple(ids->GetId(i)));
+    expectedScalars->InsertNextTuple(scalars->GetTuple(ids->GetId(i)));
+    for (int c = 0; c < 3; ++c)
+    {
+      sum += source->GetComponent(ids->GetId(i), c);
+    }
+    scalarSum += scalars->GetValue(ids->GetId(i));
+  }
+
+  vtkNew<vtkIndexedArray<double> > array;
+  array->ConstructBackend(ids.GetPointer(), source.GetPointer());
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(ids->GetNumberOfIds());
+  int errors = CompareValues(array, expected, "vtkIndexedArray");
+  errors += TestDispatch(array.GetPointer(), sum, "vtkIndexedArray");
+  errors += TestCopies(array.GetPointer(), "vtkIndexedArray");
+
+  vtkNew<vtkIndexedArray<double> > scalarArray;
+  scalarArray->ConstructBackend(idArray.GetPointer(), scalars.GetPointer());
+  scalarArray->SetNumberOfTuples(idArray->GetNumberOfTuples());
+  errors += CompareValues(scalarArray, expectedScalars, "Single component vtkIndexedArray");
+  errors += TestDispatch(scalarArray.GetPointer(), scalarSum, "Single component vtkIndexedArray");
+
+  // Views read a snapshot sharing the memory of the source: writes in place
+  // are seen, but the view keeps its values once the source is resized or
+  // detached, and stores them when the source is modified.
+  scalarArray->MaterializeOnModified(scalars);
+  scalars->SetValue(ids->GetId(0), -1.0);
+  if (scalarArray->IsMaterialized() || scalarArray->GetValue(0) != -1.0)
+  {
+    std::cerr << "vtkIndexedArray: view does not share the source memory\n";
+    ++errors;
+  }
+  scalars->SetNumberOfTuples(10);
+  scalars->Squeeze();
+  if (scalarArray->GetValue(0) != -1.0 || scalarArray->GetValue(4) != 121.0)
+  {
+    std::cerr << "vtkIndexedArray: view changed when the source shrank\n";
+    ++errors;
+  }
+  vtkNew<vtkIdList> detachedIds;
+  detachedIds->InsertNextId(0);
+  detachedIds->InsertNextId(3);
+  vtkNew<vtkIndexedArray<double> > detached;
+  detached->ConstructBackend(detachedIds.GetPointer(), scalars.GetPointer());
+  detached->SetNumberOfTuples(2);
+  detached->MaterializeOnModified(scalars);
+  scalars->DetachStorage();
+  scalars->SetValue(3, -2.0);
+  if (detached->IsMaterialized() || detached->GetValue(1) != 9.0)
+  {
+    std::cerr << "vtkIndexedArray: view changed with a detached source\n";
+    ++errors;
+  }
+  scalars->Modified();
+  if (!detached->IsMaterialized() || detached->GetValue(1) != 9.0 ||
+    !scalarArray->IsMaterialized() || scalarArray->GetValue(0) != -1.0)
+  {
+    std::cerr << "vtkIndexedArray: view not materialized by a modified source\n";
+    ++errors;
+  }
+  return errors;
+}
+
+}
+
+int TestImplicitArrays(int, char*[])
+{
+  // GetVoidPointer is tested on purpose.
+  vtksys::SystemTools::PutEnv("VTK_SILENCE_GET_VOID_POINTER_WARNINGS=1");
+
+  int errors = TestConstant();
+  errors += TestAffine();
+  errors += TestComposite();
+  errors += TestIndexed();
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,6 +1,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
+#include "vtkInformationIterator.h"
 #include "vtkInformationStringKey.h"
 #include "vtkInformationStringVectorKey.h"
 #include "vtkInformationVariantKey.h"
@@ -10,6 +11,8 @@
 #include "vtkVariant.h"
 #include "vtkMath.h"
 
+#include <set>
+
 template<typename T, typename V>
 int UnitTestScalarValueKey(vtkInformation* info, T* key, const V& val)
 {
@@ -130,6 +133,78 @@ int UnitTestVectorValueKey(
   return ok_setgetcomp && ok_copyget && ok_length && ok_appendedlength;
 }
 
+// Remove every key, and add one, while iterating: each key present from
+// the start must be visited once, and the added key not at all.
+int UnitTestIteratorRemoval(vtkInformation* info, vtkInformationDoubleKey* added)
+{
+  int numberOfKeys = info->GetNumberOfKeys();
+  std::set<vtkInformationKey*> visited;
+  int numberOfVisits = 0;
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformation(info);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkInformationKey* key = iter->GetCurrentKey();
+    visited.insert(key);
+    ++numberOfVisits;
+    info->Remove(key);
+    if (numberOfVisits == 2)
+    {
+      added->Set(info, 1.0);
+    }
+  }
+  int ok = (numberOfVisits == numberOfKeys &&
+            static_cast<int>(visited.size()) == numberOfKeys &&
+            visited.count(added) == 0 && info->GetNumberOfKeys() == 1);
+  if (!ok)
+  {
+    cerr << "Iteration with removal visited " << numberOfVisits << " keys, "
+         << visited.size() << " distinct, of " << numberOfKeys << ".\n";
+  }
+  return ok;
+}
+
+// Remove a key not visited yet while iterating: it must be skipped, and
+// every other key visited once.
+int UnitTestIteratorRemovalAhead(vtkInformation* info)
+{
+  int numberOfKeys = info->GetNumberOfKeys();
+  std::set<vtkInformationKey*> visited;
+  int numberOfVisits = 0;
+  vtkInformationKey* removed = nullptr;
+  vtkNew<vtkInformationIterator> iter;
+  iter->SetInformation(info);
+  vtkNew<vtkInformationIterator> other;
+  other->SetInformation(info);
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    vtkInformationKey* key = iter->GetCurrentKey();
+    visited.insert(key);
+    ++numberOfVisits;
+    for (other->InitTraversal(); !removed && !other->IsDoneWithTraversal();
+         other->GoToNextItem())
+    {
+      if (visited.count(other->GetCurrentKey()) == 0)
+      {
+        removed = other->GetCurrentKey();
+      }
+    }
+    if (removed && info->Has(removed))
+    {
+      info->Remove(removed);
+    }
+  }
+  int ok = (removed != nullptr && numberOfVisits == numberOfKeys - 1 &&
+            static_cast<int>(visited.size()) == numberOfKeys - 1 &&
+            visited.count(removed) == 0);
+  if (!ok)
+  {
+    cerr << "Iteration with removal ahead visited " << numberOfVisits << " keys, "
+         << visited.size() << " distinct, of " << numberOfKeys << ".\n";
+  }
+  return ok;
+}
+
 int UnitTestInformationKeys(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
 {
   int ok = 1;
@@ -162,5 +237,11 @@ int UnitTestInformationKeys(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
     new vtkInformationStringVectorKey("Test", "vtkTest");
   ok &= UnitTestVectorValueKey(info, tsvkey, tsval);
 
+  ok &= UnitTestIteratorRemovalAhead(info);
+
+  vtkInformationDoubleKey* taddedkey =
+    new vtkInformationDoubleKey("Added", "vtkTest");
+  ok &= UnitTestIteratorRemoval(info, taddedkey);
+
   return ! ok;
 }
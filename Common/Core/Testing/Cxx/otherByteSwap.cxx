@@ -20,7 +20,9 @@
 #include "vtkByteSwap.h"
 #include "vtkDebugLeaks.h"
 
+#include <cstring>
 #include <sstream>
+#include <string>
 
 int TestByteSwap(ostream& strm)
 {
@@ -153,9 +155,91 @@ int TestByteSwap(ostream& strm)
   return 0;
 }
 
+// Check the swapping of ranges of every length up to a few vector registers,
+// at every alignment, against the reversal of each segment.
+int TestByteSwapRanges(size_t wordSize)
+{
+  const size_t maxWords = 80;
+  unsigned char data[8 * maxWords + 8];
+  unsigned char expected[8 * maxWords + 8];
+  unsigned char copy[8 * maxWords + 8];
+  int errors = 0;
+  for (size_t offset = 0; offset < 8; ++offset)
+  {
+    for (size_t num = 0; num <= maxWords; ++num)
+    {
+      for (size_t i = 0; i < sizeof(data); ++i)
+      {
+        data[i] = static_cast<unsigned char>(i * 7 + num);
+      }
+      memcpy(expected, data, sizeof(data));
+      for (size_t w = 0; w < num; ++w)
+      {
+        for (size_t b = 0; b < wordSize; ++b)
+        {
+          expected[offset + w * wordSize + b] = data[offset + w * wordSize + wordSize - 1 - b];
+        }
+      }
+
+      memcpy(copy, data, sizeof(data));
+      switch (wordSize)
+      {
+        case 2: vtkByteSwap::SwapCopy2BERange(data + offset, copy + offset, num); break;
+        case 4: vtkByteSwap::SwapCopy4BERange(data + offset, copy + offset, num); break;
+        case 8: vtkByteSwap::SwapCopy8BERange(data + offset, copy + offset, num); break;
+      }
+      vtkByteSwap::SwapVoidRange(data + offset, num, wordSize);
+#ifndef VTK_WORDS_BIGENDIAN
+      if (memcmp(copy, expected, sizeof(data)) != 0)
+      {
+        cerr << "SwapCopy" << wordSize << "BERange(" << num << ") at offset " << offset
+             << " is wrong" << endl;
+        ++errors;
+      }
+#endif
+      if (memcmp(data, expected, sizeof(data)) != 0)
+      {
+        cerr << "SwapVoidRange(" << num << ", " << wordSize << ") at offset " << offset
+             << " is wrong" << endl;
+        ++errors;
+      }
+    }
+  }
+
+  // Writing swaps blocks of a range larger than a block.
+  const size_t numWords = 10000;
+  std::string values(numWords * wordSize, '\0');
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<char>(i * 13);
+  }
+  std::ostringstream written;
+  switch (wordSize)
+  {
+    case 2: vtkByteSwap::SwapWrite2BERange(values.data(), numWords, &written); break;
+    case 4: vtkByteSwap::SwapWrite4BERange(values.data(), numWords, &written); break;
+    case 8: vtkByteSwap::SwapWrite8BERange(values.data(), numWords, &written); break;
+  }
+  std::string swapped = values;
+  vtkByteSwap::SwapVoidRange(&swapped[0], numWords, wordSize);
+#ifndef VTK_WORDS_BIGENDIAN
+  if (written.str() != swapped)
+#else
+  if (written.str() != values)
+#endif
+  {
+    cerr << "SwapWrite" << wordSize << "BERange(" << numWords << ") is wrong" << endl;
+    ++errors;
+  }
+  return errors;
+}
 
 int otherByteSwap(int,char *[])
 {
   std::ostringstream vtkmsg_with_warning_C4701;
-  return TestByteSwap(vtkmsg_with_warning_C4701);
+  int errors = TestByteSwap(vtkmsg_with_warning_C4701);
+  errors += TestByteSwapRanges(2);
+  errors += TestByteSwapRanges(4);
+  errors += TestByteSwapRanges(8);
+  return errors;
 }
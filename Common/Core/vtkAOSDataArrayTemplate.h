@@ -273,6 +273,8 @@ public:
   VTK_NEWINSTANCE vtkArrayIterator *NewIterator() override;
   bool HasStandardMemoryLayout() override { return true; }
   void ShallowCopy(vtkDataArray *other) override;
+  bool HasSharedStorage() override { return this->Buffer->IsShared(); }
+  void DetachStorage() override;
 
   // Reimplemented for efficiency:
   void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
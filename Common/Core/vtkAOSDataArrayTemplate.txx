@@ -46,6 +46,12 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>
 ::SetArray(ValueType* array, vtkIdType size, int save, int deleteMethod)
 {
+  // Leave shared memory to the arrays still using it.
+  if (this->Buffer->IsShared())
+  {
+    this->Buffer->Delete();
+    this->Buffer = vtkBuffer<ValueType>::New();
+  }
 
   this->Buffer->SetBuffer(array, size);
 
@@ -303,6 +309,25 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::ShallowCopy(vtkDataArray *other)
   }
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+void vtkAOSDataArrayTemplate<ValueTypeT>::DetachStorage()
+{
+  if (!this->Buffer->IsShared())
+  {
+    return;
+  }
+
+  vtkBuffer<ValueType>* buffer = this->Buffer->NewCopy(this->Size, this->MaxId + 1);
+  if (!buffer)
+  {
+    vtkErrorMacro("Failed to allocate memory to detach shared storage.");
+    return;
+  }
+  this->Buffer->Delete();
+  this->Buffer = buffer;
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
@@ -447,6 +472,12 @@ template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 {
   vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  // Leave shared memory to the arrays still using it.
+  if (this->Buffer->IsShared())
+  {
+    this->Buffer->Delete();
+    this->Buffer = vtkBuffer<ValueType>::New();
+  }
   if (this->Buffer->Allocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
@@ -459,7 +490,22 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
 {
-  if (this->Buffer->Reallocate(numTuples * this->GetNumberOfComponents()))
+  vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  // Shared memory is not resized under the arrays still using it: the values
+  // kept are copied into memory of the new size instead.
+  if (this->Buffer->IsShared())
+  {
+    vtkBuffer<ValueType>* buffer = this->Buffer->NewCopy(numValues, this->MaxId + 1);
+    if (!buffer)
+    {
+      return false;
+    }
+    this->Buffer->Delete();
+    this->Buffer = buffer;
+    this->Size = this->Buffer->GetSize();
+    return true;
+  }
+  if (this->Buffer->Reallocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
     return true;
@@ -643,6 +643,7 @@ public:
     SoADataArrayTemplate,
     TypedDataArray,
     MappedDataArray,
+    ImplicitArray,
 
     DataArrayTemplate = AoSDataArrayTemplate //! Legacy
   };
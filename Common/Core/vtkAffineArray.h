@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAffineArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkAffineArray
+ * @brief   implicit array of values affine in their index
+ *
+ * vtkAffineArray<T> is a vtkImplicitArray whose value at index i (in AOS
+ * ordering) is slope * i + intercept. It represents ids (vtkIdFilter,
+ * original cell ids of a pass-through), or the uniform coordinates of a
+ * structured axis, without storage:
+ *
+ * @code
+ * vtkNew<vtkAffineArray<vtkIdType>> ids;
+ * ids->ConstructBackend(1, 0);
+ * ids->SetNumberOfTuples(numCells);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray
+*/
+
+#ifndef vtkAffineArray_h
+#define vtkAffineArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueTypeT>
+struct vtkAffineImplicitBackend
+{
+  typedef ValueTypeT ValueType;
+
+  vtkAffineImplicitBackend(ValueType slope, ValueType intercept)
+    : Slope(slope)
+    , Intercept(intercept)
+  {
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    return static_cast<ValueType>(this->Slope * valueIdx + this->Intercept);
+  }
+
+  unsigned long GetActualMemorySize() const { return 1; }
+
+  const ValueType Slope;
+  const ValueType Intercept;
+};
+
+template <typename ValueTypeT>
+using vtkAffineArray = vtkImplicitArray<vtkAffineImplicitBackend<ValueTypeT> >;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAffineArray.h
@@ -28,6 +28,8 @@
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
+#include <algorithm> // for std::min and std::copy
+
 template <class ScalarTypeT>
 class vtkBuffer : public vtkObject
 {
@@ -74,6 +76,20 @@ public:
    */
   bool Reallocate(vtkIdType newsize);
 
+  /**
+   * Returns true if more than one owner holds a reference to this buffer,
+   * e.g. after a vtkDataArray::ShallowCopy(). Data array implementations use
+   * this to detach shared storage before writing (copy-on-write).
+   */
+  bool IsShared() { return this->GetReferenceCount() > 1; }
+
+  /**
+   * Allocate a new buffer holding @a size elements and initialize it with the
+   * first @a count elements of this one. The caller owns the returned buffer.
+   * Returns nullptr if the allocation fails.
+   */
+  vtkBuffer<ScalarTypeT>* NewCopy(vtkIdType size, vtkIdType count);
+
 protected:
   vtkBuffer()
     : Pointer(nullptr),
@@ -187,5 +203,23 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
   return true;
 }
 
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+vtkBuffer<ScalarT>* vtkBuffer<ScalarT>::NewCopy(vtkIdType size, vtkIdType count)
+{
+  vtkBuffer<ScalarT>* copy = vtkBuffer<ScalarT>::New();
+  if (!copy->Allocate(size))
+  {
+    copy->Delete();
+    return nullptr;
+  }
+  count = std::min(count, std::min(size, this->Size));
+  if (count > 0)
+  {
+    std::copy(this->Pointer, this->Pointer + count, copy->Pointer);
+  }
+  return copy;
+}
+
 #endif
 // VTK-HeaderTest-Exclude: vtkBuffer.h
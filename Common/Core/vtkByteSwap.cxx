@@ -16,6 +16,22 @@
 #include <memory.h>
 #include "vtkObjectFactory.h"
 
+// Pick the widest byte shuffle available at compile time for the swapping
+// of ranges.
+#if defined(__AVX2__)
+# include <immintrin.h>
+# define VTK_BYTE_SWAP_AVX2
+#elif defined(__SSSE3__)
+# include <tmmintrin.h>
+# define VTK_BYTE_SWAP_SSSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define VTK_BYTE_SWAP_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+# include <arm_neon.h>
+# define VTK_BYTE_SWAP_NEON
+#endif
+
 vtkStandardNewMacro(vtkByteSwap);
 
 //----------------------------------------------------------------------------
@@ -61,16 +77,151 @@ template<> struct vtkByteSwapper<8>
 };
 
 //----------------------------------------------------------------------------
-// Define range swap functions.
+// Define block swap functions, which swap as many whole vector registers of
+// segments as possible from src to dst and return the number of segments
+// swapped.  The rest is swapped one segment at a time.
+#if defined(VTK_BYTE_SWAP_AVX2) || defined(VTK_BYTE_SWAP_SSSE3)
+template <size_t s> inline __m128i vtkByteSwapMask()
+{
+  // Reverse the bytes of each segment of a 16-byte lane.
+  char mask[16];
+  for (size_t i = 0; i < 16; ++i)
+  {
+    mask[i] = static_cast<char>(i - i % s + s - 1 - i % s);
+  }
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+template <size_t s>
+inline size_t vtkByteSwapBlocks(const char* src, char* dst, size_t num)
+{
+  const __m128i mask = vtkByteSwapMask<s>();
+  size_t i = 0;
+# if defined(VTK_BYTE_SWAP_AVX2)
+  const __m256i mask2 = _mm256_broadcastsi128_si256(mask);
+  for (; i + 32 / s <= num; i += 32 / s)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * s));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * s),
+                        _mm256_shuffle_epi8(v, mask2));
+  }
+# endif
+  for (; i + 16 / s <= num; i += 16 / s)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * s));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * s),
+                     _mm_shuffle_epi8(v, mask));
+  }
+  return i;
+}
+#elif defined(VTK_BYTE_SWAP_SSE2)
+// Without a byte shuffle, reorder the 16-bit words of each segment and then
+// swap the two bytes of every word.
+template <size_t s> inline __m128i vtkByteSwapWords(__m128i v);
+template <> inline __m128i vtkByteSwapWords<2>(__m128i v)
+{
+  return v;
+}
+template <> inline __m128i vtkByteSwapWords<4>(__m128i v)
+{
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+  return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+template <> inline __m128i vtkByteSwapWords<8>(__m128i v)
+{
+  v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+  return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+template <size_t s>
+inline size_t vtkByteSwapBlocks(const char* src, char* dst, size_t num)
+{
+  size_t i = 0;
+  for (; i + 16 / s <= num; i += 16 / s)
+  {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * s));
+    v = vtkByteSwapWords<s>(v);
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * s), v);
+  }
+  return i;
+}
+#elif defined(VTK_BYTE_SWAP_NEON)
+template <size_t s> inline uint8x16_t vtkByteSwapReverse(uint8x16_t v);
+template <> inline uint8x16_t vtkByteSwapReverse<2>(uint8x16_t v)
+{
+  return vrev16q_u8(v);
+}
+template <> inline uint8x16_t vtkByteSwapReverse<4>(uint8x16_t v)
+{
+  return vrev32q_u8(v);
+}
+template <> inline uint8x16_t vtkByteSwapReverse<8>(uint8x16_t v)
+{
+  return vrev64q_u8(v);
+}
+template <size_t s>
+inline size_t vtkByteSwapBlocks(const char* src, char* dst, size_t num)
+{
+  size_t i = 0;
+  for (; i + 16 / s <= num; i += 16 / s)
+  {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i * s));
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + i * s), vtkByteSwapReverse<s>(v));
+  }
+  return i;
+}
+#else
+template <size_t s>
+inline size_t vtkByteSwapBlocks(const char*, char*, size_t)
+{
+  return 0;
+}
+#endif
+
+//----------------------------------------------------------------------------
+// Define range swap functions.  The copies swap num segments of s bytes from
+// src to dst, which must either be the same or not overlap.
+template <size_t s>
+inline void vtkByteSwapRangeCopy(const char* src, char* dst, size_t num)
+{
+  size_t i = vtkByteSwapBlocks<s>(src, dst, num);
+  for (; i < num; ++i)
+  {
+    char temp[s];
+    memcpy(temp, src + i * s, s);
+    vtkByteSwapper<s>::Swap(temp);
+    memcpy(dst + i * s, temp, s);
+  }
+}
+template <>
+inline void vtkByteSwapRangeCopy<1>(const char* src, char* dst, size_t num)
+{
+  if (src != dst)
+  {
+    memcpy(dst, src, num);
+  }
+}
 template <class T> inline void vtkByteSwapRange(T* first, size_t num)
 {
-  // Swap one value at a time.
-  T* last = first + num;
-  for(T* p=first; p != last; ++p)
+  char* data = reinterpret_cast<char*>(first);
+  vtkByteSwapRangeCopy<sizeof(T)>(data, data, num);
+}
+template <class T>
+inline void vtkByteSwapCopy(const void* src, void* dst, size_t num)
+{
+  vtkByteSwapRangeCopy<sizeof(T)>(static_cast<const char*>(src),
+                                  static_cast<char*>(dst), num);
+}
+inline void vtkNoByteSwapCopy(const void* src, void* dst, size_t num,
+                              size_t size)
+{
+  if (src != dst)
   {
-    vtkByteSwapper<sizeof(T)>::Swap(reinterpret_cast<char*>(p));
+    memcpy(dst, src, num * size);
   }
 }
+
+// Size in bytes of the blocks swapped before they are written.
+#define VTK_BYTE_SWAP_WRITE_BLOCK_SIZE 16384
 inline bool vtkByteSwapRangeWrite(const char* first, size_t num,
                                   FILE* f, int)
 {
@@ -95,17 +246,16 @@ inline bool vtkByteSwapRangeWrite(const unsigned char* first, size_t num,
 template <class T>
 inline bool vtkByteSwapRangeWrite(const T* first, size_t num, FILE* f, long)
 {
-  // Swap and write one value at a time.  We do not need to do this in
-  // blocks because the file stream is already buffered.
-  const T* last = first + num;
+  // Swap and write one block of values at a time.
+  const size_t blockSize = VTK_BYTE_SWAP_WRITE_BLOCK_SIZE / sizeof(T);
+  char block[VTK_BYTE_SWAP_WRITE_BLOCK_SIZE];
   bool result=true;
-  for(const T* p=first; p != last && result; ++p)
+  for(size_t i=0; i < num && result; i += blockSize)
   {
-    // Use a union to avoid breaking C++ aliasing rules.
-    union { T value; char data[sizeof(T)]; } temp = {*p};
-    vtkByteSwapper<sizeof(T)>::Swap(temp.data);
-    size_t status=fwrite(temp.data, sizeof(T), 1, f);
-    result=status==1;
+    size_t n = num - i < blockSize ? num - i : blockSize;
+    vtkByteSwapCopy<T>(first + i, block, n);
+    size_t status=fwrite(block, sizeof(T), n, f);
+    result=status==n;
   }
   return result;
 }
@@ -133,15 +283,14 @@ template <class T>
 inline void vtkByteSwapRangeWrite(const T* first, size_t num,
                                   ostream* os, long)
 {
-  // Swap and write one value at a time.  We do not need to do this in
-  // blocks because the file stream is already buffered.
-  const T* last = first + num;
-  for(const T* p=first; p != last; ++p)
+  // Swap and write one block of values at a time.
+  const size_t blockSize = VTK_BYTE_SWAP_WRITE_BLOCK_SIZE / sizeof(T);
+  char block[VTK_BYTE_SWAP_WRITE_BLOCK_SIZE];
+  for(size_t i=0; i < num; i += blockSize)
   {
-    // Use a union to avoid breaking C++ aliasing rules.
-    union { T value; char data[sizeof(T)]; } temp = {*p};
-    vtkByteSwapper<sizeof(T)>::Swap(temp.data);
-    os->write(temp.data, sizeof(T));
+    size_t n = num - i < blockSize ? num - i : blockSize;
+    vtkByteSwapCopy<T>(first + i, block, n);
+    os->write(block, n*sizeof(T));
   }
 }
 
@@ -151,6 +300,11 @@ inline void vtkByteSwapRangeWrite(const T* first, size_t num,
 template <class T> inline void vtkByteSwapBE(T*) {}
 template <class T> inline void vtkByteSwapBERange(T*, size_t) {}
 template <class T>
+inline void vtkByteSwapBERangeCopy(const T* src, T* dst, size_t num)
+{
+  vtkNoByteSwapCopy(src, dst, num, sizeof(T));
+}
+template <class T>
 inline bool vtkByteSwapBERangeWrite(const T* p, size_t num, FILE* f)
 {
   size_t status=fwrite(p, sizeof(T), static_cast<size_t>(num), f);
@@ -170,6 +324,11 @@ template <class T> inline void vtkByteSwapLERange(T* p, size_t num)
   vtkByteSwapRange(p, num);
 }
 template <class T>
+inline void vtkByteSwapLERangeCopy(const T* src, T* dst, size_t num)
+{
+  vtkByteSwapCopy<T>(src, dst, num);
+}
+template <class T>
 inline bool vtkByteSwapLERangeWrite(const T* p, size_t num, FILE* f)
 {
   return vtkByteSwapRangeWrite(p, num, f, 1);
@@ -189,6 +348,11 @@ template <class T> inline void vtkByteSwapBERange(T* p, size_t num)
   vtkByteSwapRange(p, num);
 }
 template <class T>
+inline void vtkByteSwapBERangeCopy(const T* src, T* dst, size_t num)
+{
+  vtkByteSwapCopy<T>(src, dst, num);
+}
+template <class T>
 inline bool vtkByteSwapBERangeWrite(const T* p, size_t num, FILE* f)
 {
   return vtkByteSwapRangeWrite(p, num, f, 1);
@@ -201,6 +365,11 @@ inline void vtkByteSwapBERangeWrite(const T* p, size_t num, ostream* os)
 template <class T> inline void vtkByteSwapLE(T*) {}
 template <class T> inline void vtkByteSwapLERange(T*, size_t) {}
 template <class T>
+inline void vtkByteSwapLERangeCopy(const T* src, T* dst, size_t num)
+{
+  vtkNoByteSwapCopy(src, dst, num, sizeof(T));
+}
+template <class T>
 inline bool vtkByteSwapLERangeWrite(const T* p, size_t num, FILE* f)
 {
   size_t status=fwrite(p, sizeof(T), static_cast<size_t>(num), f);
@@ -273,6 +442,12 @@ typedef double vtkByteSwapType8;
     { vtkByteSwap::SwapLERange(static_cast<vtkByteSwapType##S*>(p), n); }       \
   void vtkByteSwap::Swap##S##BERange(void* p, size_t n)                         \
     { vtkByteSwap::SwapBERange(static_cast<vtkByteSwapType##S*>(p), n); }       \
+  void vtkByteSwap::SwapCopy##S##LERange(void const* s, void* d, size_t n)      \
+    { vtkByteSwapLERangeCopy(static_cast<const vtkByteSwapType##S*>(s),         \
+        static_cast<vtkByteSwapType##S*>(d), n); }                              \
+  void vtkByteSwap::SwapCopy##S##BERange(void const* s, void* d, size_t n)      \
+    { vtkByteSwapBERangeCopy(static_cast<const vtkByteSwapType##S*>(s),         \
+        static_cast<vtkByteSwapType##S*>(d), n); }                              \
   bool vtkByteSwap::SwapWrite##S##LERange(void const* p, size_t n, FILE* f)     \
     { return vtkByteSwap::SwapLERangeWrite(                                     \
        static_cast<const vtkByteSwapType##S*>(p), n, f); }                      \
@@ -295,6 +470,15 @@ VTK_BYTE_SWAP_SIZE(8)
 // assumes the word size is divisible by two.
 void vtkByteSwap::SwapVoidRange(void *buffer, size_t numWords, size_t wordSize)
 {
+  switch (wordSize)
+  {
+    case 1: return;
+    case 2: vtkByteSwapRange(static_cast<vtkByteSwapType2*>(buffer), numWords); return;
+    case 4: vtkByteSwapRange(static_cast<vtkByteSwapType4*>(buffer), numWords); return;
+    case 8: vtkByteSwapRange(static_cast<vtkByteSwapType8*>(buffer), numWords); return;
+    default: break;
+  }
+
   unsigned char temp, *out, *buf;
   size_t idx1, idx2, inc, half;
 
@@ -19,6 +19,10 @@
  * vtkByteSwap is used by other classes to perform machine dependent byte
  * swapping. Byte swapping is often used when reading or writing binary
  * files.
+ *
+ * Ranges of 2-, 4- and 8-byte segments are swapped with the vector
+ * instructions available at compile time (AVX2, SSSE3, SSE2 or NEON), and
+ * one segment at a time otherwise.
 */
 
 #ifndef vtkByteSwap_h
@@ -95,6 +99,17 @@ public:
   static void SwapWrite8LERange(void const* p, size_t num, ostream* os);
   //@}
 
+  //@{
+  /**
+   * Copy a block of 2-, 4-, or 8-byte segments from src to dst, swapping
+   * them for storage as Little Endian.  src and dst may be the same but
+   * must not otherwise overlap.
+   */
+  static void SwapCopy2LERange(void const* src, void* dst, size_t num);
+  static void SwapCopy4LERange(void const* src, void* dst, size_t num);
+  static void SwapCopy8LERange(void const* src, void* dst, size_t num);
+  //@}
+
   //@{
   /**
    * Swap 2, 4, or 8 bytes for storage as Big Endian.
@@ -126,6 +141,17 @@ public:
   static void SwapWrite8BERange(void const* p, size_t num, ostream* os);
   //@}
 
+  //@{
+  /**
+   * Copy a block of 2-, 4-, or 8-byte segments from src to dst, swapping
+   * them for storage as Big Endian.  src and dst may be the same but must
+   * not otherwise overlap.
+   */
+  static void SwapCopy2BERange(void const* src, void* dst, size_t num);
+  static void SwapCopy4BERange(void const* src, void* dst, size_t num);
+  static void SwapCopy8BERange(void const* src, void* dst, size_t num);
+  //@}
+
   /**
    * Swaps the bytes of a buffer.  Uses an arbitrary word size, but
    * assumes the word size is divisible by two.
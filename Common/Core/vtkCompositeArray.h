@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeArray
+ * @brief   implicit array concatenating other arrays
+ *
+ * vtkCompositeArray<T> is a vtkImplicitArray presenting a list of arrays as
+ * a single one, the tuples of the first array followed by those of the
+ * second one, etc. All arrays must have the same number of components, and
+ * must not be resized while the composite array is in use. Values are read
+ * directly from arrays of type vtkAOSDataArrayTemplate<T> and through the
+ * vtkDataArray API from the others.
+ *
+ * @code
+ * vtkNew<vtkCompositeArray<float>> all;
+ * all->ConstructBackend(std::vector<vtkDataArray*>{ first, second });
+ * all->SetNumberOfComponents(3);
+ * all->SetNumberOfTuples(first->GetNumberOfTuples() + second->GetNumberOfTuples());
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray
+*/
+
+#ifndef vtkCompositeArray_h
+#define vtkCompositeArray_h
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkImplicitArray.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <vector>
+
+template <typename ValueTypeT>
+class vtkCompositeImplicitBackend
+{
+public:
+  typedef ValueTypeT ValueType;
+
+  vtkCompositeImplicitBackend(const std::vector<vtkDataArray*>& arrays)
+  {
+    this->Offsets.push_back(0);
+    for (vtkDataArray* array : arrays)
+    {
+      vtkAOSDataArrayTemplate<ValueType>* aos =
+        vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType> >(array);
+      this->Arrays.push_back(array);
+      this->Pointers.push_back(aos ? aos->GetPointer(0) : nullptr);
+      this->Offsets.push_back(this->Offsets.back() + array->GetNumberOfValues());
+    }
+    this->NumberOfComponents = arrays.empty() ? 1 : arrays[0]->GetNumberOfComponents();
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    // Offsets holds the first value of each array, then the total size.
+    std::size_t a = static_cast<std::size_t>(
+      std::upper_bound(this->Offsets.begin(), this->Offsets.end(), valueIdx) -
+      this->Offsets.begin() - 1);
+    vtkIdType localIdx = valueIdx - this->Offsets[a];
+    if (const ValueType* ptr = this->Pointers[a])
+    {
+      return ptr[localIdx];
+    }
+    vtkIdType tupleIdx = localIdx / this->NumberOfComponents;
+    return static_cast<ValueType>(this->Arrays[a]->GetComponent(
+      tupleIdx, static_cast<int>(localIdx - tupleIdx * this->NumberOfComponents)));
+  }
+
+  unsigned long GetActualMemorySize() const { return 1; }
+
+private:
+  std::vector<vtkSmartPointer<vtkDataArray> > Arrays;
+  std::vector<const ValueType*> Pointers;
+  std::vector<vtkIdType> Offsets;
+  vtkIdType NumberOfComponents;
+};
+
+template <typename ValueTypeT>
+using vtkCompositeArray = vtkImplicitArray<vtkCompositeImplicitBackend<ValueTypeT> >;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCompositeArray.h
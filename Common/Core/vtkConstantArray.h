@@ -0,0 +1,59 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConstantArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConstantArray
+ * @brief   implicit array holding the same value everywhere
+ *
+ * vtkConstantArray<T> is a vtkImplicitArray returning one value for every
+ * component of every tuple, whatever the size of the array:
+ *
+ * @code
+ * vtkNew<vtkConstantArray<double>> ones;
+ * ones->ConstructBackend(1.0);
+ * ones->SetNumberOfComponents(3);
+ * ones->SetNumberOfTuples(numPts);
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray
+*/
+
+#ifndef vtkConstantArray_h
+#define vtkConstantArray_h
+
+#include "vtkImplicitArray.h"
+
+template <typename ValueTypeT>
+struct vtkConstantImplicitBackend
+{
+  typedef ValueTypeT ValueType;
+
+  vtkConstantImplicitBackend(ValueType value)
+    : Value(value)
+  {
+  }
+
+  ValueType operator()(vtkIdType) const { return this->Value; }
+
+  unsigned long GetActualMemorySize() const { return 1; }
+
+  const ValueType Value;
+};
+
+template <typename ValueTypeT>
+using vtkConstantArray = vtkImplicitArray<vtkConstantImplicitBackend<ValueTypeT> >;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkConstantArray.h
@@ -15,6 +15,10 @@
 #   Include vtkTypedDataArray<ValueType> for the basic types supported
 #   by VTK. This enables the old-style in-situ vtkMappedDataArray subclasses
 #   to be used.
+# - VTK_DISPATCH_IMPLICIT_ARRAYS (default: OFF)
+#   Include vtkConstantArray<ValueType>, vtkAffineArray<ValueType>,
+#   vtkCompositeArray<ValueType> and vtkIndexedArray<ValueType> for the basic
+#   types supported by VTK.
 #
 # At a lower level, specific arrays can be added to the list individually in
 # two ways:
@@ -139,6 +143,17 @@ if (VTK_DISPATCH_TYPED_ARRAYS)
   )
 endif()
 
+if (VTK_DISPATCH_IMPLICIT_ARRAYS)
+  foreach(implicit_array
+      vtkConstantArray vtkAffineArray vtkCompositeArray vtkIndexedArray)
+    list(APPEND vtkArrayDispatch_containers ${implicit_array})
+    set(vtkArrayDispatch_${implicit_array}_header ${implicit_array}.h)
+    set(vtkArrayDispatch_${implicit_array}_types
+      ${vtkArrayDispatch_all_types}
+    )
+  endforeach()
+endif()
+
 endmacro()
 
 # Concatenates a list of strings into a single string, since string(CONCAT ...)
@@ -306,6 +306,24 @@ public:
    */
   virtual void ShallowCopy(vtkDataArray *other);
 
+  /**
+   * Returns true if the memory holding the values of this array is shared
+   * with another array, which happens after ShallowCopy(). Writing to such an
+   * array also changes the values seen by the arrays sharing its memory.
+   * Resizing it, or giving it new memory, does not: the array then stops
+   * sharing its memory first.
+   */
+  virtual bool HasSharedStorage() { return false; }
+
+  /**
+   * Copy-on-write support for shallow copies. If HasSharedStorage() is true,
+   * copy the values into memory owned only by this array, so that it can be
+   * modified without affecting the arrays it shares memory with. Does nothing
+   * otherwise. The writable range functions vtk::DataArrayWritableTupleRange
+   * and vtk::DataArrayWritableValueRange call this before returning.
+   */
+  virtual void DetachStorage() {}
+
   /**
    * Fill a component of a data array with a specified value. This method
    * sets the specified component to specified value for all tuples in the
@@ -628,6 +646,7 @@ inline vtkDataArray* vtkDataArray::FastDownCast(vtkAbstractArray *source)
       case TypedDataArray:
       case DataArray:
       case MappedDataArray:
+      case ImplicitArray:
         return static_cast<vtkDataArray*>(source);
       default:
         break;
@@ -219,6 +219,50 @@ auto DataArrayValueRange(const ArrayType& array,
         end < 0 ? array->GetNumberOfValues() : end);
 }
 
+/**
+ * @brief Same as vtk::DataArrayTupleRange, but for writing.
+ *
+ * Arrays that share their memory with other arrays after a
+ * vtkDataArray::ShallowCopy are detached first (see
+ * vtkDataArray::DetachStorage), so that writing through the returned range
+ * does not modify the arrays it was shallow copied from or to. Use this
+ * instead of vtk::DataArrayTupleRange whenever the range is used to modify
+ * an array whose storage may be shared.
+ */
+template <ComponentIdType TupleSize = detail::DynamicTupleSize,
+          typename ArrayType = vtkDataArray*>
+VTK_ITER_INLINE
+auto DataArrayWritableTupleRange(const ArrayType& array,
+                                 TupleIdType start = -1,
+                                 TupleIdType end = -1)
+    -> detail::TupleRange<typename detail::StripPointers<ArrayType>::type, TupleSize>
+{
+  assert(array);
+  array->DetachStorage();
+  return DataArrayTupleRange<TupleSize>(array, start, end);
+}
+
+/**
+ * @brief Same as vtk::DataArrayValueRange, but for writing.
+ *
+ * Arrays that share their memory with other arrays after a
+ * vtkDataArray::ShallowCopy are detached first (see
+ * vtkDataArray::DetachStorage), so that writing through the returned range
+ * does not modify the arrays it was shallow copied from or to.
+ */
+template <ComponentIdType TupleSize = detail::DynamicTupleSize,
+          typename ArrayType = vtkDataArray*>
+VTK_ITER_INLINE
+auto DataArrayWritableValueRange(const ArrayType& array,
+                                 ValueIdType start = -1,
+                                 ValueIdType end = -1)
+-> detail::ValueRange<typename detail::StripPointers<ArrayType>::type, TupleSize>
+{
+  assert(array);
+  array->DetachStorage();
+  return DataArrayValueRange<TupleSize>(array, start, end);
+}
+
 } // end namespace vtk
 
 VTK_ITER_OPTIMIZE_END
@@ -0,0 +1,249 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitArray
+ * @brief   A read-only vtkGenericDataArray whose values are computed on
+ * demand.
+ *
+ *
+ * vtkImplicitArray does not store its values. They are computed by a
+ * backend, a small functor given as template parameter, from the index of
+ * the value (in AOS ordering). A backend must provide:
+ *
+ * - a ValueType typedef;
+ * - ValueType operator()(vtkIdType valueIdx) const;
+ * - unsigned long GetActualMemorySize() const, the memory it holds in KiB.
+ *
+ * As the backend is known at compile time, vtkArrayDispatch workers and
+ * vtkDataArrayRange iterate over implicit arrays with inlined accesses and
+ * without materializing the values. See vtkConstantArray, vtkAffineArray,
+ * vtkCompositeArray and vtkIndexedArray for the predefined backends. Add them
+ * to the default dispatch list with the VTK_DISPATCH_IMPLICIT_ARRAYS CMake
+ * option, or dispatch on an explicit type list.
+ *
+ * The number of components and tuples must be set as for any other array.
+ * Implicit arrays are copied on write: the first method modifying a value,
+ * growing the array or requesting a raw pointer (GetVoidPointer()) computes
+ * all values into an internal buffer, releases the backend, and the array
+ * behaves as an explicit array from then on. See Materialize().
+ * NewInstance() returns a vtkAOSDataArrayTemplate of the same value type, so
+ * that algorithms copying tuples into a new array produce an explicit array.
+ *
+ * @sa
+ * vtkGenericDataArray vtkConstantArray vtkAffineArray vtkCompositeArray
+ * vtkIndexedArray
+*/
+
+#ifndef vtkImplicitArray_h
+#define vtkImplicitArray_h
+
+#include "vtkBuffer.h"
+#include "vtkGenericDataArray.h"
+#include "vtkObjectFactory.h" // For VTK_STANDARD_NEW_BODY
+#include "vtkWeakPointer.h"    // For ObservedSource
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+template <class BackendT>
+class vtkImplicitArray
+  : public vtkGenericDataArray<vtkImplicitArray<BackendT>, typename BackendT::ValueType>
+{
+  typedef vtkGenericDataArray<vtkImplicitArray<BackendT>, typename BackendT::ValueType>
+    GenericDataArrayType;
+
+public:
+  typedef vtkImplicitArray<BackendT> SelfType;
+  typedef BackendT BackendType;
+  vtkAbstractTypeMacroWithNewInstanceType(SelfType, GenericDataArrayType,
+    vtkDataArray, typeid(SelfType).name())
+  vtkAOSArrayNewInstanceMacro(SelfType)
+  typedef typename Superclass::ValueType ValueType;
+
+  static vtkImplicitArray* New();
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set or get the backend computing the values. Backends are shared between
+   * shallow and deep copies of the array, and must not be modified once the
+   * array is in use. Setting a backend discards materialized values.
+   */
+  void SetBackend(std::shared_ptr<BackendT> backend);
+  std::shared_ptr<BackendT> GetBackend() { return this->Backend; }
+  //@}
+
+  /**
+   * Create a new backend from the given constructor arguments.
+   */
+  template <typename... Args>
+  void ConstructBackend(Args&&... args)
+  {
+    this->SetBackend(std::make_shared<BackendT>(std::forward<Args>(args)...));
+  }
+
+  /**
+   * Get the value at @a valueIdx. @a valueIdx assumes AOS ordering.
+   */
+  inline ValueType GetValue(vtkIdType valueIdx) const
+  {
+    return this->Values ? this->Values[valueIdx] : (*this->Backend)(valueIdx);
+  }
+
+  /**
+   * Set the value at @a valueIdx, materializing the array first if needed.
+   */
+  inline void SetValue(vtkIdType valueIdx, ValueType value)
+  {
+    this->Materialize();
+    this->Values[valueIdx] = value;
+  }
+
+  /**
+   * Copy the tuple at @a tupleIdx into @a tuple.
+   */
+  inline void GetTypedTuple(vtkIdType tupleIdx, ValueType* tuple) const
+  {
+    const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
+    for (int cc = 0; cc < this->NumberOfComponents; ++cc)
+    {
+      tuple[cc] = this->GetValue(valueIdx + cc);
+    }
+  }
+
+  /**
+   * Set the tuple at @a tupleIdx, materializing the array first if needed.
+   */
+  inline void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple)
+  {
+    this->Materialize();
+    std::copy(tuple, tuple + this->NumberOfComponents,
+      this->Values + tupleIdx * this->NumberOfComponents);
+  }
+
+  /**
+   * Get component @a comp of the tuple at @a tupleIdx.
+   */
+  inline ValueType GetTypedComponent(vtkIdType tupleIdx, int comp) const
+  {
+    return this->GetValue(tupleIdx * this->NumberOfComponents + comp);
+  }
+
+  /**
+   * Set component @a comp of the tuple at @a tupleIdx, materializing the
+   * array first if needed.
+   */
+  inline void SetTypedComponent(vtkIdType tupleIdx, int comp, ValueType value)
+  {
+    this->SetValue(tupleIdx * this->NumberOfComponents + comp, value);
+  }
+
+  /**
+   * Compute all values into an internal buffer and release the backend. Does
+   * nothing if the array is already materialized.
+   */
+  void Materialize()
+  {
+    if (!this->Values)
+    {
+      this->MaterializeValues();
+    }
+  }
+
+  /**
+   * Return true once the values are stored in an internal buffer.
+   */
+  bool IsMaterialized() const { return this->Values != nullptr; }
+
+  /**
+   * Materialize the array as soon as @a source invokes a ModifiedEvent. The
+   * values are computed by the backend when the event is received, so the
+   * backend must not read @a source itself but data that the modification
+   * does not change, as vtkIndexedArray does with the snapshot of its
+   * source. The event is received after the modification: values the
+   * backend reads that were written in place beforehand are stored as
+   * modified. Pass nullptr to stop observing.
+   */
+  void MaterializeOnModified(vtkObject* source);
+
+  /**
+   * Return the memory held by the backend, or by the values once
+   * materialized, in KiB.
+   */
+  unsigned long GetActualMemorySize() override;
+
+  /**
+   * Use of this method is discouraged: it materializes the array.
+   */
+  void* GetVoidPointer(vtkIdType valueIdx) override;
+
+  /**
+   * Export a copy of the values in AOS ordering to the preallocated memory
+   * buffer.
+   */
+  void ExportToVoidPointer(void* ptr) override;
+
+  //@{
+  /**
+   * Copies from an implicit array of the same type share its backend, or its
+   * values once materialized for shallow copies. Deep copies of other arrays
+   * materialize the array.
+   */
+  void ShallowCopy(vtkDataArray* other) override;
+  void DeepCopy(vtkAbstractArray* aa) override { this->Superclass::DeepCopy(aa); }
+  void DeepCopy(vtkDataArray* other) override;
+  //@}
+
+  bool HasStandardMemoryLayout() override { return false; }
+  int GetArrayType() override { return vtkAbstractArray::ImplicitArray; }
+
+protected:
+  vtkImplicitArray();
+  ~vtkImplicitArray() override;
+
+  //@{
+  /**
+   * No storage is allocated until the array is materialized: the array only
+   * records its size. Growing an array holding values materializes it.
+   */
+  bool AllocateTuples(vtkIdType numTuples);
+  bool ReallocateTuples(vtkIdType numTuples);
+  //@}
+
+  void MaterializeValues();
+  void ReleaseValues();
+  void OnSourceModified() { this->Materialize(); }
+
+  std::shared_ptr<BackendT> Backend;
+
+  // Storage of the materialized values, and its buffer.
+  vtkBuffer<ValueType>* Buffer;
+  ValueType* Values;
+
+  vtkWeakPointer<vtkObject> ObservedSource;
+  unsigned long ObserverTag;
+
+private:
+  vtkImplicitArray(const vtkImplicitArray&) = delete;
+  void operator=(const vtkImplicitArray&) = delete;
+
+  friend class vtkGenericDataArray<vtkImplicitArray<BackendT>, ValueType>;
+};
+
+#include "vtkImplicitArray.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImplicitArray.h
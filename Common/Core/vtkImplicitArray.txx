@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitArray.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkImplicitArray_txx
+#define vtkImplicitArray_txx
+
+#include "vtkImplicitArray.h"
+
+#include "vtkCommand.h"
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>* vtkImplicitArray<BackendT>::New()
+{
+  VTK_STANDARD_NEW_BODY(vtkImplicitArray<BackendT>);
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::vtkImplicitArray()
+  : Buffer(nullptr)
+  , Values(nullptr)
+  , ObserverTag(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+vtkImplicitArray<BackendT>::~vtkImplicitArray()
+{
+  this->MaterializeOnModified(nullptr);
+  this->ReleaseValues();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Backend: " << this->Backend.get() << endl;
+  os << indent << "Materialized: " << (this->Values ? "true" : "false") << endl;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::SetBackend(std::shared_ptr<BackendT> backend)
+{
+  this->ReleaseValues();
+  this->Backend = std::move(backend);
+  this->DataChanged();
+  this->Modified();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::MaterializeOnModified(vtkObject* source)
+{
+  if (this->ObservedSource)
+  {
+    this->ObservedSource->RemoveObserver(this->ObserverTag);
+  }
+  this->ObservedSource = source;
+  this->ObserverTag = 0;
+  if (source && !this->Values)
+  {
+    this->ObserverTag =
+      source->AddObserver(vtkCommand::ModifiedEvent, this, &SelfType::OnSourceModified);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::MaterializeValues()
+{
+  vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+  if (!buffer->Allocate(std::max(this->Size, static_cast<vtkIdType>(1))))
+  {
+    vtkErrorMacro(<< "Error allocating a buffer of " << this->Size << " '"
+                  << this->GetDataTypeAsString() << "' elements.");
+    buffer->Delete();
+    return;
+  }
+  ValueType* values = buffer->GetBuffer();
+  if (this->Backend)
+  {
+    const BackendT& backend = *this->Backend;
+    const vtkIdType numValues = this->GetNumberOfValues();
+    for (vtkIdType valueIdx = 0; valueIdx < numValues; ++valueIdx)
+    {
+      values[valueIdx] = backend(valueIdx);
+    }
+  }
+  this->Buffer = buffer;
+  this->Values = values;
+  this->Backend.reset();
+  this->MaterializeOnModified(nullptr);
+  this->DataChanged();
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ReleaseValues()
+{
+  if (this->Buffer)
+  {
+    this->Buffer->Delete();
+    this->Buffer = nullptr;
+    this->Values = nullptr;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::AllocateTuples(vtkIdType numTuples)
+{
+  if (!this->Values)
+  {
+    return true;
+  }
+  vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->Buffer->Allocate(std::max(numValues, static_cast<vtkIdType>(1))))
+  {
+    this->Values = this->Buffer->GetBuffer();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+bool vtkImplicitArray<BackendT>::ReallocateTuples(vtkIdType numTuples)
+{
+  vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (!this->Values)
+  {
+    if (this->MaxId < 0 || numValues <= this->MaxId + 1)
+    {
+      return true;
+    }
+    // Values appended after those of the backend.
+    this->MaterializeValues();
+    if (!this->Values)
+    {
+      return false;
+    }
+  }
+  if (this->Buffer->Reallocate(std::max(numValues, static_cast<vtkIdType>(1))))
+  {
+    this->Values = this->Buffer->GetBuffer();
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+unsigned long vtkImplicitArray<BackendT>::GetActualMemorySize()
+{
+  if (this->Values)
+  {
+    return static_cast<unsigned long>(
+      std::ceil(this->Size * static_cast<double>(sizeof(ValueType)) / 1024.0));
+  }
+  return this->Backend ? this->Backend->GetActualMemorySize() : 0;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void* vtkImplicitArray<BackendT>::GetVoidPointer(vtkIdType valueIdx)
+{
+  if (!this->Values)
+  {
+    vtkDebugMacro(<< "GetVoidPointer called: materializing the implicit array.");
+    this->Materialize();
+  }
+  return this->Values ? static_cast<void*>(this->Values + valueIdx) : nullptr;
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ExportToVoidPointer(void* voidPtr)
+{
+  vtkIdType numValues = this->GetNumberOfValues();
+  if (numValues == 0)
+  {
+    // Nothing to do.
+    return;
+  }
+  if (!voidPtr)
+  {
+    vtkErrorMacro(<< "Buffer is nullptr.");
+    return;
+  }
+
+  ValueType* ptr = static_cast<ValueType*>(voidPtr);
+  if (this->Values)
+  {
+    std::copy(this->Values, this->Values + numValues, ptr);
+    return;
+  }
+  const BackendT& backend = *this->Backend;
+  for (vtkIdType valueIdx = 0; valueIdx < numValues; ++valueIdx)
+  {
+    ptr[valueIdx] = backend(valueIdx);
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::ShallowCopy(vtkDataArray* other)
+{
+  SelfType* o = SelfType::SafeDownCast(other);
+  if (!o)
+  {
+    // Not an implicit array of this type: copy the values.
+    this->DeepCopy(other);
+    return;
+  }
+  if (o != this)
+  {
+    this->ReleaseValues();
+    this->Size = o->Size;
+    this->MaxId = o->MaxId;
+    this->SetName(o->Name);
+    this->SetNumberOfComponents(o->NumberOfComponents);
+    this->CopyComponentNames(o);
+    this->Backend = o->Backend;
+    if (o->Buffer)
+    {
+      this->Buffer = o->Buffer;
+      this->Buffer->Register(nullptr);
+      this->Values = o->Values;
+    }
+    this->DataChanged();
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <class BackendT>
+void vtkImplicitArray<BackendT>::DeepCopy(vtkDataArray* other)
+{
+  SelfType* o = SelfType::SafeDownCast(other);
+  if (!o || o->Values)
+  {
+    // Explicit values: copy them into a materialized array.
+    if (other != this)
+    {
+      this->ReleaseValues();
+      this->Backend.reset();
+      this->MaxId = -1;
+      this->Size = 0;
+      this->MaterializeValues();
+      this->Superclass::DeepCopy(other);
+    }
+    return;
+  }
+  // Backends are immutable, so sharing them is a deep copy.
+  this->ShallowCopy(other);
+  if (o != this && o->HasInformation())
+  {
+    this->CopyInformation(o->GetInformation(), /*deep=*/1);
+  }
+}
+
+#endif // header guard
@@ -0,0 +1,155 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkIndexedArray.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkIndexedArray
+ * @brief   implicit array viewing selected tuples of another array
+ *
+ * vtkIndexedArray<T> is a vtkImplicitArray whose tuple i is the tuple ids[i]
+ * of a source array, as produced by an extraction. The ids are referenced,
+ * not copied, and must not be modified while the indexed array is in use.
+ *
+ * Sources of type vtkAOSDataArrayTemplate<T> and vtkSOADataArrayTemplate<T>
+ * are not referenced either: the view reads a shallow copy taken when it is
+ * created, which shares the memory of the source. The source stops sharing
+ * its memory when it is resized or written through the copy-on-write API
+ * (vtkFieldData::GetArrayForWrite(), vtkDataArray::DetachStorage(), the
+ * writable ranges), and the view keeps the values it was created with.
+ *
+ * Views do not protect against in-place writes: values written into the
+ * source with SetValue(), SetTuple(), GetPointer() and the like, which do
+ * not detach shared memory, are seen by the view as by any shallow copy,
+ * and MaterializeOnModified() then stores these modified values. Write
+ * the source through the copy-on-write API to keep the values of its views.
+ *
+ * Call MaterializeOnModified(source) to copy the viewed values, and release
+ * the memory of the snapshot, when the source is modified. Other sources are
+ * referenced and read through the vtkDataArray API. Writing into the view
+ * also copies its values.
+ *
+ * The number of components must be the one of the source array and the
+ * number of tuples the number of ids.
+ *
+ * @code
+ * vtkNew<vtkIndexedArray<double>> view;
+ * view->ConstructBackend(ids, source);
+ * view->SetNumberOfComponents(source->GetNumberOfComponents());
+ * view->SetNumberOfTuples(ids->GetNumberOfIds());
+ * @endcode
+ *
+ * @sa
+ * vtkImplicitArray
+*/
+
+#ifndef vtkIndexedArray_h
+#define vtkIndexedArray_h
+
+#include "vtkAOSDataArrayTemplate.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImplicitArray.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+
+template <typename ValueTypeT>
+class vtkIndexedImplicitBackend
+{
+public:
+  typedef ValueTypeT ValueType;
+
+  vtkIndexedImplicitBackend(vtkIdList* ids, vtkDataArray* array)
+    : IdList(ids)
+    , Ids(ids->GetPointer(0))
+    , NumberOfIds(ids->GetNumberOfIds())
+  {
+    this->SetArray(array);
+  }
+
+  vtkIndexedImplicitBackend(vtkIdTypeArray* ids, vtkDataArray* array)
+    : IdArray(ids)
+    , Ids(ids->GetPointer(0))
+    , NumberOfIds(ids->GetNumberOfValues())
+  {
+    this->SetArray(array);
+  }
+
+  ValueType operator()(vtkIdType valueIdx) const
+  {
+    if (this->NumberOfComponents == 1)
+    {
+      return this->GetSourceComponent(this->Ids[valueIdx], 0);
+    }
+    vtkIdType tupleIdx = valueIdx / this->NumberOfComponents;
+    int comp = static_cast<int>(valueIdx - tupleIdx * this->NumberOfComponents);
+    return this->GetSourceComponent(this->Ids[tupleIdx], comp);
+  }
+
+  unsigned long GetActualMemorySize() const
+  {
+    return static_cast<unsigned long>(this->NumberOfIds * sizeof(vtkIdType) / 1024 + 1);
+  }
+
+private:
+  ValueType GetSourceComponent(vtkIdType tupleIdx, int comp) const
+  {
+    if (this->Aos)
+    {
+      return this->Aos->GetTypedComponent(tupleIdx, comp);
+    }
+    if (this->Soa)
+    {
+      return this->Soa->GetTypedComponent(tupleIdx, comp);
+    }
+    return static_cast<ValueType>(this->Array->GetComponent(tupleIdx, comp));
+  }
+
+  void SetArray(vtkDataArray* array)
+  {
+    this->Aos = nullptr;
+    this->Soa = nullptr;
+    if (auto aos = vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType> >(array))
+    {
+      this->Aos = vtkAOSDataArrayTemplate<ValueType>::New();
+      this->Aos->ShallowCopy(aos);
+      this->Array.TakeReference(this->Aos);
+    }
+    else if (auto soa = vtkArrayDownCast<vtkSOADataArrayTemplate<ValueType> >(array))
+    {
+      this->Soa = vtkSOADataArrayTemplate<ValueType>::New();
+      this->Soa->ShallowCopy(soa);
+      this->Array.TakeReference(this->Soa);
+    }
+    else
+    {
+      this->Array = array;
+    }
+    this->NumberOfComponents = array->GetNumberOfComponents();
+  }
+
+  vtkSmartPointer<vtkIdList> IdList;
+  vtkSmartPointer<vtkIdTypeArray> IdArray;
+  const vtkIdType* Ids;
+  vtkIdType NumberOfIds;
+  // The source, or the shallow copy of the source the view reads.
+  vtkSmartPointer<vtkDataArray> Array;
+  vtkAOSDataArrayTemplate<ValueType>* Aos;
+  vtkSOADataArrayTemplate<ValueType>* Soa;
+  vtkIdType NumberOfComponents;
+};
+
+template <typename ValueTypeT>
+using vtkIndexedArray = vtkImplicitArray<vtkIndexedImplicitBackend<ValueTypeT> >;
+
+#endif
+// VTK-HeaderTest-Exclude: vtkIndexedArray.h
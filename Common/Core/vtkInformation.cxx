@@ -25,7 +25,6 @@
 #include "vtkInformationIntegerKey.h"
 #include "vtkInformationIntegerPointerKey.h"
 #include "vtkInformationIntegerVectorKey.h"
-#include "vtkInformationIterator.h"
 #include "vtkInformationKeyVectorKey.h"
 #include "vtkInformationObjectBaseKey.h"
 #include "vtkInformationObjectBaseVectorKey.h"
@@ -112,20 +111,10 @@ void vtkInformation::Modified(vtkInformationKey* key)
 }
 
 //----------------------------------------------------------------------------
-// Return the number of keys as a result of iteration.
+// Return the number of keys.
 int vtkInformation::GetNumberOfKeys()
 {
-  vtkSmartPointer<vtkInformationIterator> infoIterator =
-    vtkSmartPointer<vtkInformationIterator>::New();
-  infoIterator->SetInformation( this );
-
-  int numberOfKeys = 0;
-  for (infoIterator->InitTraversal(); !infoIterator->IsDoneWithTraversal();
-    infoIterator->GoToNextItem())
-  {
-    numberOfKeys++;
-  }
-  return numberOfKeys;
+  return static_cast<int>(this->Internal->Map.size());
 }
 
 //----------------------------------------------------------------------------
@@ -206,6 +195,7 @@ void vtkInformation::Copy(vtkInformation* from, int deep)
   if(from)
   {
     typedef vtkInformationInternals::MapType MapType;
+    this->Internal->Map.reserve(from->Internal->Map.size());
     for(MapType::const_iterator i = from->Internal->Map.begin();
         i != from->Internal->Map.end(); ++i)
     {
@@ -221,6 +211,7 @@ void vtkInformation::Append(vtkInformation* from, int deep)
   if(from)
   {
     typedef vtkInformationInternals::MapType MapType;
+    this->Internal->Map.reserve(this->Internal->Map.size() + from->Internal->Map.size());
     for(MapType::const_iterator i = from->Internal->Map.begin();
         i != from->Internal->Map.end(); ++i)
     {
@@ -433,6 +424,7 @@ void vtkInformation::CopyEntries(vtkInformation* from,
 {
   int numberOfKeys = from->Length(key);
   vtkInformationKey** keys = from->Get(key);
+  this->Internal->Map.reserve(this->Internal->Map.size() + numberOfKeys);
   for(int i=0; i < numberOfKeys; ++i)
   {
     this->CopyEntry(from, keys[i], deep);
@@ -27,12 +27,8 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectBase.h"
 
-#define VTK_INFORMATION_USE_HASH_MAP
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-# include <unordered_map>
-#else
-# include <map>
-#endif
+#include <utility>
+#include <vector>
 
 //----------------------------------------------------------------------------
 class vtkInformationInternals
@@ -40,23 +36,82 @@ class vtkInformationInternals
 public:
   typedef vtkInformationKey* KeyType;
   typedef vtkObjectBase* DataType;
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  struct HashFun
+
+  // Information objects hold few entries (rarely more than a couple dozen)
+  // but are created, queried and copied for every pipeline request, per
+  // block for composite data. A flat vector searched linearly is faster at
+  // these sizes than a hash map and needs a single allocation instead of a
+  // bucket array plus one node per entry. Keys are singletons, so they are
+  // compared by address.
+  class MapType
   {
-    size_t operator()(KeyType key) const
+  public:
+    typedef std::pair<KeyType, DataType> value_type;
+    typedef std::vector<value_type>::iterator iterator;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    iterator begin() { return this->Entries.begin(); }
+    iterator end() { return this->Entries.end(); }
+    const_iterator begin() const { return this->Entries.begin(); }
+    const_iterator end() const { return this->Entries.end(); }
+    size_t size() const { return this->Entries.size(); }
+    bool empty() const { return this->Entries.empty(); }
+
+    iterator find(KeyType key)
+    {
+      iterator i = this->Entries.begin();
+      for (; i != this->Entries.end() && i->first != key; ++i)
+      {
+      }
+      return i;
+    }
+
+    const_iterator find(KeyType key) const
+    {
+      const_iterator i = this->Entries.begin();
+      for (; i != this->Entries.end() && i->first != key; ++i)
+      {
+      }
+      return i;
+    }
+
+    void reserve(size_t n)
     {
-      return static_cast<size_t>(key - KeyType(nullptr));
+      this->Entries.reserve(n);
     }
+
+    // The key must not already be in the map.
+    void insert(const value_type& entry)
+    {
+      if (this->Entries.capacity() == 0)
+      {
+        this->Entries.reserve(8);
+      }
+      this->Entries.push_back(entry);
+    }
+
+    // Order is not preserved: the last entry is moved into the erased slot,
+    // which is then returned. As with std::vector, insert() invalidates all
+    // iterators and erase() those at or after the erased slot, and an entry
+    // moved back by erase() is skipped by a forward traversal that did not
+    // use the returned iterator. vtkInformationIterator, which lets keys be
+    // set and removed during the traversal, therefore walks a copy of the
+    // keys.
+    iterator erase(iterator i)
+    {
+      const std::vector<value_type>::difference_type pos = i - this->Entries.begin();
+      *i = this->Entries.back();
+      this->Entries.pop_back();
+      return this->Entries.begin() + pos;
+    }
+
+  private:
+    std::vector<value_type> Entries;
   };
-  typedef std::unordered_map<KeyType, DataType, HashFun> MapType;
-#else
-  typedef std::map<KeyType, DataType> MapType;
-#endif
+
   MapType Map;
 
-#ifdef VTK_INFORMATION_USE_HASH_MAP
-  vtkInformationInternals(): Map(33) {}
-#endif
+  vtkInformationInternals() = default;
 
   ~vtkInformationInternals()
   {
@@ -73,7 +128,5 @@ private:
   vtkInformationInternals(vtkInformationInternals const &) = delete;
 };
 
-#undef VTK_INFORMATION_USE_HASH_MAP
-
 #endif
 // VTK-HeaderTest-Exclude: vtkInformationInternals.h
@@ -19,12 +19,18 @@
 #include "vtkInformationKey.h"
 #include "vtkObjectFactory.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkInformationIterator);
 
+// The keys present when the traversal starts are copied, and visited in
+// that order. Keys removed since are skipped, and keys added are not in the
+// copy, so setting or removing keys does not invalidate the position.
 class vtkInformationIteratorInternals
 {
 public:
-  vtkInformationInternals::MapType::iterator Iterator;
+  std::vector<vtkInformationKey*> Keys;
+  size_t Index = 0;
 };
 
 //----------------------------------------------------------------------------
@@ -86,7 +92,13 @@ void vtkInformationIterator::GoToFirstItem()
     vtkErrorMacro("No information has been set.");
     return;
   }
-  this->Internal->Iterator = this->Information->Internal->Map.begin();
+  this->Internal->Keys.clear();
+  vtkInformationInternals::MapType& map = this->Information->Internal->Map;
+  for (vtkInformationInternals::MapType::iterator i = map.begin(); i != map.end(); ++i)
+  {
+    this->Internal->Keys.push_back(i->first);
+  }
+  this->Internal->Index = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -98,7 +110,12 @@ void vtkInformationIterator::GoToNextItem()
     return;
   }
 
-  ++this->Internal->Iterator;
+  // Removed keys are skipped by IsDoneWithTraversal() only: the current key
+  // may have been removed, and skipping it here would also skip the next.
+  if (this->Internal->Index < this->Internal->Keys.size())
+  {
+    ++this->Internal->Index;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -110,11 +127,15 @@ int vtkInformationIterator::IsDoneWithTraversal()
     return 1;
   }
 
-  if(this->Internal->Iterator == this->Information->Internal->Map.end())
+  // Skip the keys removed during the traversal.
+  vtkInformationInternals::MapType& map = this->Information->Internal->Map;
+  std::vector<vtkInformationKey*>& keys = this->Internal->Keys;
+  size_t& index = this->Internal->Index;
+  while (index < keys.size() && map.find(keys[index]) == map.end())
   {
-    return 1;
+    ++index;
   }
-  return 0;
+  return index < keys.size() ? 0 : 1;
 }
 
 //----------------------------------------------------------------------------
@@ -125,7 +146,7 @@ vtkInformationKey* vtkInformationIterator::GetCurrentKey()
     return nullptr;
   }
 
-  return this->Internal->Iterator->first;
+  return this->Internal->Keys[this->Internal->Index];
 }
 
 //----------------------------------------------------------------------------
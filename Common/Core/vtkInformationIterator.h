@@ -18,7 +18,10 @@
  *
  * vtkInformationIterator can be used to iterate over the keys of an
  * information object. The corresponding values can then be directly
- * obtained from the information object using the keys.
+ * obtained from the information object using the keys. Keys may be set or
+ * removed during the traversal: keys added then are not visited, keys
+ * removed before their turn are skipped, and the other keys present from
+ * the start are each visited once.
  *
  * @sa
  * vtkInformation vtkInformationKey
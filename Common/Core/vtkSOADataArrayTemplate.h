@@ -209,6 +209,8 @@ public:
   VTK_NEWINSTANCE vtkArrayIterator *NewIterator() override;
   void SetNumberOfComponents(int numComps) override;
   void ShallowCopy(vtkDataArray *other) override;
+  bool HasSharedStorage() override;
+  void DetachStorage() override;
 
   // Reimplemented for efficiency:
   void InsertTuples(vtkIdType dstStart, vtkIdType n, vtkIdType srcStart,
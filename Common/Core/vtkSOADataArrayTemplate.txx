@@ -115,6 +115,43 @@ void vtkSOADataArrayTemplate<ValueType>::ShallowCopy(vtkDataArray *other)
   }
 }
 
+//-----------------------------------------------------------------------------
+template<class ValueType>
+bool vtkSOADataArrayTemplate<ValueType>::HasSharedStorage()
+{
+  for (size_t cc = 0; cc < this->Data.size(); ++cc)
+  {
+    if (this->Data[cc]->IsShared())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+template<class ValueType>
+void vtkSOADataArrayTemplate<ValueType>::DetachStorage()
+{
+  const vtkIdType numTuples = this->GetNumberOfTuples();
+  for (size_t cc = 0; cc < this->Data.size(); ++cc)
+  {
+    vtkBuffer<ValueType>* buffer = this->Data[cc];
+    if (!buffer->IsShared())
+    {
+      continue;
+    }
+    vtkBuffer<ValueType>* copy = buffer->NewCopy(buffer->GetSize(), numTuples);
+    if (!copy)
+    {
+      vtkErrorMacro("Failed to allocate memory to detach shared storage.");
+      return;
+    }
+    buffer->Delete();
+    this->Data[cc] = copy;
+  }
+}
+
 //-----------------------------------------------------------------------------
 template<class ValueType>
 void vtkSOADataArrayTemplate<ValueType>::InsertTuples(
@@ -202,6 +239,12 @@ void vtkSOADataArrayTemplate<ValueType>::SetArray(int comp, ValueType* array,
     return;
   }
 
+  // Leave shared memory to the arrays still using it.
+  if (this->Data[comp]->IsShared())
+  {
+    this->Data[comp]->Delete();
+    this->Data[comp] = vtkBuffer<ValueType>::New();
+  }
   this->Data[comp]->SetBuffer(array, size);
 
   if(deleteMethod == VTK_DATA_ARRAY_DELETE)
@@ -276,6 +319,12 @@ bool vtkSOADataArrayTemplate<ValueType>::AllocateTuples(vtkIdType numTuples)
 {
   for (size_t cc = 0, max = this->Data.size(); cc < max; ++cc)
   {
+    // Leave shared memory to the arrays still using it.
+    if (this->Data[cc]->IsShared())
+    {
+      this->Data[cc]->Delete();
+      this->Data[cc] = vtkBuffer<ValueType>::New();
+    }
     if (!this->Data[cc]->Allocate(numTuples))
     {
       return false;
@@ -288,8 +337,22 @@ bool vtkSOADataArrayTemplate<ValueType>::AllocateTuples(vtkIdType numTuples)
 template<class ValueType>
 bool vtkSOADataArrayTemplate<ValueType>::ReallocateTuples(vtkIdType numTuples)
 {
+  const vtkIdType numKept = this->GetNumberOfTuples();
   for (size_t cc = 0, max = this->Data.size(); cc < max; ++cc)
   {
+    // Shared memory is not resized under the arrays still using it: the
+    // values kept are copied into memory of the new size instead.
+    if (this->Data[cc]->IsShared())
+    {
+      vtkBuffer<ValueType>* buffer = this->Data[cc]->NewCopy(numTuples, numKept);
+      if (!buffer)
+      {
+        return false;
+      }
+      this->Data[cc]->Delete();
+      this->Data[cc] = buffer;
+      continue;
+    }
     if (!this->Data[cc]->Reallocate(numTuples))
     {
       return false;
@@ -0,0 +1,354 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks the queries of vtkBVHCellLocator against brute force on a graded
+// structured grid, the batched queries against the single ones, and Refit()
+// after the grid is deformed. A grid large enough for the tree to be built
+// in parallel subtrees and the tolerance of FindCell() are also checked.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int DIM = 12;
+const int NUMBER_OF_QUERIES = 200;
+
+// Cell sizes vary by two orders of magnitude along each axis.
+double Coordinate(int i)
+{
+  return (std::pow(1.5, i) - 1.0) / (std::pow(1.5, DIM - 1) - 1.0);
+}
+
+void SetGridPoints(vtkStructuredGrid* grid, double shear)
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < DIM; ++k)
+  {
+    for (int j = 0; j < DIM; ++j)
+    {
+      for (int i = 0; i < DIM; ++i)
+      {
+        double x = Coordinate(i), y = Coordinate(j), z = Coordinate(k);
+        points->InsertNextPoint(x + shear * z, y, z + shear * x * y);
+      }
+    }
+  }
+  grid->SetPoints(points);
+}
+
+void RandomPoint(vtkMinimalStandardRandomSequence* random, double lo, double hi, double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = random->GetRangeValue(lo, hi);
+    random->Next();
+  }
+}
+
+int CheckQueries(vtkStructuredGrid* grid, vtkBVHCellLocator* locator, const char* label)
+{
+  int errors = 0;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1234);
+  vtkNew<vtkGenericCell> cell;
+  double weights[VTK_CELL_SIZE], pcoords[3], dist2;
+  int subId;
+
+  vtkNew<vtkPoints> queries, lineEnds;
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3], y[3];
+    RandomPoint(random, -0.2, 1.4, x);
+    RandomPoint(random, -0.2, 1.4, y);
+    queries->InsertNextPoint(x);
+    lineEnds->InsertNextPoint(y);
+
+    // FindCell: the cell found must contain the point, and no cell may
+    // contain it if none is found.
+    vtkIdType found = locator->FindCell(x, 0.0, cell, pcoords, weights);
+    vtkIdType expected = -1;
+    for (vtkIdType c = 0; c < grid->GetNumberOfCells() && expected < 0; ++c)
+    {
+      grid->GetCell(c, cell);
+      if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+      {
+        expected = c;
+      }
+    }
+    if ((found < 0) != (expected < 0))
+    {
+      std::cerr << label << ": FindCell returned " << found << ", expected " << expected << "\n";
+      ++errors;
+    }
+
+    // FindClosestPoint: same distance as brute force.
+    double closest[3], bestDist2 = VTK_DOUBLE_MAX, point[3];
+    vtkIdType cellId;
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    for (vtkIdType c = 0; c < grid->GetNumberOfCells(); ++c)
+    {
+      double d2;
+      grid->GetCell(c, cell);
+      if (cell->EvaluatePosition(x, point, subId, pcoords, d2, weights) != -1)
+      {
+        bestDist2 = std::min(bestDist2, d2);
+      }
+    }
+    if (cellId < 0 || std::abs(dist2 - bestDist2) > 1e-12)
+    {
+      std::cerr << label << ": FindClosestPoint distance " << dist2 << ", expected "
+                << bestDist2 << "\n";
+      ++errors;
+    }
+
+    // IntersectWithLine: same closest intersection as brute force.
+    double t, xHit[3], bestT = VTK_DOUBLE_MAX;
+    int hit = locator->IntersectWithLine(x, y, 0.0, t, xHit, pcoords, subId, cellId, cell);
+    for (vtkIdType c = 0; c < grid->GetNumberOfCells(); ++c)
+    {
+      double tc;
+      grid->GetCell(c, cell);
+      if (cell->IntersectWithLine(x, y, 0.0, tc, point, pcoords, subId))
+      {
+        bestT = std::min(bestT, tc);
+      }
+    }
+    if ((hit != 0) != (bestT <= 1.0) || (hit && std::abs(t - bestT) > 1e-12))
+    {
+      std::cerr << label << ": IntersectWithLine t " << (hit ? t : -1.0) << ", expected "
+                << bestT << "\n";
+      ++errors;
+    }
+  }
+
+  // Batched queries match the single queries.
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkDoubleArray> values;
+  vtkNew<vtkPoints> positions;
+  locator->BatchFindCell(queries, ids);
+  for (vtkIdType q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    if (ids->GetValue(q) != locator->FindCell(queries->GetPoint(q), 0.0, cell, pcoords, weights))
+    {
+      std::cerr << label << ": BatchFindCell differs for query " << q << "\n";
+      ++errors;
+    }
+  }
+
+  locator->BatchFindClosestPoint(queries, ids, positions, values);
+  for (vtkIdType q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double closest[3];
+    vtkIdType cellId;
+    locator->FindClosestPoint(queries->GetPoint(q), closest, cell, cellId, subId, dist2);
+    if (ids->GetValue(q) != cellId || values->GetValue(q) != dist2 ||
+      vtkMath::Distance2BetweenPoints(positions->GetPoint(q), closest) != 0.0)
+    {
+      std::cerr << label << ": BatchFindClosestPoint differs for query " << q << "\n";
+      ++errors;
+    }
+  }
+
+  locator->BatchIntersectWithLine(queries, lineEnds, 0.0, ids, values, positions);
+  for (vtkIdType q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double t, xHit[3], p1[3], p2[3];
+    vtkIdType cellId;
+    queries->GetPoint(q, p1);
+    lineEnds->GetPoint(q, p2);
+    int hit = locator->IntersectWithLine(p1, p2, 0.0, t, xHit, pcoords, subId, cellId, cell);
+    if (!hit)
+    {
+      // Misses do not keep the values of the previous query.
+      t = VTK_DOUBLE_MAX;
+      xHit[0] = xHit[1] = xHit[2] = 0.0;
+    }
+    if (ids->GetValue(q) != (hit ? cellId : -1) || values->GetValue(q) != t ||
+      vtkMath::Distance2BetweenPoints(positions->GetPoint(q), xHit) != 0.0)
+    {
+      std::cerr << label << ": BatchIntersectWithLine differs for query " << q << "\n";
+      ++errors;
+    }
+  }
+
+  return errors;
+}
+
+// More cells than a subtree built serially, so that the top of the tree is
+// split in parallel and the subtrees are stitched together. Every cell must
+// be found from its center.
+int CheckLargeGrid()
+{
+  int errors = 0;
+  const int n = 40;
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(n + 1, n + 1, n + 1);
+  image->SetSpacing(1.0 / n, 1.0 / n, 1.0 / n);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(image);
+  locator->BuildLocator();
+
+  vtkNew<vtkPoints> centers;
+  vtkIdType numCells = image->GetNumberOfCells();
+  centers->SetNumberOfPoints(numCells);
+  for (vtkIdType c = 0; c < numCells; ++c)
+  {
+    int ijk[3] = { static_cast<int>(c % n), static_cast<int>((c / n) % n),
+      static_cast<int>(c / (n * n)) };
+    centers->SetPoint(c, (ijk[0] + 0.5) / n, (ijk[1] + 0.5) / n, (ijk[2] + 0.5) / n);
+  }
+  vtkNew<vtkIdTypeArray> ids;
+  locator->BatchFindCell(centers, ids);
+  vtkIdType wrong = 0;
+  for (vtkIdType c = 0; c < numCells; ++c)
+  {
+    wrong += ids->GetValue(c) != c ? 1 : 0;
+  }
+  if (wrong != 0)
+  {
+    std::cerr << "Large grid: " << wrong << " of " << numCells << " cells not found\n";
+    ++errors;
+  }
+
+  // The box covers 8x8 columns of cells, and touches 10x10 of them.
+  double bbox[6] = { 0.2, 0.4, 0.3, 0.5, 0.0, 1.0 };
+  vtkNew<vtkIdList> cells;
+  locator->FindCellsWithinBounds(bbox, cells);
+  if (cells->GetNumberOfIds() < 8 * 8 * n || cells->GetNumberOfIds() > 10 * 10 * n)
+  {
+    std::cerr << "Large grid: " << cells->GetNumberOfIds() << " cells within bounds\n";
+    ++errors;
+  }
+  return errors;
+}
+
+// A point above a triangle is in the triangle only within the tolerance.
+int CheckTolerance()
+{
+  int errors = 0;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  vtkNew<vtkCellArray> triangles;
+  vtkIdType triangle[3] = { 0, 1, 2 };
+  triangles->InsertNextCell(3, triangle);
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points);
+  pd->SetPolys(triangles);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(pd);
+  locator->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3] = { 0.2, 0.2, 1e-3 }, pcoords[3], weights[VTK_CELL_SIZE];
+  if (locator->FindCell(x, 0.0, cell, pcoords, weights) != -1 ||
+    locator->FindCell(x, 1e-5, cell, pcoords, weights) != 0)
+  {
+    std::cerr << "FindCell does not honor the tolerance\n";
+    ++errors;
+  }
+  vtkNew<vtkPoints> queries;
+  queries->InsertNextPoint(x);
+  vtkNew<vtkIdTypeArray> ids;
+  locator->BatchFindCell(queries, ids);
+  vtkIdType strict = ids->GetValue(0);
+  locator->BatchFindCell(queries, ids, 1e-5);
+  if (strict != -1 || ids->GetValue(0) != 0)
+  {
+    std::cerr << "BatchFindCell does not honor the tolerance\n";
+    ++errors;
+  }
+  return errors;
+}
+
+} // end anon namespace
+
+int TestBVHCellLocator(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<vtkStructuredGrid> grid;
+  grid->SetDimensions(DIM, DIM, DIM);
+  SetGridPoints(grid, 0.0);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->SetNumberOfCellsPerNode(4);
+  locator->BuildLocator();
+  if (locator->GetNumberOfNodes() < 2 * (grid->GetNumberOfCells() / 4) - 1)
+  {
+    std::cerr << "Unexpected number of nodes: " << locator->GetNumberOfNodes() << "\n";
+    ++errors;
+  }
+  errors += CheckQueries(grid, locator, "Build");
+
+  // All intersections along a line through the grid, sorted by t.
+  double p1[3] = { -0.1, 0.5, 0.5 }, p2[3] = { 1.1, 0.5, 0.5 };
+  vtkNew<vtkPoints> hits;
+  vtkNew<vtkIdList> hitCells;
+  locator->IntersectWithLine(p1, p2, hits, hitCells);
+  if (hits->GetNumberOfPoints() == 0 || hits->GetNumberOfPoints() != hitCells->GetNumberOfIds())
+  {
+    std::cerr << "IntersectWithLine found no intersections.\n";
+    ++errors;
+  }
+  for (vtkIdType i = 1; i < hits->GetNumberOfPoints(); ++i)
+  {
+    if (hits->GetPoint(i)[0] < hits->GetPoint(i - 1)[0])
+    {
+      std::cerr << "IntersectWithLine intersections are not sorted.\n";
+      ++errors;
+      break;
+    }
+  }
+
+  // Deform the grid and refit the tree.
+  SetGridPoints(grid, 0.3);
+  locator->Refit();
+  errors += CheckQueries(grid, locator, "Refit");
+
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(3, representation);
+  vtkIdType numFaces = representation->GetNumberOfCells();
+  if (numFaces == 0 || numFaces % 6 != 0 || numFaces > 6 * 8)
+  {
+    std::cerr << "Unexpected representation: " << numFaces << " faces.\n";
+    ++errors;
+  }
+
+  errors += CheckLargeGrid();
+  errors += CheckTolerance();
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,213 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLinks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Builds vtkCellLinks on polydata, unstructured grids and image data,
+// compares them with vtkStaticCellLinks, and edits the links of a polydata
+// after BuildLinks().
+
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLinks.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+const int RES = 15;
+
+// Both structures must hold the same lists; those of vtkCellLinks are sorted
+// by cell id.
+int CompareLinks(vtkDataSet* ds, vtkCellLinks* links, const char* name)
+{
+  vtkNew<vtkStaticCellLinks> reference;
+  reference->BuildLinks(ds);
+  int errors = 0;
+  for (vtkIdType ptId = 0; ptId < ds->GetNumberOfPoints(); ++ptId)
+  {
+    vtkIdType ncells = links->GetNcells(ptId);
+    const vtkIdType* cells = links->GetCells(ptId);
+    std::vector<vtkIdType> expected(
+      reference->GetCells(ptId), reference->GetCells(ptId) + reference->GetNumberOfCells(ptId));
+    std::sort(expected.begin(), expected.end());
+    if (ncells != reference->GetNumberOfCells(ptId))
+    {
+      ++errors;
+      continue;
+    }
+    for (vtkIdType i = 0; i < ncells; ++i)
+    {
+      if (cells[i] != expected[i] || (i > 0 && cells[i] <= cells[i - 1]))
+      {
+        ++errors;
+      }
+    }
+  }
+  if (errors)
+  {
+    std::cerr << name << ": " << errors << " wrong links\n";
+  }
+  return errors;
+}
+
+void MakePoints(vtkPoints* points)
+{
+  for (int k = 0; k <= RES; ++k)
+  {
+    for (int j = 0; j <= RES; ++j)
+    {
+      for (int i = 0; i <= RES; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+}
+
+int TestPolyData()
+{
+  const int np = RES + 1;
+  vtkNew<vtkPoints> points;
+  MakePoints(points);
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkCellArray> lines;
+  for (int j = 0; j < RES; ++j)
+  {
+    for (int i = 0; i < RES; ++i)
+    {
+      vtkIdType p0 = i + np * j;
+      vtkIdType tri0[3] = { p0, p0 + 1, p0 + np + 1 };
+      vtkIdType tri1[3] = { p0, p0 + np + 1, p0 + np };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+      vtkIdType line[2] = { p0, p0 + np * np };
+      lines->InsertNextCell(2, line);
+    }
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+  polyData->SetLines(lines);
+  polyData->BuildLinks();
+  int errors = CompareLinks(polyData, polyData->GetCellLinks(), "vtkPolyData");
+
+  // Editing after BuildLinks(): replace a triangle and add a new one.
+  vtkIdType ptId = np + 1;
+  vtkIdType numUses = polyData->GetCellLinks()->GetNcells(ptId);
+  vtkIdType cellId = polyData->GetCellLinks()->GetCells(ptId)[numUses - 1];
+  vtkIdType npts, *pts;
+  polyData->GetCellPoints(cellId, npts, pts);
+  vtkIdType oldPts[3] = { pts[0], pts[1], pts[2] };
+  polyData->RemoveCellReference(cellId);
+  vtkIdType newPts[3] = { 0, 1, 2 };
+  for (int i = 0; i < 3; ++i)
+  {
+    polyData->ResizeCellList(newPts[i], 1);
+  }
+  polyData->ReplaceLinkedCell(cellId, 3, newPts);
+  vtkIdType newCellId = polyData->InsertNextLinkedCell(VTK_TRIANGLE, 3, oldPts);
+  errors += CompareLinks(polyData, polyData->GetCellLinks(), "Edited vtkPolyData");
+  if (polyData->GetCellLinks()->GetNcells(ptId) != numUses ||
+    newCellId != polyData->GetNumberOfCells() - 1)
+  {
+    std::cerr << "Edited vtkPolyData: unexpected number of uses\n";
+    ++errors;
+  }
+
+  // Deep copies do not share the lists.
+  vtkNew<vtkCellLinks> copy;
+  copy->DeepCopy(polyData->GetCellLinks());
+  polyData->BuildLinks();
+  errors += CompareLinks(polyData, copy, "Copied links");
+  copy->DeletePoint(0);
+  copy->ResizeCellList(1, 2);
+  copy->InsertNextPoint(4);
+  return errors;
+}
+
+int TestUnstructuredGrid()
+{
+  const int np = RES + 1;
+  vtkNew<vtkPoints> points;
+  MakePoints(points);
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->Allocate(2 * RES * RES * RES);
+  for (int k = 0; k < RES; ++k)
+  {
+    for (int j = 0; j < RES; ++j)
+    {
+      for (int i = 0; i < RES; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        if ((i + j + k) % 3)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_TETRA, 4, hex);
+          grid->InsertNextCell(VTK_VERTEX, 1, hex + 6);
+        }
+      }
+    }
+  }
+  grid->BuildLinks();
+  int errors = CompareLinks(grid, grid->GetCellLinks(), "vtkUnstructuredGrid");
+
+  // Cells given by their connectivity array only
+  vtkNew<vtkCellLinks> links;
+  links->Allocate(grid->GetNumberOfPoints());
+  links->BuildLinks(grid, grid->GetCells());
+  errors += CompareLinks(grid, links, "Connectivity array");
+
+  vtkNew<vtkIdList> cellIds;
+  grid->GetPointCells(np * np + np + 1, cellIds);
+  if (cellIds->GetNumberOfIds() != 8)
+  {
+    std::cerr << "vtkUnstructuredGrid: " << cellIds->GetNumberOfIds()
+              << " cells use an interior point\n";
+    ++errors;
+  }
+  return errors;
+}
+
+int TestImageData()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(RES, RES + 2, RES + 4);
+  vtkNew<vtkCellLinks> links;
+  links->BuildLinks(image);
+  return CompareLinks(image, links, "vtkImageData");
+}
+
+}
+
+int TestCellLinks(int, char*[])
+{
+  int errors = TestPolyData();
+  errors += TestUnstructuredGrid();
+  errors += TestImageData();
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,108 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompositeDataSetSMPTools.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that vtkCompositeDataSetSMPTools gathers leaves in iterator order
+// and puts the per-leaf results back at the matching positions.
+
+#include "vtkCompositeDataSetSMPTools.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+namespace
+{
+
+// Replaces every polydata leaf with a polydata holding as many points as the
+// leaf index; empty positions stay empty.
+struct LeafIndexWorker
+{
+  const std::vector<vtkDataObject*>& Leaves;
+
+  LeafIndexWorker(const std::vector<vtkDataObject*>& leaves)
+    : Leaves(leaves)
+  {
+  }
+
+  vtkSmartPointer<vtkDataObject> operator()(vtkIdType leaf)
+  {
+    if (!vtkPolyData::SafeDownCast(this->Leaves[leaf]))
+    {
+      return nullptr;
+    }
+    vtkNew<vtkPoints> points;
+    points->SetNumberOfPoints(leaf);
+    vtkSmartPointer<vtkPolyData> result = vtkSmartPointer<vtkPolyData>::New();
+    result->SetPoints(points);
+    return result;
+  }
+};
+
+} // end anon namespace
+
+int TestCompositeDataSetSMPTools(int, char*[])
+{
+  // Two levels, with an empty position in the nested block.
+  vtkNew<vtkMultiBlockDataSet> input;
+  vtkNew<vtkMultiBlockDataSet> nested;
+  nested->SetNumberOfBlocks(3);
+  for (unsigned int i = 0; i < 3; i += 2)
+  {
+    vtkNew<vtkPolyData> block;
+    nested->SetBlock(i, block);
+  }
+  vtkNew<vtkPolyData> block0;
+  input->SetBlock(0, block0);
+  input->SetBlock(1, nested);
+
+  std::vector<vtkDataObject*> leaves = vtkCompositeDataSetSMPTools::GetLeaves(input);
+  if (leaves.size() != 4 || leaves[0] != block0 || leaves[1] != nested->GetBlock(0) ||
+    leaves[2] != nullptr || leaves[3] != nested->GetBlock(2))
+  {
+    std::cerr << "Unexpected leaves." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkMultiBlockDataSet> output;
+  output->CopyStructure(input);
+  if (vtkCompositeDataSetSMPTools::GetLeaves(input, output) != leaves)
+  {
+    std::cerr << "Leaves gathered through the output structure differ." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  LeafIndexWorker worker(leaves);
+  vtkCompositeDataSetSMPTools::GenerateLeaves(output, worker);
+
+  std::vector<vtkDataObject*> results = vtkCompositeDataSetSMPTools::GetLeaves(output);
+  if (results.size() != leaves.size() || results[2] != nullptr)
+  {
+    std::cerr << "Unexpected output structure." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType leaf = 0; leaf < static_cast<vtkIdType>(results.size()); ++leaf)
+  {
+    vtkPolyData* pd = vtkPolyData::SafeDownCast(results[leaf]);
+    if (leaf != 2 && (!pd || pd == leaves[leaf] || pd->GetNumberOfPoints() != leaf))
+    {
+      std::cerr << "Unexpected result at leaf " << leaf << "." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
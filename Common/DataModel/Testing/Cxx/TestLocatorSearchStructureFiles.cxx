@@ -0,0 +1,299 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorSearchStructureFiles.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Saves the search structures of vtkStaticPointLocator, vtkStaticCellLocator
+// and vtkKdTree, loads them back and checks that the loaded locators answer
+// queries like the original ones. Files written for other data, or
+// corrupted, must be rejected.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkKdTree.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+
+const int NUMBER_OF_QUERIES = 1000;
+const int RES = 12;
+
+void RandomPoint(vtkMinimalStandardRandomSequence* random, double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = random->GetValue();
+    random->Next();
+  }
+}
+
+// Flip a byte near the end of a file.
+void CorruptFile(const std::string& fileName)
+{
+  std::string content;
+  {
+    std::ifstream in(fileName.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  content[content.size() - 5] ^= 0x5a;
+  std::ofstream out(fileName.c_str(), std::ios::binary);
+  out.write(content.data(), content.size());
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(bool reversed)
+{
+  const int np = RES + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(
+          static_cast<double>(i) / RES, static_cast<double>(j) / RES, static_cast<double>(k) / RES);
+      }
+    }
+  }
+  vtkNew<vtkCellArray> hexes;
+  for (int c = 0; c < RES * RES * RES; ++c)
+  {
+    int id = reversed ? RES * RES * RES - 1 - c : c;
+    int i = id % RES, j = (id / RES) % RES, k = id / (RES * RES);
+    vtkIdType p0 = i + np * (j + np * k);
+    vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+      p0 + 1 + np + np * np, p0 + np + np * np };
+    hexes->InsertNextCell(8, hex);
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->SetCells(VTK_HEXAHEDRON, hexes);
+  return grid;
+}
+
+int TestPointLocatorFile(const std::string& fileName)
+{
+  int errors = 0;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1177);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 20000; ++i)
+  {
+    double x[3];
+    RandomPoint(random, x);
+    points->InsertNextPoint(x);
+  }
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData);
+  if (!locator->WriteSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticPointLocator: could not write " << fileName << "\n";
+    return 1;
+  }
+
+  vtkNew<vtkStaticPointLocator> loaded;
+  loaded->SetDataSet(polyData);
+  if (!loaded->ReadSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticPointLocator: could not read " << fileName << "\n";
+    return 1;
+  }
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3];
+    RandomPoint(random, x);
+    if (loaded->FindClosestPoint(x) != locator->FindClosestPoint(x))
+    {
+      std::cerr << "vtkStaticPointLocator: loaded locator differs for query " << q << "\n";
+      ++errors;
+    }
+  }
+
+  // Other points
+  vtkNew<vtkPoints> otherPoints;
+  otherPoints->DeepCopy(points);
+  otherPoints->SetPoint(10, 0.5, 0.5, 0.5);
+  vtkNew<vtkPolyData> otherPolyData;
+  otherPolyData->SetPoints(otherPoints);
+  vtkNew<vtkStaticPointLocator> other;
+  other->SetDataSet(otherPolyData);
+  if (other->ReadSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticPointLocator: file accepted for other points\n";
+    ++errors;
+  }
+
+  // Corrupted file
+  CorruptFile(fileName);
+  vtkNew<vtkStaticPointLocator> corrupted;
+  corrupted->SetDataSet(polyData);
+  if (corrupted->ReadSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticPointLocator: corrupted file accepted\n";
+    ++errors;
+  }
+  double x[3] = { 0.25, 0.5, 0.75 };
+  if (corrupted->FindClosestPoint(x) != locator->FindClosestPoint(x))
+  {
+    std::cerr << "vtkStaticPointLocator: no rebuild after a failed read\n";
+    ++errors;
+  }
+  return errors;
+}
+
+int TestCellLocatorFile(const std::string& fileName, const std::string& pointFileName)
+{
+  int errors = 0;
+  vtkSmartPointer<vtkUnstructuredGrid> grid = MakeGrid(false);
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(grid);
+  if (!locator->WriteSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticCellLocator: could not write " << fileName << "\n";
+    return 1;
+  }
+
+  vtkNew<vtkStaticCellLocator> loaded;
+  loaded->SetDataSet(grid);
+  if (!loaded->ReadSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticCellLocator: could not read " << fileName << "\n";
+    return 1;
+  }
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2288);
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[8];
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3];
+    RandomPoint(random, x);
+    if (loaded->FindCell(x, 0.0, cell, pcoords, weights) !=
+      locator->FindCell(x, 0.0, cell, pcoords, weights))
+    {
+      std::cerr << "vtkStaticCellLocator: loaded locator differs for query " << q << "\n";
+      ++errors;
+    }
+  }
+
+  // Same points, other cells
+  vtkNew<vtkStaticCellLocator> other;
+  other->SetDataSet(MakeGrid(true));
+  if (other->ReadSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkStaticCellLocator: file accepted for other cells\n";
+    ++errors;
+  }
+
+  // File of another locator
+  vtkNew<vtkStaticCellLocator> wrongType;
+  wrongType->SetDataSet(grid);
+  if (wrongType->ReadSearchStructure(pointFileName.c_str()))
+  {
+    std::cerr << "vtkStaticCellLocator: point locator file accepted\n";
+    ++errors;
+  }
+  return errors;
+}
+
+int TestKdTreeFile(const std::string& fileName)
+{
+  int errors = 0;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3399);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < 5000; ++i)
+  {
+    double x[3];
+    RandomPoint(random, x);
+    points->InsertNextPoint(x);
+  }
+
+  vtkNew<vtkKdTree> tree;
+  tree->BuildLocatorFromPoints(points);
+  if (!tree->WriteSearchStructure(fileName.c_str()))
+  {
+    std::cerr << "vtkKdTree: could not write " << fileName << "\n";
+    return 1;
+  }
+
+  vtkNew<vtkKdTree> loaded;
+  if (!loaded->ReadSearchStructure(fileName.c_str(), points))
+  {
+    std::cerr << "vtkKdTree: could not read " << fileName << "\n";
+    return 1;
+  }
+  if (loaded->GetNumberOfRegions() != tree->GetNumberOfRegions())
+  {
+    std::cerr << "vtkKdTree: loaded tree has " << loaded->GetNumberOfRegions()
+              << " regions instead of " << tree->GetNumberOfRegions() << "\n";
+    ++errors;
+  }
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3], d1, d2;
+    RandomPoint(random, x);
+    if (loaded->FindClosestPoint(x, d1) != tree->FindClosestPoint(x, d2) || d1 != d2)
+    {
+      std::cerr << "vtkKdTree: loaded tree differs for query " << q << "\n";
+      ++errors;
+    }
+    if (loaded->FindPoint(points->GetPoint(q)) != q)
+    {
+      std::cerr << "vtkKdTree: loaded tree does not find point " << q << "\n";
+      ++errors;
+    }
+  }
+
+  points->SetPoint(0, 0.5, 0.5, 0.5);
+  vtkNew<vtkKdTree> other;
+  if (other->ReadSearchStructure(fileName.c_str(), points))
+  {
+    std::cerr << "vtkKdTree: file accepted for other points\n";
+    ++errors;
+  }
+  return errors;
+}
+
+}
+
+int TestLocatorSearchStructureFiles(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string prefix = std::string(tempDir) + "/TestLocatorSearchStructureFiles";
+  delete[] tempDir;
+
+  int errors = TestPointLocatorFile(prefix + "-points.loc");
+  errors += TestCellLocatorFile(prefix + "-cells.loc", prefix + "-points.loc");
+  errors += TestKdTreeFile(prefix + "-kdtree.loc");
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointLocatorBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Checks that the batched queries of vtkAbstractPointLocator, serial by
+// default and parallel for vtkStaticPointLocator, return the same results as
+// the single queries.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+void RandomPoints(vtkPoints* points, vtkIdType n, vtkMinimalStandardRandomSequence* random)
+{
+  points->SetNumberOfPoints(n);
+  for (vtkIdType i = 0; i < n; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      random->Next();
+      x[j] = random->GetValue();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// Compares the CSR result of query i with a single query result. Radius
+// queries are unordered, so they are compared as sorted lists.
+bool SameIds(vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkIdType i, vtkIdList* expected,
+  bool sort)
+{
+  std::vector<vtkIdType> a(ids->GetPointer(offsets->GetValue(i)),
+    ids->GetPointer(0) + offsets->GetValue(i + 1));
+  std::vector<vtkIdType> b(expected->GetPointer(0),
+    expected->GetPointer(0) + expected->GetNumberOfIds());
+  if (sort)
+  {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+  }
+  return a == b;
+}
+
+int TestLocator(vtkAbstractPointLocator* locator, vtkPoints* queries)
+{
+  const char* name = locator->GetClassName();
+  const int N = 5;
+  const double R = 0.1;
+  int errors = 0;
+
+  locator->BuildLocator();
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+
+  vtkNew<vtkIdTypeArray> closest;
+  vtkNew<vtkDoubleArray> closestDist2;
+  locator->BatchFindClosestPoint(queries, closest, closestDist2);
+
+  vtkNew<vtkIdTypeArray> nOffsets;
+  vtkNew<vtkIdTypeArray> nIds;
+  vtkNew<vtkDoubleArray> nDist2;
+  locator->BatchFindClosestNPoints(N, queries, nOffsets, nIds, nDist2);
+
+  vtkNew<vtkIdTypeArray> rOffsets;
+  vtkNew<vtkIdTypeArray> rIds;
+  locator->BatchFindPointsWithinRadius(R, queries, rOffsets, rIds);
+
+  if (closest->GetNumberOfValues() != numQueries ||
+    nOffsets->GetNumberOfValues() != numQueries + 1 ||
+    rOffsets->GetNumberOfValues() != numQueries + 1 ||
+    nIds->GetNumberOfValues() != nOffsets->GetValue(numQueries) ||
+    nDist2->GetNumberOfValues() != nIds->GetNumberOfValues() ||
+    rIds->GetNumberOfValues() != rOffsets->GetValue(numQueries))
+  {
+    std::cerr << name << ": unexpected result sizes." << std::endl;
+    return 1;
+  }
+
+  vtkDataSet* ds = locator->GetDataSet();
+  vtkNew<vtkIdList> expected;
+  for (vtkIdType i = 0; i < numQueries && errors < 10; ++i)
+  {
+    double x[3], y[3];
+    queries->GetPoint(i, x);
+
+    vtkIdType id = locator->FindClosestPoint(x);
+    ds->GetPoint(id, y);
+    if (closest->GetValue(i) != id ||
+      closestDist2->GetValue(i) != vtkMath::Distance2BetweenPoints(x, y))
+    {
+      std::cerr << name << ": closest point mismatch for query " << i << std::endl;
+      ++errors;
+    }
+
+    locator->FindClosestNPoints(N, x, expected);
+    if (!SameIds(nOffsets, nIds, i, expected, false))
+    {
+      std::cerr << name << ": closest N points mismatch for query " << i << std::endl;
+      ++errors;
+    }
+    for (vtkIdType j = nOffsets->GetValue(i); j < nOffsets->GetValue(i + 1); ++j)
+    {
+      ds->GetPoint(nIds->GetValue(j), y);
+      if (nDist2->GetValue(j) != vtkMath::Distance2BetweenPoints(x, y))
+      {
+        std::cerr << name << ": wrong distance for query " << i << std::endl;
+        ++errors;
+        break;
+      }
+    }
+
+    locator->FindPointsWithinRadius(R, x, expected);
+    if (!SameIds(rOffsets, rIds, i, expected, true))
+    {
+      std::cerr << name << ": points within radius mismatch for query " << i << std::endl;
+      ++errors;
+    }
+  }
+
+  return errors;
+}
+
+} // end anon namespace
+
+int TestPointLocatorBatchQueries(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1177);
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, 10000, random);
+  vtkNew<vtkPolyData> polydata;
+  polydata->SetPoints(points);
+
+  vtkNew<vtkPoints> queries;
+  RandomPoints(queries, 1000, random);
+
+  vtkNew<vtkStaticPointLocator> staticLocator;
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  vtkNew<vtkOctreePointLocator> octreeLocator;
+  vtkNew<vtkPointLocator> pointLocator;
+  vtkAbstractPointLocator* locators[] = { staticLocator, kdTreeLocator, octreeLocator,
+    pointLocator };
+
+  int errors = 0;
+  for (vtkAbstractPointLocator* locator : locators)
+  {
+    locator->SetDataSet(polydata);
+    errors += TestLocator(locator, queries);
+  }
+
+  // An empty batch gives valid empty results.
+  vtkNew<vtkPoints> none;
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  staticLocator->BatchFindPointsWithinRadius(0.1, none, offsets, ids);
+  if (offsets->GetNumberOfValues() != 1 || offsets->GetValue(0) != 0 ||
+    ids->GetNumberOfValues() != 0)
+  {
+    std::cerr << "Unexpected results for an empty batch." << std::endl;
+    ++errors;
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUnstructuredGridCellAccess.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads the cells of a mixed vtkUnstructuredGrid from several threads with
+// the const accessors and compares them with the vtkIdList based API.
+
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+const int RES = 20;
+const int MAX_PTS = 8;
+
+// Hexahedra, tetrahedra and a polyline every other cell.
+void BuildGrid(vtkUnstructuredGrid* grid, int pointType)
+{
+  const int np = RES + 1;
+  vtkNew<vtkPoints> points;
+  points->SetDataType(pointType);
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(i, 2 * j, 3 * k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(3 * RES * RES * RES);
+  for (int k = 0; k < RES; ++k)
+  {
+    for (int j = 0; j < RES; ++j)
+    {
+      for (int i = 0; i < RES; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        if ((i + j + k) % 2)
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_TETRA, 4, hex);
+          grid->InsertNextCell(VTK_POLY_LINE, 3, hex + 4);
+        }
+      }
+    }
+  }
+}
+
+struct CheckCells
+{
+  vtkUnstructuredGrid* Grid;
+  vtkSMPThreadLocal<int> Errors;
+
+  CheckCells(vtkUnstructuredGrid* grid)
+    : Grid(grid)
+  {
+  }
+
+  void Initialize() { this->Errors.Local() = 0; }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    const vtkUnstructuredGrid* grid = this->Grid;
+    int& errors = this->Errors.Local();
+    double x[3 * MAX_PTS];
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdType npts;
+      const vtkIdType* pts;
+      grid->GetCellPoints(cellId, npts, pts);
+      if (grid->GetCellSize(cellId) != npts)
+      {
+        ++errors;
+      }
+      // A buffer too small for hexahedra.
+      vtkIdType maxPts = (cellId % 3 ? MAX_PTS : 4);
+      if (grid->GetCellPointCoordinates(cellId, maxPts, x) != npts)
+      {
+        ++errors;
+      }
+      for (vtkIdType i = 0; i < npts && i < maxPts; ++i)
+      {
+        double p[3];
+        this->Grid->GetPoint(pts[i], p);
+        if (p[0] != x[3 * i] || p[1] != x[3 * i + 1] || p[2] != x[3 * i + 2])
+        {
+          ++errors;
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  int GetErrors()
+  {
+    int errors = 0;
+    for (vtkSMPThreadLocal<int>::iterator iter = this->Errors.begin(); iter != this->Errors.end();
+         ++iter)
+    {
+      errors += *iter;
+    }
+    return errors;
+  }
+};
+
+int TestGrid(int pointType)
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  BuildGrid(grid, pointType);
+
+  // Compare with the vtkIdList API.
+  int errors = 0;
+  const vtkUnstructuredGrid* constGrid = grid;
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    grid->GetCellPoints(cellId, ptIds);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    constGrid->GetCellPoints(cellId, npts, pts);
+    if (npts != ptIds->GetNumberOfIds() ||
+      constGrid->GetCellType(cellId) != grid->GetCellType(cellId))
+    {
+      ++errors;
+      continue;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      errors += (pts[i] != ptIds->GetId(i));
+    }
+  }
+
+  CheckCells check(grid);
+  vtkSMPTools::For(0, grid->GetNumberOfCells(), check);
+  errors += check.GetErrors();
+
+  if (errors)
+  {
+    std::cerr << errors << " errors with points of type " << pointType << "\n";
+  }
+  return errors;
+}
+
+}
+
+int TestUnstructuredGridCellAccess(int, char*[])
+{
+  int errors = TestGrid(VTK_FLOAT);
+  errors += TestGrid(VTK_DOUBLE);
+  errors += TestGrid(VTK_INT);
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestUnstructuredGridSingleCellType.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares a hexahedral vtkUnstructuredGrid using the single cell type
+// storage with the same grid stored explicitly, and checks the transitions
+// between the two storages.
+
+#include "vtkCellArray.h"
+#include "vtkCellIterator.h"
+#include "vtkCellTypes.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+namespace
+{
+
+const int RES = 10;
+
+void MakeHexahedra(vtkPoints* points, vtkCellArray* hexes)
+{
+  const int np = RES + 1;
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  for (int k = 0; k < RES; ++k)
+  {
+    for (int j = 0; j < RES; ++j)
+    {
+      for (int i = 0; i < RES; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        hexes->InsertNextCell(8, hex);
+      }
+    }
+  }
+}
+
+// Both grids must have the same cells, seen through the accessors and the
+// cell iterators.
+int CompareGrids(vtkUnstructuredGrid* single, vtkUnstructuredGrid* grid, const char* name)
+{
+  int errors = 0;
+  if (single->GetNumberOfCells() != grid->GetNumberOfCells())
+  {
+    std::cerr << name << ": " << single->GetNumberOfCells() << " cells instead of "
+              << grid->GetNumberOfCells() << "\n";
+    return 1;
+  }
+  vtkNew<vtkIdList> ptIds;
+  vtkNew<vtkIdList> expectedIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); ++cellId)
+  {
+    single->GetCellPoints(cellId, ptIds);
+    grid->GetCellPoints(cellId, expectedIds);
+    double bounds[6], expectedBounds[6];
+    single->GetCellBounds(cellId, bounds);
+    grid->GetCellBounds(cellId, expectedBounds);
+    if (single->GetCellType(cellId) != grid->GetCellType(cellId) ||
+      single->GetCell(cellId)->GetCellType() != grid->GetCellType(cellId) ||
+      ptIds->GetNumberOfIds() != expectedIds->GetNumberOfIds() || bounds[1] != expectedBounds[1])
+    {
+      ++errors;
+      continue;
+    }
+    for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+    {
+      errors += (ptIds->GetId(i) != expectedIds->GetId(i));
+    }
+  }
+
+  vtkSmartPointer<vtkCellIterator> iter =
+    vtkSmartPointer<vtkCellIterator>::Take(single->NewCellIterator());
+  vtkSmartPointer<vtkCellIterator> expected =
+    vtkSmartPointer<vtkCellIterator>::Take(grid->NewCellIterator());
+  vtkIdType numCells = 0;
+  for (iter->InitTraversal(), expected->InitTraversal(); !iter->IsDoneWithTraversal();
+       iter->GoToNextCell(), expected->GoToNextCell(), ++numCells)
+  {
+    // Only fetch the points of some cells, to skip over the others.
+    if (iter->GetCellId() != expected->GetCellId() ||
+      iter->GetCellType() != expected->GetCellType() ||
+      (numCells % 3 == 0 && iter->GetPointIds()->GetId(7) != expected->GetPointIds()->GetId(7)))
+    {
+      ++errors;
+    }
+  }
+  if (numCells != grid->GetNumberOfCells())
+  {
+    ++errors;
+  }
+  if (errors)
+  {
+    std::cerr << name << ": " << errors << " errors\n";
+  }
+  return errors;
+}
+
+}
+
+int TestUnstructuredGridSingleCellType(int, char*[])
+{
+  int errors = 0;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> hexes;
+  MakeHexahedra(points, hexes);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  std::vector<int> types(hexes->GetNumberOfCells(), VTK_HEXAHEDRON);
+  grid->SetCells(types.data(), hexes);
+
+  // SetCells() keeps the explicit storage, SetSingleTypeCells() does not.
+  vtkNew<vtkUnstructuredGrid> explicitGrid;
+  explicitGrid->SetPoints(points);
+  explicitGrid->SetCells(VTK_HEXAHEDRON, hexes);
+  vtkNew<vtkUnstructuredGrid> single;
+  single->SetPoints(points);
+  single->SetSingleTypeCells(VTK_HEXAHEDRON, hexes);
+  if (single->GetSingleCellType() != VTK_HEXAHEDRON ||
+    explicitGrid->GetSingleCellType() != VTK_EMPTY_CELL ||
+    grid->GetSingleCellType() != VTK_EMPTY_CELL)
+  {
+    std::cerr << "SetSingleTypeCells(VTK_HEXAHEDRON): unexpected storage\n";
+    ++errors;
+  }
+  errors += CompareGrids(explicitGrid, grid, "SetCells(VTK_HEXAHEDRON)");
+  errors += CompareGrids(single, grid, "SetSingleTypeCells(VTK_HEXAHEDRON)");
+
+  vtkNew<vtkCellTypes> cellTypes;
+  single->GetCellTypes(cellTypes);
+  vtkNew<vtkIdTypeArray> hexIds;
+  single->GetIdsOfCellsOfType(VTK_HEXAHEDRON, hexIds);
+  if (!single->IsHomogeneous() || cellTypes->GetNumberOfTypes() != 1 ||
+    cellTypes->GetCellType(0) != VTK_HEXAHEDRON ||
+    hexIds->GetNumberOfTuples() != single->GetNumberOfCells() ||
+    single->GetMaxCellSize() != 8)
+  {
+    std::cerr << "Single cell type grid: wrong cell types\n";
+    ++errors;
+  }
+
+  // Links and neighbors
+  single->BuildLinks();
+  grid->BuildLinks();
+  vtkNew<vtkIdList> cellIds, expectedIds;
+  vtkIdType ptId = 3 + (RES + 1) * (4 + (RES + 1) * 5);
+  single->GetPointCells(ptId, cellIds);
+  grid->GetPointCells(ptId, expectedIds);
+  if (cellIds->GetNumberOfIds() != 8 || expectedIds->GetNumberOfIds() != 8)
+  {
+    std::cerr << "Single cell type grid: wrong links\n";
+    ++errors;
+  }
+
+  // Copies keep the storage.
+  vtkNew<vtkUnstructuredGrid> shallow;
+  shallow->ShallowCopy(single);
+  vtkNew<vtkUnstructuredGrid> deep;
+  deep->DeepCopy(single);
+  if (shallow->GetSingleCellType() != VTK_HEXAHEDRON ||
+    deep->GetSingleCellType() != VTK_HEXAHEDRON)
+  {
+    std::cerr << "Copies do not keep the single cell type storage\n";
+    ++errors;
+  }
+  errors += CompareGrids(deep, grid, "DeepCopy");
+
+  // Asking for the types array does not change the grid.
+  vtkMTimeType mtime = shallow->GetMTime();
+  vtkUnsignedCharArray* typesArray = shallow->GetCellTypesArray();
+  if (shallow->GetSingleCellType() != VTK_HEXAHEDRON || shallow->GetMTime() != mtime ||
+    !typesArray || typesArray != shallow->GetCellTypesArray() ||
+    typesArray->GetNumberOfTuples() != grid->GetNumberOfCells() ||
+    typesArray->GetValue(5) != VTK_HEXAHEDRON ||
+    shallow->GetCellLocationsArray()->GetValue(5) != grid->GetCellLocationsArray()->GetValue(5))
+  {
+    std::cerr << "GetCellTypesArray(): wrong types array\n";
+    ++errors;
+  }
+  errors += CompareGrids(shallow, grid, "GetCellTypesArray()");
+
+  // Going back and forth between the storages.
+  shallow->ConvertToExplicitCellTypes();
+  if (shallow->GetSingleCellType() != VTK_EMPTY_CELL || shallow->GetMTime() == mtime ||
+    shallow->GetCellTypesArray()->GetNumberOfTuples() != grid->GetNumberOfCells())
+  {
+    std::cerr << "ConvertToExplicitCellTypes() failed\n";
+    ++errors;
+  }
+  errors += CompareGrids(shallow, grid, "ConvertToExplicitCellTypes()");
+  if (!shallow->ConvertToSingleCellType() || shallow->GetSingleCellType() != VTK_HEXAHEDRON)
+  {
+    std::cerr << "ConvertToSingleCellType() failed\n";
+    ++errors;
+  }
+
+  // Inserting another type converts to the explicit storage.
+  vtkIdType tet[4] = { 0, 1, 2, RES + 1 };
+  vtkIdType tetId = deep->InsertNextCell(VTK_TETRA, 4, tet);
+  grid->InsertNextCell(VTK_TETRA, 4, tet);
+  if (deep->GetSingleCellType() != VTK_EMPTY_CELL || tetId != RES * RES * RES ||
+    deep->GetCellType(tetId) != VTK_TETRA || deep->ConvertToSingleCellType())
+  {
+    std::cerr << "InsertNextCell(): wrong storage\n";
+    ++errors;
+  }
+  errors += CompareGrids(deep, grid, "InsertNextCell()");
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -69,6 +69,51 @@ int otherFieldData(int,char *[])
     return 1;
   }
 
+  // Only the array requested for writing stops being shared.
+  vtkDataArray* shared = fd->GetArray("Array1");
+  shared->SetNumberOfTuples(3);
+  shared->FillComponent(0, 0.0);
+  fd2->ShallowCopy(fd);
+  vtkDataArray* writable = fd2->GetArrayForWrite("Array1");
+  if (!writable || writable == shared || writable->GetNumberOfTuples() != 3 ||
+      fd2->GetArray("Array0") != fd->GetArray("Array0"))
+  {
+    return 1;
+  }
+  writable->SetTuple1(0, 1.0);
+  if (fd->GetArray("Array1")->GetTuple1(0) != 0.0 ||
+      fd2->GetArray("Array1")->GetTuple1(0) != 1.0 ||
+      fd2->GetArrayForWrite("Array1") != writable)
+  {
+    return 1;
+  }
+
+  // Other references to an array returned for writing do not replace it
+  // again; its values are copied only when its memory is shared.
+  writable->Register(nullptr);
+  if (fd2->GetArrayForWrite("Array1") != writable || writable->HasSharedStorage())
+  {
+    writable->UnRegister(nullptr);
+    return 1;
+  }
+  vtkFloatArray* reader = vtkFloatArray::New();
+  reader->ShallowCopy(writable);
+  if (fd2->GetArrayForWrite("Array1") != writable || writable->HasSharedStorage() ||
+      reader->GetValue(0) != 1.0f)
+  {
+    writable->UnRegister(nullptr);
+    reader->Delete();
+    return 1;
+  }
+  writable->SetTuple1(0, 2.0);
+  const bool readerChanged = reader->GetValue(0) != 1.0f;
+  writable->UnRegister(nullptr);
+  reader->Delete();
+  if (readerChanged)
+  {
+    return 1;
+  }
+
   /* Obsolete API.
   double tuple[10];
   // initialize tuple before using it to set something
@@ -22,6 +22,11 @@
 #include "vtkPoints.h"
 #include "vtkDataSet.h"
 #include "vtkMath.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -34,7 +39,14 @@ vtkAbstractCellLocator::vtkAbstractCellLocator()
   this->NumberOfCellsPerNode       = 32;
   this->UseExistingSearchStructure = 0;
   this->LazyEvaluation             = 0;
+  this->IncrementalUpdate          = 0;
   this->GenericCell                = vtkGenericCell::New();
+  this->BuildNumberOfPoints        = -1;
+  this->BuildNumberOfCells         = -1;
+  for (int i=0; i<6; i++)
+  {
+    this->BuildExtent[i] = 0;
+  }
 }
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::~vtkAbstractCellLocator()
@@ -49,10 +61,24 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double [numCells][6];
-  for (vtkIdType j=0; j<numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+
+  // The first call is made serially to trigger the non thread safe lazy
+  // initialization some datasets do in GetCellBounds(); the remaining cells
+  // are then processed in parallel.
+  vtkDataSet *ds = this->DataSet;
+  double (*cellBounds)[6] = this->CellBounds;
+  ds->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [ds, cellBounds](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType j=begin; j<end; j++)
+    {
+      ds->GetCellBounds(j, cellBounds[j]);
+    }
+  });
   return true;
 }
 //----------------------------------------------------------------------------
@@ -62,6 +88,89 @@ void vtkAbstractCellLocator::FreeCellBounds()
   this->CellBounds = nullptr;
 }
 //----------------------------------------------------------------------------
+void vtkAbstractCellLocator::RecordDataSetTopology()
+{
+  if (!this->DataSet)
+  {
+    this->BuildNumberOfPoints = this->BuildNumberOfCells = -1;
+    return;
+  }
+  this->BuildNumberOfPoints = this->DataSet->GetNumberOfPoints();
+  this->BuildNumberOfCells = this->DataSet->GetNumberOfCells();
+  if (vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(this->DataSet))
+  {
+    sg->GetExtent(this->BuildExtent);
+  }
+}
+//----------------------------------------------------------------------------
+namespace
+{
+// vtkCellArray does not report modifications made through its data array.
+bool CellArrayModifiedAfter(vtkCellArray *cells, vtkMTimeType time)
+{
+  return cells && (cells->GetMTime() > time ||
+                   (cells->GetData() && cells->GetData()->GetMTime() > time));
+}
+}
+//----------------------------------------------------------------------------
+bool vtkAbstractCellLocator::OnlyPointsModified()
+{
+  if (!this->IncrementalUpdate || !this->DataSet ||
+      this->MTime > this->BuildTime ||
+      this->DataSet->GetNumberOfPoints() != this->BuildNumberOfPoints ||
+      this->DataSet->GetNumberOfCells() != this->BuildNumberOfCells)
+  {
+    return false;
+  }
+
+  // The connectivity must not have been modified since the last build.
+  // Point coordinates and attributes are free to change.
+  vtkMTimeType buildTime = this->BuildTime.GetMTime();
+  if (vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(this->DataSet))
+  {
+    if (CellArrayModifiedAfter(ug->GetCells(), buildTime))
+    {
+      return false;
+    }
+    // Grids with a single cell type have no types array.
+    vtkObject *types = (ug->GetSingleCellType() == VTK_EMPTY_CELL ?
+                        ug->GetCellTypesArray() : nullptr);
+    vtkObject *topology[3] = { types, ug->GetFaces(),
+                               ug->GetFaceLocations() };
+    for (int i=0; i<3; i++)
+    {
+      if (topology[i] && topology[i]->GetMTime() > buildTime)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  else if (vtkPolyData *pd = vtkPolyData::SafeDownCast(this->DataSet))
+  {
+    return !CellArrayModifiedAfter(pd->GetVerts(), buildTime) &&
+           !CellArrayModifiedAfter(pd->GetLines(), buildTime) &&
+           !CellArrayModifiedAfter(pd->GetPolys(), buildTime) &&
+           !CellArrayModifiedAfter(pd->GetStrips(), buildTime);
+  }
+  else if (vtkStructuredGrid *sg = vtkStructuredGrid::SafeDownCast(this->DataSet))
+  {
+    // Blanking changes the visible cells.
+    int extent[6];
+    sg->GetExtent(extent);
+    for (int i=0; i<6; i++)
+    {
+      if (extent[i] != this->BuildExtent[i])
+      {
+        return false;
+      }
+    }
+    vtkUnsignedCharArray *ghosts = sg->GetCellGhostArray();
+    return !ghosts || ghosts->GetMTime() <= buildTime;
+  }
+  return false;
+}
+//----------------------------------------------------------------------------
 int vtkAbstractCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
   double& t, double x[3], double pcoords[3],
   int &subId)
@@ -224,5 +333,7 @@ void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
      << this->UseExistingSearchStructure << "\n";
   os << indent << "LazyEvaluation: "
      << this->LazyEvaluation << "\n";
+  os << indent << "IncrementalUpdate: "
+     << this->IncrementalUpdate << "\n";
 }
 //----------------------------------------------------------------------------
@@ -111,6 +111,21 @@ public:
   vtkBooleanMacro(UseExistingSearchStructure,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Boolean controls whether BuildLocator() may update the search structure
+   * in place when only the point coordinates of the dataset changed since
+   * the last build, as happens every time step with moving meshes (ALE or
+   * fluid-structure interaction simulations). The dataset must keep the same
+   * number of points and cells and its connectivity must not be modified;
+   * otherwise the locator is rebuilt. Locators that do not support updates
+   * always rebuild. Off by default.
+   */
+  vtkSetMacro(IncrementalUpdate,vtkTypeBool);
+  vtkGetMacro(IncrementalUpdate,vtkTypeBool);
+  vtkBooleanMacro(IncrementalUpdate,vtkTypeBool);
+  //@}
+
   /**
    * Return intersection point (if any) of finite line with cells contained
    * in cell locator. See vtkCell.h parameters documentation.
@@ -283,14 +298,33 @@ protected:
   virtual void FreeCellBounds();
   //@}
 
+  //@{
+  /**
+   * Support for IncrementalUpdate. RecordDataSetTopology() must be called
+   * by subclasses at the end of BuildLocator(). OnlyPointsModified() then
+   * returns true when IncrementalUpdate is on, the locator was not modified
+   * since it was built, and the dataset kept its number of points and cells
+   * and its connectivity, so that the search structure can be updated in
+   * place rather than rebuilt. Only vtkPolyData, vtkUnstructuredGrid and
+   * vtkStructuredGrid datasets qualify.
+   */
+  void RecordDataSetTopology();
+  bool OnlyPointsModified();
+  //@}
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
   vtkTypeBool LazyEvaluation;
   vtkTypeBool UseExistingSearchStructure;
+  vtkTypeBool IncrementalUpdate;
   vtkGenericCell *GenericCell;
   double (*CellBounds)[6];
 
+  vtkIdType BuildNumberOfPoints;
+  vtkIdType BuildNumberOfCells;
+  int BuildExtent[6];
+
 private:
   vtkAbstractCellLocator(const vtkAbstractCellLocator&) = delete;
   void operator=(const vtkAbstractCellLocator&) = delete;
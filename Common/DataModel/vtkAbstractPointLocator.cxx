@@ -15,7 +15,183 @@
 #include "vtkAbstractPointLocator.h"
 
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+//-----------------------------------------------------------------------------
+// The results of the queries [Begin, Begin + Counts.size()), computed by one
+// thread.
+struct QueryChunk
+{
+  vtkIdType Begin;
+  vtkIdType Offset; // where the ids of this chunk go in the output
+  std::vector<vtkIdType> Counts;
+  std::vector<vtkIdType> Ids;
+};
+
+//-----------------------------------------------------------------------------
+// Runs a query returning a vtkIdList for a range of query points, keeping the
+// results in per-thread chunks which are then assembled in query order.
+template <typename QueryT>
+struct BatchQuery
+{
+  vtkPoints* Queries;
+  QueryT Query;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+  vtkSMPThreadLocal<std::vector<QueryChunk> > Chunks;
+
+  BatchQuery(vtkPoints* queries, QueryT query)
+    : Queries(queries)
+    , Query(query)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList*& result = this->Result.Local();
+    QueryChunk chunk;
+    chunk.Begin = begin;
+    chunk.Offset = 0;
+    chunk.Counts.reserve(end - begin);
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Queries->GetPoint(i, x);
+      this->Query(x, result);
+      vtkIdType n = result->GetNumberOfIds();
+      chunk.Counts.push_back(n);
+      chunk.Ids.insert(chunk.Ids.end(), result->GetPointer(0), result->GetPointer(0) + n);
+    }
+    this->Chunks.Local().push_back(std::move(chunk));
+  }
+
+  void Reduce() {}
+};
+
+//-----------------------------------------------------------------------------
+// Copies the chunks into the output arrays, in parallel over the chunks.
+struct AssembleChunks
+{
+  const std::vector<QueryChunk*>& Chunks;
+  vtkDataSet* DataSet;
+  vtkPoints* Queries;
+  vtkIdType* Offsets;
+  vtkIdType* Ids;
+  double* Dist2;
+
+  AssembleChunks(const std::vector<QueryChunk*>& chunks, vtkDataSet* ds, vtkPoints* queries,
+    vtkIdType* offsets, vtkIdType* ids, double* dist2)
+    : Chunks(chunks)
+    , DataSet(ds)
+    , Queries(queries)
+    , Offsets(offsets)
+    , Ids(ids)
+    , Dist2(dist2)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], y[3];
+    for (vtkIdType c = begin; c < end; ++c)
+    {
+      const QueryChunk* chunk = this->Chunks[c];
+      vtkIdType offset = chunk->Offset;
+      std::copy(chunk->Ids.begin(), chunk->Ids.end(), this->Ids + offset);
+      vtkIdType query = chunk->Begin;
+      for (vtkIdType count : chunk->Counts)
+      {
+        this->Offsets[query] = offset;
+        if (this->Dist2)
+        {
+          this->Queries->GetPoint(query, x);
+          for (vtkIdType j = offset; j < offset + count; ++j)
+          {
+            this->DataSet->GetPoint(this->Ids[j], y);
+            this->Dist2[j] = vtkMath::Distance2BetweenPoints(x, y);
+          }
+        }
+        offset += count;
+        ++query;
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+template <typename QueryT>
+void ExecuteBatchQuery(vtkDataSet* ds, vtkPoints* queries, QueryT query,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* dist2, bool threaded)
+{
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  BatchQuery<QueryT> batch(queries, query);
+  if (threaded)
+  {
+    vtkSMPTools::For(0, numQueries, batch);
+  }
+  else if (numQueries > 0)
+  {
+    batch(0, numQueries);
+  }
+
+  // Order the chunks by query and compute where their ids go.
+  std::vector<QueryChunk*> chunks;
+  for (auto& threadChunks : batch.Chunks)
+  {
+    for (QueryChunk& chunk : threadChunks)
+    {
+      chunks.push_back(&chunk);
+    }
+  }
+  std::sort(chunks.begin(), chunks.end(),
+    [](const QueryChunk* a, const QueryChunk* b) { return a->Begin < b->Begin; });
+  vtkIdType numIds = 0;
+  for (QueryChunk* chunk : chunks)
+  {
+    chunk->Offset = numIds;
+    numIds += static_cast<vtkIdType>(chunk->Ids.size());
+  }
+
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfValues(numQueries + 1);
+  offsets->SetValue(numQueries, numIds);
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfValues(numIds);
+  double* d2 = nullptr;
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfValues(numIds);
+    d2 = dist2->GetPointer(0);
+  }
+
+  AssembleChunks assemble(
+    chunks, ds, queries, offsets->GetPointer(0), ids->GetPointer(0), d2);
+  if (threaded)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), assemble);
+  }
+  else
+  {
+    assemble(0, static_cast<vtkIdType>(chunks.size()));
+  }
+}
+
+} // end anon namespace
 
 
 //-----------------------------------------------------------------------------
@@ -66,6 +242,117 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(double R, double x,
   this->FindPointsWithinRadius(R,p,result);
 }
 
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindClosestPoint(vtkPoints *queries,
+                                                    vtkIdTypeArray *ids,
+                                                    vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindClosestPoint(queries, ids, dist2, false);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindClosestNPoints(int N,
+                                                      vtkPoints *queries,
+                                                      vtkIdTypeArray *offsets,
+                                                      vtkIdTypeArray *ids,
+                                                      vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindClosestNPoints(N, queries, offsets, ids, dist2, false);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::BatchFindPointsWithinRadius(double R,
+                                                          vtkPoints *queries,
+                                                          vtkIdTypeArray *offsets,
+                                                          vtkIdTypeArray *ids,
+                                                          vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindPointsWithinRadius(R, queries, offsets, ids, dist2, false);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::ExecuteBatchFindClosestPoint(vtkPoints *queries,
+                                                           vtkIdTypeArray *ids,
+                                                           vtkDoubleArray *dist2,
+                                                           bool threaded)
+{
+  this->BuildLocator();
+
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfValues(numQueries);
+  vtkIdType* idPtr = ids->GetPointer(0);
+  double* d2 = nullptr;
+  if (dist2)
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfValues(numQueries);
+    d2 = dist2->GetPointer(0);
+  }
+
+  vtkDataSet* ds = this->DataSet;
+  auto query = [&](vtkIdType begin, vtkIdType end) {
+    double x[3], y[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      queries->GetPoint(i, x);
+      idPtr[i] = this->FindClosestPoint(x);
+      if (d2)
+      {
+        if (idPtr[i] >= 0)
+        {
+          ds->GetPoint(idPtr[i], y);
+          d2[i] = vtkMath::Distance2BetweenPoints(x, y);
+        }
+        else
+        {
+          d2[i] = VTK_DOUBLE_MAX;
+        }
+      }
+    }
+  };
+  if (threaded)
+  {
+    vtkSMPTools::For(0, numQueries, query);
+  }
+  else
+  {
+    query(0, numQueries);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::ExecuteBatchFindClosestNPoints(int N,
+                                                             vtkPoints *queries,
+                                                             vtkIdTypeArray *offsets,
+                                                             vtkIdTypeArray *ids,
+                                                             vtkDoubleArray *dist2,
+                                                             bool threaded)
+{
+  this->BuildLocator();
+  ExecuteBatchQuery(this->DataSet, queries,
+    [this, N](const double x[3], vtkIdList* result) {
+      this->FindClosestNPoints(N, x, result);
+    },
+    offsets, ids, dist2, threaded);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::ExecuteBatchFindPointsWithinRadius(double R,
+                                                                 vtkPoints *queries,
+                                                                 vtkIdTypeArray *offsets,
+                                                                 vtkIdTypeArray *ids,
+                                                                 vtkDoubleArray *dist2,
+                                                                 bool threaded)
+{
+  this->BuildLocator();
+  ExecuteBatchQuery(this->DataSet, queries,
+    [this, R](const double x[3], vtkIdList* result) {
+      this->FindPointsWithinRadius(R, x, result);
+    },
+    offsets, ids, dist2, threaded);
+}
+
 //-----------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -33,7 +33,10 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -93,6 +96,32 @@ public:
                                       vtkIdList *result);
   //@}
 
+  //@{
+  /**
+   * Batched versions of FindClosestPoint(), FindClosestNPoints() and
+   * FindPointsWithinRadius() that process all the given query points.
+   * BatchFindClosestPoint() returns one id per
+   * query (-1 if there is none). The other methods return their results in
+   * compressed sparse row form: the ids found for query i are ids[offsets[i]]
+   * up to, but not including, ids[offsets[i+1]], so offsets has one more value
+   * than there are queries. For each query, the ids are in the order returned
+   * by the corresponding single query method. If dist2 is not nullptr, it is
+   * filled with the squared distance between each returned point and its
+   * query point, aligned with ids. BuildLocator() is called before the
+   * queries are started. The queries run serially here; subclasses whose
+   * single query methods are thread safe once the locator is built (e.g.
+   * vtkStaticPointLocator) run them in parallel with vtkSMPTools.
+   */
+  virtual void BatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *ids,
+                                     vtkDoubleArray *dist2 = nullptr);
+  virtual void BatchFindClosestNPoints(int N, vtkPoints *queries,
+                                       vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                                       vtkDoubleArray *dist2 = nullptr);
+  virtual void BatchFindPointsWithinRadius(double R, vtkPoints *queries,
+                                           vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                                           vtkDoubleArray *dist2 = nullptr);
+  //@}
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -113,6 +142,21 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  //@{
+  /**
+   * Implementation of the batched queries, run in parallel with vtkSMPTools
+   * if threaded is true and serially otherwise.
+   */
+  void ExecuteBatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *ids,
+                                    vtkDoubleArray *dist2, bool threaded);
+  void ExecuteBatchFindClosestNPoints(int N, vtkPoints *queries,
+                                      vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                                      vtkDoubleArray *dist2, bool threaded);
+  void ExecuteBatchFindPointsWithinRadius(double R, vtkPoints *queries,
+                                          vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                                          vtkDoubleArray *dist2, bool threaded);
+  //@}
+
   double Bounds[6]; // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
@@ -0,0 +1,1384 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCell.h"
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//-----------------------------------------------------------------------------
+// The tree proper. Nodes are stored in a single array; the two children of
+// an interior node are stored next to each other, after their parent.
+struct vtkBVHTree
+{
+  struct Node
+  {
+    float Bounds[6];    // conservatively rounded bounds of the node
+    vtkTypeInt32 Index; // first cell (leaf) or first child (interior node)
+    vtkTypeInt32 Count; // number of cells (leaf) or 0 (interior node)
+  };
+
+  std::vector<Node> Nodes;
+  std::vector<vtkIdType> CellIds;  // cell ids, ordered by leaf
+  std::vector<double> CellBounds;  // 6 values per cell
+
+  vtkIdType GetNumberOfCells() const
+  {
+    return static_cast<vtkIdType>(this->CellIds.size());
+  }
+
+  void ComputeCellBounds(vtkDataSet *ds, double *centroids);
+  void RefitNodes();
+
+  vtkIdType FindCell(vtkDataSet *ds, const double x[3], double tol2,
+                     vtkGenericCell *cell, double pcoords[3], double *weights) const;
+  int IntersectWithLine(vtkDataSet *ds, const double p1[3], const double p2[3],
+                        double tol, double& t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId, vtkGenericCell *cell) const;
+  bool FindClosestPoint(vtkDataSet *ds, const double x[3], double radius2,
+                        double closestPoint[3], vtkGenericCell *cell,
+                        vtkIdType &cellId, int &subId, double& dist2,
+                        int &inside) const;
+
+  // Visit the cells of all leaves whose bounds pass the node test. The
+  // traversal stops as soon as the visitor returns true.
+  template <typename NodeTest, typename CellVisitor>
+  void Traverse(NodeTest& nodeTest, CellVisitor& visit) const;
+};
+
+static_assert(sizeof(vtkBVHTree::Node) == 32, "BVH nodes must use 32 bytes");
+
+namespace
+{
+
+// Deeper nodes are made leaves regardless of their size. This bounds the
+// size of the traversal stacks.
+const int VTK_BVH_MAX_DEPTH = 64;
+const int VTK_BVH_STACK_SIZE = VTK_BVH_MAX_DEPTH + 2;
+
+// Ranges of cells larger than this are processed in parallel.
+const vtkIdType VTK_BVH_PARALLEL_CELLS = 32768;
+
+//-----------------------------------------------------------------------------
+// Bounding box helpers, used with the double precision bounds of cells and
+// the single precision bounds of nodes.
+inline void InitializeBounds(double b[6])
+{
+  b[0] = b[2] = b[4] = VTK_DOUBLE_MAX;
+  b[1] = b[3] = b[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void AddBounds(double b[6], const double c[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    b[2*i] = std::min(b[2*i], c[2*i]);
+    b[2*i+1] = std::max(b[2*i+1], c[2*i+1]);
+  }
+}
+
+inline void AddPoint(double b[6], const double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    b[2*i] = std::min(b[2*i], x[i]);
+    b[2*i+1] = std::max(b[2*i+1], x[i]);
+  }
+}
+
+// Half the surface area of a box, zero for an empty box.
+inline double HalfArea(const double b[6])
+{
+  if (b[0] > b[1])
+  {
+    return 0.0;
+  }
+  double dx = b[1] - b[0], dy = b[3] - b[2], dz = b[5] - b[4];
+  return dx*dy + dy*dz + dz*dx;
+}
+
+inline float RoundDown(double v)
+{
+  float f = static_cast<float>(v);
+  return static_cast<double>(f) > v ?
+    std::nextafter(f, -std::numeric_limits<float>::infinity()) : f;
+}
+
+inline float RoundUp(double v)
+{
+  float f = static_cast<float>(v);
+  return static_cast<double>(f) < v ?
+    std::nextafter(f, std::numeric_limits<float>::infinity()) : f;
+}
+
+inline void SetNodeBounds(vtkBVHTree::Node& node, const double b[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    node.Bounds[2*i] = RoundDown(b[2*i]);
+    node.Bounds[2*i+1] = RoundUp(b[2*i+1]);
+  }
+}
+
+template <typename T>
+inline bool PointInBox(const T b[6], const double x[3])
+{
+  return x[0] >= b[0] && x[0] <= b[1] && x[1] >= b[2] && x[1] <= b[3] &&
+    x[2] >= b[4] && x[2] <= b[5];
+}
+
+// Same as above, with the box enlarged by tol on each side.
+template <typename T>
+inline bool PointInBox(const T b[6], const double x[3], double tol)
+{
+  return x[0] >= b[0] - tol && x[0] <= b[1] + tol && x[1] >= b[2] - tol &&
+    x[1] <= b[3] + tol && x[2] >= b[4] - tol && x[2] <= b[5] + tol;
+}
+
+template <typename T>
+inline bool BoxesOverlap(const T b[6], const double bb[6])
+{
+  return b[0] <= bb[1] && b[1] >= bb[0] && b[2] <= bb[3] && b[3] >= bb[2] &&
+    b[4] <= bb[5] && b[5] >= bb[4];
+}
+
+template <typename T>
+inline double BoxDistance2(const T b[6], const double x[3])
+{
+  double d2 = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    double d = std::max(std::max(b[2*i] - x[i], 0.0), x[i] - b[2*i+1]);
+    d2 += d*d;
+  }
+  return d2;
+}
+
+// Clip the segment o + t*d, t in [0,tMax], against the box enlarged by tol.
+// Returns true and the entry parameter if the segment hits the box.
+template <typename T>
+inline bool SegmentHitsBox(const T b[6], const double o[3], const double d[3],
+                           double tol, double tMax, double& tEnter)
+{
+  double t0 = 0.0, t1 = tMax;
+  for (int i = 0; i < 3; ++i)
+  {
+    double lo = b[2*i] - tol, hi = b[2*i+1] + tol;
+    if (d[i] == 0.0)
+    {
+      if (o[i] < lo || o[i] > hi)
+      {
+        return false;
+      }
+    }
+    else
+    {
+      double tn = (lo - o[i]) / d[i], tf = (hi - o[i]) / d[i];
+      if (tn > tf)
+      {
+        std::swap(tn, tf);
+      }
+      t0 = std::max(t0, tn);
+      t1 = std::min(t1, tf);
+      if (t0 > t1)
+      {
+        return false;
+      }
+    }
+  }
+  tEnter = t0;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Accumulates the bounds of a range of cells and of their centroids.
+struct RangeBounds
+{
+  const double *CellBounds;
+  const double *Centroids;
+  double Node[6];
+  double Centroid[6];
+
+  RangeBounds(const double *cellBounds = nullptr, const double *centroids = nullptr)
+    : CellBounds(cellBounds), Centroids(centroids)
+  {
+    InitializeBounds(this->Node);
+    InitializeBounds(this->Centroid);
+  }
+
+  void Add(vtkIdType cellId)
+  {
+    AddBounds(this->Node, this->CellBounds + 6*cellId);
+    AddPoint(this->Centroid, this->Centroids + 3*cellId);
+  }
+
+  void Merge(const RangeBounds& other)
+  {
+    AddBounds(this->Node, other.Node);
+    AddBounds(this->Centroid, other.Centroid);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Accumulates the number of cells and their bounds in bins along each axis,
+// binning the cells by centroid.
+struct SplitBins
+{
+  const double *CellBounds;
+  const double *Centroids;
+  int NumberOfBins;
+  double Min[3];
+  double Scale[3]; // bins per unit length, 0 if the axis cannot be split
+  std::vector<vtkIdType> Counts; // per axis and bin
+  std::vector<double> Bounds; // 6 values per axis and bin
+
+  SplitBins()
+    : CellBounds(nullptr), Centroids(nullptr), NumberOfBins(0)
+  {
+  }
+
+  SplitBins(const double *cellBounds, const double *centroids, int numBins,
+            const double centroidBounds[6])
+    : CellBounds(cellBounds), Centroids(centroids), NumberOfBins(numBins),
+      Counts(3*numBins, 0), Bounds(18*numBins)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double extent = centroidBounds[2*axis+1] - centroidBounds[2*axis];
+      this->Min[axis] = centroidBounds[2*axis];
+      this->Scale[axis] = extent > 0.0 ? numBins / extent : 0.0;
+    }
+    for (int bin = 0; bin < 3*numBins; ++bin)
+    {
+      InitializeBounds(&this->Bounds[6*bin]);
+    }
+  }
+
+  int GetBin(int axis, vtkIdType cellId) const
+  {
+    int bin = static_cast<int>(
+      (this->Centroids[3*cellId+axis] - this->Min[axis]) * this->Scale[axis]);
+    return std::min(std::max(bin, 0), this->NumberOfBins - 1);
+  }
+
+  void Add(vtkIdType cellId)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (this->Scale[axis] > 0.0)
+      {
+        int bin = axis*this->NumberOfBins + this->GetBin(axis, cellId);
+        ++this->Counts[bin];
+        AddBounds(&this->Bounds[6*bin], this->CellBounds + 6*cellId);
+      }
+    }
+  }
+
+  void Merge(const SplitBins& other)
+  {
+    for (int bin = 0; bin < 3*this->NumberOfBins; ++bin)
+    {
+      this->Counts[bin] += other.Counts[bin];
+      AddBounds(&this->Bounds[6*bin], &other.Bounds[6*bin]);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Runs an accumulator over a range of the cell ids, in parallel with one
+// accumulator per thread.
+template <typename Accumulator>
+struct AccumulateFunctor
+{
+  const vtkIdType *CellIds;
+  vtkSMPThreadLocal<Accumulator> Local;
+  Accumulator Result;
+
+  AccumulateFunctor(const vtkIdType *cellIds, const Accumulator& exemplar)
+    : CellIds(cellIds), Local(exemplar), Result(exemplar)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    Accumulator& accumulator = this->Local.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      accumulator.Add(this->CellIds[i]);
+    }
+  }
+
+  void Reduce()
+  {
+    for (auto& accumulator : this->Local)
+    {
+      this->Result.Merge(accumulator);
+    }
+  }
+};
+
+template <typename Accumulator>
+Accumulator Accumulate(const vtkIdType *cellIds, vtkIdType begin, vtkIdType end,
+                       const Accumulator& exemplar, bool parallel)
+{
+  if (parallel && end - begin > VTK_BVH_PARALLEL_CELLS)
+  {
+    AccumulateFunctor<Accumulator> functor(cellIds, exemplar);
+    vtkSMPTools::For(begin, end, functor);
+    return functor.Result;
+  }
+  Accumulator accumulator(exemplar);
+  for (vtkIdType i = begin; i < end; ++i)
+  {
+    accumulator.Add(cellIds[i]);
+  }
+  return accumulator;
+}
+
+//-----------------------------------------------------------------------------
+// Top-down construction of the tree using binned surface area heuristic.
+struct BVHBuilder
+{
+  const double *CellBounds;
+  const double *Centroids;
+  vtkIdType *CellIds;
+  int NumberOfBins;
+  vtkIdType LeafSize;
+
+  RangeBounds ComputeBounds(vtkIdType begin, vtkIdType end, bool parallel) const
+  {
+    return Accumulate(this->CellIds, begin, end,
+      RangeBounds(this->CellBounds, this->Centroids), parallel);
+  }
+
+  // Partition the cells of [begin,end) and return where the second child
+  // starts, or -1 if the range should be a leaf.
+  vtkIdType Split(vtkIdType begin, vtkIdType end, const double centroidBounds[6],
+                  int depth, bool parallel) const
+  {
+    vtkIdType numCells = end - begin;
+    if (numCells <= this->LeafSize || depth >= VTK_BVH_MAX_DEPTH)
+    {
+      return -1;
+    }
+
+    SplitBins bins = Accumulate(this->CellIds, begin, end,
+      SplitBins(this->CellBounds, this->Centroids, this->NumberOfBins, centroidBounds),
+      parallel);
+
+    // Sweep the bins of each axis to find the split with the lowest cost.
+    int numBins = this->NumberOfBins;
+    int bestAxis = -1, bestBin = -1;
+    double bestCost = VTK_DOUBLE_MAX;
+    std::vector<double> leftArea(numBins);
+    std::vector<vtkIdType> leftCount(numBins);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (bins.Scale[axis] <= 0.0)
+      {
+        continue;
+      }
+      const vtkIdType *counts = &bins.Counts[axis*numBins];
+      const double *bounds = &bins.Bounds[6*axis*numBins];
+
+      double b[6];
+      InitializeBounds(b);
+      vtkIdType count = 0;
+      for (int bin = 0; bin < numBins - 1; ++bin)
+      {
+        AddBounds(b, bounds + 6*bin);
+        count += counts[bin];
+        leftArea[bin] = HalfArea(b);
+        leftCount[bin] = count;
+      }
+
+      InitializeBounds(b);
+      count = 0;
+      for (int bin = numBins - 1; bin > 0; --bin)
+      {
+        AddBounds(b, bounds + 6*bin);
+        count += counts[bin];
+        if (count == 0 || leftCount[bin-1] == 0)
+        {
+          continue;
+        }
+        double cost = leftArea[bin-1]*leftCount[bin-1] + HalfArea(b)*count;
+        if (cost < bestCost)
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestBin = bin - 1;
+        }
+      }
+    }
+
+    vtkIdType mid = begin + numCells/2;
+    if (bestAxis >= 0)
+    {
+      vtkIdType *first = this->CellIds + begin;
+      vtkIdType *split = std::partition(first, this->CellIds + end,
+        [&bins, bestAxis, bestBin](vtkIdType cellId)
+        { return bins.GetBin(bestAxis, cellId) <= bestBin; });
+      if (split != first && split != this->CellIds + end)
+      {
+        mid = split - this->CellIds;
+      }
+    }
+    // else all centroids coincide, any split is as good as another
+    return mid;
+  }
+
+  // Serially build the subtree rooted at nodes[nodeIndex].
+  void BuildSubtree(std::vector<vtkBVHTree::Node>& nodes, size_t nodeIndex,
+                    vtkIdType begin, vtkIdType end, int depth) const
+  {
+    RangeBounds bounds = this->ComputeBounds(begin, end, false);
+    SetNodeBounds(nodes[nodeIndex], bounds.Node);
+
+    vtkIdType mid = this->Split(begin, end, bounds.Centroid, depth, false);
+    if (mid < 0)
+    {
+      nodes[nodeIndex].Index = static_cast<vtkTypeInt32>(begin);
+      nodes[nodeIndex].Count = static_cast<vtkTypeInt32>(end - begin);
+      return;
+    }
+
+    size_t left = nodes.size();
+    nodes.resize(left + 2);
+    nodes[nodeIndex].Index = static_cast<vtkTypeInt32>(left);
+    nodes[nodeIndex].Count = 0;
+    this->BuildSubtree(nodes, left, begin, mid, depth + 1);
+    this->BuildSubtree(nodes, left + 1, mid, end, depth + 1);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Emit the eight corners and six faces of a box.
+void AddBox(const float b[6], vtkPoints *pts, vtkCellArray *polys)
+{
+  static const int faces[6][4] = { {0,2,6,4}, {1,5,7,3}, {0,4,5,1},
+                                   {2,3,7,6}, {0,1,3,2}, {4,6,7,5} };
+  vtkIdType ids[8];
+  for (int i = 0; i < 8; ++i)
+  {
+    ids[i] = pts->InsertNextPoint(b[i & 1], b[2 + ((i >> 1) & 1)], b[4 + ((i >> 2) & 1)]);
+  }
+  for (int f = 0; f < 6; ++f)
+  {
+    vtkIdType face[4] = { ids[faces[f][0]], ids[faces[f][1]],
+                          ids[faces[f][2]], ids[faces[f][3]] };
+    polys->InsertNextCell(4, face);
+  }
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+// Compute the bounds (and optionally the centroids) of all cells in parallel.
+void vtkBVHTree::ComputeCellBounds(vtkDataSet *ds, double *centroids)
+{
+  vtkIdType numCells = ds->GetNumberOfCells();
+  this->CellBounds.resize(6*numCells);
+  double *cellBounds = this->CellBounds.data();
+
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellBounds().
+  ds->GetCellBounds(0, cellBounds);
+
+  vtkSMPTools::For(0, numCells, [ds, cellBounds, centroids](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      double *b = cellBounds + 6*cellId;
+      ds->GetCellBounds(cellId, b);
+      if (centroids)
+      {
+        centroids[3*cellId] = 0.5*(b[0] + b[1]);
+        centroids[3*cellId+1] = 0.5*(b[2] + b[3]);
+        centroids[3*cellId+2] = 0.5*(b[4] + b[5]);
+      }
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+// Recompute the node bounds from the cell bounds, keeping the topology.
+// Children are always stored after their parent, so a reverse sweep over the
+// nodes updates the children before their parent.
+void vtkBVHTree::RefitNodes()
+{
+  std::vector<Node>& nodes = this->Nodes;
+  const vtkIdType *cellIds = this->CellIds.data();
+  const double *cellBounds = this->CellBounds.data();
+
+  vtkSMPTools::For(0, static_cast<vtkIdType>(nodes.size()),
+    [&nodes, cellIds, cellBounds](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      Node& node = nodes[i];
+      if (node.Count > 0)
+      {
+        double b[6];
+        InitializeBounds(b);
+        for (vtkIdType j = node.Index; j < node.Index + node.Count; ++j)
+        {
+          AddBounds(b, cellBounds + 6*cellIds[j]);
+        }
+        SetNodeBounds(node, b);
+      }
+    }
+  });
+
+  for (size_t i = nodes.size(); i-- > 0;)
+  {
+    Node& node = nodes[i];
+    if (node.Count == 0)
+    {
+      const Node& left = nodes[node.Index];
+      const Node& right = nodes[node.Index + 1];
+      for (int j = 0; j < 3; ++j)
+      {
+        node.Bounds[2*j] = std::min(left.Bounds[2*j], right.Bounds[2*j]);
+        node.Bounds[2*j+1] = std::max(left.Bounds[2*j+1], right.Bounds[2*j+1]);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <typename NodeTest, typename CellVisitor>
+void vtkBVHTree::Traverse(NodeTest& nodeTest, CellVisitor& visit) const
+{
+  if (this->Nodes.empty())
+  {
+    return;
+  }
+  vtkTypeInt32 stack[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const Node& node = this->Nodes[stack[--top]];
+    if (!nodeTest(node.Bounds))
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      for (vtkIdType i = node.Index; i < node.Index + node.Count; ++i)
+      {
+        if (visit(this->CellIds[i]))
+        {
+          return;
+        }
+      }
+    }
+    else
+    {
+      stack[top++] = node.Index + 1;
+      stack[top++] = node.Index;
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHTree::FindCell(vtkDataSet *ds, const double x[3], double tol2,
+                               vtkGenericCell *cell, double pcoords[3],
+                               double *weights) const
+{
+  // The cells found within the tolerance, e.g. 2D cells slightly out of
+  // plane, may lie outside the box of the point.
+  const double tol = std::sqrt(std::max(tol2, 0.0));
+  vtkIdType found = -1;
+  auto nodeTest = [x, tol](const float b[6]) { return PointInBox(b, x, tol); };
+  auto visit = [&](vtkIdType cellId)
+  {
+    if (!PointInBox(&this->CellBounds[6*cellId], x, tol))
+    {
+      return false;
+    }
+    int subId;
+    double closestPoint[3], dist2;
+    ds->GetCell(cellId, cell);
+    if (cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights) == 1 &&
+        dist2 <= tol2)
+    {
+      found = cellId;
+      return true;
+    }
+    return false;
+  };
+  this->Traverse(nodeTest, visit);
+  return found;
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHTree::IntersectWithLine(vtkDataSet *ds, const double p1[3], const double p2[3],
+                                  double tol, double& t, double x[3], double pcoords[3],
+                                  int &subId, vtkIdType &cellId,
+                                  vtkGenericCell *cell) const
+{
+  cellId = -1;
+  subId = 0;
+  if (this->Nodes.empty())
+  {
+    return 0;
+  }
+
+  double dir[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double tBest = 1.0, tEnter;
+  double tCell, xCell[3], pcoordsCell[3];
+  int subIdCell;
+
+  // Closest hit first: visit the nearest child first and prune the nodes
+  // beyond the best intersection found so far.
+  vtkTypeInt32 stack[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const Node& node = this->Nodes[stack[--top]];
+    if (!SegmentHitsBox(node.Bounds, p1, dir, tol, tBest, tEnter))
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      for (vtkIdType i = node.Index; i < node.Index + node.Count; ++i)
+      {
+        vtkIdType cId = this->CellIds[i];
+        if (!SegmentHitsBox(&this->CellBounds[6*cId], p1, dir, tol, tBest, tEnter))
+        {
+          continue;
+        }
+        ds->GetCell(cId, cell);
+        if (cell->IntersectWithLine(p1, p2, tol, tCell, xCell, pcoordsCell, subIdCell) &&
+            (cellId < 0 || tCell < tBest))
+        {
+          tBest = tCell;
+          cellId = cId;
+          subId = subIdCell;
+          for (int j = 0; j < 3; ++j)
+          {
+            x[j] = xCell[j];
+            pcoords[j] = pcoordsCell[j];
+          }
+        }
+      }
+    }
+    else
+    {
+      const Node& left = this->Nodes[node.Index];
+      const Node& right = this->Nodes[node.Index + 1];
+      double tLeft = VTK_DOUBLE_MAX, tRight = VTK_DOUBLE_MAX;
+      bool hitLeft = SegmentHitsBox(left.Bounds, p1, dir, tol, tBest, tLeft);
+      bool hitRight = SegmentHitsBox(right.Bounds, p1, dir, tol, tBest, tRight);
+      vtkTypeInt32 first = node.Index, second = node.Index + 1;
+      if (hitRight && (!hitLeft || tRight < tLeft))
+      {
+        std::swap(first, second);
+        std::swap(hitLeft, hitRight);
+      }
+      if (hitRight)
+      {
+        stack[top++] = second;
+      }
+      if (hitLeft)
+      {
+        stack[top++] = first;
+      }
+    }
+  }
+
+  if (cellId < 0)
+  {
+    return 0;
+  }
+  t = tBest;
+  ds->GetCell(cellId, cell);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkBVHTree::FindClosestPoint(vtkDataSet *ds, const double x[3], double radius2,
+                                  double closestPoint[3], vtkGenericCell *cell,
+                                  vtkIdType &cellId, int &subId, double& dist2,
+                                  int &inside) const
+{
+  cellId = -1;
+  subId = 0;
+  inside = 0;
+  dist2 = radius2;
+  if (this->Nodes.empty())
+  {
+    return false;
+  }
+
+  double localWeights[VTK_CELL_SIZE];
+  std::vector<double> largeWeights;
+  double point[3], pcoords[3], d2;
+  int subIdCell;
+
+  // Nearest first: visit the nearest child first and prune the nodes farther
+  // than the closest point found so far.
+  vtkTypeInt32 stack[VTK_BVH_STACK_SIZE];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const Node& node = this->Nodes[stack[--top]];
+    if (BoxDistance2(node.Bounds, x) > dist2)
+    {
+      continue;
+    }
+    if (node.Count > 0)
+    {
+      for (vtkIdType i = node.Index; i < node.Index + node.Count; ++i)
+      {
+        vtkIdType cId = this->CellIds[i];
+        if (BoxDistance2(&this->CellBounds[6*cId], x) > dist2)
+        {
+          continue;
+        }
+        ds->GetCell(cId, cell);
+        double *weights = localWeights;
+        if (cell->GetNumberOfPoints() > VTK_CELL_SIZE)
+        {
+          largeWeights.resize(cell->GetNumberOfPoints());
+          weights = largeWeights.data();
+        }
+        int status = cell->EvaluatePosition(x, point, subIdCell, pcoords, d2, weights);
+        if (status != -1 && (d2 < dist2 || (cellId < 0 && d2 <= dist2)))
+        {
+          dist2 = d2;
+          cellId = cId;
+          subId = subIdCell;
+          inside = (status == 1);
+          closestPoint[0] = point[0];
+          closestPoint[1] = point[1];
+          closestPoint[2] = point[2];
+        }
+      }
+    }
+    else
+    {
+      double dLeft = BoxDistance2(this->Nodes[node.Index].Bounds, x);
+      double dRight = BoxDistance2(this->Nodes[node.Index + 1].Bounds, x);
+      vtkTypeInt32 nearest = node.Index, farthest = node.Index + 1;
+      if (dRight < dLeft)
+      {
+        std::swap(nearest, farthest);
+        std::swap(dLeft, dRight);
+      }
+      if (dRight <= dist2)
+      {
+        stack[top++] = farthest;
+      }
+      if (dLeft <= dist2)
+      {
+        stack[top++] = nearest;
+      }
+    }
+  }
+
+  if (cellId < 0)
+  {
+    return false;
+  }
+  ds->GetCell(cellId, cell);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Here is the VTK class proper.
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 8;
+  this->NumberOfBins = 16;
+  this->CacheCellBounds = 1;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  vtkDebugMacro( << "Building BVH cell locator" );
+
+  if ( !this->DataSet )
+  {
+    vtkErrorMacro( << "No cells to build");
+    return;
+  }
+
+  // Do we need to build?
+  if ( (this->Tree != nullptr) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+  {
+    return;
+  }
+
+  // Only the points moved: refit the existing tree.
+  if ( (this->Tree != nullptr) && this->OnlyPointsModified() )
+  {
+    vtkDebugMacro( << "Refitting BVH cell locator" );
+    this->Refit();
+    return;
+  }
+
+  vtkIdType numCells;
+  if ( (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+  {
+    vtkErrorMacro( << "No cells to build");
+    return;
+  }
+  if ( numCells >= VTK_INT_MAX )
+  {
+    vtkErrorMacro( << "Too many cells (" << numCells << ") for a BVH cell locator");
+    return;
+  }
+
+  this->FreeSearchStructure();
+  vtkBVHTree *tree = new vtkBVHTree;
+
+  // Cell bounds and centroids
+  std::vector<double> centroids(3*numCells);
+  tree->ComputeCellBounds(this->DataSet, centroids.data());
+  tree->CellIds.resize(numCells);
+  std::iota(tree->CellIds.begin(), tree->CellIds.end(), 0);
+
+  BVHBuilder builder;
+  builder.CellBounds = tree->CellBounds.data();
+  builder.Centroids = centroids.data();
+  builder.CellIds = tree->CellIds.data();
+  builder.NumberOfBins = this->NumberOfBins;
+  builder.LeafSize = this->NumberOfCellsPerNode;
+
+  // Split the top levels of the tree, binning the cells in parallel, until
+  // there are enough subtrees to keep all threads busy.
+  struct Task
+  {
+    size_t Node;
+    vtkIdType Begin;
+    vtkIdType End;
+    int Depth;
+  };
+  std::vector<vtkBVHTree::Node>& nodes = tree->Nodes;
+  nodes.resize(1);
+  std::vector<Task> pending(1, Task{ 0, 0, numCells, 0 });
+  std::vector<Task> subtrees;
+  size_t numTasks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  while ( !pending.empty() && pending.size() + subtrees.size() < numTasks )
+  {
+    std::vector<Task> next;
+    for (const Task& task : pending)
+    {
+      if ( task.End - task.Begin <= VTK_BVH_PARALLEL_CELLS )
+      {
+        subtrees.push_back(task);
+        continue;
+      }
+      RangeBounds bounds = builder.ComputeBounds(task.Begin, task.End, true);
+      SetNodeBounds(nodes[task.Node], bounds.Node);
+      vtkIdType mid = builder.Split(task.Begin, task.End, bounds.Centroid, task.Depth, true);
+      if ( mid < 0 )
+      {
+        nodes[task.Node].Index = static_cast<vtkTypeInt32>(task.Begin);
+        nodes[task.Node].Count = static_cast<vtkTypeInt32>(task.End - task.Begin);
+        continue;
+      }
+      size_t left = nodes.size();
+      nodes.resize(left + 2);
+      nodes[task.Node].Index = static_cast<vtkTypeInt32>(left);
+      nodes[task.Node].Count = 0;
+      next.push_back(Task{ left, task.Begin, mid, task.Depth + 1 });
+      next.push_back(Task{ left + 1, mid, task.End, task.Depth + 1 });
+    }
+    pending.swap(next);
+  }
+  subtrees.insert(subtrees.end(), pending.begin(), pending.end());
+
+  // Build the subtrees concurrently, each into its own array of nodes.
+  std::vector<std::vector<vtkBVHTree::Node> > subtreeNodes(subtrees.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [&builder, &subtrees, &subtreeNodes](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const Task& task = subtrees[i];
+      subtreeNodes[i].resize(1);
+      builder.BuildSubtree(subtreeNodes[i], 0, task.Begin, task.End, task.Depth);
+    }
+  });
+
+  // Stitch the subtrees into the tree: the subtree root replaces the task
+  // node and the other nodes are appended.
+  for (size_t i = 0; i < subtrees.size(); ++i)
+  {
+    const std::vector<vtkBVHTree::Node>& local = subtreeNodes[i];
+    vtkTypeInt32 base = static_cast<vtkTypeInt32>(nodes.size()) - 1;
+    auto relocate = [base](vtkBVHTree::Node node)
+    {
+      if ( node.Count == 0 )
+      {
+        node.Index += base;
+      }
+      return node;
+    };
+    nodes[subtrees[i].Node] = relocate(local[0]);
+    for (size_t j = 1; j < local.size(); ++j)
+    {
+      nodes.push_back(relocate(local[j]));
+    }
+  }
+
+  this->Tree = tree;
+  this->RecordDataSetTopology();
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::Refit()
+{
+  if ( !this->Tree || !this->DataSet ||
+       this->DataSet->GetNumberOfCells() != this->Tree->GetNumberOfCells() )
+  {
+    this->BuildLocator();
+    return;
+  }
+
+  this->Tree->ComputeCellBounds(this->DataSet, nullptr);
+  this->Tree->RefitNodes();
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::
+FindCell(double x[3], double tol2, vtkGenericCell *cell,
+         double pcoords[3], double *weights)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return -1;
+  }
+  return this->Tree->FindCell(this->DataSet, x, tol2, cell, pcoords, weights);
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHCellLocator::
+IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                  double &t, double x[3], double pcoords[3],
+                  int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    cellId = -1;
+    return 0;
+  }
+  return this->Tree->IntersectWithLine(
+    this->DataSet, p1, p2, tol, t, x, pcoords, subId, cellId, cell);
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHCellLocator::
+IntersectWithLine(const double p1[3], const double p2[3],
+                  vtkPoints *points, vtkIdList *cellIds)
+{
+  this->BuildLocator();
+  if ( points )
+  {
+    points->Reset();
+  }
+  if ( cellIds )
+  {
+    cellIds->Reset();
+  }
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  struct Hit
+  {
+    double T;
+    double X[3];
+    vtkIdType CellId;
+  };
+  std::vector<Hit> hits;
+  double dir[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double tol = this->Tolerance, tEnter, pcoords[3];
+  int subId;
+  const vtkBVHTree *tree = this->Tree;
+  vtkDataSet *ds = this->DataSet;
+  vtkGenericCell *cell = this->GenericCell;
+
+  auto nodeTest = [&](const float b[6])
+  {
+    return SegmentHitsBox(b, p1, dir, tol, 1.0, tEnter);
+  };
+  auto visit = [&](vtkIdType cellId)
+  {
+    Hit hit;
+    if ( SegmentHitsBox(&tree->CellBounds[6*cellId], p1, dir, tol, 1.0, tEnter) )
+    {
+      ds->GetCell(cellId, cell);
+      if ( cell->IntersectWithLine(p1, p2, tol, hit.T, hit.X, pcoords, subId) )
+      {
+        hit.CellId = cellId;
+        hits.push_back(hit);
+      }
+    }
+    return false;
+  };
+  tree->Traverse(nodeTest, visit);
+
+  std::sort(hits.begin(), hits.end(),
+    [](const Hit& a, const Hit& b) { return a.T < b.T; });
+  for (const Hit& hit : hits)
+  {
+    if ( points )
+    {
+      points->InsertNextPoint(hit.X);
+    }
+    if ( cellIds )
+    {
+      cellIds->InsertNextId(hit.CellId);
+    }
+  }
+  return hits.empty() ? 0 : 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell *cell,
+                 vtkIdType &cellId, int &subId, double& dist2)
+{
+  this->BuildLocator();
+  int inside;
+  cellId = -1;
+  if ( this->Tree )
+  {
+    this->Tree->FindClosestPoint(this->DataSet, x, VTK_DOUBLE_MAX, closestPoint,
+                                 cell, cellId, subId, dist2, inside);
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::
+FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+                             vtkGenericCell *cell, vtkIdType &cellId,
+                             int &subId, double& dist2, int &inside)
+{
+  this->BuildLocator();
+  cellId = -1;
+  inside = 0;
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+  return this->Tree->FindClosestPoint(this->DataSet, x, radius*radius, closestPoint,
+                                      cell, cellId, subId, dist2, inside) ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  this->BuildLocator();
+  cells->Reset();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+  const vtkBVHTree *tree = this->Tree;
+  auto nodeTest = [bbox](const float b[6]) { return BoxesOverlap(b, bbox); };
+  auto visit = [tree, bbox, cells](vtkIdType cellId)
+  {
+    if ( BoxesOverlap(&tree->CellBounds[6*cellId], bbox) )
+    {
+      cells->InsertNextId(cellId);
+    }
+    return false;
+  };
+  tree->Traverse(nodeTest, visit);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindCellsAlongLine(const double p1[3], const double p2[3], double tol, vtkIdList *cells)
+{
+  this->BuildLocator();
+  cells->Reset();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+  const vtkBVHTree *tree = this->Tree;
+  double dir[3] = { p2[0] - p1[0], p2[1] - p1[1], p2[2] - p1[2] };
+  double tEnter;
+  auto nodeTest = [&](const float b[6])
+  {
+    return SegmentHitsBox(b, p1, dir, tol, 1.0, tEnter);
+  };
+  auto visit = [&](vtkIdType cellId)
+  {
+    if ( SegmentHitsBox(&tree->CellBounds[6*cellId], p1, dir, tol, 1.0, tEnter) )
+    {
+      cells->InsertNextId(cellId);
+    }
+    return false;
+  };
+  tree->Traverse(nodeTest, visit);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+BatchIntersectWithLine(vtkPoints *p1, vtkPoints *p2, double tol,
+                       vtkIdTypeArray *cellIds, vtkDoubleArray *t, vtkPoints *x)
+{
+  vtkIdType numLines = p1->GetNumberOfPoints();
+  if ( p2->GetNumberOfPoints() != numLines )
+  {
+    vtkErrorMacro( << "BatchIntersectWithLine: p1 and p2 must have the same number of points.");
+    return;
+  }
+  this->BuildLocator();
+
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfValues(numLines);
+  vtkIdType *ids = cellIds->GetPointer(0);
+  double *tPtr = nullptr, *xPtr = nullptr;
+  if ( t )
+  {
+    t->SetNumberOfComponents(1);
+    t->SetNumberOfValues(numLines);
+    tPtr = t->GetPointer(0);
+  }
+  if ( x )
+  {
+    x->SetDataTypeToDouble();
+    x->SetNumberOfPoints(numLines);
+    xPtr = static_cast<vtkDoubleArray*>(x->GetData())->GetPointer(0);
+  }
+
+  const vtkBVHTree *tree = this->Tree;
+  vtkDataSet *ds = this->DataSet;
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPTools::For(0, numLines, [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = cells.Local();
+    double a[3], b[3], tHit = 0.0, xHit[3] = { 0.0, 0.0, 0.0 }, pcoords[3];
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      p1->GetPoint(i, a);
+      p2->GetPoint(i, b);
+      ids[i] = -1;
+      if ( tree )
+      {
+        tree->IntersectWithLine(ds, a, b, tol, tHit, xHit, pcoords, subId, ids[i], cell);
+      }
+      if ( ids[i] < 0 )
+      {
+        tHit = VTK_DOUBLE_MAX;
+        xHit[0] = xHit[1] = xHit[2] = 0.0;
+      }
+      if ( tPtr )
+      {
+        tPtr[i] = tHit;
+      }
+      if ( xPtr )
+      {
+        std::copy(xHit, xHit + 3, xPtr + 3*i);
+      }
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+BatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *cellIds,
+                      vtkPoints *closestPoints, vtkDoubleArray *dist2)
+{
+  this->BuildLocator();
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfValues(numQueries);
+  vtkIdType *ids = cellIds->GetPointer(0);
+  double *d2Ptr = nullptr, *xPtr = nullptr;
+  if ( dist2 )
+  {
+    dist2->SetNumberOfComponents(1);
+    dist2->SetNumberOfValues(numQueries);
+    d2Ptr = dist2->GetPointer(0);
+  }
+  if ( closestPoints )
+  {
+    closestPoints->SetDataTypeToDouble();
+    closestPoints->SetNumberOfPoints(numQueries);
+    xPtr = static_cast<vtkDoubleArray*>(closestPoints->GetData())->GetPointer(0);
+  }
+
+  const vtkBVHTree *tree = this->Tree;
+  vtkDataSet *ds = this->DataSet;
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = cells.Local();
+    double x[3], closest[3] = { 0.0, 0.0, 0.0 }, d2 = VTK_DOUBLE_MAX;
+    int subId, inside;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      queries->GetPoint(i, x);
+      ids[i] = -1;
+      if ( tree )
+      {
+        tree->FindClosestPoint(ds, x, VTK_DOUBLE_MAX, closest, cell, ids[i], subId, d2, inside);
+      }
+      if ( ids[i] < 0 )
+      {
+        d2 = VTK_DOUBLE_MAX;
+        closest[0] = closest[1] = closest[2] = 0.0;
+      }
+      if ( d2Ptr )
+      {
+        d2Ptr[i] = d2;
+      }
+      if ( xPtr )
+      {
+        std::copy(closest, closest + 3, xPtr + 3*i);
+      }
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+BatchFindCell(vtkPoints *queries, vtkIdTypeArray *cellIds, double tol2)
+{
+  this->BuildLocator();
+  vtkIdType numQueries = queries->GetNumberOfPoints();
+
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfValues(numQueries);
+  vtkIdType *ids = cellIds->GetPointer(0);
+
+  const vtkBVHTree *tree = this->Tree;
+  vtkDataSet *ds = this->DataSet;
+  vtkSMPThreadLocalObject<vtkGenericCell> cells;
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell *cell = cells.Local();
+    double x[3], pcoords[3], weights[VTK_CELL_SIZE];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      queries->GetPoint(i, x);
+      ids[i] = tree ? tree->FindCell(ds, x, tol2, cell, pcoords, weights) : -1;
+    }
+  });
+}
+
+//-----------------------------------------------------------------------------
+// Produce a polygonal representation of the nodes at the given level of the
+// tree, or of the leaves above that level.
+void vtkBVHCellLocator::
+GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->SetDataTypeToFloat();
+  vtkCellArray *polys = vtkCellArray::New();
+
+  const std::vector<vtkBVHTree::Node>& nodes = this->Tree->Nodes;
+  std::vector<std::pair<vtkTypeInt32, int> > stack(1, std::make_pair(0, 0));
+  while ( !stack.empty() )
+  {
+    std::pair<vtkTypeInt32, int> item = stack.back();
+    stack.pop_back();
+    const vtkBVHTree::Node& node = nodes[item.first];
+    if ( item.second == level || node.Count > 0 )
+    {
+      AddBox(node.Bounds, pts, polys);
+    }
+    else
+    {
+      stack.push_back(std::make_pair(node.Index + 1, item.second + 1));
+      stack.push_back(std::make_pair(node.Index, item.second + 1));
+    }
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+  pts->Delete();
+  polys->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number Of Nodes: " << this->GetNumberOfNodes() << "\n";
+}
@@ -0,0 +1,263 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator that organizes the
+ * cells of a dataset in a binary tree of axis-aligned bounding boxes (a
+ * bounding volume hierarchy, or BVH). Unlike the uniform bins of
+ * vtkStaticCellLocator, the tree adapts to the distribution of the cells,
+ * so it performs well on meshes whose cell sizes vary over several orders
+ * of magnitude, as is typical of CAD-derived meshes.
+ *
+ * The tree is built top-down with the surface area heuristic evaluated over
+ * NumberOfBins bins per axis. Construction is threaded via vtkSMPTools: the
+ * cell bounds and the binning of the top levels are computed in parallel,
+ * and the resulting subtrees are then built concurrently. Each node uses 32
+ * bytes (single precision bounds that conservatively enclose the cells,
+ * plus two 32-bit integers), so datasets are limited to VTK_INT_MAX cells.
+ *
+ * Besides the vtkAbstractCellLocator queries, batched versions of
+ * IntersectWithLine(), FindClosestPoint() and FindCell() process many
+ * queries in parallel. Refit() updates the bounds of the tree after the
+ * points of the dataset moved but its cells did not change, which is much
+ * cheaper than rebuilding the locator for deforming meshes. With
+ * IncrementalUpdateOn(), BuildLocator() refits the tree automatically when
+ * only the points of the dataset were modified.
+ *
+ * @warning
+ * This class *always* caches cell bounds. The query methods are thread safe
+ * if BuildLocator() is directly or indirectly called from a single thread
+ * first and a separate vtkGenericCell is used by each thread.
+ *
+ * @sa
+ * vtkLocator vtkAbstractCellLocator vtkStaticCellLocator vtkCellLocator
+ * vtkCellTreeLocator vtkModifiedBSPTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+class vtkDoubleArray;
+class vtkIdTypeArray;
+
+// Forward declaration for PIMPL
+struct vtkBVHTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator *New();
+  vtkTypeMacro(vtkBVHCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set the number of bins per axis used to evaluate the surface area
+   * heuristic when splitting a node. More bins give better trees at a
+   * higher construction cost. The default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins,int,2,256);
+  vtkGetMacro(NumberOfBins,int);
+  //@}
+
+  /**
+   * Test a point to find if it is inside a cell. Returns the cellId if inside
+   * or -1 if not. As with vtkDataSet::FindCell(), the point must also be
+   * within the squared distance tol2 of the cell, which matters for cells
+   * that are not 3D.
+   */
+  vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                     double pcoords[3], double *weights) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindCell(double x[3]) override
+    { return this->Superclass::FindCell(x); }
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The closest intersection to p1 is returned. The cell is
+   * returned as a cell id and as a generic cell.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                        double& t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId,
+                        vtkGenericCell *cell) override;
+
+  /**
+   * Return all the intersection points of the finite line with the cells,
+   * sorted by increasing distance from p1, and the corresponding cell ids.
+   * Either points or cellIds may be nullptr. Returns 1 if there is at least
+   * one intersection.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3],
+                        vtkPoints *points, vtkIdList *cellIds) override;
+
+  //@{
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                        double& t, double x[3], double pcoords[3], int &subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                        double &t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+  //@}
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The closest point is somewhere on a cell, it need not be one of the
+   * vertices of the cell.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkGenericCell *cell, vtkIdType &cellId,
+                        int &subId, double& dist2) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkIdType &cellId, int &subId, double& dist2) override
+  {
+    this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. Returns 1 if a point is found within the radius,
+   * and inside is set to 1 if x lies inside the returned cell.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell, vtkIdType &cellId,
+                                         int &subId, double& dist2,
+                                         int &inside) override;
+
+  //@{
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cellId, subId, dist2);
+  }
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell, vtkIdType &cellId,
+                                         int &subId, double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cell, cellId, subId, dist2);
+  }
+  //@}
+
+  /**
+   * Return a list of unique cell ids whose bounds intersect the given
+   * bounding box. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double *bbox, vtkIdList *cells) override;
+
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounds, enlarged by the tolerance, are crossed
+   * by the line. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsAlongLine(const double p1[3], const double p2[3],
+                          double tolerance, vtkIdList *cells) override;
+
+  //@{
+  /**
+   * Batched queries, processed in parallel with vtkSMPTools. Each query i
+   * gives the same result as the corresponding single query.
+   * BatchIntersectWithLine() intersects the segments (p1[i],p2[i]) and
+   * returns the id of the closest intersected cell, or -1, and optionally the
+   * parametric coordinate t and the position x of the intersection.
+   * BatchFindClosestPoint() returns the id of the closest cell to each query
+   * point, and optionally the closest point and its squared distance.
+   * BatchFindCell() returns the id of the cell containing each query point
+   * within the squared tolerance tol2, as FindCell() does, or -1.
+   * For the queries that find no cell, t and dist2 are set to
+   * VTK_DOUBLE_MAX and the positions to (0,0,0).
+   */
+  void BatchIntersectWithLine(vtkPoints *p1, vtkPoints *p2, double tol,
+                              vtkIdTypeArray *cellIds, vtkDoubleArray *t = nullptr,
+                              vtkPoints *x = nullptr);
+  void BatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *cellIds,
+                             vtkPoints *closestPoints = nullptr,
+                             vtkDoubleArray *dist2 = nullptr);
+  void BatchFindCell(vtkPoints *queries, vtkIdTypeArray *cellIds,
+                     double tol2 = 0.0);
+  //@}
+
+  /**
+   * Update the bounds of the tree after the points of the dataset moved,
+   * keeping the tree topology. The cells of the dataset must be the same as
+   * when the locator was built; if the number of cells changed, the locator
+   * is rebuilt instead. The quality of the tree degrades as the mesh
+   * deforms, so it should be rebuilt from time to time.
+   */
+  void Refit();
+
+  /**
+   * Return the number of nodes of the tree. This has meaning only after the
+   * locator is built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() outputs
+   * the bounding boxes of the nodes at the given level of the tree, or of
+   * the leaves above that level.
+   */
+  void GenerateRepresentation(int level, vtkPolyData *pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  int NumberOfBins;
+  vtkBVHTree *Tree;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
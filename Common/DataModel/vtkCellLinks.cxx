@@ -16,12 +16,140 @@
 
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
-#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLinks);
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Thread-safe access to the points of a cell for the various kinds of
+// datasets.
+struct UnstructuredGridCells
+{
+  const vtkUnstructuredGrid *Grid;
+
+  void operator()(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts) const
+  {
+    this->Grid->GetCellPoints(cellId, npts, pts);
+  }
+};
+
+struct PolyDataCells
+{
+  vtkPolyData *PolyData;
+
+  void operator()(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts) const
+  {
+    vtkIdType *cellPts;
+    this->PolyData->GetCellPoints(cellId, npts, cellPts);
+    pts = cellPts;
+  }
+};
+
+// Cells stored as (npts, id0, id1, ...) at known locations of an array.
+struct ConnectivityCells
+{
+  const vtkIdType *Connectivity;
+  const vtkIdType *Locations;
+
+  void operator()(vtkIdType cellId, vtkIdType& npts, const vtkIdType* &pts) const
+  {
+    const vtkIdType *cell = this->Connectivity + this->Locations[cellId];
+    npts = cell[0];
+    pts = cell + 1;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Build the links of numPts points with a parallel counting sort, in the
+// layout of vtkStaticCellLinksTemplate: the lists of all points are stored
+// contiguously in the returned pool, and each link points to its run. The
+// uses of each point are counted with atomics; after a prefix sum the
+// counters become insertion cursors. Cells are inserted concurrently, so the
+// lists are sorted afterwards to give the same result as a serial build.
+template <typename TCellPoints>
+vtkIdType *BuildPool(vtkIdType numPts, vtkIdType numCells,
+                     const TCellPoints& cellPoints, vtkCellLinks::Link *links,
+                     vtkIdType& poolSize)
+{
+  std::unique_ptr<std::atomic<vtkIdType>[]> counters(
+    new std::atomic<vtkIdType>[numPts + 1]());
+  std::atomic<vtkIdType> *cursor = counters.get();
+
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      cellPoints(cellId, npts, pts);
+      for (vtkIdType i=0; i < npts; ++i)
+      {
+        cursor[pts[i]].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  poolSize = 0;
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    vtkIdType ncells = cursor[ptId].load(std::memory_order_relaxed);
+    links[ptId].ncells = ncells;
+    cursor[ptId].store(poolSize, std::memory_order_relaxed);
+    poolSize += ncells;
+  }
+
+  vtkIdType *pool = new vtkIdType[poolSize > 0 ? poolSize : 1];
+  for (vtkIdType ptId=0; ptId < numPts; ++ptId)
+  {
+    links[ptId].cells = (links[ptId].ncells > 0 ?
+      pool + cursor[ptId].load(std::memory_order_relaxed) : nullptr);
+  }
+
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      cellPoints(cellId, npts, pts);
+      for (vtkIdType i=0; i < npts; ++i)
+      {
+        pool[cursor[pts[i]].fetch_add(1, std::memory_order_relaxed)] = cellId;
+      }
+    }
+  });
+
+  vtkSMPTools::For(0, numPts, [links](vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId )
+    {
+      vtkIdType *begin = links[ptId].cells;
+      vtkIdType *end = begin + links[ptId].ncells;
+      if ( !std::is_sorted(begin, end) )
+      {
+        std::sort(begin, end);
+      }
+    }
+  });
+
+  return pool;
+}
+
+} // anonymous namespace
+
 //----------------------------------------------------------------------------
 vtkCellLinks::~vtkCellLinks()
 {
@@ -30,17 +158,29 @@ vtkCellLinks::~vtkCellLinks()
 
 //----------------------------------------------------------------------------
 void vtkCellLinks::Initialize()
+{
+  this->FreeCellLists();
+  delete [] this->Array;
+  this->Array = nullptr;
+  this->Size = 0;
+  this->MaxId = -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLinks::FreeCellLists()
 {
   if ( this->Array != nullptr )
   {
     for (vtkIdType i=0; i<=this->MaxId; i++)
     {
-      delete [] this->Array[i].cells;
+      this->FreeCellList(this->Array[i].cells);
+      this->Array[i].cells = nullptr;
+      this->Array[i].ncells = 0;
     }
-
-    delete [] this->Array;
-    this->Array = nullptr;
   }
+  delete [] this->Pool;
+  this->Pool = nullptr;
+  this->PoolSize = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -48,6 +188,7 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
 {
   static vtkCellLinks::Link linkInit = {0,nullptr};
 
+  this->FreeCellLists();
   this->Size = sz;
   delete [] this->Array;
   this->Array = new vtkCellLinks::Link[sz];
@@ -60,16 +201,6 @@ void vtkCellLinks::Allocate(vtkIdType sz, vtkIdType ext)
   }
 }
 
-//----------------------------------------------------------------------------
-// Allocate memory for the list of lists of cell ids.
-void vtkCellLinks::AllocateLinks(vtkIdType n)
-{
-  for (vtkIdType i=0; i < n; i++)
-  {
-    this->Array[i].cells = new vtkIdType[this->Array[i].ncells];
-  }
-}
-
 //----------------------------------------------------------------------------
 // Reclaim any unused memory.
 void vtkCellLinks::Squeeze()
@@ -124,83 +255,47 @@ vtkCellLinks::Link *vtkCellLinks::Resize(vtkIdType sz)
 }
 
 //----------------------------------------------------------------------------
-// Build the link list array.
+// Build the link list array. Polydata and unstructured grids are traversed
+// in parallel; the cells of other datasets are first gathered serially.
 void vtkCellLinks::BuildLinks(vtkDataSet *data)
 {
   vtkIdType numPts = data->GetNumberOfPoints();
   vtkIdType numCells = data->GetNumberOfCells();
-  int j;
-  vtkIdType cellId;
-  vtkIdType *linkLoc;
 
-  // fill out lists with number of references to cells
-  linkLoc = new vtkIdType[numPts];
-  memset(linkLoc, 0, numPts*sizeof(vtkIdType));
+  this->FreeCellLists();
+  if ( this->Size < numPts )
+  {
+    this->Resize(numPts);
+  }
 
-  // Use fast path if polydata
+  vtkUnstructuredGrid *ugrid = vtkUnstructuredGrid::SafeDownCast(data);
   if ( data->GetDataObjectType() == VTK_POLY_DATA )
   {
-    vtkIdType *pts, npts;
-
-    vtkPolyData *pdata = static_cast<vtkPolyData *>(data);
-    // traverse data to determine number of uses of each point
-    for (cellId=0; cellId < numCells; cellId++)
-    {
-      pdata->GetCellPoints(cellId, npts, pts);
-      for (j=0; j < npts; j++)
-      {
-        this->IncrementLinkCount(pts[j]);
-      }
-    }
-
-    // now allocate storage for the links
-    this->AllocateLinks(numPts);
-    this->MaxId = numPts - 1;
-
-    for (cellId=0; cellId < numCells; cellId++)
-    {
-      pdata->GetCellPoints(cellId, npts, pts);
-      for (j=0; j < npts; j++)
-      {
-        this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
-      }
-    }
+    PolyDataCells cells = { static_cast<vtkPolyData *>(data) };
+    this->Pool = BuildPool(numPts, numCells, cells, this->Array, this->PoolSize);
+  }
+  else if ( ugrid && ugrid->GetCells() )
+  {
+    UnstructuredGridCells cells = { ugrid };
+    this->Pool = BuildPool(numPts, numCells, cells, this->Array, this->PoolSize);
   }
-
   else //any other type of dataset
   {
-    vtkIdType numberOfPoints, ptId;
-    vtkGenericCell *cell=vtkGenericCell::New();
-
-    // traverse data to determine number of uses of each point
-    for (cellId=0; cellId < numCells; cellId++)
-    {
-      data->GetCell(cellId,cell);
-      numberOfPoints = cell->GetNumberOfPoints();
-      for (j=0; j < numberOfPoints; j++)
-      {
-        this->IncrementLinkCount(cell->PointIds->GetId(j));
-      }
-    }
-
-    // now allocate storage for the links
-    this->AllocateLinks(numPts);
-    this->MaxId = numPts - 1;
-
-    for (cellId=0; cellId < numCells; cellId++)
+    std::vector<vtkIdType> connectivity;
+    std::vector<vtkIdType> locations(numCells);
+    vtkNew<vtkIdList> ptIds;
+    for (vtkIdType cellId=0; cellId < numCells; cellId++)
     {
-      data->GetCell(cellId,cell);
-      numberOfPoints = cell->GetNumberOfPoints();
-      for (j=0; j < numberOfPoints; j++)
-      {
-        ptId = cell->PointIds->GetId(j);
-        this->InsertCellReference(ptId, (linkLoc[ptId])++, cellId);
-      }
+      data->GetCellPoints(cellId, ptIds);
+      locations[cellId] = static_cast<vtkIdType>(connectivity.size());
+      connectivity.push_back(ptIds->GetNumberOfIds());
+      connectivity.insert(connectivity.end(), ptIds->GetPointer(0),
+                          ptIds->GetPointer(0) + ptIds->GetNumberOfIds());
     }
-    cell->Delete();
-  }//end else
-
-  delete [] linkLoc;
+    ConnectivityCells cells = { connectivity.data(), locations.data() };
+    this->Pool = BuildPool(numPts, numCells, cells, this->Array, this->PoolSize);
+  }
+  this->MaxId = numPts - 1;
 }
 
 //----------------------------------------------------------------------------
@@ -208,41 +303,26 @@ void vtkCellLinks::BuildLinks(vtkDataSet *data)
 void vtkCellLinks::BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity)
 {
   vtkIdType numPts = data->GetNumberOfPoints();
-  vtkIdType j, cellId;
-  vtkIdType *linkLoc;
-  vtkIdType npts=0;
-  vtkIdType *pts=nullptr;
-  vtkIdType loc = Connectivity->GetTraversalLocation();
-
-  // traverse data to determine number of uses of each point
-  for (Connectivity->InitTraversal();
-       Connectivity->GetNextCell(npts,pts);)
+  vtkIdType numCells = Connectivity->GetNumberOfCells();
+  const vtkIdType *conn = Connectivity->GetPointer();
+
+  this->FreeCellLists();
+  if ( this->Size < numPts )
   {
-    for (j=0; j < npts; j++)
-    {
-      this->IncrementLinkCount(pts[j]);
-    }
+    this->Resize(numPts);
   }
 
-  // now allocate storage for the links
-  this->AllocateLinks(numPts);
-  this->MaxId = numPts - 1;
-
-  // fill out lists with references to cells
-  linkLoc = new vtkIdType[numPts];
-  memset(linkLoc, 0, numPts*sizeof(vtkIdType));
-
-  cellId = 0;
-  for (Connectivity->InitTraversal();
-       Connectivity->GetNextCell(npts,pts); cellId++)
+  // Locate the cells so that they can be traversed in parallel
+  std::vector<vtkIdType> locations(numCells);
+  for (vtkIdType cellId=0, loc=0; cellId < numCells; cellId++)
   {
-    for (j=0; j < npts; j++)
-    {
-      this->InsertCellReference(pts[j], (linkLoc[pts[j]])++, cellId);
-    }
+    locations[cellId] = loc;
+    loc += conn[loc] + 1;
   }
-  delete [] linkLoc;
-  Connectivity->SetTraversalLocation(loc);
+
+  ConnectivityCells cells = { conn, locations.data() };
+  this->Pool = BuildPool(numPts, numCells, cells, this->Array, this->PoolSize);
+  this->MaxId = numPts - 1;
 }
 
 //----------------------------------------------------------------------------
@@ -276,10 +356,31 @@ unsigned long vtkCellLinks::GetActualMemorySize()
 }
 
 //----------------------------------------------------------------------------
+// The lists of the source are copied into a single pool.
 void vtkCellLinks::DeepCopy(vtkCellLinks *src)
 {
   this->Allocate(src->Size, src->Extend);
-  memcpy(this->Array, src->Array, this->Size * sizeof(vtkCellLinks::Link));
+
+  vtkIdType poolSize = 0;
+  for (vtkIdType ptId=0; ptId <= src->MaxId; ptId++)
+  {
+    poolSize += src->Array[ptId].ncells;
+  }
+  this->Pool = new vtkIdType[poolSize > 0 ? poolSize : 1];
+  this->PoolSize = poolSize;
+
+  vtkIdType *cells = this->Pool;
+  for (vtkIdType ptId=0; ptId <= src->MaxId; ptId++)
+  {
+    vtkIdType ncells = src->Array[ptId].ncells;
+    this->Array[ptId].ncells = ncells;
+    if ( ncells > 0 )
+    {
+      memcpy(cells, src->Array[ptId].cells, ncells * sizeof(vtkIdType));
+      this->Array[ptId].cells = cells;
+      cells += ncells;
+    }
+  }
   this->MaxId = src->MaxId;
 }
 
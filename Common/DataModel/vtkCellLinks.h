@@ -22,11 +22,18 @@
  * using the point. The information provided by this object can be used to
  * determine neighbors and construct other local topological information.
  *
+ * BuildLinks() uses the same layout as vtkStaticCellLinks: the lists of all
+ * points are stored contiguously in a single array, ordered by point id, and
+ * are built in parallel with a counting sort. The lists of each point are
+ * sorted by increasing cell id. Lists that are later edited (e.g., with
+ * ResizeCellList() or InsertNextPoint()) are moved to their own storage, so
+ * that incremental construction keeps working after BuildLinks().
+ *
  * @warning
  * Note that this class is designed to support incremental link construction.
- * More efficient cell links structures can be built with vtkStaticCellLinks
- * (and vtkStaticCellLinksTemplate). However these other classes are typically
- * meant for one-time (static) construction.
+ * When the links are not edited, vtkStaticCellLinks (and
+ * vtkStaticCellLinksTemplate) use less memory since they need no per-point
+ * Link structure.
  *
  * @sa
  * vtkCellArray vtkCellTypes vtkStaticCellLinks vtkStaticCellLinksTemplate
@@ -67,7 +74,8 @@ public:
   void BuildLinks(vtkDataSet *data) override;
 
   /**
-   * Build the link list array with a provided connectivity array.
+   * Build the link list array with a provided connectivity array. Cell ids
+   * are the positions of the cells in the connectivity array.
    */
   void BuildLinks(vtkDataSet *data, vtkCellArray *Connectivity);
 
@@ -162,7 +170,8 @@ public:
   void DeepCopy(vtkCellLinks *src);
 
 protected:
-  vtkCellLinks():Array(nullptr),Size(0),MaxId(-1),Extend(1000) {}
+  vtkCellLinks():Array(nullptr),Size(0),MaxId(-1),Extend(1000),
+                 Pool(nullptr),PoolSize(0) {}
   ~vtkCellLinks() override;
 
   /**
@@ -170,19 +179,30 @@ protected:
    */
   void IncrementLinkCount(vtkIdType ptId) { this->Array[ptId].ncells++;};
 
-  void AllocateLinks(vtkIdType n);
-
   /**
    * Insert a cell id into the list of cells using the point.
    */
   void InsertCellReference(vtkIdType ptId, vtkIdType pos,
                            vtkIdType cellId);
 
+  /**
+   * Release a list of cell ids, unless it is stored in the pool filled by
+   * BuildLinks().
+   */
+  void FreeCellList(vtkIdType *cells);
+
+  /**
+   * Release the lists of all points and the pool.
+   */
+  void FreeCellLists();
+
   Link *Array;   // pointer to data
   vtkIdType Size;       // allocated size of data
   vtkIdType MaxId;     // maximum index inserted thus far
   vtkIdType Extend;     // grow array by this point
   Link *Resize(vtkIdType sz);  // function to resize data
+  vtkIdType *Pool;      // lists of cell ids filled by BuildLinks()
+  vtkIdType PoolSize;   // number of cell ids in the pool
 
 private:
   vtkCellLinks(const vtkCellLinks&) = delete;
@@ -197,11 +217,21 @@ inline void vtkCellLinks::InsertCellReference(vtkIdType ptId,
   this->Array[ptId].cells[pos] = cellId;
 }
 
+//----------------------------------------------------------------------------
+inline void vtkCellLinks::FreeCellList(vtkIdType *cells)
+{
+  if ( !this->Pool || cells < this->Pool ||
+       cells >= this->Pool + this->PoolSize )
+  {
+    delete [] cells;
+  }
+}
+
 //----------------------------------------------------------------------------
 inline void vtkCellLinks::DeletePoint(vtkIdType ptId)
 {
   this->Array[ptId].ncells = 0;
-  delete [] this->Array[ptId].cells;
+  this->FreeCellList(this->Array[ptId].cells);
   this->Array[ptId].cells = nullptr;
 }
 
@@ -248,7 +278,7 @@ inline void vtkCellLinks::ResizeCellList(vtkIdType ptId, int size)
   cells = new vtkIdType[newSize];
   memcpy(cells, this->Array[ptId].cells,
          this->Array[ptId].ncells*sizeof(vtkIdType));
-  delete [] this->Array[ptId].cells;
+  this->FreeCellList(this->Array[ptId].cells);
   this->Array[ptId].cells = cells;
 }
 
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCompositeDataSetSMPTools.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCompositeDataSetSMPTools
+ * @brief   process the leaves of composite datasets in parallel
+ *
+ * vtkCompositeDataSetSMPTools lets filters that handle composite data
+ * natively run their per-block work through vtkSMPTools instead of a serial
+ * iterator loop. Leaves are first gathered into a flat list in iterator
+ * order with GetLeaves(); the work is then done in parallel on leaf indices,
+ * and GenerateLeaves() assembles the results into the output composite
+ * dataset serially, so vtkMultiBlockDataSet, vtkPartitionedDataSet and other
+ * composite datasets never get modified from more than one thread.
+ *
+ * A typical composite-aware filter becomes:
+ *
+ * @code
+ * output->CopyStructure(input);
+ * std::vector<vtkDataObject*> leaves =
+ *   vtkCompositeDataSetSMPTools::GetLeaves(input, output);
+ * MyBlockWorker worker(leaves); // vtkSmartPointer<vtkDataObject> operator()(vtkIdType)
+ * vtkCompositeDataSetSMPTools::GenerateLeaves(output, worker);
+ * @endcode
+ *
+ * As with vtkSMPTools::For, the functor may define Initialize() and Reduce()
+ * to manage thread local state. The work done for a leaf must not modify
+ * objects shared with other leaves.
+ *
+ * @sa
+ * vtkSMPTools vtkThreadedCompositeDataPipeline
+ */
+
+#ifndef vtkCompositeDataSetSMPTools_h
+#define vtkCompositeDataSetSMPTools_h
+
+#include "vtkCompositeDataIterator.h"
+#include "vtkCompositeDataSet.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <vector>
+
+#ifndef __VTK_WRAP__
+
+namespace vtk
+{
+namespace detail
+{
+
+// Runs the user functor for a range of leaves and keeps its results,
+// forwarding Initialize()/Reduce() when the functor defines them.
+template <typename Functor, bool Init = vtk::detail::smp::vtkSMPTools_Has_Initialize<Functor>::value>
+struct CompositeDataSetLeafWorker
+{
+  Functor& F;
+  std::vector<vtkSmartPointer<vtkDataObject> >& Results;
+
+  CompositeDataSetLeafWorker(Functor& f, std::vector<vtkSmartPointer<vtkDataObject> >& results)
+    : F(f)
+    , Results(results)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType leaf = begin; leaf < end; ++leaf)
+    {
+      this->Results[leaf] = this->F(leaf);
+    }
+  }
+};
+
+template <typename Functor>
+struct CompositeDataSetLeafWorker<Functor, true> : public CompositeDataSetLeafWorker<Functor, false>
+{
+  CompositeDataSetLeafWorker(Functor& f, std::vector<vtkSmartPointer<vtkDataObject> >& results)
+    : CompositeDataSetLeafWorker<Functor, false>(f, results)
+  {
+  }
+
+  void Initialize() { this->F.Initialize(); }
+  void Reduce() { this->F.Reduce(); }
+};
+
+} // end namespace detail
+} // end namespace vtk
+
+class vtkCompositeDataSetSMPTools
+{
+public:
+  /**
+   * Return the leaves of @a cds at the positions of the leaves of
+   * @a structure (or of @a cds itself if @a structure is nullptr), in
+   * iterator order. Positions holding no data are returned as nullptr, so the
+   * indices in the returned vector match the leaf indices used by
+   * GenerateLeaves() when @a structure is the output.
+   */
+  static std::vector<vtkDataObject*> GetLeaves(
+    vtkCompositeDataSet* cds, vtkCompositeDataSet* structure = nullptr)
+  {
+    std::vector<vtkDataObject*> leaves;
+    if (!cds)
+    {
+      return leaves;
+    }
+    structure = structure ? structure : cds;
+
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(structure->NewIterator());
+    iter->SkipEmptyNodesOff();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      leaves.push_back(structure == cds ? iter->GetCurrentDataObject() : cds->GetDataSet(iter));
+    }
+    return leaves;
+  }
+
+  /**
+   * Call `vtkSmartPointer<vtkDataObject> functor(vtkIdType leafIndex)` for
+   * the leaf indices 0 to @a numberOfLeaves - 1 in parallel, and return the
+   * results by leaf index. Use this instead of GenerateLeaves() when the
+   * results must be inserted into the output in a serial pass of the filter.
+   */
+  template <typename Functor>
+  static std::vector<vtkSmartPointer<vtkDataObject> > ProcessLeaves(
+    vtkIdType numberOfLeaves, Functor& functor)
+  {
+    std::vector<vtkSmartPointer<vtkDataObject> > results(numberOfLeaves);
+    vtk::detail::CompositeDataSetLeafWorker<Functor> worker(functor, results);
+    vtkSMPTools::For(0, numberOfLeaves, worker);
+    return results;
+  }
+
+  /**
+   * Fill the leaves of @a output, which must already have its final
+   * structure (see vtkCompositeDataSet::CopyStructure), by calling
+   * `vtkSmartPointer<vtkDataObject> functor(vtkIdType leafIndex)` for every
+   * leaf in parallel. Leaf indices follow the order of GetLeaves(). Results
+   * are inserted into @a output after all leaves have been processed; a
+   * nullptr result leaves the position empty.
+   */
+  template <typename Functor>
+  static void GenerateLeaves(vtkCompositeDataSet* output, Functor& functor)
+  {
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(output->NewIterator());
+    iter->SkipEmptyNodesOff();
+
+    vtkIdType numberOfLeaves = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      ++numberOfLeaves;
+    }
+
+    std::vector<vtkSmartPointer<vtkDataObject> > results =
+      vtkCompositeDataSetSMPTools::ProcessLeaves(numberOfLeaves, functor);
+
+    vtkIdType leaf = 0;
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem(), ++leaf)
+    {
+      if (results[leaf])
+      {
+        output->SetDataSet(iter, results[leaf]);
+      }
+    }
+  }
+};
+
+#endif // __VTK_WRAP__
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCompositeDataSetSMPTools.h
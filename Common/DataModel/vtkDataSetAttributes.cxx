@@ -23,10 +23,12 @@
 #include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
+#include "vtkIndexedArray.h"
 #include "vtkInformation.h"
 #include "vtkIntArray.h"
 #include "vtkLongArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkShortArray.h"
 #include "vtkStructuredExtent.h"
@@ -868,6 +870,81 @@ void vtkDataSetAttributes::CopyData(vtkDataSetAttributes *fromPd,
   }
 }
 
+//--------------------------------------------------------------------------
+namespace
+{
+// Views are made of arrays whose memory can be shared with their snapshot
+// only; the tuples of the others are copied.
+template <typename ValueType>
+vtkDataArray* NewIndexedView(vtkDataArray* source, vtkIdList* ids)
+{
+  if (!vtkArrayDownCast<vtkAOSDataArrayTemplate<ValueType> >(source) &&
+    !vtkArrayDownCast<vtkSOADataArrayTemplate<ValueType> >(source))
+  {
+    return nullptr;
+  }
+  vtkIndexedArray<ValueType>* view = vtkIndexedArray<ValueType>::New();
+  view->ConstructBackend(ids, source);
+  view->SetNumberOfComponents(source->GetNumberOfComponents());
+  view->SetNumberOfTuples(ids->GetNumberOfIds());
+  view->MaterializeOnModified(source);
+  return view;
+}
+}
+
+//--------------------------------------------------------------------------
+void vtkDataSetAttributes::CopyDataAsViews(vtkDataSetAttributes *fromPd,
+                                           vtkIdList *fromIds)
+{
+  // The views share a copy of the ids, which the caller may reuse.
+  vtkNew<vtkIdList> ids;
+  ids->DeepCopy(fromIds);
+  vtkNew<vtkIdList> toIds;
+
+  for (int i = this->RequiredArrays.BeginIndex(); !this->RequiredArrays.End();
+       i = this->RequiredArrays.NextIndex())
+  {
+    vtkAbstractArray* fromArray = fromPd->Data[i];
+    vtkAbstractArray* toArray = this->Data[this->TargetIndices[i]];
+    vtkDataArray* fromDA = vtkArrayDownCast<vtkDataArray>(fromArray);
+    int attributeType = fromPd->IsArrayAnAttribute(i);
+    const char* name = fromArray->GetName();
+    vtkDataArray* view = nullptr;
+    if (fromDA && attributeType != GLOBALIDS && attributeType != PEDIGREEIDS &&
+      !(name && strcmp(name, vtkDataSetAttributes::GhostArrayName()) == 0))
+    {
+      switch (fromDA->GetDataType())
+      {
+        vtkTemplateMacro(view = NewIndexedView<VTK_TT>(fromDA, ids));
+      }
+    }
+    if (!view)
+    {
+      if (toIds->GetNumberOfIds() == 0)
+      {
+        toIds->SetNumberOfIds(ids->GetNumberOfIds());
+        for (vtkIdType id = 0; id < ids->GetNumberOfIds(); ++id)
+        {
+          toIds->SetId(id, id);
+        }
+      }
+      this->CopyTuples(fromArray, toArray, ids, toIds);
+      continue;
+    }
+
+    view->SetName(toArray->GetName());
+    view->CopyComponentNames(toArray);
+    if (toArray->HasInformation())
+    {
+      view->CopyInformation(toArray->GetInformation(), /*deep=*/1);
+    }
+    view->SetLookupTable(fromDA->GetLookupTable());
+    // Same index, so that the array keeps its attribute type.
+    this->SetArray(this->TargetIndices[i], view);
+    view->Delete();
+  }
+}
+
 //--------------------------------------------------------------------------
 void vtkDataSetAttributes::CopyAllocate(vtkDataSetAttributes* pd,
                                         vtkIdType sze, vtkIdType ext,
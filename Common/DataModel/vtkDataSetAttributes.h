@@ -473,6 +473,22 @@ public:
   void CopyData(vtkDataSetAttributes *fromPd, vtkIdType dstStart, vtkIdType n,
                 vtkIdType srcStart);
 
+  /**
+   * Like CopyData(fromPd, fromIds, toIds) with toIds = 0, 1, ... but without
+   * copying values: the data arrays are replaced by vtkIndexedArray views of
+   * the arrays of fromPd, which read the tuples of the source arrays on
+   * demand. The views share the memory of the source arrays, keep their
+   * values when a source array stops sharing it (see vtkIndexedArray), and
+   * copy their values when they are written into or when their source array
+   * is modified. In-place writes into a source array that do not detach its
+   * memory are seen by its views. The ghost, global ids and pedigree ids arrays, the arrays
+   * that are not vtkDataArrays, as algorithms down cast them to their
+   * concrete types, and the arrays that are neither AOS nor SOA arrays are
+   * copied. Make sure that CopyAllocate()
+   * has been invoked with fromPd before using this method.
+   */
+  void CopyDataAsViews(vtkDataSetAttributes *fromPd, vtkIdList *fromIds);
+
   //@{
   /**
    * Copy a tuple (or set of tuples) of data from one data array to another.
@@ -19,8 +19,14 @@
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 
+#include <set>
+
 vtkStandardNewMacro(vtkFieldData);
 
+class vtkFieldData::vtkWriteArrays : public std::set<vtkAbstractArray*>
+{
+};
+
 //----------------------------------------------------------------------------
 vtkFieldData::BasicIterator::BasicIterator(const int* list,
                                            unsigned int listSize)
@@ -188,6 +194,7 @@ vtkFieldData::vtkFieldData()
   this->NumberOfArrays = 0;
   this->Data = nullptr;
   this->NumberOfActiveArrays = 0;
+  this->WriteArrays = new vtkWriteArrays;
 
   this->CopyFieldFlags = nullptr;
   this->NumberOfFieldFlags = 0;
@@ -203,6 +210,15 @@ vtkFieldData::~vtkFieldData()
 {
   this->Initialize();
   this->ClearFieldFlags();
+  delete this->WriteArrays;
+}
+
+//----------------------------------------------------------------------------
+// Forget that an array released by this field data was returned by
+// GetArrayForWrite(), as another array may be allocated at its address.
+void vtkFieldData::ReleaseArray(vtkAbstractArray* array)
+{
+  this->WriteArrays->erase(array);
 }
 
 //----------------------------------------------------------------------------
@@ -211,6 +227,7 @@ void vtkFieldData::InitializeFields()
 {
   int i;
 
+  this->WriteArrays->clear();
   if ( this->Data )
   {
     for ( i=0; i<this->GetNumberOfArrays(); i++ )
@@ -315,6 +332,7 @@ void vtkFieldData::AllocateArrays(int num)
     {
       if( this->Data[i] )
       {
+        this->ReleaseArray(this->Data[i]);
         this->Data[i]->UnRegister(this);
       }
     }
@@ -371,6 +389,7 @@ void vtkFieldData::SetArray(int i, vtkAbstractArray *data)
   {
     if ( this->Data[i] != nullptr )
     {
+      this->ReleaseArray(this->Data[i]);
       this->Data[i]->UnRegister(this);
     }
     this->Data[i] = data;
@@ -390,6 +409,45 @@ vtkDataArray *vtkFieldData::GetArray(int i)
   return vtkArrayDownCast<vtkDataArray>(this->GetAbstractArray(i));
 }
 
+//----------------------------------------------------------------------------
+vtkDataArray *vtkFieldData::GetArrayForWrite(int i)
+{
+  vtkDataArray* array = this->GetArray(i);
+  if (!array)
+  {
+    return nullptr;
+  }
+
+  // Another owner may be holding the same array instance (e.g. the input of
+  // a filter after PassData()); give this field data its own instance, which
+  // shares the memory of the array until it is detached below.
+  if (array->GetReferenceCount() > 1 &&
+    this->WriteArrays->find(array) == this->WriteArrays->end())
+  {
+    vtkDataArray* copy = array->NewInstance();
+    copy->ShallowCopy(array);
+    if (array->HasInformation())
+    {
+      copy->CopyInformation(array->GetInformation(), /*deep=*/1);
+    }
+    this->SetArray(i, copy);
+    copy->Delete();
+    array = copy;
+  }
+  this->WriteArrays->insert(array);
+
+  // The values are copied only if the memory is still shared.
+  array->DetachStorage();
+  return array;
+}
+
+//----------------------------------------------------------------------------
+vtkDataArray *vtkFieldData::GetArrayForWrite(const char *arrayName)
+{
+  int i;
+  return this->GetArray(arrayName, i) ? this->GetArrayForWrite(i) : nullptr;
+}
+
 //----------------------------------------------------------------------------
 // Return the ith array in the field. A nullptr is returned if the index i is out
 // if range.
@@ -569,6 +627,7 @@ void vtkFieldData::RemoveArray(int index)
   {
     return;
   }
+  this->ReleaseArray(this->Data[index]);
   this->Data[index]->UnRegister(this);
   this->Data[index] = nullptr;
   this->NumberOfActiveArrays--;
@@ -153,6 +153,29 @@ public:
   }
   //@}
 
+  //@{
+  /**
+   * Return the ith array (or the array with the given name) ready to be
+   * modified without affecting any other field data. Arrays passed with
+   * ShallowCopy() or PassData() are shared with the source field data; in that
+   * case the array is replaced in this field data by a new instance with its
+   * own copy of the values, while the other arrays remain shared. This lets a
+   * filter shallow copy all of its input attributes and pay for a copy of the
+   * single array it modifies only. Returns nullptr if the array does not
+   * exist or is not a vtkDataArray.
+   *
+   * The values are copied only when their memory is still shared after the
+   * array was replaced (see vtkDataArray::HasSharedStorage()), e.g. with the
+   * array of the source field data, and not when the instance merely has
+   * other references. An array is replaced at most once: the arrays
+   * returned by this method are returned again, memory copied if it was
+   * shared since, for as long as they stay in this field data. Pointers
+   * previously obtained with GetArray() refer to the replaced array.
+   */
+  vtkDataArray *GetArrayForWrite(int i);
+  vtkDataArray *GetArrayForWrite(const char *arrayName);
+  //@}
+
   /**
    * Returns the ith array in the field. Unlike GetArray(), this method returns
    * a vtkAbstractArray and can be used to access any array type. A nullptr is
@@ -394,6 +417,11 @@ private:
   vtkFieldData(const vtkFieldData&) = delete;
   void operator=(const vtkFieldData&) = delete;
 
+  // The arrays returned by GetArrayForWrite(), which are not replaced again.
+  class vtkWriteArrays;
+  vtkWriteArrays* WriteArrays;
+  void ReleaseArray(vtkAbstractArray* array);
+
 public:
 
   class VTKCOMMONDATAMODEL_EXPORT BasicIterator
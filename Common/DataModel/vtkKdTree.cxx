@@ -36,6 +36,7 @@
 #include "vtkPoints.h"
 #include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
+#include "vtkLocatorFile.h"
 #include "vtkPointSet.h"
 #include "vtkImageData.h"
 #include "vtkTimerLog.h"
@@ -48,6 +49,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace
 {
@@ -1886,6 +1888,212 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints **ptArrays, int numPtArrays)
   TIMERDONE("Build tree");
 }
 
+//----------------------------------------------------------------------------
+// Search structure files hold the parameters of the tree, its nodes in
+// preorder, and the locator points and ids.
+namespace
+{
+struct KdTreeParameters
+{
+  vtkTypeInt32 NumberOfPoints;
+  vtkTypeInt32 NumberOfNodes;
+  double FudgeFactor;
+  double MaxWidth;
+};
+
+struct KdNodeRecord
+{
+  double Bounds[6];
+  double DataBounds[6];
+  vtkTypeInt32 Dim;
+  vtkTypeInt32 NumberOfPoints;
+  vtkTypeInt32 IsLeaf;
+  vtkTypeInt32 Padding;
+};
+
+void SaveNodes(vtkKdNode *kd, std::vector<KdNodeRecord>& records)
+{
+  KdNodeRecord record;
+  kd->GetBounds(record.Bounds);
+  kd->GetDataBounds(record.DataBounds);
+  record.Dim = kd->GetDim();
+  record.NumberOfPoints = kd->GetNumberOfPoints();
+  record.IsLeaf = (kd->GetLeft() == nullptr);
+  record.Padding = 0;
+  records.push_back(record);
+  if (!record.IsLeaf)
+  {
+    SaveNodes(kd->GetLeft(), records);
+    SaveNodes(kd->GetRight(), records);
+  }
+}
+
+// Deeper trees are considered corrupted. This bounds the recursion below,
+// which happens before the checksum of the file can be verified.
+const int KD_MAX_RESTORED_DEPTH = 100;
+
+// Returns false if the records do not describe a tree
+bool RestoreNodes(vtkKdNode *kd, const std::vector<KdNodeRecord>& records,
+                  size_t& next, int depth)
+{
+  const KdNodeRecord& record = records[next++];
+  kd->SetBounds(record.Bounds);
+  kd->SetDataBounds(record.DataBounds[0], record.DataBounds[1], record.DataBounds[2],
+                    record.DataBounds[3], record.DataBounds[4], record.DataBounds[5]);
+  kd->SetDim(record.Dim);
+  kd->SetNumberOfPoints(record.NumberOfPoints);
+  if (record.IsLeaf)
+  {
+    return true;
+  }
+  if (depth >= KD_MAX_RESTORED_DEPTH || next + 2 > records.size())
+  {
+    return false;
+  }
+  vtkKdNode *left = vtkKdNode::New();
+  vtkKdNode *right = vtkKdNode::New();
+  kd->AddChildNodes(left, right);
+  return RestoreNodes(left, records, next, depth + 1) &&
+    next < records.size() && RestoreNodes(right, records, next, depth + 1);
+}
+
+// Checksum of the points converted to float, as they are stored by the tree
+vtkTypeUInt64 PointsChecksum(const float *points, int numPoints)
+{
+  return vtkLocatorFile::Checksum(points, 3 * static_cast<size_t>(numPoints) * sizeof(float));
+}
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::WriteSearchStructure(const char *fileName)
+{
+  if (!this->Top || !this->LocatorPoints || !this->LocatorIds)
+  {
+    vtkErrorMacro(<< "WriteSearchStructure - the tree must be built with BuildLocatorFromPoints");
+    return 0;
+  }
+
+  // Points in their original order
+  int numPoints = this->NumberOfLocatorPoints;
+  std::vector<float> points(3 * static_cast<size_t>(numPoints));
+  for (int i = 0; i < numPoints; i++)
+  {
+    std::copy(this->LocatorPoints + 3*i, this->LocatorPoints + 3*i + 3,
+              points.begin() + 3 * static_cast<size_t>(this->LocatorIds[i]));
+  }
+
+  std::vector<KdNodeRecord> nodes;
+  SaveNodes(this->Top, nodes);
+  KdTreeParameters params;
+  params.NumberOfPoints = numPoints;
+  params.NumberOfNodes = static_cast<vtkTypeInt32>(nodes.size());
+  params.FudgeFactor = this->FudgeFactor;
+  params.MaxWidth = this->MaxWidth;
+
+  vtkLocatorFile file;
+  bool success =
+    file.OpenForWriting(fileName, vtkLocatorFile::KD_TREE, PointsChecksum(points.data(), numPoints)) &&
+    file.Write(&params, sizeof(params)) &&
+    file.Write(nodes.data(), nodes.size() * sizeof(KdNodeRecord)) &&
+    file.Write(this->LocatorPoints, 3 * static_cast<size_t>(numPoints) * sizeof(float)) &&
+    file.Write(this->LocatorIds, numPoints * sizeof(int));
+  success = file.Close() && success;
+  if (!success)
+  {
+    vtkErrorMacro(<< "Could not write search structure to " << (fileName ? fileName : "(null)"));
+  }
+  return success ? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkKdTree::ReadSearchStructure(const char *fileName, vtkPoints *ptArray)
+{
+  vtkIdType numPoints = ptArray ? ptArray->GetNumberOfPoints() : 0;
+  if (numPoints < 1 || numPoints >= VTK_INT_MAX)
+  {
+    vtkErrorMacro(<< "ReadSearchStructure - invalid number of points");
+    return 0;
+  }
+
+  // Convert the points to float as BuildLocatorFromPoints() does
+  std::vector<float> converted;
+  const float *points;
+  if (ptArray->GetDataType() == VTK_FLOAT)
+  {
+    points = static_cast<float*>(ptArray->GetVoidPointer(0));
+  }
+  else
+  {
+    converted.resize(3 * numPoints);
+    for (vtkIdType i = 0; i < numPoints; i++)
+    {
+      double *pt = ptArray->GetPoint(i);
+      converted[3*i] = static_cast<float>(pt[0]);
+      converted[3*i+1] = static_cast<float>(pt[1]);
+      converted[3*i+2] = static_cast<float>(pt[2]);
+    }
+    points = converted.data();
+  }
+
+  vtkLocatorFile file;
+  KdTreeParameters params;
+  if (!file.OpenForReading(fileName, vtkLocatorFile::KD_TREE,
+        PointsChecksum(points, static_cast<int>(numPoints))) ||
+      !file.Read(&params, sizeof(params)) || params.NumberOfPoints != numPoints ||
+      params.NumberOfNodes < 1)
+  {
+    vtkDebugMacro(<< "No valid search structure for these points in "
+                  << (fileName ? fileName : "(null)"));
+    return 0;
+  }
+
+  std::vector<KdNodeRecord> nodes(params.NumberOfNodes);
+  if (!file.Read(nodes.data(), nodes.size() * sizeof(KdNodeRecord)))
+  {
+    vtkWarningMacro(<< "Corrupted search structure in " << fileName);
+    return 0;
+  }
+
+  this->FreeSearchStructure();
+  this->ClearLastBuildCache();
+
+  this->LocatorPoints = new float [3 * numPoints];
+  this->LocatorIds = new int [numPoints];
+  this->Top = vtkKdNode::New();
+  size_t next = 0;
+  if (!RestoreNodes(this->Top, nodes, next, 0) || next != nodes.size() ||
+      !file.Read(this->LocatorPoints, 3 * numPoints * sizeof(float)) ||
+      !file.Read(this->LocatorIds, numPoints * sizeof(int)) || !file.Validate())
+  {
+    vtkWarningMacro(<< "Corrupted search structure in " << fileName);
+    this->FreeSearchStructure();
+    return 0;
+  }
+
+  this->FudgeFactor = params.FudgeFactor;
+  this->MaxWidth = static_cast<float>(params.MaxWidth);
+  this->SetActualLevel();
+  this->BuildRegionList();
+
+  this->LocatorRegionLocation = new int [this->NumberOfRegions];
+  int idx = 0;
+  for (int reg = 0; reg < this->NumberOfRegions; reg++)
+  {
+    this->LocatorRegionLocation[reg] = idx;
+    idx += this->RegionList[reg]->GetNumberOfPoints();
+  }
+  this->NumberOfLocatorPoints = idx;
+  if (idx != numPoints)
+  {
+    vtkWarningMacro(<< "Corrupted search structure in " << fileName);
+    this->FreeSearchStructure();
+    return 0;
+  }
+
+  this->SetCalculator(this->Top);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 // Query functions subsequent to BuildLocatorFromPoints,
 // relating to duplicate and nearby points
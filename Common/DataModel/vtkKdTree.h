@@ -485,6 +485,21 @@ public:
   void BuildLocatorFromPoints(vtkPoints **ptArray, int numPtArrays);
   //@}
 
+  //@{
+  /**
+   * Save the k-d tree built by BuildLocatorFromPoints() to a binary file, or
+   * load it instead of calling BuildLocatorFromPoints() with the same points,
+   * which is much faster for large point sets that are loaded repeatedly.
+   * The file records a checksum of the points: ReadSearchStructure() succeeds
+   * only if the file was written for the same points, on a platform with the
+   * same byte order, and its content is intact. Both methods return 1 on
+   * success and 0 otherwise. k-d trees built from datasets (with cell lists)
+   * are not supported.
+   */
+  int WriteSearchStructure(const char *fileName);
+  int ReadSearchStructure(const char *fileName, vtkPoints *ptArray);
+  //@}
+
   /**
    * This call returns a mapping from the original point IDs supplied
    * to BuildLocatorFromPoints to a subset of those IDs that is unique
@@ -0,0 +1,322 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLocatorFile.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkLocatorFile.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <cstring>
+#include <vector>
+
+namespace
+{
+
+const char FILE_MAGIC[8] = { 'V', 'T', 'K', 'L', 'O', 'C', 'T', 'R' };
+const vtkTypeUInt32 FILE_VERSION = 1;
+const vtkTypeUInt32 FILE_BYTE_ORDER = 0x01020304;
+const vtkTypeUInt64 SEED = 0xcbf29ce484222325ULL;
+const size_t BLOCK_SIZE = 1 << 20;
+
+inline vtkTypeUInt64 Mix(vtkTypeUInt64 h, vtkTypeUInt64 v)
+{
+  v *= 0x9e3779b97f4a7c15ULL;
+  v ^= v >> 32;
+  h ^= v;
+  h *= 0xff51afd7ed558ccdULL;
+  return h ^ (h >> 29);
+}
+
+vtkTypeUInt64 BlockChecksum(const unsigned char *data, size_t numBytes)
+{
+  vtkTypeUInt64 h = SEED;
+  size_t i = 0;
+  for ( ; i + 8 <= numBytes; i += 8 )
+  {
+    vtkTypeUInt64 word;
+    memcpy(&word, data + i, 8);
+    h = Mix(h, word);
+  }
+  if ( i < numBytes )
+  {
+    vtkTypeUInt64 word = 0;
+    memcpy(&word, data + i, numBytes - i);
+    h = Mix(h, word);
+  }
+  return Mix(h, numBytes);
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkLocatorFile::vtkLocatorFile()
+  : File(nullptr)
+  , Writing(false)
+  , Failed(false)
+  , PayloadSize(0)
+  , PayloadChecksum(SEED)
+{
+  memset(&this->FileHeader, 0, sizeof(Header));
+}
+
+//----------------------------------------------------------------------------
+vtkLocatorFile::~vtkLocatorFile()
+{
+  if ( this->File )
+  {
+    fclose(this->File);
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkLocatorFile::Checksum(const void *data, size_t numBytes)
+{
+  const unsigned char *bytes = static_cast<const unsigned char*>(data);
+  vtkIdType numBlocks = static_cast<vtkIdType>((numBytes + BLOCK_SIZE - 1) / BLOCK_SIZE);
+  std::vector<vtkTypeUInt64> blocks(numBlocks);
+  vtkTypeUInt64 *blockChecksums = blocks.data();
+  vtkSMPTools::For(0, numBlocks, [bytes, numBytes, blockChecksums](vtkIdType begin, vtkIdType end)
+  {
+    for ( vtkIdType b = begin; b < end; ++b )
+    {
+      size_t offset = static_cast<size_t>(b) * BLOCK_SIZE;
+      size_t size = (numBytes - offset < BLOCK_SIZE ? numBytes - offset : BLOCK_SIZE);
+      blockChecksums[b] = BlockChecksum(bytes + offset, size);
+    }
+  });
+
+  vtkTypeUInt64 h = SEED;
+  for ( vtkTypeUInt64 blockChecksum : blocks )
+  {
+    h = Mix(h, blockChecksum);
+  }
+  return Mix(h, numBytes);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkLocatorFile::DataSetChecksum(vtkDataSet *ds, bool withCells)
+{
+  vtkIdType numPts = ds->GetNumberOfPoints();
+  vtkTypeUInt64 h = Mix(SEED, static_cast<vtkTypeUInt64>(numPts));
+
+  vtkPointSet *ps = vtkPointSet::SafeDownCast(ds);
+  if ( ps && ps->GetPoints() )
+  {
+    vtkDataArray *pts = ps->GetPoints()->GetData();
+    h = Mix(h, static_cast<vtkTypeUInt64>(pts->GetDataType()));
+    h = Mix(h, vtkLocatorFile::Checksum(pts->GetVoidPointer(0),
+      static_cast<size_t>(3 * numPts) * pts->GetDataTypeSize()));
+  }
+  else
+  {
+    // Implicit points (image data, rectilinear grids)
+    std::vector<double> pts(3 * numPts);
+    for ( vtkIdType ptId = 0; ptId < numPts; ++ptId )
+    {
+      ds->GetPoint(ptId, pts.data() + 3 * ptId);
+    }
+    h = Mix(h, vtkLocatorFile::Checksum(pts.data(), pts.size() * sizeof(double)));
+  }
+
+  if ( !withCells )
+  {
+    return h;
+  }
+
+  vtkIdType numCells = ds->GetNumberOfCells();
+  h = Mix(h, static_cast<vtkTypeUInt64>(numCells));
+  vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(ds);
+  vtkPolyData *pd = vtkPolyData::SafeDownCast(ds);
+  if ( ug && ug->GetCells() &&
+       (ug->GetSingleCellType() != VTK_EMPTY_CELL || ug->GetCellTypesArray()) )
+  {
+    vtkIdTypeArray *conn = ug->GetCells()->GetData();
+    h = Mix(h, vtkLocatorFile::Checksum(conn->GetPointer(0),
+      conn->GetNumberOfValues() * sizeof(vtkIdType)));
+    if ( ug->GetSingleCellType() != VTK_EMPTY_CELL )
+    {
+      // Hash the implied types array, without creating it in the grid.
+      std::vector<unsigned char> types(numCells,
+        static_cast<unsigned char>(ug->GetSingleCellType()));
+      h = Mix(h, vtkLocatorFile::Checksum(types.data(), types.size()));
+    }
+    else
+    {
+      vtkUnsignedCharArray *types = ug->GetCellTypesArray();
+      h = Mix(h, vtkLocatorFile::Checksum(types->GetPointer(0),
+        types->GetNumberOfValues()));
+    }
+    if ( ug->GetFaces() )
+    {
+      h = Mix(h, vtkLocatorFile::Checksum(ug->GetFaces()->GetPointer(0),
+        ug->GetFaces()->GetNumberOfValues() * sizeof(vtkIdType)));
+    }
+  }
+  else if ( pd )
+  {
+    vtkCellArray *cells[4] = { pd->GetVerts(), pd->GetLines(), pd->GetPolys(), pd->GetStrips() };
+    for ( int i = 0; i < 4; ++i )
+    {
+      vtkIdTypeArray *conn = cells[i] ? cells[i]->GetData() : nullptr;
+      vtkIdType size = conn ? conn->GetNumberOfValues() : 0;
+      h = Mix(h, size > 0 ? vtkLocatorFile::Checksum(conn->GetPointer(0),
+        size * sizeof(vtkIdType)) : 0);
+    }
+  }
+  else
+  {
+    // Other datasets: hash the type and points of every cell
+    std::vector<vtkIdType> topology;
+    vtkNew<vtkIdList> ptIds;
+    for ( vtkIdType cellId = 0; cellId < numCells; ++cellId )
+    {
+      ds->GetCellPoints(cellId, ptIds);
+      topology.push_back(ds->GetCellType(cellId));
+      topology.push_back(ptIds->GetNumberOfIds());
+      topology.insert(topology.end(), ptIds->GetPointer(0),
+                      ptIds->GetPointer(0) + ptIds->GetNumberOfIds());
+    }
+    h = Mix(h, vtkLocatorFile::Checksum(topology.data(),
+      topology.size() * sizeof(vtkIdType)));
+  }
+  return h;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::OpenForWriting(const char *fileName, int locatorType,
+                                    vtkTypeUInt64 dataSetChecksum)
+{
+  if ( !fileName || !(this->File = vtksys::SystemTools::Fopen(fileName, "wb")) )
+  {
+    return false;
+  }
+  this->Writing = true;
+
+  // The magic is written by Close(), so that incomplete files are rejected.
+  Header& header = this->FileHeader;
+  header.Version = FILE_VERSION;
+  header.ByteOrder = FILE_BYTE_ORDER;
+  header.LocatorType = static_cast<vtkTypeUInt32>(locatorType);
+  header.IdTypeSize = static_cast<vtkTypeUInt32>(sizeof(vtkIdType));
+  header.DataSetChecksum = dataSetChecksum;
+  this->Failed = fwrite(&header, sizeof(Header), 1, this->File) != 1;
+  return !this->Failed;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::Write(const void *data, size_t numBytes)
+{
+  if ( !this->File || !this->Writing || this->Failed )
+  {
+    return false;
+  }
+  if ( numBytes > 0 && fwrite(data, 1, numBytes, this->File) != numBytes )
+  {
+    this->Failed = true;
+    return false;
+  }
+  this->Accumulate(data, numBytes);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::Close()
+{
+  if ( !this->File || !this->Writing )
+  {
+    return false;
+  }
+  if ( !this->Failed )
+  {
+    Header& header = this->FileHeader;
+    memcpy(header.Magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.PayloadSize = this->PayloadSize;
+    header.PayloadChecksum = this->PayloadChecksum;
+    this->Failed = fseek(this->File, 0, SEEK_SET) != 0 ||
+      fwrite(&header, sizeof(Header), 1, this->File) != 1;
+  }
+  this->Failed = (fclose(this->File) != 0) || this->Failed;
+  this->File = nullptr;
+  return !this->Failed;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::OpenForReading(const char *fileName, int locatorType,
+                                    vtkTypeUInt64 dataSetChecksum)
+{
+  if ( !fileName || !(this->File = vtksys::SystemTools::Fopen(fileName, "rb")) )
+  {
+    return false;
+  }
+  this->Writing = false;
+
+  Header& header = this->FileHeader;
+  if ( fread(&header, sizeof(Header), 1, this->File) != 1 ||
+       memcmp(header.Magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+       header.Version != FILE_VERSION || header.ByteOrder != FILE_BYTE_ORDER ||
+       header.LocatorType != static_cast<vtkTypeUInt32>(locatorType) ||
+       header.IdTypeSize != sizeof(vtkIdType) ||
+       header.DataSetChecksum != dataSetChecksum )
+  {
+    this->Failed = true;
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::Read(void *data, size_t numBytes)
+{
+  if ( !this->File || this->Writing || this->Failed ||
+       this->PayloadSize + numBytes > this->FileHeader.PayloadSize )
+  {
+    this->Failed = true;
+    return false;
+  }
+  if ( numBytes > 0 && fread(data, 1, numBytes, this->File) != numBytes )
+  {
+    this->Failed = true;
+    return false;
+  }
+  this->Accumulate(data, numBytes);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLocatorFile::Validate()
+{
+  return this->File && !this->Writing && !this->Failed &&
+    this->PayloadSize == this->FileHeader.PayloadSize &&
+    this->PayloadChecksum == this->FileHeader.PayloadChecksum;
+}
+
+//----------------------------------------------------------------------------
+void vtkLocatorFile::Accumulate(const void *data, size_t numBytes)
+{
+  this->PayloadChecksum = Mix(this->PayloadChecksum, vtkLocatorFile::Checksum(data, numBytes));
+  this->PayloadSize += numBytes;
+}
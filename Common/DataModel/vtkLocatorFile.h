@@ -0,0 +1,120 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLocatorFile.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLocatorFile
+ * @brief   binary file holding the search structure of a locator
+ *
+ * vtkLocatorFile is an internal helper used by the locators that can save
+ * their search structure and load it back instead of rebuilding it
+ * (vtkStaticPointLocator, vtkStaticCellLocator and vtkKdTree). A file starts
+ * with a fixed header recording the kind of locator, a checksum of the
+ * dataset the structure was built for and the size and checksum of the
+ * payload. The payload is the raw, native byte order content of the
+ * locator arrays, written and read in bulk directly from and into the
+ * arrays of the locator.
+ *
+ * Reading a file fails if its header does not match the expected locator
+ * and dataset checksum. Validate() must be called once the whole payload
+ * has been read to check its size and checksum; the payload must be read
+ * with the same sequence of Read() sizes as it was written.
+ */
+
+#ifndef vtkLocatorFile_h
+#define vtkLocatorFile_h
+
+#include "vtkType.h"
+
+#include <cstdio>
+#include <cstddef>
+
+class vtkDataSet;
+
+class vtkLocatorFile
+{
+public:
+  enum LocatorType
+  {
+    STATIC_POINT_LOCATOR = 1,
+    STATIC_CELL_LOCATOR = 2,
+    KD_TREE = 3
+  };
+
+  vtkLocatorFile();
+  ~vtkLocatorFile();
+
+  /**
+   * Return a 64-bit checksum of a block of memory. It is computed in parallel
+   * but does not depend on the number of threads.
+   */
+  static vtkTypeUInt64 Checksum(const void *data, size_t numBytes);
+
+  /**
+   * Return a checksum of the points of a dataset and, optionally, of its
+   * cells. Points are hashed in their native precision.
+   */
+  static vtkTypeUInt64 DataSetChecksum(vtkDataSet *ds, bool withCells);
+
+  //@{
+  /**
+   * Create a file and write data to it. Close() completes the header and
+   * returns false if any write failed.
+   */
+  bool OpenForWriting(const char *fileName, int locatorType,
+                      vtkTypeUInt64 dataSetChecksum);
+  bool Write(const void *data, size_t numBytes);
+  bool Close();
+  //@}
+
+  //@{
+  /**
+   * Open a file for a given locator type and dataset, and read data from it.
+   * OpenForReading() returns false if the file does not exist or was written
+   * for another locator type, dataset or platform. Validate() returns true
+   * if the whole payload was read and its checksum is correct.
+   */
+  bool OpenForReading(const char *fileName, int locatorType,
+                      vtkTypeUInt64 dataSetChecksum);
+  bool Read(void *data, size_t numBytes);
+  bool Validate();
+  //@}
+
+private:
+  struct Header
+  {
+    char Magic[8];
+    vtkTypeUInt32 Version;
+    vtkTypeUInt32 ByteOrder;
+    vtkTypeUInt32 LocatorType;
+    vtkTypeUInt32 IdTypeSize;
+    vtkTypeUInt64 DataSetChecksum;
+    vtkTypeUInt64 PayloadSize;
+    vtkTypeUInt64 PayloadChecksum;
+  };
+
+  void Accumulate(const void *data, size_t numBytes);
+
+  Header FileHeader;
+  FILE *File;
+  bool Writing;
+  bool Failed;
+  vtkTypeUInt64 PayloadSize;
+  vtkTypeUInt64 PayloadChecksum;
+
+  vtkLocatorFile(const vtkLocatorFile&) = delete;
+  void operator=(const vtkLocatorFile&) = delete;
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkLocatorFile.h
@@ -281,6 +281,11 @@ public:
    */
   void DeleteLinks();
 
+  /**
+   * Return the upward links built by BuildLinks(), or nullptr.
+   */
+  vtkCellLinks *GetCellLinks() { return this->Links; }
+
   /**
    * Special (efficient) operations on poly data. Use carefully.
    */
@@ -27,10 +27,14 @@
 #include "vtkPlane.h"
 #include "vtkBox.h"
 #include "vtkBoundingBox.h"
+#include "vtkLocatorFile.h"
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkStaticCellLocator);
 
 //----------------------------------------------------------------------------
@@ -204,6 +208,47 @@ struct vtkCellBinner
     this->NumFragments = total;
   }
 
+  // Recompute the cell bounds after the points of the dataset moved, and
+  // return (sorted) the cells whose footprint in the bins changed.
+  void UpdateCellBounds(std::vector<vtkIdType>& moved)
+  {
+    // Trigger the non-thread safe initialization of GetCellBounds().
+    double bds[6];
+    this->DataSet->GetCellBounds(0,bds);
+
+    vtkSMPThreadLocal<std::vector<vtkIdType>> localMoved;
+    vtkSMPTools::For(0, this->NumCells, [this,&localMoved](vtkIdType cellId, vtkIdType endCellId)
+    {
+      std::vector<vtkIdType>& cellIds = localMoved.Local();
+      double *oldBds = this->CellBounds + cellId*6;
+      double newBds[6];
+      for ( ; cellId < endCellId; ++cellId, oldBds+=6 )
+      {
+        this->DataSet->GetCellBounds(cellId,newBds);
+        int oldMin[3], oldMax[3], newMin[3], newMax[3];
+        const double oldXMin[3] = {oldBds[0], oldBds[2], oldBds[4]};
+        const double oldXMax[3] = {oldBds[1], oldBds[3], oldBds[5]};
+        const double newXMin[3] = {newBds[0], newBds[2], newBds[4]};
+        const double newXMax[3] = {newBds[1], newBds[3], newBds[5]};
+        this->GetBinIndices(oldXMin,oldMin);
+        this->GetBinIndices(oldXMax,oldMax);
+        this->GetBinIndices(newXMin,newMin);
+        this->GetBinIndices(newXMax,newMax);
+        if ( !std::equal(oldMin,oldMin+3,newMin) || !std::equal(oldMax,oldMax+3,newMax) )
+        {
+          cellIds.push_back(cellId);
+        }
+        std::copy(newBds,newBds+6,oldBds);
+      }
+    });
+
+    for ( const std::vector<vtkIdType>& cellIds : localMoved )
+    {
+      moved.insert(moved.end(), cellIds.begin(), cellIds.end());
+    }
+    std::sort(moved.begin(), moved.end());
+  }
+
 }; //vtkCellBinner
 
 //-----------------------------------------------------------------------------
@@ -271,6 +316,8 @@ struct vtkCellProcessor
                                 vtkGenericCell *cell) = 0;
   // Convenience for computing
   virtual int IsEmpty(vtkIdType binId) = 0;
+  // Re-bin the given (sorted) cells after their bounds changed
+  virtual bool UpdateFragments(const std::vector<vtkIdType>& moved) = 0;
 };
 
 namespace { //anonymous to wrap non-public stuff
@@ -354,6 +401,7 @@ struct CellProcessor : public vtkCellProcessor
   {
     return ( this->GetNumberOfIds(static_cast<T>(binId)) > 0 ? 0 : 1 );
   }
+  bool UpdateFragments(const std::vector<vtkIdType>& moved) override;
 
   // This functor is used to perform the final cell binning
   void Initialize()
@@ -476,6 +524,85 @@ struct MapOffsets
 
 }; //MapOffsets
 
+//-----------------------------------------------------------------------------
+// Replace the fragments of the moved cells with fragments computed from
+// their current bounds. The new fragments are sorted and merged with the
+// remaining ones, which is linear in the number of fragments instead of
+// sorting the whole map again.
+template <typename T> bool CellProcessor<T>::
+UpdateFragments(const std::vector<vtkIdType>& moved)
+{
+  std::vector<unsigned char> isMoved(this->NumCells, 0);
+  std::vector<CellFragments<T>> added;
+  double xmin[3], xmax[3];
+  int ijkMin[3], ijkMax[3];
+  for ( vtkIdType cellId : moved )
+  {
+    const double *bds = this->CellBounds + cellId*6;
+    xmin[0] = bds[0];
+    xmin[1] = bds[2];
+    xmin[2] = bds[4];
+    xmax[0] = bds[1];
+    xmax[1] = bds[3];
+    xmax[2] = bds[5];
+    this->Binner->GetBinIndices(xmin,ijkMin);
+    this->Binner->GetBinIndices(xmax,ijkMax);
+
+    isMoved[cellId] = 1;
+    for (int k=ijkMin[2]; k <= ijkMax[2]; ++k)
+    {
+      for (int j=ijkMin[1]; j <= ijkMax[1]; ++j)
+      {
+        for (int i=ijkMin[0]; i <= ijkMax[0]; ++i)
+        {
+          CellFragments<T> t;
+          t.CellId = static_cast<T>(cellId);
+          t.BinId = static_cast<T>(i + j*xD + k*xyD);
+          added.push_back(t);
+        }
+      }
+    }
+  }
+
+  // Small ids may not be able to hold the new fragments
+  vtkIdType maxFragments = this->NumFragments + static_cast<vtkIdType>(added.size());
+  if ( sizeof(T) < sizeof(vtkIdType) && maxFragments >= VTK_INT_MAX )
+  {
+    return false;
+  }
+  std::sort(added.begin(), added.end());
+
+  CellFragments<T> *map = new CellFragments<T>[maxFragments+1];
+  CellFragments<T> *out = map;
+  typename std::vector<CellFragments<T>>::const_iterator a = added.begin();
+  const CellFragments<T> *endPt = this->Map + this->NumFragments;
+  for ( const CellFragments<T> *t = this->Map; t < endPt; ++t )
+  {
+    if ( isMoved[t->CellId] )
+    {
+      continue;
+    }
+    for ( ; a != added.end() && *a < *t; ++a )
+    {
+      *out++ = *a;
+    }
+    *out++ = *t;
+  }
+  out = std::copy(a, added.cend(), out);
+
+  delete [] this->Map;
+  this->Map = map;
+  this->NumFragments = this->Binner->NumFragments = out - map;
+  this->Map[this->NumFragments].BinId = this->NumBins;
+  this->Offsets[this->NumBins] = this->NumFragments;
+  this->NumBatches = static_cast<int>(
+    ceil(static_cast<double>(this->NumFragments) / this->BatchSize));
+
+  MapOffsets<T> mapOffsets(this);
+  vtkSMPTools::For(0, this->NumBatches, mapOffsets);
+  return true;
+}
+
 
 //-----------------------------------------------------------------------------
 template <typename T> vtkIdType CellProcessor<T>::
@@ -1207,6 +1334,14 @@ BuildLocator()
     return;
   }
 
+  // Only the points moved: update the existing bins if possible.
+  if ( (this->Binner != nullptr) && this->OnlyPointsModified() && this->UpdateBins() )
+  {
+    vtkDebugMacro( << "Updated static cell locator bins" );
+    this->BuildTime.Modified();
+    return;
+  }
+
   vtkIdType numCells;
   if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
   {
@@ -1286,7 +1421,156 @@ BuildLocator()
     this->Processor = processor;
   }
 
+  this->RecordDataSetTopology();
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+// Search structure files hold the binning parameters, followed by the cell
+// bounds and the map and offsets arrays of the processor.
+namespace
+{
+struct BinningParameters
+{
+  vtkTypeInt32 LargeIds;
+  vtkTypeInt32 Divisions[3];
+  double Bounds[6];
+  double H[3];
+  vtkTypeInt64 NumberOfCells;
+  vtkTypeInt64 NumberOfBins;
+  vtkTypeInt64 NumberOfFragments;
+};
+
+template <typename T>
+bool WriteProcessor(vtkCellProcessor *p, vtkLocatorFile& file)
+{
+  CellProcessor<T> *processor = static_cast<CellProcessor<T>*>(p);
+  return file.Write(processor->CellBounds, processor->NumCells * 6 * sizeof(double)) &&
+    file.Write(processor->Map, (processor->NumFragments+1) * sizeof(CellFragments<T>)) &&
+    file.Write(processor->Offsets, (processor->NumBins+1) * sizeof(T));
+}
+
+template <typename T>
+bool ReadProcessor(vtkCellProcessor *p, vtkLocatorFile& file)
+{
+  CellProcessor<T> *processor = static_cast<CellProcessor<T>*>(p);
+  return file.Read(processor->CellBounds, processor->NumCells * 6 * sizeof(double)) &&
+    file.Read(processor->Map, (processor->NumFragments+1) * sizeof(CellFragments<T>)) &&
+    file.Read(processor->Offsets, (processor->NumBins+1) * sizeof(T));
+}
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticCellLocator::WriteSearchStructure(const char *fileName)
+{
+  this->BuildLocator();
+  if ( !this->Processor )
+  {
+    return 0;
+  }
+
+  BinningParameters params;
+  params.LargeIds = this->LargeIds;
+  for (int i=0; i<3; i++)
+  {
+    params.Divisions[i] = this->Divisions[i];
+    params.Bounds[2*i] = this->Bounds[2*i];
+    params.Bounds[2*i+1] = this->Bounds[2*i+1];
+    params.H[i] = this->H[i];
+  }
+  params.NumberOfCells = this->Processor->NumCells;
+  params.NumberOfBins = this->Processor->NumBins;
+  params.NumberOfFragments = this->Processor->NumFragments;
+
+  vtkLocatorFile file;
+  bool success = file.OpenForWriting(fileName, vtkLocatorFile::STATIC_CELL_LOCATOR,
+    vtkLocatorFile::DataSetChecksum(this->DataSet, true)) &&
+    file.Write(&params, sizeof(params)) &&
+    ( this->LargeIds ? WriteProcessor<vtkIdType>(this->Processor, file) :
+      WriteProcessor<int>(this->Processor, file) );
+  success = file.Close() && success;
+  if ( !success )
+  {
+    vtkErrorMacro( << "Could not write search structure to " << (fileName ? fileName : "(null)") );
+  }
+  return success ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticCellLocator::ReadSearchStructure(const char *fileName)
+{
+  vtkIdType numCells;
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+  {
+    vtkErrorMacro( << "No cells to locate");
+    return 0;
+  }
+
+  vtkLocatorFile file;
+  BinningParameters params;
+  if ( !file.OpenForReading(fileName, vtkLocatorFile::STATIC_CELL_LOCATOR,
+         vtkLocatorFile::DataSetChecksum(this->DataSet, true)) ||
+       !file.Read(&params, sizeof(params)) || params.NumberOfCells != numCells ||
+       params.Divisions[0] < 1 || params.Divisions[1] < 1 || params.Divisions[2] < 1 ||
+       params.NumberOfBins != static_cast<vtkIdType>(params.Divisions[0]) *
+         params.Divisions[1] * params.Divisions[2] || params.NumberOfFragments < numCells )
+  {
+    vtkDebugMacro( << "No valid search structure for this dataset in "
+                   << (fileName ? fileName : "(null)") );
+    return 0;
+  }
+
+  this->FreeSearchStructure();
+  this->LargeIds = (params.LargeIds != 0);
+  for (int i=0; i<3; i++)
+  {
+    this->Divisions[i] = params.Divisions[i];
+    this->Bounds[2*i] = params.Bounds[2*i];
+    this->Bounds[2*i+1] = params.Bounds[2*i+1];
+    this->H[i] = params.H[i];
+  }
+
+  this->Binner = new vtkCellBinner(this, numCells, params.NumberOfBins);
+  this->Binner->NumFragments = params.NumberOfFragments;
+  bool success;
+  if ( this->LargeIds )
+  {
+    this->Processor = new CellProcessor<vtkIdType>(this->Binner);
+    success = ReadProcessor<vtkIdType>(this->Processor, file);
+  }
+  else
+  {
+    this->Processor = new CellProcessor<int>(this->Binner);
+    success = ReadProcessor<int>(this->Processor, file);
+  }
+  if ( !success || !file.Validate() )
+  {
+    vtkWarningMacro( << "Corrupted search structure in " << fileName );
+    this->FreeSearchStructure();
+    return 0;
+  }
+
+  this->RecordDataSetTopology();
   this->BuildTime.Modified();
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkStaticCellLocator::UpdateBins()
+{
+  // The bins are kept only if they still cover the dataset.
+  const double *bounds = this->DataSet->GetBounds();
+  for (int i=0; i<3; i++)
+  {
+    if ( bounds[2*i] < this->Bounds[2*i] || bounds[2*i+1] > this->Bounds[2*i+1] )
+    {
+      return false;
+    }
+  }
+
+  std::vector<vtkIdType> moved;
+  this->Binner->UpdateCellBounds(moved);
+  return moved.empty() || this->Processor->UpdateFragments(moved);
 }
 
 //-----------------------------------------------------------------------------
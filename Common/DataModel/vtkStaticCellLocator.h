@@ -23,7 +23,10 @@
  *
  * vtkStaticCellLocator is an accelerated version of vtkCellLocator. It is
  * threaded (via vtkSMPTools), and supports one-time static construction
- * (i.e., incremental cell insertion is not supported).
+ * (i.e., incremental cell insertion is not supported). However, with
+ * IncrementalUpdateOn(), BuildLocator() reuses the bins when only the
+ * points of the dataset moved and the dataset stays within the binned
+ * region: only the cells whose bin footprint changed are re-binned.
  *
  * @warning
  * This class is templated. It may run slower than serial execution if the code
@@ -162,6 +165,23 @@ public:
   void BuildLocator() override;
   //@}
 
+  //@{
+  /**
+   * Save the search structure to a binary file, or load it instead of
+   * building it, which is much faster for large datasets that are loaded
+   * repeatedly. WriteSearchStructure() builds the locator if needed. The file
+   * records a checksum of the points and cells of the dataset:
+   * ReadSearchStructure() succeeds only if the file was written for the same
+   * dataset, on a platform with the same byte order and id size, and its
+   * content is intact. The arrays of the locator (including the cached cell
+   * bounds) are read in place, without conversion. Both methods return 1 on
+   * success and 0 otherwise; after a failed read the locator is built as
+   * usual when needed.
+   */
+  int WriteSearchStructure(const char *fileName);
+  int ReadSearchStructure(const char *fileName);
+  //@}
+
   //@{
   /**
    * Set the maximum number of buckets in the locator. By default the value
@@ -201,6 +221,10 @@ protected:
   vtkIdType MaxNumberOfBuckets; // Maximum number of buckets in locator
   bool LargeIds; //indicate whether integer ids are small or large
 
+  // Update the existing bins after the points of the dataset moved. Returns
+  // false if the locator must be rebuilt instead.
+  bool UpdateBins();
+
   // Support PIMPLd implementation
   vtkCellBinner *Binner; // Does the binning
   vtkCellProcessor *Processor; // Invokes methods (templated subclasses)
@@ -24,6 +24,7 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkLine.h"
+#include "vtkLocatorFile.h"
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocalObject.h"
 
@@ -1879,6 +1880,131 @@ void vtkStaticPointLocator::BuildLocator(const double *bds)
   this->BuildTime.Modified();
 }
 
+//-----------------------------------------------------------------------------
+// Search structure files hold the binning parameters, followed by the map
+// and offsets arrays of the bucket list.
+namespace
+{
+struct BinningParameters
+{
+  vtkTypeInt32 LargeIds;
+  vtkTypeInt32 Divisions[3];
+  double Bounds[6];
+  double H[3];
+  vtkTypeInt64 NumberOfPoints;
+  vtkTypeInt64 NumberOfBuckets;
+};
+
+template <typename TIds>
+bool WriteBucketList(vtkBucketList *bList, vtkLocatorFile& file)
+{
+  BucketList<TIds> *buckets = static_cast<BucketList<TIds>*>(bList);
+  return file.Write(buckets->Map, (buckets->NumPts+1) * sizeof(LocatorTuple<TIds>)) &&
+    file.Write(buckets->Offsets, (buckets->NumBuckets+1) * sizeof(TIds));
+}
+
+template <typename TIds>
+bool ReadBucketList(vtkBucketList *bList, vtkLocatorFile& file)
+{
+  BucketList<TIds> *buckets = static_cast<BucketList<TIds>*>(bList);
+  return file.Read(buckets->Map, (buckets->NumPts+1) * sizeof(LocatorTuple<TIds>)) &&
+    file.Read(buckets->Offsets, (buckets->NumBuckets+1) * sizeof(TIds));
+}
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticPointLocator::WriteSearchStructure(const char *fileName)
+{
+  this->BuildLocator();
+  if ( !this->Buckets )
+  {
+    return 0;
+  }
+
+  BinningParameters params;
+  params.LargeIds = this->LargeIds;
+  for (int i=0; i<3; i++)
+  {
+    params.Divisions[i] = this->Divisions[i];
+    params.Bounds[2*i] = this->Bounds[2*i];
+    params.Bounds[2*i+1] = this->Bounds[2*i+1];
+    params.H[i] = this->H[i];
+  }
+  params.NumberOfPoints = this->Buckets->NumPts;
+  params.NumberOfBuckets = this->Buckets->NumBuckets;
+
+  vtkLocatorFile file;
+  bool success = file.OpenForWriting(fileName, vtkLocatorFile::STATIC_POINT_LOCATOR,
+    vtkLocatorFile::DataSetChecksum(this->DataSet, false)) &&
+    file.Write(&params, sizeof(params)) &&
+    ( this->LargeIds ? WriteBucketList<vtkIdType>(this->Buckets, file) :
+      WriteBucketList<int>(this->Buckets, file) );
+  success = file.Close() && success;
+  if ( !success )
+  {
+    vtkErrorMacro( << "Could not write search structure to " << (fileName ? fileName : "(null)") );
+  }
+  return success ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticPointLocator::ReadSearchStructure(const char *fileName)
+{
+  vtkIdType numPts;
+  if ( !this->DataSet || (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+  {
+    vtkErrorMacro( << "No points to locate");
+    return 0;
+  }
+
+  vtkLocatorFile file;
+  BinningParameters params;
+  if ( !file.OpenForReading(fileName, vtkLocatorFile::STATIC_POINT_LOCATOR,
+         vtkLocatorFile::DataSetChecksum(this->DataSet, false)) ||
+       !file.Read(&params, sizeof(params)) || params.NumberOfPoints != numPts ||
+       params.Divisions[0] < 1 || params.Divisions[1] < 1 || params.Divisions[2] < 1 ||
+       params.NumberOfBuckets != static_cast<vtkIdType>(params.Divisions[0]) *
+         params.Divisions[1] * params.Divisions[2] )
+  {
+    vtkDebugMacro( << "No valid search structure for this dataset in "
+                   << (fileName ? fileName : "(null)") );
+    return 0;
+  }
+
+  this->FreeSearchStructure();
+  this->Level = 1;
+  this->LargeIds = (params.LargeIds != 0);
+  for (int i=0; i<3; i++)
+  {
+    this->Divisions[i] = params.Divisions[i];
+    this->Bounds[2*i] = params.Bounds[2*i];
+    this->Bounds[2*i+1] = params.Bounds[2*i+1];
+    this->H[i] = params.H[i];
+  }
+  this->NumberOfBuckets = params.NumberOfBuckets;
+
+  bool success;
+  if ( this->LargeIds )
+  {
+    this->Buckets = new BucketList<vtkIdType>(this,numPts,this->NumberOfBuckets);
+    success = ReadBucketList<vtkIdType>(this->Buckets, file);
+  }
+  else
+  {
+    this->Buckets = new BucketList<int>(this,numPts,this->NumberOfBuckets);
+    success = ReadBucketList<int>(this->Buckets, file);
+  }
+  if ( !success || !file.Validate() )
+  {
+    vtkWarningMacro( << "Corrupted search structure in " << fileName );
+    this->FreeSearchStructure();
+    return 0;
+  }
+
+  this->BuildTime.Modified();
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 // These methods satisfy the vtkStaticPointLocator API. The implementation is
 // with the templated BucketList class. Note that a lot of the complexity here
@@ -1985,6 +2111,29 @@ FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+BatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *ids, vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindClosestPoint(queries, ids, dist2, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+BatchFindClosestNPoints(int N, vtkPoints *queries, vtkIdTypeArray *offsets,
+                        vtkIdTypeArray *ids, vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindClosestNPoints(N, queries, offsets, ids, dist2, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::
+BatchFindPointsWithinRadius(double R, vtkPoints *queries, vtkIdTypeArray *offsets,
+                            vtkIdTypeArray *ids, vtkDoubleArray *dist2)
+{
+  this->ExecuteBatchFindPointsWithinRadius(R, queries, offsets, ids, dist2, true);
+}
+
 //-----------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
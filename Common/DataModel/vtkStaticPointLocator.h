@@ -95,6 +95,22 @@ public:
   vtkGetVectorMacro(Divisions,int,3);
   //@}
 
+  //@{
+  /**
+   * Batched queries, see vtkAbstractPointLocator. They run in parallel with
+   * vtkSMPTools since the single queries are thread safe once the locator is
+   * built.
+   */
+  void BatchFindClosestPoint(vtkPoints *queries, vtkIdTypeArray *ids,
+                             vtkDoubleArray *dist2 = nullptr) override;
+  void BatchFindClosestNPoints(int N, vtkPoints *queries,
+                               vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                               vtkDoubleArray *dist2 = nullptr) override;
+  void BatchFindPointsWithinRadius(double R, vtkPoints *queries,
+                                   vtkIdTypeArray *offsets, vtkIdTypeArray *ids,
+                                   vtkDoubleArray *dist2 = nullptr) override;
+  //@}
+
   // Re-use any superclass signatures that we don't override.
   using vtkAbstractPointLocator::FindClosestPoint;
   using vtkAbstractPointLocator::FindClosestNPoints;
@@ -176,6 +192,22 @@ public:
   void BuildLocator(const double *bounds);
   //@}
 
+  //@{
+  /**
+   * Save the search structure to a binary file, or load it instead of
+   * building it, which is much faster for large datasets that are loaded
+   * repeatedly. WriteSearchStructure() builds the locator if needed. The file
+   * records a checksum of the points of the dataset: ReadSearchStructure()
+   * succeeds only if the file was written for the same points, on a platform
+   * with the same byte order and id size, and its content is intact. The
+   * arrays of the locator are read in place, without conversion. Both methods
+   * return 1 on success and 0 otherwise; after a failed read the locator is
+   * built as usual when needed.
+   */
+  int WriteSearchStructure(const char *fileName);
+  int ReadSearchStructure(const char *fileName);
+  //@}
+
   /**
    * Populate a polydata with the faces of the bins that potentially contain cells.
    * Note that the level parameter has no effect on this method as there is no
@@ -17,9 +17,12 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLinks.h"
+#include "vtkCellTypes.h"
 #include "vtkConvexPointSet.h"
 #include "vtkCubicLine.h"
+#include "vtkDoubleArray.h"
 #include "vtkEmptyCell.h"
+#include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
 #include "vtkHexahedron.h"
 #include "vtkIdTypeArray.h"
@@ -52,6 +55,7 @@
 #include "vtkQuadraticQuad.h"
 #include "vtkQuadraticTetra.h"
 #include "vtkQuadraticTriangle.h"
+#include "vtkSimpleCriticalSection.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
@@ -126,6 +130,11 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
   this->Links = nullptr;
   this->Types = nullptr;
   this->Locations = nullptr;
+  this->SingleCellType = VTK_EMPTY_CELL;
+  this->SingleCellSize = 0;
+  this->ImpliedTypes = nullptr;
+  this->ImpliedLocations = nullptr;
+  this->ImpliedArraysMutex = new vtkSimpleCriticalSection;
 
   this->Faces = nullptr;
   this->FaceLocations = nullptr;
@@ -133,11 +142,49 @@ vtkUnstructuredGrid::vtkUnstructuredGrid ()
   this->Allocate(1000,1000);
 }
 
+//----------------------------------------------------------------------------
+// Location and type of a cell, for both explicit and single-cell-type
+// storage.
+inline vtkIdType vtkUnstructuredGrid::GetCellLocation(vtkIdType cellId) const
+{
+  return (this->SingleCellType == VTK_EMPTY_CELL ?
+          this->Locations->GetValue(cellId) :
+          cellId * (this->SingleCellSize + 1));
+}
+
+inline unsigned char vtkUnstructuredGrid::GetCellTypeValue(vtkIdType cellId) const
+{
+  return (this->SingleCellType == VTK_EMPTY_CELL ?
+          this->Types->GetValue(cellId) :
+          static_cast<unsigned char>(this->SingleCellType));
+}
+
+//----------------------------------------------------------------------------
+// Select the storage of the cells, dropping the arrays derived from the
+// previous single cell type storage.
+void vtkUnstructuredGrid::SetCellStorage(int singleCellType, vtkIdType singleCellSize)
+{
+  this->SingleCellType = singleCellType;
+  this->SingleCellSize = singleCellSize;
+  if ( this->ImpliedTypes )
+  {
+    this->ImpliedTypes->UnRegister(this);
+    this->ImpliedTypes = nullptr;
+  }
+  if ( this->ImpliedLocations )
+  {
+    this->ImpliedLocations->UnRegister(this);
+    this->ImpliedLocations = nullptr;
+  }
+}
+
 //----------------------------------------------------------------------------
 // Allocate memory space for data insertion. Execute this method before
 // inserting any cells into object.
 void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
 {
+  this->SetCellStorage(VTK_EMPTY_CELL, 0);
+
   if ( numCells < 1 )
   {
     numCells = 1000;
@@ -179,6 +226,7 @@ void vtkUnstructuredGrid::Allocate (vtkIdType numCells, int extSize)
 vtkUnstructuredGrid::~vtkUnstructuredGrid()
 {
   this->Cleanup();
+  delete this->ImpliedArraysMutex;
 
   if(this->Vertex)
   {
@@ -423,6 +471,7 @@ void vtkUnstructuredGrid::CopyStructure(vtkDataSet *ds)
         this->Locations->Register(this);
       }
     }
+    this->SetCellStorage(ug->SingleCellType, ug->SingleCellSize);
 
     if (this->Faces != ug->Faces)
     {
@@ -480,6 +529,7 @@ void vtkUnstructuredGrid::Cleanup()
     this->Locations->UnRegister(this);
     this->Locations = nullptr;
   }
+  this->SetCellStorage(VTK_EMPTY_CELL, 0);
 
   if ( this->Faces )
   {
@@ -513,8 +563,8 @@ void vtkUnstructuredGrid::Initialize()
 int vtkUnstructuredGrid::GetCellType(vtkIdType cellId)
 {
 
-  vtkDebugMacro(<< "Returning cell type " << static_cast<int>(this->Types->GetValue(cellId)));
-  return static_cast<int>(this->Types->GetValue(cellId));
+  vtkDebugMacro(<< "Returning cell type " << static_cast<int>(this->GetCellTypeValue(cellId)));
+  return static_cast<int>(this->GetCellTypeValue(cellId));
 }
 
 //----------------------------------------------------------------------------
@@ -525,11 +575,11 @@ vtkCell *vtkUnstructuredGrid::GetCell(vtkIdType cellId)
   vtkCell *cell = nullptr;
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   vtkDebugMacro(<< "location = " <<  loc);
   this->Connectivity->GetCell(loc,numPts,pts);
 
-  int cellType = static_cast<int>(this->Types->GetValue(cellId));
+  int cellType = static_cast<int>(this->GetCellTypeValue(cellId));
   switch (cellType)
   {
     case VTK_VERTEX:
@@ -890,10 +940,10 @@ void vtkUnstructuredGrid::GetCell(vtkIdType cellId, vtkGenericCell *cell)
   vtkIdType loc;
   vtkIdType *pts, numPts;
 
-  int cellType = static_cast<int>(this->Types->GetValue(cellId));
+  int cellType = static_cast<int>(this->GetCellTypeValue(cellId));
   cell->SetCellType(cellType);
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
 
   cell->PointIds->SetNumberOfIds(numPts);
@@ -925,7 +975,7 @@ void vtkUnstructuredGrid::GetCellBounds(vtkIdType cellId, double bounds[6])
   double x[3];
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
 
   // carefully compute the bounds
@@ -983,6 +1033,10 @@ vtkIdType vtkUnstructuredGrid::GetNumberOfCells()
 // polyhedron cells.
 vtkIdType vtkUnstructuredGrid::InternalInsertNextCell(int type, vtkIdList *ptIds)
 {
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    this->ConvertToExplicitCellTypes();
+  }
   if (type == VTK_POLYHEDRON)
   {
     // For polyhedron cell, input ptIds is of format:
@@ -1017,6 +1071,10 @@ vtkIdType vtkUnstructuredGrid::InternalInsertNextCell(int type, vtkIdList *ptIds
 vtkIdType vtkUnstructuredGrid::InternalInsertNextCell(int type, vtkIdType npts,
                                               const vtkIdType ptIds[])
 {
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    this->ConvertToExplicitCellTypes();
+  }
   if (type != VTK_POLYHEDRON)
   {
     // insert connectivity
@@ -1079,6 +1137,10 @@ InternalInsertNextCell(int type, vtkIdType npts, const vtkIdType pts[],
   {
     return this->InsertNextCell(type, npts, pts);
   }
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    this->ConvertToExplicitCellTypes();
+  }
   // Insert connectivity (points that make up polyhedron)
   this->Connectivity->InsertNextCell(npts,pts);
 
@@ -1131,6 +1193,10 @@ int vtkUnstructuredGrid::InitializeFacesRepresentation(vtkIdType numPrevCells)
                   "InitializeFacesRepresentation returned without execution.");
     return 0;
   }
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    this->ConvertToExplicitCellTypes();
+  }
 
   this->Faces = vtkIdTypeArray::New();
   this->Faces->Allocate(this->Types->GetSize());
@@ -1169,6 +1235,31 @@ vtkIdType *vtkUnstructuredGrid::GetFaces(vtkIdType cellId)
   return this->Faces->GetPointer(loc);
 }
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::SetSingleTypeCells(int type, vtkCellArray *cells)
+{
+  // Cells of one type and size do not need the types and locations arrays.
+  vtkIdType ncells = cells->GetNumberOfCells();
+  if (type != VTK_POLYHEDRON && ncells > 0)
+  {
+    vtkIdType *conn = cells->GetPointer();
+    vtkIdType size = conn[0];
+    vtkIdType connSize = cells->GetNumberOfConnectivityEntries();
+    bool singleSize = (connSize == ncells * (size + 1));
+    for (vtkIdType loc = 0; singleSize && loc < connSize; loc += size + 1)
+    {
+      singleSize = (conn[loc] == size);
+    }
+    if (singleSize)
+    {
+      this->SetCells(nullptr, nullptr, cells, nullptr, nullptr);
+      this->SetCellStorage(type, size);
+      return;
+    }
+  }
+  this->SetCells(type, cells);
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::SetCells(int type, vtkCellArray *cells)
 {
@@ -1330,6 +1421,8 @@ void vtkUnstructuredGrid::SetCells(vtkUnsignedCharArray *cellTypes,
                                    vtkIdTypeArray *faceLocations,
                                    vtkIdTypeArray *faces)
 {
+  this->SetCellStorage(VTK_EMPTY_CELL, 0);
+
   if ( this->Connectivity )
   {
     this->Connectivity->UnRegister(this);
@@ -1393,7 +1486,7 @@ void vtkUnstructuredGrid::BuildLinks()
   this->Links = vtkCellLinks::New();
   this->Links->Allocate(this->GetNumberOfPoints());
   this->Links->Register(this);
-  this->Links->BuildLinks(this, this->Connectivity);
+  this->Links->BuildLinks(this);
   this->Links->Delete();
 }
 
@@ -1403,7 +1496,7 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
   vtkIdType i, loc;
   vtkIdType *pts, numPts;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   this->Connectivity->GetCell(loc,numPts,pts);
   ptIds->SetNumberOfIds(numPts);
   for (i=0; i<numPts; i++)
@@ -1421,11 +1514,82 @@ void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
 {
   vtkIdType loc;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
 
   this->Connectivity->GetCell(loc,npts,pts);
 }
 
+//----------------------------------------------------------------------------
+int vtkUnstructuredGrid::GetCellType(vtkIdType cellId) const
+{
+  return static_cast<int>(this->GetCellTypeValue(cellId));
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkUnstructuredGrid::GetCellSize(vtkIdType cellId) const
+{
+  return this->Connectivity->GetPointer()[this->GetCellLocation(cellId)];
+}
+
+//----------------------------------------------------------------------------
+// Read-only access to the connectivity array, safe to call from several
+// threads.
+void vtkUnstructuredGrid::GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                                        const vtkIdType* &pts) const
+{
+  const vtkIdType *cell =
+    this->Connectivity->GetPointer() + this->GetCellLocation(cellId);
+  npts = cell[0];
+  pts = cell + 1;
+}
+
+//----------------------------------------------------------------------------
+namespace
+{
+template <typename T>
+inline void GatherPoints(const T *points, vtkIdType npts, const vtkIdType *pts,
+                         double *x)
+{
+  for (vtkIdType i = 0; i < npts; ++i, x += 3)
+  {
+    const T *p = points + 3 * pts[i];
+    x[0] = static_cast<double>(p[0]);
+    x[1] = static_cast<double>(p[1]);
+    x[2] = static_cast<double>(p[2]);
+  }
+}
+}
+
+vtkIdType vtkUnstructuredGrid::GetCellPointCoordinates(vtkIdType cellId,
+                                                       vtkIdType maxPts,
+                                                       double *x) const
+{
+  vtkIdType npts;
+  const vtkIdType *pts;
+  this->GetCellPoints(cellId, npts, pts);
+  vtkIdType numCopied = (npts < maxPts ? npts : maxPts);
+
+  // Direct access for the usual float and double points; GetTuple() is
+  // thread safe for the other arrays.
+  vtkDataArray *data = this->Points->GetData();
+  if (vtkFloatArray *fa = vtkArrayDownCast<vtkFloatArray>(data))
+  {
+    GatherPoints(fa->GetPointer(0), numCopied, pts, x);
+  }
+  else if (vtkDoubleArray *da = vtkArrayDownCast<vtkDoubleArray>(data))
+  {
+    GatherPoints(da->GetPointer(0), numCopied, pts, x);
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < numCopied; ++i)
+    {
+      data->GetTuple(pts[i], x + 3 * i);
+    }
+  }
+  return npts;
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::GetFaceStream(vtkIdType cellId, vtkIdList *ptIds)
 {
@@ -1511,9 +1675,141 @@ vtkCellIterator *vtkUnstructuredGrid::NewCellIterator()
   return iter;
 }
 
+//----------------------------------------------------------------------------
+vtkUnsignedCharArray* vtkUnstructuredGrid::GetCellTypesArray()
+{
+  if ( this->SingleCellType == VTK_EMPTY_CELL )
+  {
+    return this->Types;
+  }
+  this->BuildImpliedArrays();
+  return this->ImpliedTypes;
+}
+
+//----------------------------------------------------------------------------
+vtkIdTypeArray* vtkUnstructuredGrid::GetCellLocationsArray()
+{
+  if ( this->SingleCellType == VTK_EMPTY_CELL )
+  {
+    return this->Locations;
+  }
+  this->BuildImpliedArrays();
+  return this->ImpliedLocations;
+}
+
+//----------------------------------------------------------------------------
+// Create, once, the types and locations arrays implied by the single cell
+// type storage. The storage of the grid does not change, so several threads
+// may ask for the arrays of the same grid.
+void vtkUnstructuredGrid::BuildImpliedArrays()
+{
+  this->ImpliedArraysMutex->Lock();
+  if ( this->ImpliedTypes )
+  {
+    this->ImpliedArraysMutex->Unlock();
+    return;
+  }
+
+  vtkIdType numCells = this->GetNumberOfCells();
+  vtkUnsignedCharArray *types = vtkUnsignedCharArray::New();
+  types->SetNumberOfValues(numCells);
+  vtkIdTypeArray *locations = vtkIdTypeArray::New();
+  locations->SetNumberOfValues(numCells);
+  unsigned char *typePtr = types->GetPointer(0);
+  vtkIdType *locPtr = locations->GetPointer(0);
+  unsigned char type = static_cast<unsigned char>(this->SingleCellType);
+  vtkIdType incr = this->SingleCellSize + 1;
+  for ( vtkIdType cellId = 0; cellId < numCells; ++cellId )
+  {
+    typePtr[cellId] = type;
+    locPtr[cellId] = cellId * incr;
+  }
+
+  this->ImpliedLocations = locations;
+  this->ImpliedLocations->Register(this);
+  locations->Delete();
+  this->ImpliedTypes = types;
+  this->ImpliedTypes->Register(this);
+  types->Delete();
+  this->ImpliedArraysMutex->Unlock();
+}
+
+//----------------------------------------------------------------------------
+bool vtkUnstructuredGrid::ConvertToSingleCellType()
+{
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    return true;
+  }
+  vtkIdType numCells = this->GetNumberOfCells();
+  if ( numCells == 0 || !this->Types || this->Faces ||
+       this->Types->GetNumberOfValues() != numCells )
+  {
+    return false;
+  }
+
+  // All cells must have the same type and size, and be stored in order.
+  const unsigned char *types = this->Types->GetPointer(0);
+  const vtkIdType *locs = this->Locations->GetPointer(0);
+  const vtkIdType *conn = this->Connectivity->GetPointer();
+  unsigned char type = types[0];
+  vtkIdType size = conn[0];
+  if ( type == VTK_POLYHEDRON || this->Connectivity->GetNumberOfConnectivityEntries() !=
+       numCells * (size + 1) )
+  {
+    return false;
+  }
+  for ( vtkIdType cellId = 0; cellId < numCells; ++cellId )
+  {
+    vtkIdType loc = cellId * (size + 1);
+    if ( types[cellId] != type || locs[cellId] != loc || conn[loc] != size )
+    {
+      return false;
+    }
+  }
+
+  this->Types->UnRegister(this);
+  this->Types = nullptr;
+  this->Locations->UnRegister(this);
+  this->Locations = nullptr;
+  this->SetCellStorage(type, size);
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Go back to the explicit storage, using the types and locations arrays
+// implied by the single cell type storage.
+void vtkUnstructuredGrid::ConvertToExplicitCellTypes()
+{
+  if ( this->SingleCellType == VTK_EMPTY_CELL )
+  {
+    return;
+  }
+  this->BuildImpliedArrays();
+  if ( this->Types )
+  {
+    this->Types->UnRegister(this);
+  }
+  this->Types = this->ImpliedTypes;
+  this->Types->Register(this);
+  if ( this->Locations )
+  {
+    this->Locations->UnRegister(this);
+  }
+  this->Locations = this->ImpliedLocations;
+  this->Locations->Register(this);
+  this->SetCellStorage(VTK_EMPTY_CELL, 0);
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::Reset()
 {
+  if ( this->SingleCellType != VTK_EMPTY_CELL )
+  {
+    this->ConvertToExplicitCellTypes();
+  }
   if ( this->Connectivity )
   {
     this->Connectivity->Reset();
@@ -1610,7 +1906,7 @@ void vtkUnstructuredGrid::InternalReplaceCell(vtkIdType cellId, int npts,
 {
   vtkIdType loc;
 
-  loc = this->Locations->GetValue(cellId);
+  loc = this->GetCellLocation(cellId);
   this->Connectivity->ReplaceCell(loc,npts,pts);
 }
 
@@ -1678,6 +1974,8 @@ void vtkUnstructuredGrid::ShallowCopy(vtkDataObject *dataObject)
   {
     // I do not know if this is correct but.
 
+    this->SetCellStorage(grid->SingleCellType, grid->SingleCellSize);
+
     if (this->Connectivity)
     {
       this->Connectivity->UnRegister(this);
@@ -1766,6 +2064,8 @@ void vtkUnstructuredGrid::DeepCopy(vtkDataObject *dataObject)
 
   if ( grid != nullptr )
   {
+    this->SetCellStorage(grid->SingleCellType, grid->SingleCellSize);
+
     if ( this->Connectivity )
     {
       this->Connectivity->UnRegister(this);
@@ -1862,6 +2162,7 @@ void vtkUnstructuredGrid::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Pieces: " << this->GetNumberOfPieces() << endl;
   os << indent << "Piece: " << this->GetPiece() << endl;
   os << indent << "Ghost Level: " << this->GetGhostLevel() << endl;
+  os << indent << "Single Cell Type: " << this->SingleCellType << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1942,6 +2243,10 @@ void vtkUnstructuredGrid::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
 //----------------------------------------------------------------------------
 int vtkUnstructuredGrid::IsHomogeneous()
 {
+  if (this->SingleCellType != VTK_EMPTY_CELL)
+  {
+    return 1;
+  }
   unsigned char type;
   if (this->Types && this->Types->GetMaxId() >= 0)
   {
@@ -1963,6 +2268,17 @@ int vtkUnstructuredGrid::IsHomogeneous()
 // Fill container with indices of cells which match given type.
 void vtkUnstructuredGrid::GetIdsOfCellsOfType(int type, vtkIdTypeArray *array)
 {
+  if (this->SingleCellType != VTK_EMPTY_CELL)
+  {
+    if (type == this->SingleCellType)
+    {
+      for (vtkIdType cellId = 0; cellId < this->GetNumberOfCells(); cellId++)
+      {
+        array->InsertNextValue(cellId);
+      }
+    }
+    return;
+  }
   for (int cellId = 0; cellId < this->GetNumberOfCells(); cellId++)
   {
     if (static_cast<int>(Types->GetValue(cellId)) == type)
@@ -1973,6 +2289,21 @@ void vtkUnstructuredGrid::GetIdsOfCellsOfType(int type, vtkIdTypeArray *array)
 }
 
 
+//----------------------------------------------------------------------------
+void vtkUnstructuredGrid::GetCellTypes(vtkCellTypes *types)
+{
+  if (this->SingleCellType == VTK_EMPTY_CELL)
+  {
+    this->Superclass::GetCellTypes(types);
+    return;
+  }
+  types->Reset();
+  if (this->GetNumberOfCells() > 0)
+  {
+    types->InsertNextType(static_cast<unsigned char>(this->SingleCellType));
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkUnstructuredGrid::RemoveGhostCells()
 {
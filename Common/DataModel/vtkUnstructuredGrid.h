@@ -22,6 +22,19 @@
  * types. This includes 0D (e.g., points), 1D (e.g., lines, polylines), 2D
  * (e.g., triangles, polygons), and 3D (e.g., hexahedron, tetrahedron,
  * polyhedron, etc.).
+ *
+ * Reading a grid from several threads is safe as long as no thread modifies
+ * it and BuildLinks() was called beforehand if GetPointCells() or
+ * GetCellNeighbors() are used. The exceptions are GetCell(vtkIdType), which
+ * returns a cell shared by all callers, and GetCellPoints(vtkIdType,
+ * vtkIdList*), which needs a list per thread. Threaded code should prefer
+ * the const GetCellType(), GetCellSize(), GetCellPoints() and
+ * GetCellPointCoordinates() methods, which neither lock nor allocate.
+ *
+ * Grids whose cells all share one type and number of points (e.g. pure
+ * tetrahedral or hexahedral meshes) can be stored without the cell types and
+ * cell locations arrays, which are then implied by the cell id. See
+ * SetSingleTypeCells() and ConvertToSingleCellType().
 */
 
 #ifndef vtkUnstructuredGrid_h
@@ -32,6 +45,7 @@
 
 class vtkCellArray;
 class vtkCellLinks;
+class vtkCellTypes;
 class vtkConvexPointSet;
 class vtkEmptyCell;
 class vtkHexahedron;
@@ -60,6 +74,7 @@ class vtkQuadraticPyramid;
 class vtkQuadraticQuad;
 class vtkQuadraticTetra;
 class vtkQuadraticTriangle;
+class vtkSimpleCriticalSection;
 class vtkTetra;
 class vtkTriangle;
 class vtkTriangleStrip;
@@ -117,8 +132,46 @@ public:
   //@}
 
   int GetCellType(vtkIdType cellId) override;
-  vtkUnsignedCharArray* GetCellTypesArray() { return this->Types; }
-  vtkIdTypeArray* GetCellLocationsArray() { return this->Locations; }
+
+  //@{
+  /**
+   * Get the arrays of cell types and cell locations. If the grid uses the
+   * single cell type storage, these are arrays derived from it, created
+   * once and kept by the grid, whose storage does not change. They must then
+   * be treated as read only: to modify the types or locations of the cells,
+   * call ConvertToExplicitCellTypes() first. Use GetSingleCellType() to
+   * avoid creating the arrays.
+   */
+  vtkUnsignedCharArray* GetCellTypesArray();
+  vtkIdTypeArray* GetCellLocationsArray();
+  //@}
+
+  /**
+   * Return the type shared by all cells when the grid uses the single cell
+   * type storage, VTK_EMPTY_CELL otherwise. In that storage the cell types
+   * and locations arrays do not exist: cell i has the type returned here and
+   * its connectivity starts at i * (GetCellSize(0) + 1).
+   */
+  int GetSingleCellType() { return this->SingleCellType; }
+
+  /**
+   * Switch to the single cell type storage if all cells have the same type
+   * and number of points, releasing the cell types and locations arrays.
+   * Polyhedra and empty grids keep the explicit storage. Inserting a cell
+   * of another type or size, or calling ConvertToExplicitCellTypes(), goes
+   * back to the explicit storage. GetCellTypesArray() and
+   * GetCellLocationsArray() do not: they return read-only arrays derived
+   * from the single cell type. Return true if the grid uses the single
+   * cell type storage.
+   */
+  bool ConvertToSingleCellType();
+
+  /**
+   * Go back to the explicit storage, with cell types and locations arrays
+   * that belong to the grid. Nothing is done for grids already using it.
+   */
+  void ConvertToExplicitCellTypes();
+
   void Squeeze() override;
   void Initialize() override;
   int GetMaxCellSize() override;
@@ -127,6 +180,26 @@ public:
   virtual void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
                              vtkIdType* &pts);
 
+  //@{
+  /**
+   * Thread-safe, allocation-free access to the cells. These methods only
+   * read the cell arrays and may be called concurrently from any number of
+   * threads while the grid is not modified. GetCellType() and GetCellSize()
+   * return the type and number of points of a cell. GetCellPoints() returns
+   * the number of points of a cell and a pointer to its point ids inside the
+   * connectivity array, valid until the grid is modified.
+   * GetCellPointCoordinates() copies the coordinates of at most maxPts
+   * points of a cell into x, which must hold 3*maxPts values (typically a
+   * buffer on the stack), and returns the number of points of the cell.
+   */
+  int GetCellType(vtkIdType cellId) const;
+  vtkIdType GetCellSize(vtkIdType cellId) const;
+  void GetCellPoints(vtkIdType cellId, vtkIdType& npts,
+                     const vtkIdType* &pts) const;
+  vtkIdType GetCellPointCoordinates(vtkIdType cellId, vtkIdType maxPts,
+                                    double *x) const;
+  //@}
+
   /**
    * Get the face stream of a polyhedron cell in the following format:
    * (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts,id1, id2, id3, ...).
@@ -168,6 +241,13 @@ public:
                 vtkIdTypeArray *faces);
   //@}
 
+  /**
+   * Same as SetCells(int type, vtkCellArray*), but use the single cell type
+   * storage when all cells have the same number of points: the cell types
+   * and locations arrays are then not created.
+   */
+  void SetSingleTypeCells(int type, vtkCellArray *cells);
+
   vtkCellArray *GetCells() {return this->Connectivity;};
   vtkIdType InsertNextLinkedCell(int type, int npts, const vtkIdType pts[]) VTK_SIZEHINT(pts, npts);
   void RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId);
@@ -221,6 +301,12 @@ public:
    */
   void GetIdsOfCellsOfType(int type, vtkIdTypeArray *array) override;
 
+  /**
+   * Get the list of cell types in the grid. This is immediate for grids
+   * using the single cell type storage.
+   */
+  void GetCellTypes(vtkCellTypes *types) override;
+
   /**
    * Traverse cells and determine if cells are all of the same type.
    */
@@ -406,6 +492,20 @@ private:
   void operator=(const vtkUnstructuredGrid&) = delete;
 
   void Cleanup();
+
+  // Single cell type storage: when SingleCellType is not VTK_EMPTY_CELL,
+  // Types and Locations are null and every cell has SingleCellSize points.
+  // ImpliedTypes and ImpliedLocations are the arrays returned by
+  // GetCellTypesArray() and GetCellLocationsArray() in that storage.
+  int SingleCellType;
+  vtkIdType SingleCellSize;
+  vtkUnsignedCharArray *ImpliedTypes;
+  vtkIdTypeArray *ImpliedLocations;
+  vtkSimpleCriticalSection *ImpliedArraysMutex; // Guards BuildImpliedArrays()
+  vtkIdType GetCellLocation(vtkIdType cellId) const;
+  unsigned char GetCellTypeValue(vtkIdType cellId) const;
+  void SetCellStorage(int singleCellType, vtkIdType singleCellSize);
+  void BuildImpliedArrays();
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include "vtkUnstructuredGridCellIterator.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellType.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
@@ -34,10 +35,9 @@ void vtkUnstructuredGridCellIterator::PrintSelf(ostream &os, vtkIndent indent)
   // interpreting them as strings.
   os << indent << "CellTypeBegin: "
      << static_cast<void*>(this->CellTypeBegin) << endl;
-  os << indent << "CellTypePtr: "
-     << static_cast<void*>(this->CellTypePtr) << endl;
-  os << indent << "CellTypeEnd: "
-     << static_cast<void*>(this->CellTypeEnd) << endl;
+  os << indent << "SingleCellType: " << this->SingleCellType << endl;
+  os << indent << "CellId: " << this->CellId << endl;
+  os << indent << "NumberOfCells: " << this->NumberOfCells << endl;
   os << indent << "ConnectivityBegin: " << this->ConnectivityBegin << endl;
   os << indent << "ConnectivityPtr: " << this->ConnectivityPtr << endl;
   os << indent << "FacesBegin: " << this->FacesBegin<< endl;
@@ -52,8 +52,11 @@ void vtkUnstructuredGridCellIterator::PrintSelf(ostream &os, vtkIndent indent)
 void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
     vtkUnstructuredGrid *ug)
 {
-  // If the unstructured grid has not been initialized yet, these may not exist:
-  vtkUnsignedCharArray *cellTypeArray = ug ? ug->GetCellTypesArray() : nullptr;
+  // If the unstructured grid has not been initialized yet, these may not exist.
+  // Grids with a single cell type have no cell types array; do not create it.
+  int singleCellType = ug ? ug->GetSingleCellType() : VTK_EMPTY_CELL;
+  vtkUnsignedCharArray *cellTypeArray =
+    ug && singleCellType == VTK_EMPTY_CELL ? ug->GetCellTypesArray() : nullptr;
   vtkCellArray *cellArray = ug ? ug->GetCells() : nullptr;
   vtkPoints *points = ug ? ug->GetPoints() : nullptr;
 
@@ -62,12 +65,14 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
     this->Points->SetDataType(points->GetDataType());
   }
 
-  if (ug && cellTypeArray && cellArray && points)
+  if (ug && (cellTypeArray || singleCellType != VTK_EMPTY_CELL) && cellArray &&
+      points)
   {
     // Cell types
-    this->CellTypeBegin = this->CellTypeEnd = this->CellTypePtr
-        = cellTypeArray ? cellTypeArray->GetPointer(0) : nullptr;
-    this->CellTypeEnd += cellTypeArray ? cellTypeArray->GetNumberOfTuples() : 0;
+    this->CellTypeBegin = cellTypeArray ? cellTypeArray->GetPointer(0) : nullptr;
+    this->SingleCellType = singleCellType;
+    this->NumberOfCells = cellTypeArray ? cellTypeArray->GetNumberOfTuples()
+                                        : cellArray->GetNumberOfCells();
 
     // CellArray
     this->ConnectivityBegin = this->ConnectivityPtr = cellArray->GetPointer();
@@ -93,8 +98,8 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
   else
   {
     this->CellTypeBegin = nullptr;
-    this->CellTypePtr = nullptr;
-    this->CellTypeEnd = nullptr;
+    this->SingleCellType = VTK_EMPTY_CELL;
+    this->NumberOfCells = 0;
     this->FacesBegin = nullptr;
     this->FacesLocsBegin = nullptr;
     this->FacesLocsPtr = nullptr;
@@ -103,6 +108,7 @@ void vtkUnstructuredGridCellIterator::SetUnstructuredGrid(
     this->UnstructuredGridPoints = nullptr;
   }
 
+  this->CellId = 0;
   this->SkippedCells = 0;
 }
 
@@ -135,19 +141,19 @@ void vtkUnstructuredGridCellIterator::CatchUpSkippedCells()
 //------------------------------------------------------------------------------
 bool vtkUnstructuredGridCellIterator::IsDoneWithTraversal()
 {
-  return this->CellTypePtr >= this->CellTypeEnd;
+  return this->CellId >= this->NumberOfCells;
 }
 
 //------------------------------------------------------------------------------
 vtkIdType vtkUnstructuredGridCellIterator::GetCellId()
 {
-  return static_cast<vtkIdType>(this->CellTypePtr - this->CellTypeBegin);
+  return this->CellId;
 }
 
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::IncrementToNextCell()
 {
-  ++this->CellTypePtr;
+  ++this->CellId;
 
   // Bookkeeping for ConnectivityPtr
   ++this->SkippedCells;
@@ -161,8 +167,9 @@ void vtkUnstructuredGridCellIterator::IncrementToNextCell()
 vtkUnstructuredGridCellIterator::vtkUnstructuredGridCellIterator()
   : vtkCellIterator(),
     CellTypeBegin(nullptr),
-    CellTypePtr(nullptr),
-    CellTypeEnd(nullptr),
+    SingleCellType(VTK_EMPTY_CELL),
+    CellId(0),
+    NumberOfCells(0),
     ConnectivityBegin(nullptr),
     ConnectivityPtr(nullptr),
     FacesBegin(nullptr),
@@ -179,7 +186,7 @@ vtkUnstructuredGridCellIterator::~vtkUnstructuredGridCellIterator() = default;
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::ResetToFirstCell()
 {
-  this->CellTypePtr = this->CellTypeBegin;
+  this->CellId = 0;
   this->FacesLocsPtr = this->FacesLocsBegin;
   this->ConnectivityPtr = this->ConnectivityBegin;
   this->SkippedCells = 0;
@@ -188,12 +195,20 @@ void vtkUnstructuredGridCellIterator::ResetToFirstCell()
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::FetchCellType()
 {
-  this->CellType = *this->CellTypePtr;
+  this->CellType = this->CellTypeBegin ? this->CellTypeBegin[this->CellId]
+                                       : this->SingleCellType;
 }
 
 //------------------------------------------------------------------------------
 void vtkUnstructuredGridCellIterator::FetchPointIds()
 {
+  if (this->SingleCellType != VTK_EMPTY_CELL)
+  {
+    // Cells are stored at regular intervals.
+    vtkIdType size = *this->ConnectivityBegin;
+    this->ConnectivityPtr = this->ConnectivityBegin + this->CellId * (size + 1);
+    this->SkippedCells = 0;
+  }
   CatchUpSkippedCells();
   const vtkIdType *connPtr = this->ConnectivityPtr;
   vtkIdType numCellPoints = *(connPtr++);
@@ -55,9 +55,11 @@ protected:
   friend class vtkUnstructuredGrid;
   void SetUnstructuredGrid(vtkUnstructuredGrid *ug);
 
+  // CellTypeBegin is null when the grid uses the single cell type storage.
   unsigned char *CellTypeBegin;
-  unsigned char *CellTypePtr;
-  unsigned char *CellTypeEnd;
+  int SingleCellType;
+  vtkIdType CellId;
+  vtkIdType NumberOfCells;
 
   vtkIdType *ConnectivityBegin;
   vtkIdType *ConnectivityPtr;
@@ -362,14 +362,15 @@ struct MapUGridToSpanSpace
   {
     vtkUnstructuredGrid *grid = this->Grid;
     TS *scalars = this->Scalars;
-    vtkIdType i, npts, *pts;
+    vtkIdType i, npts;
+    const vtkIdType *pts;
     double s, sMin, sMax;
 
     for ( ; cellId < endCellId; ++cellId )
     {
       sMin = VTK_DOUBLE_MAX;
       sMax = VTK_DOUBLE_MIN;
-      // A faster version of GetCellPoints()
+      // Thread-safe, allocation-free access to the cell points
       grid->GetCellPoints(cellId, npts, pts);
       for ( i=0; i < npts; i++ )
       {
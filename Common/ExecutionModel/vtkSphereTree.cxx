@@ -23,7 +23,6 @@
 #include "vtkInformationVector.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
-#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPointData.h"
@@ -352,8 +351,8 @@ namespace {
     {
       double *sphere = this->Spheres + 4*cellId;
       vtkUnstructuredGrid *grid = static_cast<vtkUnstructuredGrid*>(this->DataSet);
-      double cellPts[120], *p, r;
-      vtkIdType ptNum, *cellIds, numCellPts;
+      double cellPts[120], r;
+      vtkIdType numCellPts;
       double& radius = this->Radius.Local();
       vtkIdType& count = this->Count.Local();
       double& xmin = this->XMin.Local();
@@ -365,13 +364,8 @@ namespace {
 
       for ( ; cellId < endCellId; ++cellId, sphere+=4)
       {
-        grid->GetCellPoints(cellId, numCellPts, cellIds);
+        numCellPts = grid->GetCellPointCoordinates(cellId, 40, cellPts);
         numCellPts = ( numCellPts < 40 ? numCellPts : 40);
-        p = cellPts;
-        for (ptNum=0; ptNum < numCellPts; ++ptNum, p+=3)
-        {
-          grid->GetPoint(cellIds[ptNum], p);
-        }
         vtkSphere::ComputeBoundingSphere(cellPts, numCellPts, sphere, nullptr);
 
         if (this->ComputeBoundsAndRadius)
@@ -402,10 +396,6 @@ namespace {
     {
       if (grid->GetNumberOfCells() > 0 && numCells <= grid->GetNumberOfCells())
       {
-        // Dummy call to GetCellPoints to enable its uses in the threaded code
-        vtkNew<vtkIdList> dummy;
-        grid->GetCellPoints(0, dummy);
-
         UnstructuredSpheres spheres(grid, s);
         vtkSMPTools::For(0, numCells, spheres);
         aveRadius = spheres.AverageRadius;
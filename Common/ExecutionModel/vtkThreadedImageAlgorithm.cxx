@@ -26,6 +26,10 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkSMPTools.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
 #include <vector>
 
 // If SMP backend is Sequential then fall back to vtkMultiThreader,
@@ -36,6 +40,31 @@ bool vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP = false;
 bool vtkThreadedImageAlgorithm::GlobalDefaultEnableSMP = true;
 #endif
 
+//----------------------------------------------------------------------------
+// The time spent on each piece during the last adaptive execution, and the
+// extent and number of pieces that it applies to.
+class vtkThreadedImageAlgorithm::vtkPieceCosts
+{
+public:
+  int Extent[6] = { 0, -1, 0, -1, 0, -1 };
+  std::vector<double> Costs;
+
+  // Compute the order in which to schedule the pieces: most expensive first
+  // if the costs of a matching execution are known, else in piece order.
+  void GetOrder(const int extent[6], vtkIdType pieces, std::vector<vtkIdType>& order) const
+  {
+    order.resize(pieces);
+    std::iota(order.begin(), order.end(), 0);
+    if (static_cast<vtkIdType>(this->Costs.size()) == pieces &&
+        std::equal(extent, extent + 6, this->Extent))
+    {
+      const std::vector<double>& costs = this->Costs;
+      std::stable_sort(order.begin(), order.end(),
+        [&costs](vtkIdType a, vtkIdType b) { return costs[a] > costs[b]; });
+    }
+  }
+};
+
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 {
@@ -59,12 +88,18 @@ vtkThreadedImageAlgorithm::vtkThreadedImageAlgorithm()
 
   // The desired block size in bytes
   this->DesiredBytesPerPiece = 65536;
+
+  // Adaptive scheduling settings
+  this->AdaptiveScheduling = false;
+  this->OverDecomposition = 8;
+  this->PieceCosts = new vtkPieceCosts;
 }
 
 //----------------------------------------------------------------------------
 vtkThreadedImageAlgorithm::~vtkThreadedImageAlgorithm()
 {
   this->Threader->Delete();
+  delete this->PieceCosts;
 }
 
 //----------------------------------------------------------------------------
@@ -102,6 +137,9 @@ void vtkThreadedImageAlgorithm::PrintSelf(ostream& os, vtkIndent indent)
      << (this->SplitMode == SLAB ? "Slab\n" :
          (this->SplitMode == BEAM ? "Beam\n" :
           (this->SplitMode == BLOCK ? "Block\n" : "Unknown\n")));
+  os << indent << "AdaptiveScheduling: "
+     << (this->AdaptiveScheduling ? "On\n" : "Off\n");
+  os << indent << "OverDecomposition: " << this->OverDecomposition << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -444,6 +482,70 @@ private:
   vtkIdType NumberOfPieces;
 };
 
+//----------------------------------------------------------------------------
+// This functor is used with vtkSMPTools for adaptive scheduling: every task
+// is a worker that takes pieces, in the given order, from a shared counter
+// until none are left, and records the time spent on each piece.
+class vtkThreadedImageAlgorithmScheduler
+{
+public:
+  vtkThreadedImageAlgorithmScheduler(
+    vtkThreadedImageAlgorithm *algo,
+    vtkInformation *request,
+    vtkInformationVector **inputsInfo,
+    vtkInformationVector *outputsInfo,
+    vtkImageData ***inputs,
+    vtkImageData **outputs,
+    const int extent[6],
+    const std::vector<vtkIdType>& order,
+    std::vector<double>& costs)
+    : Algorithm(algo), Request(request),
+      InputsInfo(inputsInfo), OutputsInfo(outputsInfo),
+      Inputs(inputs), Outputs(outputs),
+      Order(order), Costs(costs), NextPiece(0)
+  {
+    for (int i = 0; i < 6; i++)
+    {
+      this->Extent[i] = extent[i];
+    }
+  }
+
+  // Called by vtkSMPTools, each index in [begin, end) is one worker.
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType numPieces = static_cast<vtkIdType>(this->Order.size());
+    for (vtkIdType worker = begin; worker < end; worker++)
+    {
+      for (vtkIdType i = this->NextPiece++; i < numPieces; i = this->NextPiece++)
+      {
+        vtkIdType piece = this->Order[i];
+        auto start = std::chrono::steady_clock::now();
+        this->Algorithm->SMPRequestData(
+          this->Request, this->InputsInfo, this->OutputsInfo,
+          this->Inputs, this->Outputs,
+          piece, piece + 1, numPieces, this->Extent);
+        std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+        this->Costs[piece] = elapsed.count();
+      }
+    }
+  }
+
+private:
+  vtkThreadedImageAlgorithmScheduler() = delete;
+
+  vtkThreadedImageAlgorithm *Algorithm;
+  vtkInformation *Request;
+  vtkInformationVector **InputsInfo;
+  vtkInformationVector *OutputsInfo;
+  vtkImageData ***Inputs;
+  vtkImageData **Outputs;
+  int Extent[6];
+  const std::vector<vtkIdType>& Order;
+  std::vector<double>& Costs;
+  std::atomic<vtkIdType> NextPiece;
+};
+
 //----------------------------------------------------------------------------
 // The execute method created by the subclass.
 void vtkThreadedImageAlgorithm::SMPRequestData(
@@ -639,11 +741,18 @@ int vtkThreadedImageAlgorithm::RequestData(
         bytesPerVoxel);
       vtkTypeInt64 bytesPerPiece = this->DesiredBytesPerPiece;
 
+      vtkIdType threads = pieces;
+
       if (bytesPerPiece > 0 && bytesPerPiece < bytesize)
       {
         vtkTypeInt64 b = pieces*bytesPerPiece;
         pieces *= (bytesize + b - 1)/b;
       }
+      if (this->AdaptiveScheduling)
+      {
+        // over-decompose so that there is enough work left to balance
+        pieces = std::max(pieces, threads*this->OverDecomposition);
+      }
       // do a dummy execution of SplitExtent to compute the number of pieces
       int subExtent[6];
       pieces = this->SplitExtent(subExtent, updateExtent, 0, pieces);
@@ -652,11 +761,29 @@ int vtkThreadedImageAlgorithm::RequestData(
       bool debug = this->Debug;
       this->Debug = false;
 
-      vtkThreadedImageAlgorithmFunctor functor(
-        this, request, inputVector, outputVector,
-        inputs, outputs, updateExtent, pieces);
+      if (this->AdaptiveScheduling)
+      {
+        std::vector<vtkIdType> order;
+        this->PieceCosts->GetOrder(updateExtent, pieces, order);
+        std::vector<double> costs(pieces, 0.0);
+
+        vtkThreadedImageAlgorithmScheduler scheduler(
+          this, request, inputVector, outputVector,
+          inputs, outputs, updateExtent, order, costs);
 
-      vtkSMPTools::For(0, pieces, functor);
+        vtkSMPTools::For(0, std::min(threads, pieces), 1, scheduler);
+
+        std::copy(updateExtent, updateExtent + 6, this->PieceCosts->Extent);
+        this->PieceCosts->Costs.swap(costs);
+      }
+      else
+      {
+        vtkThreadedImageAlgorithmFunctor functor(
+          this, request, inputVector, outputVector,
+          inputs, outputs, updateExtent, pieces);
+
+        vtkSMPTools::For(0, pieces, functor);
+      }
 
       this->Debug = debug;
     }
@@ -109,6 +109,33 @@ public:
   vtkGetMacro(SplitMode, int);
   //@}
 
+  //@{
+  /**
+   * Enable/Disable adaptive scheduling of the pieces when SMP is enabled.
+   * When on, the volume is over-decomposed into OverDecomposition pieces
+   * per thread and every thread repeatedly takes the next piece that has not
+   * been executed yet, so that threads which finish cheap pieces early take
+   * over the remaining work instead of sitting idle. The time spent on each
+   * piece is recorded, and if the next execution has the same update extent
+   * then the pieces are scheduled from the most to the least expensive.
+   * This helps filters whose cost varies strongly across the volume, e.g.
+   * vtkImageReslice with a stencil. The default is Off.
+   */
+  vtkSetMacro(AdaptiveScheduling, bool);
+  vtkGetMacro(AdaptiveScheduling, bool);
+  vtkBooleanMacro(AdaptiveScheduling, bool);
+  //@}
+
+  //@{
+  /**
+   * The minimum number of pieces per thread when AdaptiveScheduling is on.
+   * The volume is split into more pieces if DesiredBytesPerPiece requires
+   * it. The default is 8.
+   */
+  vtkSetClampMacro(OverDecomposition, int, 1, 1024);
+  vtkGetMacro(OverDecomposition, int);
+  //@}
+
   //@{
   /**
    * Get/Set the number of threads to create when rendering.
@@ -146,6 +173,8 @@ protected:
   int SplitPathLength;
   int MinimumPieceSize[3];
   vtkIdType DesiredBytesPerPiece;
+  bool AdaptiveScheduling;
+  int OverDecomposition;
 
   /**
    * This is called by the superclass.
@@ -184,7 +213,12 @@ private:
   vtkThreadedImageAlgorithm(const vtkThreadedImageAlgorithm&) = delete;
   void operator=(const vtkThreadedImageAlgorithm&) = delete;
 
+  // The piece costs measured by the last adaptive execution.
+  class vtkPieceCosts;
+  vtkPieceCosts* PieceCosts;
+
   friend class vtkThreadedImageAlgorithmFunctor;
+  friend class vtkThreadedImageAlgorithmScheduler;
 };
 
 #endif
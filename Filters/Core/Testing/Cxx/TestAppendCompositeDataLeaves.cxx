@@ -0,0 +1,301 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAppendCompositeDataLeaves.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Appends multiblock datasets whose leaves are processed in parallel, with
+// a dataset shared by several leaves, and checks every leaf against the
+// datasets appended one by one. Also checks that the per-type methods of a
+// subclass are still called, and that an input with another structure is
+// ignored with a warning.
+
+#include "vtkAppendCompositeDataLeaves.h"
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+namespace
+{
+
+const unsigned int NumberOfBlocks = 24;
+
+// Counts the calls of the per-type methods.
+class CountingAppend : public vtkAppendCompositeDataLeaves
+{
+public:
+  static CountingAppend* New();
+  vtkTypeMacro(CountingAppend, vtkAppendCompositeDataLeaves);
+
+  int PolyDataCalls = 0;
+  int UnstructuredGridCalls = 0;
+
+protected:
+  void AppendPolyData(vtkInformationVector* inputVector, int i, int numInputs,
+    vtkCompositeDataIterator* iter, vtkCompositeDataSet* output) override
+  {
+    ++this->PolyDataCalls;
+    this->Superclass::AppendPolyData(inputVector, i, numInputs, iter, output);
+  }
+
+  void AppendUnstructuredGrids(vtkInformationVector* inputVector, int i, int numInputs,
+    vtkCompositeDataIterator* iter, vtkCompositeDataSet* output) override
+  {
+    ++this->UnstructuredGridCalls;
+    this->Superclass::AppendUnstructuredGrids(inputVector, i, numInputs, iter, output);
+  }
+};
+vtkStandardNewMacro(CountingAppend);
+
+vtkSmartPointer<vtkPolyData> MakeSphere(double x, int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(x, 0.0, 0.0);
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  vtkSmartPointer<vtkPolyData> pd = sphere->GetOutput();
+  vtkNew<vtkFloatArray> field;
+  field->SetName(("Field" + std::to_string(resolution)).c_str());
+  field->InsertNextValue(static_cast<float>(x));
+  pd->GetFieldData()->AddArray(field);
+  return pd;
+}
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(double x, int resolution)
+{
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputData(MakeSphere(x, resolution));
+  toGrid->Update();
+  return toGrid->GetOutput();
+}
+
+// Leaves: polydata, unstructured grids, images and empty positions; the
+// first input uses one polydata instance in several leaves.
+vtkSmartPointer<vtkMultiBlockDataSet> MakeInput(int offset)
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  vtkSmartPointer<vtkPolyData> shared = MakeSphere(100.0, 12);
+  for (unsigned int block = 0; block < NumberOfBlocks; ++block)
+  {
+    const double x = 3.0 * block + offset;
+    switch (block % 4)
+    {
+      case 0:
+        mb->SetBlock(block, offset == 0 && block % 8 == 0 ? shared : MakeSphere(x, 8 + block));
+        break;
+      case 1:
+        mb->SetBlock(block, MakeGrid(x, 8 + block));
+        break;
+      case 2:
+      {
+        vtkNew<vtkImageData> image;
+        image->SetDimensions(2 + block, 3, 4);
+        image->SetOrigin(x, 0.0, 0.0);
+        mb->SetBlock(block, image);
+        break;
+      }
+      default:
+        // Only the second input has data here.
+        if (offset != 0)
+        {
+          mb->SetBlock(block, MakeSphere(x, 6 + block));
+        }
+        else
+        {
+          mb->SetBlock(block, nullptr);
+        }
+        break;
+    }
+  }
+  return mb;
+}
+
+bool SamePoints(vtkPointSet* a, vtkPointSet* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(i, pa);
+    b->GetPoint(i, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends the leaves of the inputs one at a time and compares the result
+// with each leaf of the output.
+int CheckLeaves(vtkMultiBlockDataSet* input0, vtkMultiBlockDataSet* input1,
+  vtkMultiBlockDataSet* output)
+{
+  if (output->GetNumberOfBlocks() != NumberOfBlocks)
+  {
+    std::cerr << "Wrong number of output blocks\n";
+    return 1;
+  }
+  for (unsigned int block = 0; block < NumberOfBlocks; ++block)
+  {
+    vtkDataObject* a = input0->GetBlock(block);
+    vtkDataObject* b = input1->GetBlock(block);
+    vtkDataObject* result = output->GetBlock(block);
+    const std::string name = "block " + std::to_string(block);
+    vtkSmartPointer<vtkDataObject> expected;
+    if (vtkPolyData::SafeDownCast(a ? a : b))
+    {
+      vtkNew<vtkAppendPolyData> append;
+      for (vtkDataObject* leaf : { a, b })
+      {
+        if (leaf)
+        {
+          append->AddInputData(vtkPolyData::SafeDownCast(leaf));
+        }
+      }
+      append->Update();
+      expected = append->GetOutput();
+    }
+    else if (vtkUnstructuredGrid::SafeDownCast(a))
+    {
+      vtkNew<vtkAppendFilter> append;
+      append->AddInputData(a);
+      append->AddInputData(b);
+      append->Update();
+      expected = append->GetOutput();
+    }
+    else
+    {
+      // Images are passed from the first input.
+      vtkImageData* image = vtkImageData::SafeDownCast(result);
+      if (!image || image->GetNumberOfPoints() != vtkImageData::SafeDownCast(a)->GetNumberOfPoints())
+      {
+        std::cerr << name << ": image not passed\n";
+        return 1;
+      }
+      continue;
+    }
+    vtkPointSet* resultSet = vtkPointSet::SafeDownCast(result);
+    if (!resultSet || !resultSet->IsA(expected->GetClassName()) ||
+      !SamePoints(resultSet, vtkPointSet::SafeDownCast(expected)))
+    {
+      std::cerr << name << ": differs from the leaves appended one by one\n";
+      return 1;
+    }
+    // Field data of every input leaf is added.
+    for (vtkDataObject* leaf : { a, b })
+    {
+      if (leaf && leaf->GetFieldData()->GetNumberOfArrays() > 0 &&
+        !resultSet->GetFieldData()->HasArray(leaf->GetFieldData()->GetArrayName(0)))
+      {
+        std::cerr << name << ": missing field data\n";
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+void CountEvents(vtkObject*, unsigned long, void* clientData, void*)
+{
+  ++*static_cast<int*>(clientData);
+}
+
+}
+
+int TestAppendCompositeDataLeaves(int, char*[])
+{
+  vtkSmartPointer<vtkMultiBlockDataSet> input0 = MakeInput(0);
+  vtkSmartPointer<vtkMultiBlockDataSet> input1 = MakeInput(1);
+
+  vtkNew<CountingAppend> append;
+  append->AppendFieldDataOn();
+  append->AddInputDataObject(input0);
+  append->AddInputDataObject(input1);
+  append->Update();
+  vtkMultiBlockDataSet* output = vtkMultiBlockDataSet::SafeDownCast(append->GetOutput());
+  int errors = CheckLeaves(input0, input1, output);
+
+  // The leaves holding the shared sphere, appended serially, each get their
+  // own result and leave the sphere unchanged.
+  vtkPolyData* shared = vtkPolyData::SafeDownCast(input0->GetBlock(0));
+  const vtkIdType sharedPoints = MakeSphere(100.0, 12)->GetNumberOfPoints();
+  for (unsigned int block = 0; block < NumberOfBlocks; block += 8)
+  {
+    vtkPolyData* result = vtkPolyData::SafeDownCast(output->GetBlock(block));
+    vtkPointSet* other = vtkPointSet::SafeDownCast(input1->GetBlock(block));
+    if (input0->GetBlock(block) != shared || !result || result == shared ||
+      (block > 0 && result == output->GetBlock(0)) ||
+      result->GetNumberOfPoints() != sharedPoints + other->GetNumberOfPoints())
+    {
+      std::cerr << "Wrong result for the shared leaf at block " << block << "\n";
+      ++errors;
+    }
+  }
+  if (shared->GetNumberOfPoints() != sharedPoints)
+  {
+    std::cerr << "The shared leaf was modified\n";
+    ++errors;
+  }
+  if (append->PolyDataCalls != static_cast<int>(NumberOfBlocks / 2) ||
+    append->UnstructuredGridCalls != static_cast<int>(NumberOfBlocks / 4))
+  {
+    std::cerr << "Per-type methods called " << append->PolyDataCalls << " and "
+              << append->UnstructuredGridCalls << " times\n";
+    ++errors;
+  }
+
+  // An input with another structure is ignored with a warning.
+  vtkNew<vtkMultiBlockDataSet> other;
+  other->SetBlock(0, MakeSphere(0.0, 8));
+  int warnings = 0;
+  vtkNew<vtkCallbackCommand> warningObserver;
+  warningObserver->SetCallback(CountEvents);
+  warningObserver->SetClientData(&warnings);
+  append->AddObserver(vtkCommand::WarningEvent, warningObserver);
+  int outputErrors = 0;
+  vtkNew<vtkCallbackCommand> errorObserver;
+  errorObserver->SetCallback(CountEvents);
+  errorObserver->SetClientData(&outputErrors);
+  other->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  append->AddInputDataObject(other);
+  append->Update();
+  if (warnings != 1 || outputErrors != 0)
+  {
+    std::cerr << "Expected one warning and no error for the input with another structure, got "
+              << warnings << " and " << outputErrors << "\n";
+    ++errors;
+  }
+  errors += CheckLeaves(input0, input1, vtkMultiBlockDataSet::SafeDownCast(append->GetOutput()));
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
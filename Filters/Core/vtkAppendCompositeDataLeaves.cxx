@@ -20,6 +20,7 @@
 #include "vtkCell.h"
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCompositeDataSetSMPTools.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkDataSetCollection.h"
 #include "vtkExecutive.h"
@@ -36,12 +37,111 @@
 #include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Returns the datasets found at the position of iter in all the inputs.
+std::vector<vtkDataObject*> GetLeavesAt(
+  vtkInformationVector* inputVector, int numInputs, vtkCompositeDataIterator* iter)
+{
+  std::vector<vtkDataObject*> leaves(numInputs, nullptr);
+  for ( int idx = 0; idx < numInputs; ++ idx )
+  {
+    vtkCompositeDataSet* icdset = vtkCompositeDataSet::GetData(inputVector, idx);
+    leaves[idx] = icdset ? icdset->GetDataSet( iter ) : nullptr;
+  }
+  return leaves;
+}
+
+//----------------------------------------------------------------------------
+// Returns the datasets found at a leaf index in all the inputs. Inputs that
+// were skipped have no leaves.
+std::vector<vtkDataObject*> GetLeavesAt(
+  const std::vector<std::vector<vtkDataObject*> >& inputLeaves, size_t leaf)
+{
+  std::vector<vtkDataObject*> leaves(inputLeaves.size(), nullptr);
+  for (size_t idx = 0; idx < leaves.size(); ++idx)
+  {
+    const std::vector<vtkDataObject*>& inputX = inputLeaves[idx];
+    leaves[idx] = leaf < inputX.size() ? inputX[leaf] : nullptr;
+  }
+  return leaves;
+}
+
+//----------------------------------------------------------------------------
+// Returns whether each leaf position holds a dataset that is also found at
+// another position, in the same input or in another one.
+std::vector<bool> FindSharedLeaves(
+  const std::vector<std::vector<vtkDataObject*> >& inputLeaves, size_t numberOfLeaves)
+{
+  std::vector<bool> shared(numberOfLeaves, false);
+  std::map<vtkDataObject*, size_t> positions;
+  for (const std::vector<vtkDataObject*>& inputX : inputLeaves)
+  {
+    for (size_t leaf = 0; leaf < inputX.size(); ++leaf)
+    {
+      if (!inputX[leaf])
+      {
+        continue;
+      }
+      auto inserted = positions.insert(std::make_pair(inputX[leaf], leaf));
+      if (!inserted.second && inserted.first->second != leaf)
+      {
+        shared[leaf] = true;
+        shared[inserted.first->second] = true;
+      }
+    }
+  }
+  return shared;
+}
+
+//----------------------------------------------------------------------------
+// Appends one leaf position of all the inputs; run on leaf indices in
+// parallel by vtkCompositeDataSetSMPTools. The positions holding datasets
+// shared with other positions are skipped, to be appended serially.
+struct AppendLeavesWorker
+{
+  using AppendFunction =
+    std::function<vtkSmartPointer<vtkDataObject>(const std::vector<vtkDataObject*>&)>;
+
+  AppendFunction Append;
+  const std::vector<std::vector<vtkDataObject*> >& InputLeaves;
+  const std::vector<bool>& SharedLeaves;
+
+  AppendLeavesWorker(AppendFunction append,
+    const std::vector<std::vector<vtkDataObject*> >& inputLeaves,
+    const std::vector<bool>& sharedLeaves)
+    : Append(append)
+    , InputLeaves(inputLeaves)
+    , SharedLeaves(sharedLeaves)
+  {
+  }
+
+  vtkSmartPointer<vtkDataObject> operator()(vtkIdType leaf)
+  {
+    if (this->SharedLeaves[leaf])
+    {
+      return nullptr;
+    }
+    return this->Append(GetLeavesAt(this->InputLeaves, static_cast<size_t>(leaf)));
+  }
+};
+
+} // end anon namespace
+
 vtkStandardNewMacro(vtkAppendCompositeDataLeaves);
 
 //----------------------------------------------------------------------------
 vtkAppendCompositeDataLeaves::vtkAppendCompositeDataLeaves()
 {
   this->AppendFieldData = 0;
+  this->CurrentLeaf = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -113,66 +213,83 @@ int vtkAppendCompositeDataLeaves::RequestData(
 
   vtkDebugMacro(<<"Appending data together");
 
+  // Leaves are matched by their index in the structure of the first input;
+  // inputs with a different number of leaves cannot be matched and are
+  // skipped.
+  const size_t numberOfLeaves = vtkCompositeDataSetSMPTools::GetLeaves(input0).size();
+  std::vector<std::vector<vtkDataObject*> >& inputLeaves = this->InputLeaves;
+  inputLeaves.assign(numInputs, std::vector<vtkDataObject*>());
+  for ( int idx = 0; idx < numInputs; ++ idx )
+  {
+    vtkCompositeDataSet* inputX = vtkCompositeDataSet::GetData(inputVector[0], idx);
+    if (!inputX)
+    {
+      continue;
+    }
+    if (vtkCompositeDataSetSMPTools::GetLeaves(inputX).size() != numberOfLeaves)
+    {
+      vtkWarningMacro(<< "Input " << idx << " does not have the structure of the first "
+                      << "input and is ignored.");
+      continue;
+    }
+    inputLeaves[idx] = vtkCompositeDataSetSMPTools::GetLeaves(inputX, output);
+  }
+
+  // Append the leaf positions in parallel, then insert the results serially
+  // through the per-type methods, which subclasses may override. A dataset
+  // found at several positions is the input of several appenders, whose
+  // updates would race on its pipeline information: these positions are
+  // appended serially.
+  const std::vector<bool> sharedLeaves = FindSharedLeaves(inputLeaves, numberOfLeaves);
+  AppendLeavesWorker worker(
+    [this](const std::vector<vtkDataObject*>& leaves) { return this->AppendLeaves(leaves); },
+    inputLeaves, sharedLeaves);
+  this->AppendedLeaves = vtkCompositeDataSetSMPTools::ProcessLeaves(
+    static_cast<vtkIdType>(numberOfLeaves), worker);
+  for (size_t leaf = 0; leaf < numberOfLeaves; ++leaf)
+  {
+    if (sharedLeaves[leaf])
+    {
+      this->AppendedLeaves[leaf] = this->AppendLeaves(GetLeavesAt(inputLeaves, leaf));
+    }
+  }
+
   vtkSmartPointer<vtkCompositeDataIterator> iter;
   iter.TakeReference(output->NewIterator());
 
   iter->SkipEmptyNodesOff(); // We're iterating over the output, whose leaves are all empty.
-  static bool first = true;
-  for (iter->InitTraversal(); ! iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  bool first = true;
+  this->CurrentLeaf = 0;
+  for (iter->InitTraversal(); ! iter->IsDoneWithTraversal(); iter->GoToNextItem(),
+       ++this->CurrentLeaf)
   {
-    // Loop over all inputs at this "spot" in the composite data tree. locate
-    // the first input that has a non-null data-object at this location, if any.
-    vtkDataObject* obj = nullptr;
-    int inputIndex;
-    for (inputIndex = 0; inputIndex < numInputs && !obj; ++inputIndex)
+    // Locate the first input that has a non-null data-object at this
+    // location, if any.
+    std::vector<vtkDataObject*> leaves = GetLeavesAt(inputLeaves, this->CurrentLeaf);
+    int inputIndex = 0;
+    while (inputIndex < numInputs && !leaves[inputIndex])
     {
-      vtkCompositeDataSet* inputX = vtkCompositeDataSet::GetData(inputVector[0],
-        inputIndex);
-      obj = inputX? inputX->GetDataSet(iter) : nullptr;
+      ++inputIndex;
     }
-
-    if (obj == nullptr)
+    if (inputIndex == numInputs)
     {
       continue; // no input had a non-nullptr dataset
     }
 
+    vtkDataObject* obj = leaves[inputIndex];
     if (vtkUnstructuredGrid::SafeDownCast(obj))
     {
       this->AppendUnstructuredGrids(
-        inputVector[0], inputIndex - 1, numInputs, iter, output);
+        inputVector[0], inputIndex, numInputs, iter, output);
     }
     else if (vtkPolyData::SafeDownCast(obj))
     {
       this->AppendPolyData(inputVector[0],
-        inputIndex - 1, numInputs, iter, output);
+        inputIndex, numInputs, iter, output);
     }
-    else if (vtkTable *table = vtkTable::SafeDownCast(obj))
+    else if (this->AppendedLeaves[this->CurrentLeaf])
     {
-      vtkTable *newTable = vtkTable::New();
-      newTable->ShallowCopy(table);
-      output->SetDataSet(iter, newTable);
-      newTable->Delete();
-    }
-    else if (vtkImageData* img = vtkImageData::SafeDownCast(obj))
-    {
-      vtkImageData* clone = img->NewInstance();
-      clone->ShallowCopy(img);
-      output->SetDataSet(iter, clone);
-      clone->FastDelete();
-    }
-    else if (vtkStructuredGrid* sg = vtkStructuredGrid::SafeDownCast(obj))
-    {
-      vtkStructuredGrid* clone = sg->NewInstance();
-      clone->ShallowCopy(sg);
-      output->SetDataSet(iter, clone);
-      clone->FastDelete();
-    }
-    else if (vtkRectilinearGrid* rg = vtkRectilinearGrid::SafeDownCast(obj))
-    {
-      vtkRectilinearGrid* clone = rg->NewInstance();
-      clone->ShallowCopy(rg);
-      output->SetDataSet(iter, clone);
-      clone->FastDelete();
+      output->SetDataSet(iter, this->AppendedLeaves[this->CurrentLeaf]);
     }
     else if (first)
     {
@@ -182,10 +299,64 @@ int vtkAppendCompositeDataLeaves::RequestData(
         << obj->GetClassName() << "\" which is not handled\n" );
     }
   }
-  first = true;
+  this->InputLeaves.clear();
+  this->AppendedLeaves.clear();
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataObject> vtkAppendCompositeDataLeaves::AppendLeaves(
+  const std::vector<vtkDataObject*>& leaves)
+{
+  // Locate the first input that has a non-null data-object at this location,
+  // if any; it determines how the leaves are combined.
+  vtkDataObject* obj = nullptr;
+  for (size_t idx = 0; idx < leaves.size() && !obj; ++idx)
+  {
+    obj = leaves[idx];
+  }
+  if (obj == nullptr)
+  {
+    return nullptr; // no input had a non-nullptr dataset
+  }
+
+  if (vtkUnstructuredGrid::SafeDownCast(obj))
+  {
+    vtkNew<vtkAppendFilter> appender;
+    for (vtkDataObject* leaf : leaves)
+    {
+      if (vtkUnstructuredGrid* iudset = vtkUnstructuredGrid::SafeDownCast(leaf))
+      {
+        appender->AddInputDataObject( iudset );
+      }
+    }
+    appender->Update();
+    return appender->GetOutputDataObject(0);
+  }
+  else if (vtkPolyData::SafeDownCast(obj))
+  {
+    vtkNew<vtkAppendPolyData> appender;
+    for (vtkDataObject* leaf : leaves)
+    {
+      if (vtkPolyData* ipdset = vtkPolyData::SafeDownCast(leaf))
+      {
+        appender->AddInputDataObject( ipdset );
+      }
+    }
+    appender->Update();
+    return appender->GetOutputDataObject(0);
+  }
+  else if (vtkTable::SafeDownCast(obj) || vtkImageData::SafeDownCast(obj) ||
+    vtkStructuredGrid::SafeDownCast(obj) || vtkRectilinearGrid::SafeDownCast(obj))
+  {
+    vtkSmartPointer<vtkDataObject> clone;
+    clone.TakeReference(obj->NewInstance());
+    clone->ShallowCopy(obj);
+    return clone;
+  }
+  return nullptr;
+}
+
 //----------------------------------------------------------------------------
 int vtkAppendCompositeDataLeaves::FillInputPortInformation( int, vtkInformation* info )
 {
@@ -206,24 +377,7 @@ void vtkAppendCompositeDataLeaves::AppendUnstructuredGrids(
   vtkInformationVector* inputVector,
   int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output )
 {
-  vtkNew<vtkAppendFilter> appender;
-
-  for ( int idx = i; idx < numInputs; ++ idx )
-  {
-    vtkCompositeDataSet* icdset= vtkCompositeDataSet::GetData(inputVector, idx);
-    if ( icdset )
-    {
-      vtkUnstructuredGrid* iudset = vtkUnstructuredGrid::SafeDownCast( icdset->GetDataSet( iter ) );
-      if ( iudset )
-      {
-        appender->AddInputDataObject( iudset );
-      }
-    }
-  }
-  appender->Update();
-  output->SetDataSet(iter, appender->GetOutputDataObject(0));
-  this->AppendFieldDataArrays(inputVector,
-    i, numInputs, iter, appender->GetOutput(0));
+  this->InsertAppendedLeaf(inputVector, i, numInputs, iter, output);
 }
 
 //----------------------------------------------------------------------------
@@ -231,25 +385,31 @@ void vtkAppendCompositeDataLeaves::AppendPolyData(
   vtkInformationVector* inputVector,
   int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output )
 {
-  vtkNew<vtkAppendPolyData> appender;
+  this->InsertAppendedLeaf(inputVector, i, numInputs, iter, output);
+}
 
-  for ( int idx = i; idx < numInputs; ++ idx )
+//----------------------------------------------------------------------------
+void vtkAppendCompositeDataLeaves::InsertAppendedLeaf(
+  vtkInformationVector* inputVector,
+  int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output )
+{
+  vtkSmartPointer<vtkDataObject> appended;
+  if (this->CurrentLeaf < this->AppendedLeaves.size())
   {
-    vtkCompositeDataSet* icdset= vtkCompositeDataSet::GetData(inputVector, idx);
-    if ( icdset )
-    {
-      vtkPolyData* ipdset = vtkPolyData::SafeDownCast( icdset->GetDataSet( iter ) );
-      if ( ipdset )
-      {
-        appender->AddInputDataObject( ipdset );
-      }
-    }
+    appended = this->AppendedLeaves[this->CurrentLeaf];
+  }
+  else
+  {
+    // Not called from RequestData(): append the leaves now.
+    std::vector<vtkDataObject*> leaves = GetLeavesAt(inputVector, numInputs, iter);
+    std::fill(leaves.begin(), leaves.begin() + i, nullptr);
+    appended = this->AppendLeaves(leaves);
+  }
+  output->SetDataSet(iter, appended);
+  if (vtkDataSet* dset = vtkDataSet::SafeDownCast(appended))
+  {
+    this->AppendFieldDataArrays(inputVector, i, numInputs, iter, dset);
   }
-
-  appender->Update();
-  output->SetDataSet(iter, appender->GetOutputDataObject(0));
-  this->AppendFieldDataArrays(inputVector,
-    i, numInputs, iter, appender->GetOutput(0));
 }
 
 //----------------------------------------------------------------------------
@@ -260,28 +420,29 @@ void vtkAppendCompositeDataLeaves::AppendFieldDataArrays(
   if ( ! this->AppendFieldData )
     return;
 
+  // During RequestData(), the inputs that are ignored have no leaves.
+  std::vector<vtkDataObject*> leaves =
+    this->CurrentLeaf < this->AppendedLeaves.size()
+    ? GetLeavesAt(this->InputLeaves, this->CurrentLeaf)
+    : GetLeavesAt(inputVector, numInputs, iter);
   vtkFieldData* ofd = odset->GetFieldData();
   for ( int idx = i; idx < numInputs; ++ idx )
   {
-    vtkCompositeDataSet* icdset= vtkCompositeDataSet::GetData(inputVector, idx);
-    if ( icdset )
+    vtkDataObject* idobj = leaves[idx];
+    if ( idobj )
     {
-      vtkDataObject* idobj = icdset->GetDataSet( iter );
-      if ( idobj )
+      vtkFieldData* ifd = idobj->GetFieldData();
+      int numArr = ifd->GetNumberOfArrays();
+      for ( int a = 0; a < numArr; ++ a )
       {
-        vtkFieldData* ifd = idobj->GetFieldData();
-        int numArr = ifd->GetNumberOfArrays();
-        for ( int a = 0; a < numArr; ++ a )
+        vtkAbstractArray* arr = ifd->GetAbstractArray( a );
+        if ( ofd->HasArray( arr->GetName() ) )
+        {
+          // Do something?
+        }
+        else
         {
-          vtkAbstractArray* arr = ifd->GetAbstractArray( a );
-          if ( ofd->HasArray( arr->GetName() ) )
-          {
-            // Do something?
-          }
-          else
-          {
-            ofd->AddArray( arr );
-          }
+          ofd->AddArray( arr );
         }
       }
     }
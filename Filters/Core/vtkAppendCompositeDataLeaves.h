@@ -47,6 +47,8 @@
  * Other types of leaf datasets will be ignored and their positions in the
  * output dataset will be nullptr pointers.
  *
+ * Leaf positions are appended in parallel using vtkSMPTools.
+ *
  * @sa
  * vtkAppendPolyData vtkAppendFilter
 */
@@ -56,8 +58,12 @@
 
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkCompositeDataSetAlgorithm.h"
+#include "vtkSmartPointer.h" // For vtkSmartPointer
+
+#include <vector> // For std::vector
 
 class vtkCompositeDataIterator;
+class vtkDataObject;
 class vtkDataSet;
 
 class VTKFILTERSCORE_EXPORT vtkAppendCompositeDataLeaves : public vtkCompositeDataSetAlgorithm
@@ -90,7 +96,9 @@ protected:
   int RequestDataObject( vtkInformation*, vtkInformationVector**, vtkInformationVector* ) override;
 
   /**
-   * Iterates over the datasets and appends corresponding notes.
+   * Iterates over the datasets and appends corresponding nodes. The leaf
+   * positions are first appended in parallel by AppendLeaves(), then the
+   * methods below insert the results into the output serially.
    */
   int RequestData( vtkInformation*, vtkInformationVector**, vtkInformationVector* ) override;
 
@@ -99,14 +107,29 @@ protected:
    */
   int FillInputPortInformation( int port, vtkInformation* info ) override;
 
+  /**
+   * Append the datasets found at one leaf position in all the inputs, given
+   * in input order (nullptr where an input has no data at that position), and
+   * return the dataset for that position in the output, or nullptr if the
+   * leaf type is not supported. Field data is added afterwards by
+   * AppendFieldDataArrays(). RequestData() calls this concurrently for
+   * different leaf positions through vtkCompositeDataSetSMPTools, so
+   * implementations must not modify state shared between leaves.
+   */
+  virtual vtkSmartPointer<vtkDataObject> AppendLeaves(const std::vector<vtkDataObject*>& leaves);
+
   /**
    * When leaf nodes are unstructured grids, this uses a vtkAppendFilter to merge them.
+   * The default implementation inserts the grid computed by AppendLeaves() for
+   * the position of @a iter.
    */
   virtual void AppendUnstructuredGrids(vtkInformationVector* inputVector,
     int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output );
 
   /**
    * When leaf nodes are polydata, this uses a vtkAppendPolyData to merge them.
+   * The default implementation inserts the polydata computed by AppendLeaves()
+   * for the position of @a iter.
    */
   virtual void AppendPolyData(vtkInformationVector* inputVector,
     int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output );
@@ -122,7 +145,19 @@ protected:
 
   vtkTypeBool AppendFieldData;
 
+  // Leaves of each input (none for the inputs that are ignored), results of
+  // AppendLeaves() by leaf index, and the index of the leaf being inserted,
+  // during RequestData().
+  std::vector<std::vector<vtkDataObject*> > InputLeaves;
+  std::vector<vtkSmartPointer<vtkDataObject> > AppendedLeaves;
+  size_t CurrentLeaf;
+
 private:
+  // Insert the result of AppendLeaves() for the position of iter, and its
+  // field data.
+  void InsertAppendedLeaf(vtkInformationVector* inputVector,
+    int i, int numInputs, vtkCompositeDataIterator* iter, vtkCompositeDataSet* output);
+
   vtkAppendCompositeDataLeaves ( const vtkAppendCompositeDataLeaves& ) = delete;
   void operator = ( const vtkAppendCompositeDataLeaves& ) = delete;
 };
@@ -400,11 +400,15 @@ struct CellIter
   const unsigned short *Cases;
   vtkIdType Incr;
 
-  // References to unstructured grid for cell traversal.
+  // References to unstructured grid for cell traversal. Types and Locs are
+  // null for grids with a single cell type; cells then have SingleType and
+  // are SingleIncr apart in the connectivity.
   vtkIdType NumCells;
   const unsigned char *Types;
   const vtkIdType *Conn;
   const vtkIdType *Locs;
+  unsigned char SingleType;
+  vtkIdType SingleIncr;
 
   // All possible cell types. The iterator switches between them when
   // processing. All unsupported cells are of type EmptyCell.
@@ -416,13 +420,15 @@ struct CellIter
   EmptyCell *Empty;
 
   CellIter() : Copy(true), Cell(nullptr), NumVerts(0), Cases(nullptr), Incr(0),
-               NumCells(0), Types(nullptr), Conn(nullptr), Locs(nullptr), Tet(nullptr),
+               NumCells(0), Types(nullptr), Conn(nullptr), Locs(nullptr),
+               SingleType(VTK_EMPTY_CELL), SingleIncr(0), Tet(nullptr),
                Hex(nullptr), Pyr(nullptr), Wedge(nullptr), Vox(nullptr), Empty(nullptr)
   {}
 
   CellIter(vtkIdType numCells, unsigned char *types, vtkIdType *conn, vtkIdType *locs) :
     Copy(false), Cell(nullptr), NumVerts(0), Cases(nullptr), Incr(0),
-    NumCells(numCells), Types(types), Conn(conn), Locs(locs)
+    NumCells(numCells), Types(types), Conn(conn), Locs(locs),
+    SingleType(VTK_EMPTY_CELL), SingleIncr(0)
   {
     this->Tet = new TetCell;
     this->Hex = new HexCell;
@@ -445,6 +451,14 @@ struct CellIter
     }
   }
 
+  // Traversal of a grid with a single cell type.
+  CellIter(vtkIdType numCells, int singleType, vtkIdType *conn) :
+    CellIter(numCells, nullptr, conn, nullptr)
+  {
+    this->SingleType = static_cast<unsigned char>(singleType);
+    this->SingleIncr = (numCells > 0 ? conn[0] + 1 : 0);
+  }
+
   CellIter(const CellIter &) = default; //remove compiler warnings
 
   // Shallow copy to avoid new/delete.
@@ -461,6 +475,8 @@ struct CellIter
     this->Types = cellIter.Types;
     this->Conn = cellIter.Conn;
     this->Locs = cellIter.Locs;
+    this->SingleType = cellIter.SingleType;
+    this->SingleIncr = cellIter.SingleIncr;
 
     this->Tet = cellIter.Tet;
     this->Hex = cellIter.Hex;
@@ -486,6 +502,15 @@ struct CellIter
   // modified by these methods, and then subsequently read during iteration.
   const vtkIdType* Initialize(vtkIdType cellId)
   {
+    if ( ! this->Types )
+    {
+      this->Cell = this->GetCell(this->SingleType);
+      this->NumVerts = this->Cell->NumVerts;
+      this->Cases = this->Cell->Cases;
+      this->Incr = this->SingleIncr;
+      return (this->Conn + cellId*this->SingleIncr + 1);
+    }
+
     this->Cell = this->GetCell(this->Types[cellId]);
     this->NumVerts = this->Cell->NumVerts;
     this->Cases = this->Cell->Cases;
@@ -508,7 +533,7 @@ struct CellIter
     // Guard against end of array condition; only update information if the
     // cell type changes. Note however that empty cells may have to be
     // treated specially.
-    if ( cellId >= (this->NumCells-1) ||
+    if ( cellId >= (this->NumCells-1) || ! this->Types ||
          (this->Cell->CellType != VTK_EMPTY_CELL &&
           this->Cell->CellType == this->Types[cellId+1]) )
     {
@@ -537,6 +562,13 @@ struct CellIter
   // Method for random access of cell, no caching
   const vtkIdType* GetCellIds(vtkIdType cellId)
   {
+    if ( ! this->Types )
+    {
+      this->Cell = this->GetCell(this->SingleType);
+      this->NumVerts = this->Cell->NumVerts;
+      this->Cases = this->Cell->Cases;
+      return (this->Conn + cellId*this->SingleIncr + 1);
+    }
     this->Cell = this->GetCell(this->Types[cellId]);
     this->NumVerts = this->Cell->NumVerts;
     this->Cases = this->Cell->Cases;
@@ -1759,10 +1791,20 @@ ProcessPiece(vtkUnstructuredGrid *input, vtkDataArray *inScalars, vtkPolyData *o
   vtkIdType totalTris = 0;
 
   // Set up the cells for processing. A specialized iterator is used to traverse the cells.
+  // Grids with a single cell type are traversed without the types and
+  // locations arrays.
   vtkIdType *conn = cells->GetPointer();
-  unsigned char *cellTypes = static_cast<unsigned char*>(input->GetCellTypesArray()->GetVoidPointer(0));
-  vtkIdType *locs = static_cast<vtkIdType*>(input->GetCellLocationsArray()->GetVoidPointer(0));
-  CellIter *cellIter = new CellIter(numCells,cellTypes,conn,locs);
+  CellIter *cellIter;
+  if ( input->GetSingleCellType() != VTK_EMPTY_CELL )
+  {
+    cellIter = new CellIter(numCells,input->GetSingleCellType(),conn);
+  }
+  else
+  {
+    unsigned char *cellTypes = static_cast<unsigned char*>(input->GetCellTypesArray()->GetVoidPointer(0));
+    vtkIdType *locs = static_cast<vtkIdType*>(input->GetCellLocationsArray()->GetVoidPointer(0));
+    cellIter = new CellIter(numCells,cellTypes,conn,locs);
+  }
 
   // Now produce the output: fast path or general path
   int mergePoints = this->MergePoints | this->ComputeNormals | this->InterpolateAttributes;
@@ -0,0 +1,226 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtractCellsDataViews.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts cells with vtkExtractCells and vtkExtractSelectedIds with and
+// without CopyDataAsViews, checks that both outputs hold the same data and
+// that the arrays of the second one are views.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkExtractCells.h"
+#include "vtkExtractSelectedIds.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkIndexedArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSelection.h"
+#include "vtkSelectionNode.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+
+namespace
+{
+
+void AddArrays(vtkDataSetAttributes* data, vtkIdType numTuples, const char* prefix)
+{
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName((std::string(prefix) + "Vectors").c_str());
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numTuples);
+  vtkNew<vtkIntArray> scalars;
+  scalars->SetName((std::string(prefix) + "Scalars").c_str());
+  scalars->SetNumberOfTuples(numTuples);
+  vtkNew<vtkIdTypeArray> globalIds;
+  globalIds->SetName((std::string(prefix) + "GlobalIds").c_str());
+  globalIds->SetNumberOfTuples(numTuples);
+  vtkNew<vtkStringArray> labels;
+  labels->SetName((std::string(prefix) + "Labels").c_str());
+  labels->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    vectors->SetTuple3(i, i, 2.0 * i, -0.5 * i);
+    scalars->SetValue(i, static_cast<int>(i % 17));
+    globalIds->SetValue(i, 1000 + i);
+    labels->SetValue(i, std::to_string(i));
+  }
+  data->AddArray(vectors);
+  data->SetScalars(scalars);
+  data->SetGlobalIds(globalIds);
+  data->AddArray(labels);
+}
+
+int CompareData(vtkDataSetAttributes* input, vtkDataSetAttributes* copied,
+  vtkDataSetAttributes* viewed, const char* name)
+{
+  int errors = 0;
+  if (copied->GetNumberOfArrays() != viewed->GetNumberOfArrays())
+  {
+    std::cerr << name << ": " << viewed->GetNumberOfArrays() << " arrays instead of "
+              << copied->GetNumberOfArrays() << "\n";
+    return 1;
+  }
+  for (int a = 0; a < copied->GetNumberOfArrays(); ++a)
+  {
+    vtkAbstractArray* expected = copied->GetAbstractArray(a);
+    vtkAbstractArray* array = viewed->GetAbstractArray(expected->GetName());
+    if (!array || array->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+      array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+    {
+      std::cerr << name << ": wrong array " << expected->GetName() << "\n";
+      ++errors;
+      continue;
+    }
+    for (vtkIdType v = 0; v < expected->GetNumberOfValues(); ++v)
+    {
+      if (array->GetVariantValue(v) != expected->GetVariantValue(v))
+      {
+        std::cerr << name << ": wrong value " << v << " in " << expected->GetName() << "\n";
+        ++errors;
+        break;
+      }
+    }
+    // Only plain data arrays of the input are viewed.
+    bool isView = array->GetArrayType() == vtkAbstractArray::ImplicitArray;
+    bool expectView = input->GetArray(expected->GetName()) != nullptr &&
+      expected != copied->GetGlobalIds() && expected->GetNumberOfTuples() > 0;
+    if (isView != expectView)
+    {
+      std::cerr << name << ": " << expected->GetName() << (isView ? " is" : " is not")
+                << " a view\n";
+      ++errors;
+    }
+  }
+  if ((copied->GetScalars() != nullptr) != (viewed->GetScalars() != nullptr) ||
+    (copied->GetGlobalIds() != nullptr) != (viewed->GetGlobalIds() != nullptr))
+  {
+    std::cerr << name << ": attributes lost\n";
+    ++errors;
+  }
+  return errors;
+}
+
+int CompareOutputs(vtkDataSet* input, vtkDataSet* copied, vtkDataSet* viewed, const char* name)
+{
+  if (copied->GetNumberOfCells() != viewed->GetNumberOfCells() ||
+    copied->GetNumberOfPoints() != viewed->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong number of cells or points\n";
+    return 1;
+  }
+  return CompareData(input->GetPointData(), copied->GetPointData(), viewed->GetPointData(), name) +
+    CompareData(input->GetCellData(), copied->GetCellData(), viewed->GetCellData(), name);
+}
+
+}
+
+int TestExtractCellsDataViews(int, char*[])
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(12, 10, 8);
+  AddArrays(image->GetPointData(), image->GetNumberOfPoints(), "Point");
+  AddArrays(image->GetCellData(), image->GetNumberOfCells(), "Cell");
+
+  vtkNew<vtkIdList> cellIds;
+  for (vtkIdType cellId = 5; cellId < image->GetNumberOfCells(); cellId += 7)
+  {
+    cellIds->InsertNextId(cellId);
+  }
+
+  int errors = 0;
+
+  // vtkExtractCells, from an image and from an unstructured grid.
+  vtkNew<vtkExtractCells> copy;
+  copy->SetInputData(image);
+  copy->SetCellList(cellIds);
+  copy->Update();
+  vtkNew<vtkExtractCells> view;
+  view->SetInputData(image);
+  view->SetCellList(cellIds);
+  view->CopyDataAsViewsOn();
+  view->Update();
+  errors += CompareOutputs(image, copy->GetOutput(), view->GetOutput(), "vtkExtractCells");
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->DeepCopy(copy->GetOutput());
+  vtkNew<vtkIdList> gridCellIds;
+  for (vtkIdType cellId = 0; cellId < grid->GetNumberOfCells(); cellId += 3)
+  {
+    gridCellIds->InsertNextId(cellId);
+  }
+  copy->SetInputData(grid);
+  copy->SetCellList(gridCellIds);
+  copy->Update();
+  view->SetInputData(grid);
+  view->SetCellList(gridCellIds);
+  view->Update();
+  errors += CompareOutputs(
+    grid, copy->GetOutput(), view->GetOutput(), "vtkExtractCells on vtkUnstructuredGrid");
+
+  // The views keep the values of the input when it is written through
+  // copy-on-write, and store them when the input is modified.
+  auto viewVectors = vtkArrayDownCast<vtkIndexedArray<double> >(
+    view->GetOutput()->GetPointData()->GetArray("PointVectors"));
+  if (!viewVectors || viewVectors->IsMaterialized())
+  {
+    std::cerr << "vtkExtractCells: PointVectors is not a view\n";
+    return EXIT_FAILURE;
+  }
+  double expected = viewVectors->GetComponent(1, 0);
+  vtkDataArray* inputVectors = grid->GetPointData()->GetArrayForWrite("PointVectors");
+  inputVectors->FillComponent(0, -1.0);
+  if (viewVectors->IsMaterialized() || viewVectors->GetComponent(1, 0) != expected)
+  {
+    std::cerr << "vtkExtractCells: view changed with its input\n";
+    ++errors;
+  }
+  inputVectors->Modified();
+  if (!viewVectors->IsMaterialized() || viewVectors->GetComponent(1, 0) != expected)
+  {
+    std::cerr << "vtkExtractCells: view changed with its input\n";
+    ++errors;
+  }
+
+  // vtkExtractSelectedIds
+  vtkNew<vtkIdTypeArray> selectedIds;
+  for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+  {
+    selectedIds->InsertNextValue(cellIds->GetId(i));
+  }
+  vtkNew<vtkSelectionNode> node;
+  node->SetContentType(vtkSelectionNode::INDICES);
+  node->SetFieldType(vtkSelectionNode::CELL);
+  node->SetSelectionList(selectedIds);
+  vtkNew<vtkSelection> selection;
+  selection->AddNode(node);
+
+  vtkNew<vtkExtractSelectedIds> selectCopy;
+  selectCopy->SetInputData(0, image);
+  selectCopy->SetInputData(1, selection);
+  selectCopy->Update();
+  vtkNew<vtkExtractSelectedIds> selectView;
+  selectView->SetInputData(0, image);
+  selectView->SetInputData(1, selection);
+  selectView->CopyDataAsViewsOn();
+  selectView->Update();
+  errors += CompareOutputs(image, vtkDataSet::SafeDownCast(selectCopy->GetOutput()),
+    vtkDataSet::SafeDownCast(selectView->GetOutput()), "vtkExtractSelectedIds");
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -338,7 +338,10 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
     std::iota(dstIds->GetPointer(0), dstIds->GetPointer(numPoints), 0);
 
     pts->InsertPoints(dstIds, this->CellList->PointMap.Map, pointSet->GetPoints());
-    newPD->CopyData(inPD, this->CellList->PointMap.Map, dstIds);
+    if (!this->CopyDataAsViews)
+    {
+      newPD->CopyData(inPD, this->CellList->PointMap.Map, dstIds);
+    }
   }
   else
   {
@@ -347,9 +350,16 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
     {
       vtkIdType oldId = this->CellList->PointMap.Map->GetId(newId);
       pts->SetPoint(newId, input->GetPoint(oldId));
-      newPD->CopyData(inPD, oldId, newId);
+      if (!this->CopyDataAsViews)
+      {
+        newPD->CopyData(inPD, oldId, newId);
+      }
     }
   }
+  if (this->CopyDataAsViews)
+  {
+    newPD->CopyDataAsViews(inPD, this->CellList->PointMap.Map);
+  }
 
   if (this->InputIsUgrid)
   {
@@ -369,10 +379,18 @@ int vtkExtractCells::RequestData(vtkInformation* vtkNotUsed(request),
 //----------------------------------------------------------------------------
 void vtkExtractCells::Copy(vtkDataSet* input, vtkUnstructuredGrid* output)
 {
-  // If input is unstructured grid just deep copy through
+  // If input is unstructured grid just deep copy through, or share
+  // everything when copying the data as views.
   if (this->InputIsUgrid)
   {
-    output->DeepCopy(vtkUnstructuredGrid::SafeDownCast(input));
+    if (this->CopyDataAsViews)
+    {
+      output->ShallowCopy(input);
+    }
+    else
+    {
+      output->DeepCopy(vtkUnstructuredGrid::SafeDownCast(input));
+    }
     return;
   }
 
@@ -396,7 +414,14 @@ void vtkExtractCells::Copy(vtkDataSet* input, vtkUnstructuredGrid* output)
   {
     pts->SetPoint(i, input->GetPoint(i));
   }
-  newPD->DeepCopy(inPD);
+  if (this->CopyDataAsViews)
+  {
+    newPD->ShallowCopy(inPD);
+  }
+  else
+  {
+    newPD->DeepCopy(inPD);
+  }
 
   vtkNew<vtkIdList> cellPoints;
   for (vtkIdType cellId = 0; cellId < numCells; cellId++)
@@ -404,7 +429,14 @@ void vtkExtractCells::Copy(vtkDataSet* input, vtkUnstructuredGrid* output)
     input->GetCellPoints(cellId, cellPoints);
     output->InsertNextCell(input->GetCellType(cellId), cellPoints);
   }
-  newCD->DeepCopy(inCD);
+  if (this->CopyDataAsViews)
+  {
+    newCD->ShallowCopy(inCD);
+  }
+  else
+  {
+    newCD->DeepCopy(inCD);
+  }
 
   output->Squeeze();
 }
@@ -534,12 +566,24 @@ void vtkExtractCells::CopyCellsDataSet(vtkDataSet* input, vtkUnstructuredGrid* o
     }
     vtkIdType newId = output->InsertNextCell(input->GetCellType(cellId), cellPoints);
 
-    newCD->CopyData(oldCD, cellId, newId);
+    if (!this->CopyDataAsViews)
+    {
+      newCD->CopyData(oldCD, cellId, newId);
+    }
     if (origMap)
     {
       origMap->InsertNextValue(cellId);
     }
   }
+
+  if (this->CopyDataAsViews)
+  {
+    vtkNew<vtkIdList> cellIds;
+    cellIds->SetNumberOfIds(static_cast<vtkIdType>(this->CellList->CellIds.size()));
+    std::copy(this->CellList->CellIds.begin(), this->CellList->CellIds.end(),
+      cellIds->GetPointer(0));
+    newCD->CopyDataAsViews(oldCD, cellIds);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -587,6 +631,7 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
 
   vtkIdType nextCellId = 0;
   vtkIdType nextFaceId = 0;
+  vtkNew<vtkIdList> viewIds;
 
   vtkIdType maxid = ugrid->GetNumberOfCells();
   bool havePolyhedron = false;
@@ -643,7 +688,14 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
       facesLocationArray->SetValue(nextCellId, -1);
     }
 
-    newCD->CopyData(oldCD, oldCellId, nextCellId);
+    if (this->CopyDataAsViews)
+    {
+      viewIds->InsertNextId(oldCellId);
+    }
+    else
+    {
+      newCD->CopyData(oldCD, oldCellId, nextCellId);
+    }
     if (origMap)
     {
       origMap->InsertNextValue(oldCellId);
@@ -651,6 +703,11 @@ void vtkExtractCells::CopyCellsUnstructuredGrid(vtkDataSet* input, vtkUnstructur
     nextCellId++;
   }
 
+  if (this->CopyDataAsViews)
+  {
+    newCD->CopyDataAsViews(oldCD, viewIds);
+  }
+
   if (havePolyhedron)
   {
     output->SetCells(typeArray, locationArray, cellArray, facesLocationArray, facesArray);
@@ -672,4 +729,5 @@ int vtkExtractCells::FillInputPortInformation(int, vtkInformation* info)
 void vtkExtractCells::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CopyDataAsViews: " << this->CopyDataAsViews << endl;
 }
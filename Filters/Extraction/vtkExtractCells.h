@@ -74,6 +74,20 @@ public:
    */
   vtkMTimeType GetMTime() override;
 
+  //@{
+  /**
+   * When on, the point and cell data arrays of the output are views of the
+   * input arrays instead of copies: no value is copied until an output array
+   * is written into or its input array is modified, and the views keep the
+   * values of the input at the time of the extraction. The ghost, global ids
+   * and pedigree ids arrays are still copied. Off by default.
+   * @sa vtkDataSetAttributes::CopyDataAsViews
+   */
+  vtkSetMacro(CopyDataAsViews, bool);
+  vtkGetMacro(CopyDataAsViews, bool);
+  vtkBooleanMacro(CopyDataAsViews, bool);
+  //@}
+
 protected:
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
   int FillInputPortInformation(int port, vtkInformation *info) override;
@@ -93,6 +107,7 @@ protected:
   vtkIdType SubSetUGridCellArraySize = 0;
   vtkIdType SubSetUGridFacesArraySize = 0;
   bool InputIsUgrid = false;
+  bool CopyDataAsViews = false;
 
 private:
   vtkExtractCells(const vtkExtractCells&) = delete;
@@ -22,6 +22,7 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -40,6 +41,7 @@ vtkStandardNewMacro(vtkExtractSelectedIds);
 vtkExtractSelectedIds::vtkExtractSelectedIds()
 {
   this->SetNumberOfInputPorts(2);
+  this->CopyDataAsViews = false;
 }
 
 //----------------------------------------------------------------------------
@@ -128,7 +130,8 @@ int vtkExtractSelectedIds::RequestData(
 
 // Copy the points marked as "in" and build a pointmap
 static void vtkExtractSelectedIdsCopyPoints(vtkDataSet* input,
-  vtkDataSet* output, signed char* inArray, vtkIdType* pointMap)
+  vtkDataSet* output, signed char* inArray, vtkIdType* pointMap,
+  bool views)
 {
   vtkPoints* newPts = vtkPoints::New();
 
@@ -143,12 +146,20 @@ static void vtkExtractSelectedIdsCopyPoints(vtkDataSet* input,
   outPD->SetCopyGlobalIds(1);
   outPD->CopyAllocate(inPD);
 
+  vtkNew<vtkIdList> viewIds;
   for (i = 0; i < numPts; i++)
   {
     if (inArray[i] > 0)
     {
       pointMap[i] = newPts->InsertNextPoint(input->GetPoint(i));
-      outPD->CopyData(inPD, i, pointMap[i]);
+      if (views)
+      {
+        viewIds->InsertNextId(i);
+      }
+      else
+      {
+        outPD->CopyData(inPD, i, pointMap[i]);
+      }
       originalPtIds->InsertNextValue(i);
     }
     else
@@ -156,6 +167,10 @@ static void vtkExtractSelectedIdsCopyPoints(vtkDataSet* input,
       pointMap[i] = -1;
     }
   }
+  if (views)
+  {
+    outPD->CopyDataAsViews(inPD, viewIds);
+  }
 
   outPD->AddArray(originalPtIds);
   originalPtIds->Delete();
@@ -168,7 +183,7 @@ static void vtkExtractSelectedIdsCopyPoints(vtkDataSet* input,
 // Copy the cells marked as "in" using the given pointmap
 template <class T>
 void vtkExtractSelectedIdsCopyCells(vtkDataSet* input, T* output,
-  signed char* inArray, vtkIdType* pointMap)
+  signed char* inArray, vtkIdType* pointMap, bool views)
 {
   vtkIdType numCells = input->GetNumberOfCells();
   output->Allocate(numCells / 4);
@@ -184,6 +199,7 @@ void vtkExtractSelectedIdsCopyCells(vtkDataSet* input, T* output,
 
   vtkIdType i, j, newId = 0;
   vtkIdList* ptIds = vtkIdList::New();
+  vtkNew<vtkIdList> viewIds;
   for (i = 0; i < numCells; i++)
   {
     if (inArray[i] > 0)
@@ -206,10 +222,21 @@ void vtkExtractSelectedIdsCopyCells(vtkDataSet* input, T* output,
         }
       }
       output->InsertNextCell(input->GetCellType(i), ptIds);
-      outCD->CopyData(inCD, i, newId++);
+      if (views)
+      {
+        viewIds->InsertNextId(i);
+      }
+      else
+      {
+        outCD->CopyData(inCD, i, newId++);
+      }
       originalIds->InsertNextValue(i);
     }
   }
+  if (views)
+  {
+    outCD->CopyDataAsViews(inCD, viewIds);
+  }
 
   outCD->AddArray(originalIds);
   originalIds->Delete();
@@ -747,19 +774,19 @@ int vtkExtractSelectedIds::ExtractCells(
   {
     vtkIdType *pointMap = new vtkIdType[numPts]; // maps old point ids into new
     vtkExtractSelectedIdsCopyPoints(input, output,
-      pointInArray->GetPointer(0), pointMap);
+      pointInArray->GetPointer(0), pointMap, this->CopyDataAsViews);
     this->UpdateProgress(0.75);
     if (output->GetDataObjectType() == VTK_POLY_DATA)
     {
       vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
         vtkPolyData::SafeDownCast(output),
-        cellInArray->GetPointer(0), pointMap);
+        cellInArray->GetPointer(0), pointMap, this->CopyDataAsViews);
     }
     else
     {
       vtkExtractSelectedIdsCopyCells<vtkUnstructuredGrid>(input,
         vtkUnstructuredGrid::SafeDownCast(output),
-        cellInArray->GetPointer(0), pointMap);
+        cellInArray->GetPointer(0), pointMap, this->CopyDataAsViews);
     }
     delete [] pointMap;
     this->UpdateProgress(1.0);
@@ -945,7 +972,7 @@ int vtkExtractSelectedIds::ExtractPoints(
   {
     vtkIdType *pointMap = new vtkIdType[numPts]; // maps old point ids into new
     vtkExtractSelectedIdsCopyPoints(input, output,
-      pointInArray->GetPointer(0), pointMap);
+      pointInArray->GetPointer(0), pointMap, this->CopyDataAsViews);
     this->UpdateProgress(0.75);
     if (containingCells)
     {
@@ -953,13 +980,13 @@ int vtkExtractSelectedIds::ExtractPoints(
       {
         vtkExtractSelectedIdsCopyCells<vtkPolyData>(input,
           vtkPolyData::SafeDownCast(output), cellInArray->GetPointer(0),
-          pointMap);
+          pointMap, this->CopyDataAsViews);
       }
       else
       {
         vtkExtractSelectedIdsCopyCells<vtkUnstructuredGrid>(input,
           vtkUnstructuredGrid::SafeDownCast(output),
-          cellInArray->GetPointer(0), pointMap);
+          cellInArray->GetPointer(0), pointMap, this->CopyDataAsViews);
       }
     }
     else
@@ -998,5 +1025,5 @@ int vtkExtractSelectedIds::ExtractPoints(
 void vtkExtractSelectedIds::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
-
+  os << indent << "CopyDataAsViews: " << this->CopyDataAsViews << endl;
 }
@@ -44,6 +44,20 @@ public:
   vtkTypeMacro(vtkExtractSelectedIds, vtkExtractSelectionBase);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When on, the point and cell data arrays of the output are views of the
+   * input arrays instead of copies: no value is copied until an output array
+   * is written into or its input array is modified, and the views keep the
+   * values of the input at the time of the extraction. The ghost, global ids
+   * and pedigree ids arrays are still copied. Off by default.
+   * @sa vtkDataSetAttributes::CopyDataAsViews
+   */
+  vtkSetMacro(CopyDataAsViews, bool);
+  vtkGetMacro(CopyDataAsViews, bool);
+  vtkBooleanMacro(CopyDataAsViews, bool);
+  //@}
+
 protected:
   vtkExtractSelectedIds();
   ~vtkExtractSelectedIds() override;
@@ -62,6 +76,8 @@ protected:
   int ExtractPoints(vtkSelectionNode *sel, vtkDataSet *input,
                     vtkDataSet *output);
 
+  bool CopyDataAsViews;
+
 private:
   vtkExtractSelectedIds(const vtkExtractSelectedIds&) = delete;
   void operator=(const vtkExtractSelectedIds&) = delete;
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeCellLocators.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Times the construction of the cell locators on a hexahedral mesh, and
+// checks that they all find the same cells. This benchmark is not run by
+// ctest: run it with
+//   vtkFiltersFlowPathsCxxTests TimeCellLocators
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+const int RES = 60; // cells per axis
+const int NUMBER_OF_QUERIES = 10000;
+
+}
+
+int TimeCellLocators(int, char*[])
+{
+  // A hexahedral mesh of the unit cube with jittered points
+  vtkMath::RandomSeed(314159);
+  const int np = RES + 1;
+  const double h = 1.0 / RES;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(np * np * np);
+  for (int k = 0, id = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i, ++id)
+      {
+        double x[3] = { i * h, j * h, k * h };
+        if (i > 0 && i < RES && j > 0 && j < RES && k > 0 && k < RES)
+        {
+          for (int c = 0; c < 3; ++c)
+          {
+            x[c] += vtkMath::Random(-0.2, 0.2) * h;
+          }
+        }
+        points->SetPoint(id, x);
+      }
+    }
+  }
+
+  vtkNew<vtkCellArray> hexes;
+  for (int k = 0; k < RES; ++k)
+  {
+    for (int j = 0; j < RES; ++j)
+    {
+      for (int i = 0; i < RES; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        hexes->InsertNextCell(8, hex);
+      }
+    }
+  }
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  grid->SetCells(VTK_HEXAHEDRON, hexes);
+
+  std::cout << "Timing " << grid->GetNumberOfCells() << " cells with "
+            << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  vtkNew<vtkCellTreeLocator> cellTree;
+  vtkNew<vtkModifiedBSPTree> bspTree;
+  vtkNew<vtkBVHCellLocator> bvh;
+  vtkAbstractCellLocator* locators[4] = { staticLocator, cellTree, bspTree, bvh };
+  const char* names[4] = { "StaticCellLocator", "CellTreeLocator", "ModifiedBSPTree",
+    "BVHCellLocator" };
+
+  vtkNew<vtkTimerLog> timer;
+  for (int l = 0; l < 4; ++l)
+  {
+    locators[l]->SetDataSet(grid);
+    locators[l]->LazyEvaluationOff();
+    locators[l]->CacheCellBoundsOn();
+    timer->StartTimer();
+    locators[l]->BuildLocator();
+    timer->StopTimer();
+    cout << "<DartMeasurement name=\"" << names[l] << "BuildTime\" type=\"numeric/double\">"
+         << timer->GetElapsedTime() << "</DartMeasurement>\n";
+  }
+
+  // All locators must find the cell that contains each query point.
+  int errors = 0;
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[8];
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3] = { vtkMath::Random(0.01, 0.99), vtkMath::Random(0.01, 0.99),
+      vtkMath::Random(0.01, 0.99) };
+    vtkIdType expected = staticLocator->FindCell(x, 0.0, cell, pcoords, weights);
+    for (int l = 1; l < 4; ++l)
+    {
+      vtkIdType found = locators[l]->FindCell(x, 0.0, cell, pcoords, weights);
+      if (found != expected)
+      {
+        std::cerr << names[l] << " found cell " << found << " instead of " << expected
+                  << " for (" << x[0] << ", " << x[1] << ", " << x[2] << ")\n";
+        ++errors;
+      }
+    }
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -18,7 +18,9 @@
 #include "vtkPolyData.h"
 #include "vtkGenericCell.h"
 #include "vtkIdListCollection.h"
+#include "vtkSMPTools.h"
 
+#include <atomic>
 #include <stack>
 #include <vector>
 #include <algorithm>
@@ -76,7 +78,7 @@ public:
 
 typedef cell_extents *cell_extents_List;
 
-static int global_list_count = 0;
+static std::atomic<int> global_list_count(0);
 
 class Sorted_cell_extents_Lists
 {
@@ -132,6 +134,375 @@ extern "C" int __compareMax(const void *pA, const void *B )
   }
 }
 
+//---------------------------------------------------------------------------
+// Builds the tree by recursive subdivision. The top of the tree is split
+// serially; the subtrees below are then built concurrently with vtkSMPTools,
+// each thread owning the sorted lists of its subtrees.
+class vtkModifiedBSPTreeBuilder
+{
+public:
+  // A node to subdivide and the sorted extents of its cells
+  struct Task
+  {
+    BSPNode                   *Node;
+    Sorted_cell_extents_Lists *Lists;
+    vtkIdType                  NumberOfCells;
+    int                        Depth;
+  };
+
+  struct Statistics
+  {
+    int NumberOfParentNodes = 0;
+    int NumberOfLeafNodes = 0;
+    int TotalDepth = 0;
+    int MaxDepth = 0;
+
+    void Merge(const Statistics &other)
+    {
+      this->NumberOfParentNodes += other.NumberOfParentNodes;
+      this->NumberOfLeafNodes += other.NumberOfLeafNodes;
+      this->TotalDepth += other.TotalDepth;
+      this->MaxDepth = std::max(this->MaxDepth, other.MaxDepth);
+    }
+  };
+
+  vtkModifiedBSPTreeBuilder(vtkModifiedBSPTree *tree, int maxlevel, vtkIdType maxCells)
+    : Tree(tree), MaxLevel(maxlevel), MaxCells(maxCells)
+  {
+  }
+
+  // Split the node of the task into up to three children and return their
+  // tasks, which own their lists. If the node is not split, it becomes a
+  // leaf and 0 is returned. The lists of the task are not deleted.
+  int Split(const Task &task, Task children[3], Statistics &stats);
+
+  // Serial recursive subdivision
+  void Subdivide(const Task &task, Statistics &stats)
+  {
+    Task children[3];
+    int numChildren = this->Split(task, children, stats);
+    for (int i=0; i<numChildren; i++)
+    {
+      this->Subdivide(children[i], stats);
+      delete children[i].Lists;
+    }
+  }
+
+  // Parallel subdivision. The lists of the root task are not deleted.
+  void Build(const Task &root, Statistics &stats);
+
+private:
+  void MakeLeaf(const Task &task, Statistics &stats);
+
+  vtkModifiedBSPTree *Tree;
+  int                 MaxLevel;
+  vtkIdType           MaxCells;
+};
+
+//---------------------------------------------------------------------------
+//
+// The main BSP subdivision routine : The code which does the division is only
+// a small part of this, the rest is just bookkeeping - it looks worse than it is.
+//
+int vtkModifiedBSPTreeBuilder::Split(const Task &task, Task children[3], Statistics &stats)
+{
+  BSPNode *node = task.Node;
+  Sorted_cell_extents_Lists *lists = task.Lists;
+  vtkIdType nCells = task.NumberOfCells;
+  int depth = task.Depth;
+  double (*cellBounds)[6] = this->Tree->CellBounds;
+  //
+  // We've got lists sorted on the axes, so we can easily get BBox
+  node->setMin( lists->Mins[0][0].min,
+                lists->Mins[1][0].min,
+                lists->Mins[2][0].min );
+  node->setMax( lists->Maxs[0][0].max,
+                lists->Maxs[1][0].max,
+                lists->Maxs[2][0].max );
+  // Update depth info
+  if (node->depth>stats.MaxDepth)
+  {
+    stats.MaxDepth = depth;
+  }
+  //
+  // Make sure child nodes are clear to start with
+  node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
+  //
+  // Do we want to subdivide this node ?
+  //
+  double pDiv = 0.0;
+  if ((nCells  > this->MaxCells) && (depth < this->MaxLevel))
+  {
+    // test for optimal subdivision
+    bool      found = false, abort = false;
+    int       Daxis;
+    vtkIdType TargetCount = (3*nCells)/4;
+    //
+    for (vtkIdType k,j=0; j<nCells && !found && !abort; j++)
+    {
+      // for each axis..
+      // test to see which x,y,z axis we should divide along
+      for (Daxis=node->mAxis, k=0; k<3; Daxis=(Daxis+1)%3, k++)
+      {
+        // eg for X axis, move left to right, and right to left
+        // when left overlaps right stop - at the same time, scan down and up
+        // in and out, and whichever crosses first - bingo !
+        if (lists->Mins[Daxis][j].min > lists->Maxs[Daxis][j].max)
+        {
+          pDiv = lists->Mins[Daxis][j].min - Epsilon_;
+          node->mAxis = Daxis;
+          found = true;
+          break;
+        }
+        else
+        {
+          // if we have searched more than 3/4 of the cells and still
+          // not found a good plane, then abort division for this node
+          if (j>=TargetCount)
+          {
+            abort = true;
+            break;
+          }
+        }
+      }
+    }
+    // construct the 3 children
+    if (found)
+    {
+      // The children start their search for a split plane on the axes
+      // following the one of their parent, so that the tree does not depend
+      // on the order in which the subtrees are built.
+      for (int i=0; i<3; i++)
+      {
+        node->mChild[i]    = new BSPNode();
+        node->mChild[i]->depth = node->depth+1;
+        node->mChild[i]->mAxis = (node->mAxis+i+1)%3;
+      }
+      Daxis = node->mAxis;
+      Sorted_cell_extents_Lists *left  = new Sorted_cell_extents_Lists(nCells);
+      Sorted_cell_extents_Lists *mid   = new Sorted_cell_extents_Lists(nCells);
+      Sorted_cell_extents_Lists *right = new Sorted_cell_extents_Lists(nCells);
+      // we ought to keep track of how many we are adding to each list
+      vtkIdType Cmin_l[3] = {0, 0, 0},
+                Cmin_m[3] = {0, 0, 0},
+                Cmin_r[3] = {0, 0, 0};
+      vtkIdType Cmax_l[3] = {0, 0, 0},
+                Cmax_m[3] = {0, 0, 0},
+                Cmax_r[3] = {0, 0, 0};
+      // Partition the cells into the correct child lists
+      // here we use the lists for the axis we're dividing along
+      for (vtkIdType i=0; i<nCells; i++)
+      {
+        // process the MIN-List
+        cell_extents ext = lists->Mins[Daxis][i];
+        // max is on left of middle node
+        if    (ext.max < pDiv)
+        {
+          left ->Mins[Daxis][Cmin_l[Daxis]++] = ext;
+        }
+        // min is on right of middle node
+        else if (ext.min > pDiv)
+        {
+          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
+        }
+        // neither - must be one of ours
+        else
+        {
+          mid  ->Mins[Daxis][Cmin_m[Daxis]++] = ext;
+        }
+        //
+        // process the MAX-List
+        ext = lists->Maxs[Daxis][i];
+        // max is on left of middle node
+        if    (ext.max < pDiv)
+        {
+          left ->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
+        }
+        // min is on right of middle node
+        else if (ext.min > pDiv)
+        {
+          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
+        }
+        // neither - must be one of ours
+        else
+        {
+          mid  ->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+        }
+      }
+      // construct the sorted list of extents for the 2 remaining axes
+      // do everything in order so our sorted lists aren't munged
+      for (Daxis=(node->mAxis+1)%3; Daxis!=node->mAxis; Daxis=(Daxis+1)%3)
+      {
+        for (vtkIdType i=0; i<nCells; i++)
+        {
+          // process the MIN-List
+          cell_extents ext = lists->Mins[Daxis][i];
+          if (cellBounds[ext.cell_ID][2*node->mAxis+1] < pDiv)
+          {
+            left ->Mins[Daxis][Cmin_l[Daxis]++] = ext;
+          }
+          else if (cellBounds[ext.cell_ID][2*node->mAxis] > pDiv)
+          {
+            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
+          }
+          else
+          {
+            mid  ->Mins[Daxis][Cmin_m[Daxis]++] = ext;
+          }
+          //
+          // process the MAX-List
+          ext = lists->Maxs[Daxis][i];
+          if (cellBounds[ext.cell_ID][2*node->mAxis+1] < pDiv)
+          {
+            left ->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
+          }
+          else if (cellBounds[ext.cell_ID][2*node->mAxis] > pDiv)
+          {
+            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
+          }
+          else
+          {
+            mid  ->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+          }
+        }
+      }
+      //
+      // Better check we didn't make a diddly
+      // this is overkill but for now I want a FULL DEBUG!
+      for (int i=0; i<3; i++)
+      {
+        if ( (Cmin_l[i] + Cmin_r[i] + Cmin_m[i])!=nCells )
+        {
+          vtkWarningWithObjectMacro(this->Tree, "Error count in min lists");
+        }
+        if ( (Cmax_l[i] + Cmax_r[i] + Cmax_m[i])!=nCells )
+        {
+          vtkWarningWithObjectMacro(this->Tree, "Error count in max lists");
+        }
+      }
+      //
+      // Bug : Can sometimes get unbalanced leaves
+      //
+      if (!Cmin_l[0] || !Cmin_r[0])
+      {
+        // clean up all the memory we allocated. Yikes.
+        for (int i=0; i<3; i++)
+        {
+          delete node->mChild[i];
+          node->mChild[i] = nullptr;
+        }
+        delete left;
+        delete mid;
+        delete right;
+      }
+      else
+      {
+        //
+        // And of course, we really ought to subdivide again - Hoorah!
+        // NB: it is possible for the middle node to be empty now, so check
+        // and delete if necessary
+        int numChildren = 0;
+        children[numChildren++] = Task{ node->mChild[0], left, Cmin_l[0], depth+1 };
+        if (Cmin_m[0])
+        {
+          children[numChildren++] = Task{ node->mChild[1], mid, Cmin_m[0], depth+1 };
+        }
+        else
+        {
+          delete node->mChild[1]; node->mChild[1] = nullptr;
+          delete mid;
+        }
+        children[numChildren++] = Task{ node->mChild[2], right, Cmin_r[0], depth+1 };
+        //
+        stats.NumberOfParentNodes += 1; // Parent node
+        //
+        // we've done all we were asked to do
+        //
+        return numChildren;
+      }
+    }
+  }
+  // if we got here, either no further subdivision is necessary,
+  // or we couldn't find a split plane...(or we aborted)
+  this->MakeLeaf(task, stats);
+  return 0;
+}
+
+//---------------------------------------------------------------------------
+void vtkModifiedBSPTreeBuilder::MakeLeaf(const Task &task, Statistics &stats)
+{
+  BSPNode *node = task.Node;
+  vtkIdType nCells = task.NumberOfCells;
+  //
+  // Copy the cell IDs into the actual node structure for proper use
+  node->num_cells = nCells;
+  stats.NumberOfLeafNodes += 1; // Leaf node
+  stats.TotalDepth += node->depth;
+  for (int i=0; i<6; i++)
+  {
+    node->sorted_cell_lists[i] = new vtkIdType[nCells];
+  }
+  //
+  for (int i=0; i<3; i++)
+  {
+    for (vtkIdType j=0; j<nCells; j++)
+    {
+      node->sorted_cell_lists[i*2][j]   = task.Lists->Mins[i][j].cell_ID;
+      node->sorted_cell_lists[i*2+1][j] = task.Lists->Maxs[i][j].cell_ID;
+    }
+  }
+  // Thank buggery that's all over.
+}
+
+//---------------------------------------------------------------------------
+void vtkModifiedBSPTreeBuilder::Build(const Task &root, Statistics &stats)
+{
+  // Split the top levels breadth first until there are enough subtrees to
+  // keep all threads busy. Subtrees with few cells are not split further.
+  const vtkIdType parallelCells = 32768;
+  const size_t numTasks = 4 * static_cast<size_t>(vtkSMPTools::GetEstimatedNumberOfThreads());
+  std::vector<Task> pending(1, root), subtrees;
+  while (!pending.empty() && pending.size() + subtrees.size() < numTasks)
+  {
+    std::vector<Task> next;
+    for (const Task &task : pending)
+    {
+      if (task.NumberOfCells <= parallelCells)
+      {
+        subtrees.push_back(task);
+        continue;
+      }
+      Task children[3];
+      int numChildren = this->Split(task, children, stats);
+      next.insert(next.end(), children, children+numChildren);
+      if (task.Lists != root.Lists)
+      {
+        delete task.Lists;
+      }
+    }
+    pending.swap(next);
+  }
+  subtrees.insert(subtrees.end(), pending.begin(), pending.end());
+
+  std::vector<Statistics> subtreeStats(subtrees.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1,
+    [this, &root, &subtrees, &subtreeStats](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i=begin; i<end; i++)
+    {
+      this->Subdivide(subtrees[i], subtreeStats[i]);
+      if (subtrees[i].Lists != root.Lists)
+      {
+        delete subtrees[i].Lists;
+      }
+    }
+  });
+  for (const Statistics &s : subtreeStats)
+  {
+    stats.Merge(s);
+  }
+}
+
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
 //---------------------------------------------------------------------------
@@ -197,7 +568,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = new BSPNode();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = 0;
   this->mRoot->depth = 0;
   //
   if (numCells==0)
@@ -208,33 +579,37 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   this->StoreCellBounds();
   //
   // sort the cells into 6 lists using structure for subdividing tests
+  // the six lists are independent, so they are filled and sorted in parallel
   Sorted_cell_extents_Lists *lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i=0; i<3; i++)
-  { // loop over each axis
-    for (vtkIdType j=0; j<numCells; j++)
-    { // loop over each cell
-      lists->Mins[i][j].min   = CellBounds[j][i*2];   // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max   = CellBounds[j][i*2+1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min   = CellBounds[j][i*2];
-      lists->Maxs[i][j].max   = CellBounds[j][i*2+1];
-      lists->Maxs[i][j].cell_ID = j;
+  double (*cellBounds)[6] = this->CellBounds;
+  vtkSMPTools::For(0, 6, 1, [lists, cellBounds, numCells](vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType l=begin; l<end; l++)
+    {
+      int i = static_cast<int>(l/2); // axis
+      cell_extents_List list = (l%2) ? lists->Maxs[i] : lists->Mins[i];
+      for (vtkIdType j=0; j<numCells; j++)
+      { // loop over each cell
+        list[j].min   = cellBounds[j][i*2];   // i=0 xmin, i=1 ymin, i=2 zmin
+        list[j].max   = cellBounds[j][i*2+1]; // i=0 xmax, i=1 ymax, i=2 zmax
+        list[j].cell_ID = j;
+      }
+      // Sort
+      qsort( list, numCells, sizeof(cell_extents), (l%2) ? __compareMax : __compareMin) ;
     }
-    // Sort
-    qsort( lists->Mins[i], numCells, sizeof(cell_extents), __compareMin) ;
-    qsort( lists->Maxs[i], numCells, sizeof(cell_extents), __compareMax) ;
-  }
+  });
   //
   // call the recursive subdivision routine
   //
   vtkDebugMacro( << "Beginning Subdivision" );
   //
-  if (numCells>0)
-  {
-    Subdivide(this->mRoot, lists, this->DataSet, numCells, 0,
-              this->MaxLevel, this->NumberOfCellsPerNode, this->Level);
-  }
+  vtkModifiedBSPTreeBuilder builder(this, this->MaxLevel, this->NumberOfCellsPerNode);
+  vtkModifiedBSPTreeBuilder::Statistics stats;
+  builder.Build(vtkModifiedBSPTreeBuilder::Task{ this->mRoot, lists, numCells, 0 }, stats);
+  this->npn += stats.NumberOfParentNodes;
+  this->nln += stats.NumberOfLeafNodes;
+  this->tot_depth += stats.TotalDepth;
+  this->Level = std::max(this->Level, stats.MaxDepth);
   delete lists;
   // Child nodes are responsible for freeing the temporary sorted lists
   //
@@ -249,281 +624,26 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 }
 
 //
-// The main BSP subdivision routine : The code which does the division is only
-// a small part of this, the rest is just bookkeeping - it looks worse than it is.
+// Serial subdivision of a node, kept for subclasses. BuildLocator() uses
+// vtkModifiedBSPTreeBuilder to subdivide the tree in parallel.
 //
 void vtkModifiedBSPTree::Subdivide(BSPNode *node,
                                    Sorted_cell_extents_Lists *lists,
-                                   vtkDataSet *dataset,
+                                   vtkDataSet *vtkNotUsed(dataset),
                                    vtkIdType nCells,
                                    int depth,
                                    int maxlevel,
                                    vtkIdType maxCells,
                                    int &MaxDepth)
 {
-  //
-  // We've got lists sorted on the axes, so we can easily get BBox
-  node->setMin( lists->Mins[0][0].min,
-                lists->Mins[1][0].min,
-                lists->Mins[2][0].min );
-  node->setMax( lists->Maxs[0][0].max,
-                lists->Maxs[1][0].max,
-                lists->Maxs[2][0].max );
-  // Update depth info
-  if (node->depth>MaxDepth)
-  {
-    MaxDepth = depth;
-  }
-  //
-  // Make sure child nodes are clear to start with
-  node->mChild[2] = node->mChild[1] = node->mChild[0] = nullptr;
-  //
-  // Do we want to subdivide this node ?
-  //
-  double pDiv = 0.0;
-  if ((nCells  > maxCells) && (depth < maxlevel))
-  {
-    // test for optimal subdivision
-    bool      found = false, abort = false;
-    int       Daxis;
-    vtkIdType TargetCount = (3*nCells)/4;
-    //
-    for (vtkIdType k,j=0; j<nCells && !found && !abort; j++)
-    {
-      // for each axis..
-      // test to see which x,y,z axis we should divide along
-      for (Daxis=node->mAxis, k=0; k<3; Daxis=(Daxis+1)%3, k++)
-      {
-        // eg for X axis, move left to right, and right to left
-        // when left overlaps right stop - at the same time, scan down and up
-        // in and out, and whichever crosses first - bingo !
-        if (lists->Mins[Daxis][j].min > lists->Maxs[Daxis][j].max)
-        {
-          pDiv = lists->Mins[Daxis][j].min - Epsilon_;
-          node->mAxis = Daxis;
-          found = true;
-          break;
-        }
-        else
-        {
-          // if we have searched more than 3/4 of the cells and still
-          // not found a good plane, then abort division for this node
-          if (j>=TargetCount)
-          {
-            // vtkDebugMacro("Aborted node division : excessive overlap : Cell count = " << nCells);
-            abort = true;
-            break;
-          }
-        }
-      }
-    }
-    // construct the 3 children
-    if (found)
-    {
-      for (int i=0; i<3; i++)
-      {
-        node->mChild[i]    = new BSPNode();
-        node->mChild[i]->depth = node->depth+1;
-        node->mChild[i]->mAxis = rand() % 3;
-      }
-      Daxis = node->mAxis;
-      Sorted_cell_extents_Lists *left  = new Sorted_cell_extents_Lists(nCells);
-      Sorted_cell_extents_Lists *mid   = new Sorted_cell_extents_Lists(nCells);
-      Sorted_cell_extents_Lists *right = new Sorted_cell_extents_Lists(nCells);
-      // we ought to keep track of how many we are adding to each list
-      vtkIdType Cmin_l[3] = {0, 0, 0},
-        Cmin_m[3] = {0, 0, 0},
-          Cmin_r[3] = {0, 0, 0};
-          vtkIdType Cmax_l[3] = {0, 0, 0},
-            Cmax_m[3] = {0, 0, 0},
-              Cmax_r[3] = {0, 0, 0};
-              // Partition the cells into the correct child lists
-              // here we use the lists for the axis we're dividing along
-              for (vtkIdType i=0; i<nCells; i++)
-              {
-                // process the MIN-List
-                cell_extents ext = lists->Mins[Daxis][i];
-                // max is on left of middle node
-                if    (ext.max < pDiv)
-                {
-                  left ->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-                }
-                // min is on right of middle node
-                else if (ext.min > pDiv)
-                {
-                  right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-                }
-                // neither - must be one of ours
-                else
-                {
-                  mid  ->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-                }
-                //
-                // process the MAX-List
-                ext = lists->Maxs[Daxis][i];
-                // max is on left of middle node
-                if    (ext.max < pDiv)
-                {
-                  left ->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-                }
-                // min is on right of middle node
-                else if (ext.min > pDiv)
-                {
-                  right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-                }
-                // neither - must be one of ours
-                else
-                {
-                  mid  ->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-                }
-              }
-              // construct the sorted list of extents for the 2 remaining axes
-              // do everything in order so our sorted lists aren't munged
-              for (Daxis=(node->mAxis+1)%3; Daxis!=node->mAxis; Daxis=(Daxis+1)%3)
-              {
-                for (vtkIdType i=0; i<nCells; i++)
-                {
-                  // process the MIN-List
-                  cell_extents ext = lists->Mins[Daxis][i];
-                  if (this->CellBounds[ext.cell_ID][2*node->mAxis+1] < pDiv)
-                  {
-                    left ->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-                  }
-                  else if (this->CellBounds[ext.cell_ID][2*node->mAxis] > pDiv)
-                  {
-                    right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-                  }
-                  else
-                  {
-                    mid  ->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-                  }
-                  //
-                  // process the MAX-List
-                  ext = lists->Maxs[Daxis][i];
-                  if (this->CellBounds[ext.cell_ID][2*node->mAxis+1] < pDiv)
-                  {
-                    left ->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-                  }
-                  else if (this->CellBounds[ext.cell_ID][2*node->mAxis] > pDiv)
-                  {
-                    right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-                  }
-                  else
-                  {
-                    mid  ->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-                  }
-                }
-              }
-              //
-              // Better check we didn't make a diddly
-              // this is overkill but for now I want a FULL DEBUG!
-              if ( (Cmin_l[0] + Cmin_r[0] + Cmin_m[0])!=nCells )
-              {
-                vtkWarningMacro("Error count in min lists");
-              }
-              if ( (Cmin_l[1] + Cmin_r[1] + Cmin_m[1])!=nCells )
-              {
-                vtkWarningMacro("Error count in min lists");
-              }
-              if ( (Cmin_l[2] + Cmin_r[2] + Cmin_m[2])!=nCells )
-              {
-                vtkWarningMacro("Error count in min lists");
-              }
-              if ( (Cmax_l[0] + Cmax_r[0] + Cmax_m[0])!=nCells )
-              {
-                vtkWarningMacro("Error count in max lists");
-              }
-              if ( (Cmax_l[1] + Cmax_r[1] + Cmax_m[1])!=nCells )
-              {
-                vtkWarningMacro("Error count in max lists");
-              }
-              if ( (Cmax_l[2] + Cmax_r[2] + Cmax_m[2])!=nCells )
-              {
-                vtkWarningMacro("Error count in max lists");
-              }
-              //
-              // Bug : Can sometimes get unbalanced leaves
-              //
-              if (!Cmin_l[0] || !Cmin_r[0])
-              {
-                // vtkDebugMacro(<<"Child 0 or 2 empty : Aborting subdivision for node " << Cmin_l[0] << " " << Cmin_m[0] << " " << Cmin_r[0]);
-                // clean up all the memory we allocated. Yikes.
-                for (int i=0; i<3; i++)
-                {
-                  delete node->mChild[i];
-                  node->mChild[i] = nullptr;
-                }
-                delete left;
-                delete mid;
-                delete right;
-              }
-              else
-              {
-                //
-                // Now we can delete the lists that the parent passed on to us
-                //
-                //
-                // And of course, we really ought to subdivide again - Hoorah!
-                // NB: it is possible for a node to be empty now, so check and delete if necessary
-                if (Cmin_l[0])
-                {
-                  Subdivide(node->mChild[0], left, dataset, Cmin_l[0], depth+1, maxlevel, maxCells, MaxDepth);
-                }
-                else
-                {
-                  vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
-                }
-                delete left;
-
-                if (Cmin_m[0])
-                {
-                  Subdivide(node->mChild[1], mid,  dataset, Cmin_m[0], depth+1, maxlevel, maxCells, MaxDepth);
-                }
-                else
-                {
-                  delete node->mChild[1]; node->mChild[1] = nullptr;
-                }
-                delete mid;
-
-                if (Cmin_r[0])
-                {
-                  Subdivide(node->mChild[2], right,dataset, Cmin_r[0], depth+1, maxlevel, maxCells, MaxDepth);
-                }
-                else
-                {
-                  vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
-                }
-                delete right;
-                //
-                npn += 1; // Parent node
-                //
-                // we've done all we were asked to do
-                //
-                return;
-              }
-    }
-  }
-  // if we got here, either no further subdivision is necessary,
-  // or we couldn't find a split plane...(or we aborted)
-  //
-  // Copy the cell IDs into the actual node structure for proper use
-  node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
-  for (int i=0; i<6; i++)
-  {
-    node->sorted_cell_lists[i] = new vtkIdType[nCells];
-  }
-  //
-  for (int i=0; i<3; i++)
-  {
-    for (vtkIdType j=0; j<nCells; j++)
-    {
-      node->sorted_cell_lists[i*2][j]   = lists->Mins[i][j].cell_ID;
-      node->sorted_cell_lists[i*2+1][j] = lists->Maxs[i][j].cell_ID;
-    }
-  }
-  // Thank buggery that's all over.
+  vtkModifiedBSPTreeBuilder builder(this, maxlevel, maxCells);
+  vtkModifiedBSPTreeBuilder::Statistics stats;
+  stats.MaxDepth = MaxDepth;
+  builder.Subdivide(vtkModifiedBSPTreeBuilder::Task{ node, lists, nCells, depth }, stats);
+  this->npn += stats.NumberOfParentNodes;
+  this->nln += stats.NumberOfLeafNodes;
+  this->tot_depth += stats.TotalDepth;
+  MaxDepth = stats.MaxDepth;
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -149,6 +149,7 @@
 
 class Sorted_cell_extents_Lists;
 class BSPNode;
+class vtkModifiedBSPTreeBuilder;
 class vtkGenericCell;
 class vtkIdList;
 class vtkIdListCollection;
@@ -258,6 +259,8 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
   void BuildLocatorInternal();
+
+  friend class vtkModifiedBSPTreeBuilder;
 private:
   vtkModifiedBSPTree(const vtkModifiedBSPTree&) = delete;
   void operator=(const vtkModifiedBSPTree&) = delete;
@@ -313,6 +316,7 @@ class BSPNode {
       double &rTmin, double &rTmax) const;
     //
     friend class vtkModifiedBSPTree;
+    friend class vtkModifiedBSPTreeBuilder;
     friend class vtkParticleBoxTree;
   public:
   static bool VTKFILTERSFLOWPATHS_EXPORT RayMinMaxT(
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsIncrementalUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Moves the points of a hexahedral mesh and checks that the cell locators
+// updated with IncrementalUpdateOn() find the same cells as a locator built
+// from scratch, including when the connectivity changes or the mesh leaves
+// its initial bounds and the locators must be rebuilt. Also checks that the
+// locators refit their search structures when only the points moved.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkCellType.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+const int RES = 16; // cells per axis
+const int NUMBER_OF_QUERIES = 2000;
+
+// Counts the search structures freed, which a rebuild of a built locator
+// does and a refit does not.
+template <class LocatorT>
+class CountingLocator : public LocatorT
+{
+public:
+  static CountingLocator* New() { VTK_STANDARD_NEW_BODY(CountingLocator); }
+  vtkTemplateTypeMacro(CountingLocator, LocatorT);
+
+  void FreeSearchStructure() override
+  {
+    ++this->NumberOfFrees;
+    this->LocatorT::FreeSearchStructure();
+  }
+
+  int NumberOfFrees = 0;
+};
+
+int GetNumberOfFrees(vtkAbstractCellLocator* locator)
+{
+  if (auto l = CountingLocator<vtkStaticCellLocator>::SafeDownCast(locator))
+  {
+    return l->NumberOfFrees;
+  }
+  if (auto l = CountingLocator<vtkCellTreeLocator>::SafeDownCast(locator))
+  {
+    return l->NumberOfFrees;
+  }
+  return CountingLocator<vtkBVHCellLocator>::SafeDownCast(locator)->NumberOfFrees;
+}
+
+// Displace the interior points of the mesh; the boundary does not move.
+void MovePoints(vtkPoints* points, double amplitude, double scale)
+{
+  const int np = RES + 1;
+  const double h = 1.0 / RES;
+  for (int k = 0, id = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i, ++id)
+      {
+        double x[3] = { i * h, j * h, k * h };
+        double s = std::sin(vtkMath::Pi() * x[0]) * std::sin(vtkMath::Pi() * x[1]) *
+          std::sin(vtkMath::Pi() * x[2]);
+        x[0] += amplitude * h * s;
+        x[1] -= 0.5 * amplitude * h * s;
+        points->SetPoint(id, scale * x[0], scale * x[1], scale * x[2]);
+      }
+    }
+  }
+  points->Modified();
+}
+
+// Hexahedra numbered in increasing or decreasing order.
+void SetCells(vtkUnstructuredGrid* grid, bool reversed)
+{
+  const int np = RES + 1;
+  vtkNew<vtkCellArray> hexes;
+  for (int c = 0; c < RES * RES * RES; ++c)
+  {
+    int id = reversed ? RES * RES * RES - 1 - c : c;
+    int i = id % RES, j = (id / RES) % RES, k = id / (RES * RES);
+    vtkIdType p0 = i + np * (j + np * k);
+    vtkIdType hex[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+      p0 + 1 + np + np * np, p0 + np + np * np };
+    hexes->InsertNextCell(8, hex);
+  }
+  grid->SetCells(VTK_HEXAHEDRON, hexes);
+}
+
+int CheckLocators(vtkUnstructuredGrid* grid, vtkAbstractCellLocator* locators[3],
+  const char* names[3], const char* step, const bool* rebuilds)
+{
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(grid);
+  reference->BuildLocator();
+  int errors = 0;
+  for (int l = 0; l < 3; ++l)
+  {
+    const int numberOfFrees = GetNumberOfFrees(locators[l]);
+    locators[l]->BuildLocator();
+    const bool rebuilt = GetNumberOfFrees(locators[l]) != numberOfFrees;
+    if (rebuilds && rebuilt != rebuilds[l])
+    {
+      std::cerr << step << ": " << names[l] << (rebuilt ? " was rebuilt" : " was not rebuilt")
+                << "\n";
+      ++errors;
+    }
+  }
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(4321);
+  vtkNew<vtkGenericCell> cell;
+  double pcoords[3], weights[8];
+  const double* bounds = grid->GetBounds();
+  for (int q = 0; q < NUMBER_OF_QUERIES; ++q)
+  {
+    double x[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = random->GetRangeValue(bounds[2 * i], bounds[2 * i + 1]);
+      random->Next();
+    }
+    vtkIdType expected = reference->FindCell(x, 0.0, cell, pcoords, weights);
+    for (int l = 0; l < 3; ++l)
+    {
+      vtkIdType found = locators[l]->FindCell(x, 0.0, cell, pcoords, weights);
+      if (found != expected)
+      {
+        std::cerr << step << ": " << names[l] << " found cell " << found << " instead of "
+                  << expected << "\n";
+        ++errors;
+      }
+    }
+  }
+  return errors;
+}
+
+}
+
+int TestCellLocatorsIncrementalUpdate(int, char*[])
+{
+  const int np = RES + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(np * np * np);
+  MovePoints(points, 0.0, 1.0);
+  vtkNew<vtkUnstructuredGrid> grid;
+  grid->SetPoints(points);
+  SetCells(grid, false);
+
+  vtkNew<CountingLocator<vtkStaticCellLocator> > staticLocator;
+  vtkNew<CountingLocator<vtkCellTreeLocator> > cellTree;
+  vtkNew<CountingLocator<vtkBVHCellLocator> > bvh;
+  vtkAbstractCellLocator* locators[3] = { staticLocator, cellTree, bvh };
+  const char* names[3] = { "vtkStaticCellLocator", "vtkCellTreeLocator", "vtkBVHCellLocator" };
+  for (int l = 0; l < 3; ++l)
+  {
+    locators[l]->SetDataSet(grid);
+    locators[l]->IncrementalUpdateOn();
+  }
+
+  // Whether each locator is expected to be rebuilt rather than refitted.
+  const bool rebuild[3] = { true, true, true };
+  const bool refit[3] = { false, false, false };
+  int errors = CheckLocators(grid, locators, names, "Initial build", nullptr);
+
+  // Small motions keep most cells in their bins, larger ones do not.
+  MovePoints(points, 0.1, 1.0);
+  errors += CheckLocators(grid, locators, names, "Small displacement", refit);
+  MovePoints(points, 0.8, 1.0);
+  errors += CheckLocators(grid, locators, names, "Large displacement", refit);
+
+  // Same number of cells but different connectivity: the cell ids change.
+  SetCells(grid, true);
+  MovePoints(points, 0.4, 1.0);
+  errors += CheckLocators(grid, locators, names, "New connectivity", rebuild);
+
+  // The mesh grows beyond the initial bounds: the bins no longer cover it,
+  // while the trees are refitted.
+  MovePoints(points, 0.4, 1.5);
+  const bool expansion[3] = { true, false, false };
+  errors += CheckLocators(grid, locators, names, "Expansion", expansion);
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -29,6 +29,8 @@
 #include "vtkPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 
 vtkStandardNewMacro(vtkCellTreeLocator);
 
@@ -37,6 +39,8 @@ namespace
   const double EPSILON_= 1E-8;
   enum { POS_X, NEG_X, POS_Y, NEG_Y, POS_Z, NEG_Z };
   #define CELLTREE_MAX_DEPTH 32
+  // Ranges of cells larger than this are scanned in parallel
+  #define CELLTREE_PARALLEL_SIZE 32768
 }
 
 // -------------------------------------------------------------------------
@@ -217,6 +221,28 @@ class vtkCellTreeBuilder
           Max = _max;
         }
       }
+
+      void Merge( const Bucket& other )
+      {
+        Cnt += other.Cnt;
+
+        if( other.Min < Min )
+        {
+          Min = other.Min;
+        }
+
+        if( other.Max > Max )
+        {
+          Max = other.Max;
+        }
+      }
+    };
+
+    static const int NumberOfBuckets = 6;
+
+    struct Buckets
+    {
+      Bucket b[3][NumberOfBuckets];
     };
 
     struct PerCell
@@ -226,6 +252,42 @@ class vtkCellTreeBuilder
       unsigned int Ind;
     };
 
+    struct MinMax
+    {
+      float Min[3];
+      float Max[3];
+
+      MinMax()
+      {
+        for( unsigned int d=0; d<3; ++d )
+        {
+          Min[d] =  std::numeric_limits<float>::max();
+          Max[d] = -std::numeric_limits<float>::max();
+        }
+      }
+
+      void Add( const PerCell* begin, const PerCell* end )
+      {
+        for( ; begin!=end; ++begin )
+        {
+          for( unsigned int d=0; d<3; ++d )
+          {
+            if( begin->Min[d] < Min[d] )    Min[d] = begin->Min[d];
+            if( begin->Max[d] > Max[d] )    Max[d] = begin->Max[d];
+          }
+        }
+      }
+
+      void Merge( const MinMax& other )
+      {
+        for( unsigned int d=0; d<3; ++d )
+        {
+          if( other.Min[d] < Min[d] )    Min[d] = other.Min[d];
+          if( other.Max[d] > Max[d] )    Max[d] = other.Max[d];
+        }
+      }
+    };
+
     struct CenterOrder
     {
       unsigned int d;
@@ -249,77 +311,128 @@ class vtkCellTreeBuilder
       }
     };
 
+    // A subtree whose construction is handed over to a single thread.
+    struct SubtreeTask
+    {
+      unsigned int Index;
+      float Min[3];
+      float Max[3];
+    };
+
+    typedef std::vector<vtkCellTreeLocator::vtkCellTreeNode> NodeVector;
 
     // -------------------------------------------------------------------------
 
-    void FindMinMax( const PerCell* begin, const PerCell* end,
-      float* min, float* max )
+    // The min/max values are order independent, so the parallel scan gives
+    // the same result as the serial one.
+    static void FindMinMax( const PerCell* begin, const PerCell* end,
+      float* min, float* max, bool parallel )
     {
       if( begin == end )
       {
         return;
       }
 
+      MinMax result;
+      if( parallel && end - begin > CELLTREE_PARALLEL_SIZE )
+      {
+        vtkSMPThreadLocal<MinMax> local;
+        vtkSMPTools::For( 0, end - begin, [begin, &local]( vtkIdType first, vtkIdType last )
+        {
+          local.Local().Add( begin + first, begin + last );
+        });
+        for( const MinMax& mm : local )
+        {
+          result.Merge( mm );
+        }
+      }
+      else
+      {
+        result.Add( begin, end );
+      }
+
       for( unsigned int d=0; d<3; ++d )
       {
-        min[d] = begin->Min[d];
-        max[d] = begin->Max[d];
+        min[d] = result.Min[d];
+        max[d] = result.Max[d];
       }
+    }
 
+    // -------------------------------------------------------------------------
 
-      while( ++begin != end )
+    static void AddToBuckets( Buckets& buckets, const PerCell* begin, const PerCell* end,
+      const float min[3], const float iext[3] )
+    {
+      for( const PerCell* pc=begin; pc!=end; ++pc )
       {
         for( unsigned int d=0; d<3; ++d )
         {
-          if( begin->Min[d] < min[d] )    min[d] = begin->Min[d];
-          if( begin->Max[d] > max[d] )    max[d] = begin->Max[d];
+          float cen = (pc->Min[d] + pc->Max[d])/2.0f;
+          int   ind = (int)( (cen-min[d])*iext[d] );
+
+          if( ind<0 )
+          {
+            ind = 0;
+          }
+
+          if( ind>=NumberOfBuckets )
+          {
+            ind = NumberOfBuckets-1;
+          }
+
+          buckets.b[d][ind].Add( pc->Min[d], pc->Max[d] );
         }
       }
     }
 
     // -------------------------------------------------------------------------
 
-    void Split( unsigned int index, float min[3], float max[3] )
+    // Split the leaf nodes[index] in two, returning false if it is small
+    // enough to stay a leaf. The children are appended to nodes.
+    bool SplitNode( NodeVector& nodes, unsigned int index, const float min[3], const float max[3],
+      float lmin[3], float lmax[3], float rmin[3], float rmax[3], bool parallel )
     {
-      unsigned int start = this->m_nodes[index].Start();
-      unsigned int size  = this->m_nodes[index].Size();
+      unsigned int start = nodes[index].Start();
+      unsigned int size  = nodes[index].Size();
 
       if( size < this->m_leafsize )
       {
-        return;
+        return false;
       }
 
       PerCell* begin = &(this->m_pc[start]);
       PerCell* end   = &(this->m_pc[0])+start + size;
       PerCell* mid = begin;
 
-      const int nbuckets = 6;
+      const int nbuckets = NumberOfBuckets;
 
       const float ext[3] = { max[0]-min[0], max[1]-min[1], max[2]-min[2] };
       const float iext[3] = { nbuckets/ext[0], nbuckets/ext[1], nbuckets/ext[2] };
 
-      Bucket b[3][nbuckets];
-
-      for( const PerCell* pc=begin; pc!=end; ++pc )
+      Buckets buckets;
+      if( parallel && size > CELLTREE_PARALLEL_SIZE )
       {
-        for( unsigned int d=0; d<3; ++d )
+        vtkSMPThreadLocal<Buckets> local;
+        vtkSMPTools::For( 0, size, [begin, min, &iext, &local]( vtkIdType first, vtkIdType last )
         {
-          float cen = (pc->Min[d] + pc->Max[d])/2.0f;
-          int   ind = (int)( (cen-min[d])*iext[d] );
-
-          if( ind<0 )
-          {
-            ind = 0;
-          }
-
-          if( ind>=nbuckets )
+          AddToBuckets( local.Local(), begin + first, begin + last, min, iext );
+        });
+        for( const Buckets& l : local )
+        {
+          for( unsigned int d=0; d<3; ++d )
           {
-            ind = nbuckets-1;
+            for( int n=0; n<nbuckets; ++n )
+            {
+              buckets.b[d][n].Merge( l.b[d][n] );
+            }
           }
-
-          b[d][ind].Add( pc->Min[d], pc->Max[d] );
         }
       }
+      else
+      {
+        AddToBuckets( buckets, begin, end, min, iext );
+      }
+      const Bucket (&b)[3][NumberOfBuckets] = buckets.b;
 
       float cost = std::numeric_limits<float>::max();
       float plane = VTK_FLOAT_MIN; // bad value in case it doesn't get setx
@@ -331,22 +444,22 @@ class vtkCellTreeBuilder
 
         for( unsigned int n=0; n< (unsigned int)nbuckets-1; ++n )
         {
-          float lmax = -std::numeric_limits<float>::max();
-          float rmin =  std::numeric_limits<float>::max();
+          float lmaxd = -std::numeric_limits<float>::max();
+          float rmind =  std::numeric_limits<float>::max();
 
           for( unsigned int m=0; m<=n; ++m )
           {
-            if( b[d][m].Max > lmax )
+            if( b[d][m].Max > lmaxd )
             {
-              lmax = b[d][m].Max;
+              lmaxd = b[d][m].Max;
             }
           }
 
           for( unsigned int m=n+1; m< (unsigned int) nbuckets; ++m )
           {
-            if( b[d][m].Min < rmin )
+            if( b[d][m].Min < rmind )
             {
-              rmin = b[d][m].Min;
+              rmind = b[d][m].Min;
             }
           }
 
@@ -354,13 +467,13 @@ class vtkCellTreeBuilder
           // JB : added if (...) to stop floating point error if rmin is unset
           // this happens when some buckets are empty (bad volume calc)
           //
-          if (lmax != -std::numeric_limits<float>::max() &&
-              rmin !=  std::numeric_limits<float>::max())
+          if (lmaxd != -std::numeric_limits<float>::max() &&
+              rmind !=  std::numeric_limits<float>::max())
           {
               sum += b[d][n].Cnt;
 
-              float lvol = (lmax-min[d])/ext[d];
-              float rvol = (max[d]-rmin)/ext[d];
+              float lvol = (lmaxd-min[d])/ext[d];
+              float rvol = (max[d]-rmind)/ext[d];
 
               float c = lvol*sum + rvol*(size-sum);
 
@@ -388,10 +501,8 @@ class vtkCellTreeBuilder
         std::nth_element( begin, mid, end, CenterOrder( dim ) );
       }
 
-      float lmin[3], lmax[3], rmin[3], rmax[3];
-
-      FindMinMax( begin, mid, lmin, lmax );
-      FindMinMax( mid,   end, rmin, rmax );
+      FindMinMax( begin, mid, lmin, lmax, parallel );
+      FindMinMax( mid,   end, rmin, rmax, parallel );
 
       float clip[2] = { lmax[dim], rmin[dim]};
 
@@ -399,71 +510,159 @@ class vtkCellTreeBuilder
       child[0].MakeLeaf( begin - &(this->m_pc[0]), mid-begin );
       child[1].MakeLeaf( mid   - &(this->m_pc[0]), end-mid );
 
-      this->m_nodes[index].MakeNode( (int)m_nodes.size(), dim, clip );
-      this->m_nodes.insert( m_nodes.end(), child, child+2 );
-
-      Split( this->m_nodes[index].GetLeftChildIndex(), lmin, lmax );
-      Split( this->m_nodes[index].GetRightChildIndex(), rmin, rmax );
+      nodes[index].MakeNode( (int)nodes.size(), dim, clip );
+      nodes.insert( nodes.end(), child, child+2 );
+      return true;
     }
 
-  public:
+    // -------------------------------------------------------------------------
 
-    vtkCellTreeBuilder()
+    void Split( NodeVector& nodes, unsigned int index, float min[3], float max[3] )
     {
-      this->m_buckets =  5;
-      this->m_leafsize = 8;
+      float lmin[3], lmax[3], rmin[3], rmax[3];
+
+      if( !this->SplitNode( nodes, index, min, max, lmin, lmax, rmin, rmax, false ) )
+      {
+        return;
+      }
+
+      Split( nodes, nodes[index].GetLeftChildIndex(), lmin, lmax );
+      Split( nodes, nodes[index].GetRightChildIndex(), rmin, rmax );
     }
 
-    void Build( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
-    {
-      const vtkIdType size = ds->GetNumberOfCells();
-      double cellBounds[6];
-      this->m_pc.resize(size);
+    // -------------------------------------------------------------------------
 
-      float min[3] =
-        {
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max(),
-        std::numeric_limits<float>::max()
-        };
+    // Split the top of the tree, scanning the cells in parallel, until there
+    // are enough subtrees to keep all threads busy. The subtrees are then
+    // built concurrently, each on its own range of m_pc and into its own
+    // node array, and appended to m_nodes. Since the final node order is set
+    // by the breadth-first copy in Build(), the tree is the same as the one
+    // built serially.
+    void ParallelSplit( float min[3], float max[3] )
+    {
+      std::vector<SubtreeTask> pending(1), subtrees;
+      pending[0].Index = 0;
+      std::copy( min, min+3, pending[0].Min );
+      std::copy( max, max+3, pending[0].Max );
 
-      float max[3] =
+      const size_t numTasks = 4 * static_cast<size_t>( vtkSMPTools::GetEstimatedNumberOfThreads() );
+      while( !pending.empty() && pending.size() + subtrees.size() < numTasks )
+      {
+        std::vector<SubtreeTask> next;
+        for( const SubtreeTask& task : pending )
         {
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        -std::numeric_limits<float>::max(),
-        };
+          if( this->m_nodes[task.Index].Size() <= CELLTREE_PARALLEL_SIZE )
+          {
+            subtrees.push_back( task );
+            continue;
+          }
+          SubtreeTask left, right;
+          if( this->SplitNode( this->m_nodes, task.Index, task.Min, task.Max,
+                               left.Min, left.Max, right.Min, right.Max, true ) )
+          {
+            left.Index  = this->m_nodes[task.Index].GetLeftChildIndex();
+            right.Index = this->m_nodes[task.Index].GetRightChildIndex();
+            next.push_back( left );
+            next.push_back( right );
+          }
+        }
+        pending.swap( next );
+      }
+      subtrees.insert( subtrees.end(), pending.begin(), pending.end() );
 
-      for( vtkIdType i=0; i<size; ++i )
+      std::vector<NodeVector> local( subtrees.size() );
+      vtkSMPTools::For( 0, static_cast<vtkIdType>(subtrees.size()), 1,
+        [this, &subtrees, &local]( vtkIdType first, vtkIdType last )
       {
-        this->m_pc[i].Ind = i;
-
-        double *boundsPtr = cellBounds;
-        if (ctl->CellBounds)
+        for( vtkIdType i=first; i<last; ++i )
         {
-          boundsPtr = ctl->CellBounds[i];
+          SubtreeTask task = subtrees[i];
+          local[i].assign( 1, this->m_nodes[task.Index] );
+          this->Split( local[i], 0, task.Min, task.Max );
         }
-        else
+      });
+
+      // Local node 0 is the subtree root, which replaces the task node; the
+      // other nodes are appended.
+      for( size_t i=0; i<subtrees.size(); ++i )
+      {
+        const unsigned int base = static_cast<unsigned int>( this->m_nodes.size() ) - 1;
+        for( size_t j=0; j<local[i].size(); ++j )
         {
-          ds->GetCellBounds(i, boundsPtr);
+          vtkCellTreeLocator::vtkCellTreeNode node = local[i][j];
+          if( node.IsNode() )
+          {
+            node.SetChildren( base + node.GetLeftChildIndex() );
+          }
+          if( j == 0 )
+          {
+            this->m_nodes[subtrees[i].Index] = node;
+          }
+          else
+          {
+            this->m_nodes.push_back( node );
+          }
         }
+      }
+    }
+
+  public:
 
-        for( int d=0; d<3; ++d )
+    vtkCellTreeBuilder()
+    {
+      this->m_buckets =  5;
+      this->m_leafsize = 8;
+    }
+
+    void GatherCellBounds( vtkCellTreeLocator *ctl, vtkDataSet* ds )
+    {
+      const vtkIdType size = ds->GetNumberOfCells();
+      this->m_pc.resize(size);
+
+      // Gather the cell bounds in parallel. When they are not cached, the
+      // first cell is processed serially to trigger the non thread safe
+      // lazy initialization some datasets do in GetCellBounds().
+      double (*cachedBounds)[6] = ctl->CellBounds;
+      if( !cachedBounds )
+      {
+        double cellBounds[6];
+        ds->GetCellBounds(0, cellBounds);
+      }
+      PerCell* pc = this->m_pc.data();
+      vtkSMPTools::For( 0, size, [ds, cachedBounds, pc]( vtkIdType first, vtkIdType last )
+      {
+        double cellBounds[6];
+        for( vtkIdType i=first; i<last; ++i )
         {
-          this->m_pc[i].Min[d] = boundsPtr[2*d+0];
-          this->m_pc[i].Max[d] = boundsPtr[2*d+1];
+          pc[i].Ind = i;
 
-          if( this->m_pc[i].Min[d] < min[d] )
+          double *boundsPtr = cellBounds;
+          if (cachedBounds)
           {
-            min[d] = this->m_pc[i].Min[d];
+            boundsPtr = cachedBounds[i];
+          }
+          else
+          {
+            ds->GetCellBounds(i, boundsPtr);
           }
 
-          if( this->m_pc[i].Max[d] > max[d] )  /// This can be m_pc[i].max[d] instead of min
+          for( int d=0; d<3; ++d )
           {
-            max[d] = this->m_pc[i].Max[d];
+            pc[i].Min[d] = boundsPtr[2*d+0];
+            pc[i].Max[d] = boundsPtr[2*d+1];
           }
         }
-      }
+      });
+    }
+
+    void Build( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
+    {
+      const vtkIdType size = ds->GetNumberOfCells();
+      this->GatherCellBounds( ctl, ds );
+      PerCell* pc = this->m_pc.data();
+
+      float min[3], max[3];
+      FindMinMax( pc, pc + size, min, max, true );
 
       ct.DataBBox[0] = min[0];
       ct.DataBBox[1] = max[0];
@@ -476,7 +675,7 @@ class vtkCellTreeBuilder
       root.MakeLeaf( 0, size );
       this->m_nodes.push_back( root );
 
-      Split( 0, min, max );
+      ParallelSplit( min, max );
 
       ct.Nodes.resize( this->m_nodes.size() );
       ct.Nodes[0] = this->m_nodes[0];
@@ -509,6 +708,60 @@ class vtkCellTreeBuilder
       this->m_pc.clear();
     }
 
+    // Update the split planes of an existing tree and the bounds of the data
+    // after the points of the dataset moved. Each cell stays in its leaf.
+    void Refit( vtkCellTreeLocator *ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds )
+    {
+      this->GatherCellBounds( ctl, ds );
+      const PerCell* pc = this->m_pc.data();
+      const unsigned int* leaves = ct.Leaves.data();
+      const vtkIdType numNodes = static_cast<vtkIdType>( ct.Nodes.size() );
+      std::vector<MinMax> bounds( numNodes );
+      MinMax* nodeBounds = bounds.data();
+
+      // The bounds of the leaves are computed in parallel
+      vtkCellTreeLocator::vtkCellTreeNode* nodes = ct.Nodes.data();
+      vtkSMPTools::For( 0, numNodes, [nodes, nodeBounds, pc, leaves]( vtkIdType first, vtkIdType last )
+      {
+        for( vtkIdType n=first; n<last; ++n )
+        {
+          if( nodes[n].IsLeaf() )
+          {
+            for( unsigned int i=nodes[n].Start(); i<nodes[n].Start()+nodes[n].Size(); ++i )
+            {
+              nodeBounds[n].Add( pc + leaves[i], pc + leaves[i] + 1 );
+            }
+          }
+        }
+      });
+
+      // Children are stored after their parent, so a reverse sweep visits
+      // the children of a node before the node itself
+      for( vtkIdType n=numNodes-1; n>=0; --n )
+      {
+        vtkCellTreeLocator::vtkCellTreeNode& node = nodes[n];
+        if( node.IsLeaf() )
+        {
+          continue;
+        }
+        const MinMax& left = nodeBounds[node.GetLeftChildIndex()];
+        const MinMax& right = nodeBounds[node.GetRightChildIndex()];
+        const unsigned int d = node.GetDimension();
+        float planes[2] = { left.Max[d], right.Min[d] };
+        node.MakeNode( node.GetLeftChildIndex(), d, planes );
+        nodeBounds[n].Merge( left );
+        nodeBounds[n].Merge( right );
+      }
+
+      for( int d=0; d<3; ++d )
+      {
+        ct.DataBBox[2*d] = nodeBounds[0].Min[d];
+        ct.DataBBox[2*d+1] = nodeBounds[0].Max[d];
+      }
+
+      this->m_pc.clear();
+    }
+
   public:
     unsigned int     m_buckets;
     unsigned int     m_leafsize;
@@ -570,6 +823,20 @@ void vtkCellTreeLocator::ForceBuildLocator()
     vtkDebugMacro(<< "BuildLocator exited - UseExistingSearchStructure");
     return;
   }
+  // only update the split planes if the points moved but the cells did not change
+  if ( (this->Tree) && this->OnlyPointsModified())
+  {
+    if (this->CellBounds)
+    {
+      this->FreeCellBounds();
+      this->StoreCellBounds();
+    }
+    vtkCellTreeBuilder builder;
+    builder.Refit( this, *(this->Tree), this->DataSet );
+    this->BuildTime.Modified();
+    vtkDebugMacro(<< "BuildLocator exited - refitted existing tree");
+    return;
+  }
   this->BuildLocatorInternal();
 }
 //----------------------------------------------------------------------------
@@ -592,6 +859,7 @@ void vtkCellTreeLocator::BuildLocatorInternal()
   builder.m_leafsize = this->NumberOfCellsPerNode;
   builder.m_buckets  = NumberOfBuckets;
   builder.Build( this, *(Tree), this->DataSet );
+  this->RecordDataSetTopology();
   this->BuildTime.Modified();
 }
 
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompositeDataGeometryFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Extracts the surface of a multiblock dataset whose leaves are processed in
+// parallel, with datasets shared by several leaves and grids sharing their
+// points, and checks it against the surfaces of the leaves extracted and
+// appended one by one.
+
+#include "vtkAppendFilter.h"
+#include "vtkAppendPolyData.h"
+#include "vtkCell.h"
+#include "vtkCompositeDataGeometryFilter.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkImageData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(double x, int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(x, 0.0, 0.0);
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  vtkNew<vtkAppendFilter> toGrid;
+  toGrid->AddInputConnection(sphere->GetOutputPort());
+  toGrid->Update();
+  return toGrid->GetOutput();
+}
+
+}
+
+int TestCompositeDataGeometryFilter(int, char*[])
+{
+  vtkNew<vtkImageData> sharedImage;
+  sharedImage->SetDimensions(6, 5, 4);
+  vtkSmartPointer<vtkUnstructuredGrid> sharedGrid = MakeGrid(0.0, 16);
+  // Two grids with their own cells but the same points.
+  vtkSmartPointer<vtkUnstructuredGrid> samePoints = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  samePoints->DeepCopy(sharedGrid);
+  samePoints->SetPoints(sharedGrid->GetPoints());
+
+  vtkNew<vtkMultiBlockDataSet> input;
+  unsigned int block = 0;
+  for (int i = 0; i < 8; ++i)
+  {
+    vtkNew<vtkImageData> image;
+    image->SetDimensions(3 + i, 4, 5);
+    image->SetOrigin(10.0 * i, 0.0, 0.0);
+    input->SetBlock(block++, image);
+    input->SetBlock(block++, MakeGrid(10.0 * i, 8 + i));
+    input->SetBlock(block++,
+      i % 2 ? static_cast<vtkDataObject*>(sharedImage.GetPointer()) : sharedGrid.GetPointer());
+    input->SetBlock(block++, i % 3 ? nullptr : samePoints.GetPointer());
+  }
+
+  vtkNew<vtkCompositeDataGeometryFilter> filter;
+  filter->SetInputData(input);
+  filter->Update();
+  vtkPolyData* output = filter->GetOutput();
+
+  // The leaves extracted and appended one by one.
+  vtkNew<vtkAppendPolyData> append;
+  for (unsigned int leaf = 0; leaf < input->GetNumberOfBlocks(); ++leaf)
+  {
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(input->GetBlock(leaf));
+    if (ds)
+    {
+      vtkNew<vtkDataSetSurfaceFilter> surface;
+      surface->SetInputData(ds);
+      surface->Update();
+      append->AddInputData(surface->GetOutput());
+    }
+  }
+  append->Update();
+  vtkPolyData* expected = append->GetOutput();
+
+  if (output->GetNumberOfPoints() != expected->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != expected->GetNumberOfCells())
+  {
+    std::cerr << "Output has " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfCells() << " cells instead of "
+              << expected->GetNumberOfPoints() << " and " << expected->GetNumberOfCells() << "\n";
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    double p[3], q[3];
+    output->GetPoint(i, p);
+    expected->GetPoint(i, q);
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      std::cerr << "Point " << i << " differs from the serial output\n";
+      return EXIT_FAILURE;
+    }
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    if (output->GetCellType(i) != expected->GetCellType(i) ||
+      output->GetCell(i)->GetPointId(0) != expected->GetCell(i)->GetPointId(0))
+    {
+      std::cerr << "Cell " << i << " differs from the serial output\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
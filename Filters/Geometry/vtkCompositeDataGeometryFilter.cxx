@@ -15,9 +15,9 @@
 #include "vtkCompositeDataGeometryFilter.h"
 
 #include "vtkAppendPolyData.h"
-#include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
+#include "vtkCompositeDataSetSMPTools.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkImageData.h"
@@ -25,8 +25,42 @@
 #include "vtkInformationVector.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <map>
+#include <vector>
+
+namespace
+{
+// Extracts the surface of each distinct dataset; datasets are processed in
+// parallel.
+struct SurfaceWorker
+{
+  const std::vector<vtkDataSet*>& DataSets;
+  std::vector<vtkSmartPointer<vtkPolyData> >& Surfaces;
+
+  SurfaceWorker(const std::vector<vtkDataSet*>& dataSets,
+    std::vector<vtkSmartPointer<vtkPolyData> >& surfaces)
+    : DataSets(dataSets)
+    , Surfaces(surfaces)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkNew<vtkDataSetSurfaceFilter> dssf;
+      dssf->SetInputData(this->DataSets[i]);
+      dssf->Update();
+      this->Surfaces[i] = dssf->GetOutput();
+    }
+  }
+};
+}
+
 vtkStandardNewMacro(vtkCompositeDataGeometryFilter);
 
 //-----------------------------------------------------------------------------
@@ -80,20 +114,62 @@ int vtkCompositeDataGeometryFilter::RequestCompositeData(
     return 0;
   }
 
-  vtkNew<vtkAppendPolyData> append;
-  vtkSmartPointer<vtkCompositeDataIterator> iter;
-  iter.TakeReference(input->NewIterator());
-
-  for(iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  // A dataset found in several leaves is processed once: extracting its
+  // surface from several threads would race on its lazily built caches.
+  std::vector<vtkDataObject*> leaves = vtkCompositeDataSetSMPTools::GetLeaves(input);
+  std::vector<vtkDataSet*> dataSets;
+  std::vector<vtkIdType> leafDataSets(leaves.size(), -1);
+  std::map<vtkDataSet*, vtkIdType> dataSetIds;
+  for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
   {
-    vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+    vtkDataSet* ds = vtkDataSet::SafeDownCast(leaves[leaf]);
     if (ds && ds->GetNumberOfPoints() > 0)
     {
-      vtkNew<vtkDataSetSurfaceFilter> dssf;
-      dssf->SetInputData(ds);
-      dssf->Update();
-      append->AddInputDataObject(dssf->GetOutputDataObject(0));
+      auto inserted = dataSetIds.insert(std::make_pair(ds, static_cast<vtkIdType>(dataSets.size())));
+      if (inserted.second)
+      {
+        dataSets.push_back(ds);
+      }
+      leafDataSets[leaf] = inserted.first->second;
+    }
+  }
+
+  // Distinct datasets may still share points or cells, so the caches the
+  // surface filter reads are built serially first.
+  for (vtkDataSet* ds : dataSets)
+  {
+    double bounds[6];
+    ds->GetBounds(bounds);
+    vtkPolyData* pd = vtkPolyData::SafeDownCast(ds);
+    if (pd && pd->NeedToBuildCells())
+    {
+      pd->BuildCells();
+    }
+  }
+
+  std::vector<vtkSmartPointer<vtkPolyData> > surfaces(dataSets.size());
+  SurfaceWorker worker(dataSets, surfaces);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(dataSets.size()), worker);
+
+  // Append in block order so that the output does not depend on scheduling.
+  // A surface is appended once per leaf holding its dataset, as when the
+  // leaves are processed one by one.
+  vtkNew<vtkAppendPolyData> append;
+  std::vector<bool> appended(surfaces.size(), false);
+  for (vtkIdType id : leafDataSets)
+  {
+    if (id < 0)
+    {
+      continue;
+    }
+    vtkSmartPointer<vtkPolyData> surface = surfaces[id];
+    if (appended[id])
+    {
+      surface = vtkSmartPointer<vtkPolyData>::New();
+      surface->ShallowCopy(surfaces[id]);
     }
+    appended[id] = true;
+    append->AddInputDataObject(surface);
   }
   if (append->GetNumberOfInputConnections(0) > 0)
   {
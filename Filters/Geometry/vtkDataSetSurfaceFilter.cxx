@@ -1635,7 +1635,13 @@ int vtkDataSetSurfaceFilter::UnstructuredGridExecute(vtkDataSet *dataSetInput,
   }
 
   // First insert all points.  Points have to come first in poly data.
-  for (cellIter->InitTraversal(); !cellIter->IsDoneWithTraversal();
+  // Grids with a single cell type other than vertices have none.
+  vtkUnstructuredGrid *ugInput = vtkUnstructuredGrid::SafeDownCast(input);
+  int singleCellType =
+    ugInput ? ugInput->GetSingleCellType() : static_cast<int>(VTK_EMPTY_CELL);
+  bool hasVertices = (singleCellType == VTK_EMPTY_CELL ||
+    singleCellType == VTK_VERTEX || singleCellType == VTK_POLY_VERTEX);
+  for (cellIter->InitTraversal(); hasVertices && !cellIter->IsDoneWithTraversal();
        cellIter->GoToNextCell())
   {
     cellType = cellIter->GetCellType();
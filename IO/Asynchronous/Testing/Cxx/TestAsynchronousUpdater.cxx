@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAsynchronousUpdater.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkAsynchronousUpdater
+// .SECTION Description
+// Checks double buffering of the output and cancellation of a running update.
+
+#include "vtkAsynchronousUpdater.h"
+#include "vtkCommand.h"
+#include "vtkImageData.h"
+#include "vtkNew.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSmartPointer.h"
+
+#include <future>
+
+namespace
+{
+// Blocks the worker thread at StartEvent until the test releases it.
+class BlockingObserver : public vtkCommand
+{
+public:
+  static BlockingObserver* New() { return new BlockingObserver; }
+
+  void Execute(vtkObject*, unsigned long, void*) override
+  {
+    this->Started.set_value();
+    this->Release.get();
+  }
+
+  std::promise<void> Started;
+  std::shared_future<void> Release;
+};
+}
+
+int TestAsynchronousUpdater(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-16, 16, -16, 16, -16, 16);
+
+  vtkNew<vtkAsynchronousUpdater> updater;
+  updater->SetAlgorithm(source);
+  if (updater->GetOutput() != nullptr)
+  {
+    cerr << "Expected no output before the first update." << endl;
+    return EXIT_FAILURE;
+  }
+
+  bool callbackResult = false;
+  std::shared_future<bool> future =
+    updater->UpdateAsync([&callbackResult](bool completed) { callbackResult = completed; });
+  if (!future.get() || !callbackResult)
+  {
+    cerr << "First update did not complete." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Hold a reference so that the address cannot be reused by a later output.
+  vtkSmartPointer<vtkImageData> first = vtkImageData::SafeDownCast(updater->GetOutput());
+  if (!first || first->GetNumberOfPoints() != 33 * 33 * 33)
+  {
+    cerr << "Unexpected output after the first update." << endl;
+    return EXIT_FAILURE;
+  }
+  if (first == source->GetOutput())
+  {
+    cerr << "Output must not be the algorithm's own output." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Start a second update, cancel it while it runs and make sure the
+  // previous output is kept.
+  vtkNew<BlockingObserver> observer;
+  std::promise<void> release;
+  observer->Release = release.get_future().share();
+  unsigned long tag = source->AddObserver(vtkCommand::StartEvent, observer);
+
+  source->SetWholeExtent(-8, 8, -8, 8, -8, 8);
+  future = updater->UpdateAsync();
+  observer->Started.get_future().wait();
+  if (!updater->IsUpdating())
+  {
+    cerr << "Expected an update to be running." << endl;
+    return EXIT_FAILURE;
+  }
+  if (updater->GetOutput() != first)
+  {
+    cerr << "Output changed while an update is running." << endl;
+    return EXIT_FAILURE;
+  }
+  updater->Cancel();
+  release.set_value();
+  if (future.get() || updater->Wait())
+  {
+    cerr << "Cancelled update reported completion." << endl;
+    return EXIT_FAILURE;
+  }
+  if (updater->GetOutput() != first)
+  {
+    cerr << "Cancelled update replaced the output." << endl;
+    return EXIT_FAILURE;
+  }
+  source->RemoveObserver(tag);
+
+  // A new update after a cancellation must execute again.
+  if (!updater->UpdateAsync().get())
+  {
+    cerr << "Update after cancellation did not complete." << endl;
+    return EXIT_FAILURE;
+  }
+  vtkImageData* second = vtkImageData::SafeDownCast(updater->GetOutput());
+  if (!second || second == first || second->GetNumberOfPoints() != 17 * 17 * 17)
+  {
+    cerr << "Unexpected output after the update following cancellation." << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
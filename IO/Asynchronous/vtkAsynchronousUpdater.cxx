@@ -0,0 +1,260 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdater.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkAsynchronousUpdater.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+//****************************************************************************
+class vtkAsynchronousUpdater::vtkInternals
+{
+public:
+  std::thread Worker;
+  std::shared_future<bool> Future;
+  std::atomic<bool> Updating;
+  std::atomic<bool> CancelRequested;
+
+  // Mutex must be held before accessing any of the following members.
+  std::mutex Mutex;
+  vtkSmartPointer<vtkDataObject> BackBuffer;
+  bool HasNewOutput;
+
+  // Only accessed from the thread owning the updater.
+  vtkSmartPointer<vtkDataObject> FrontBuffer;
+
+  vtkNew<vtkCallbackCommand> ProgressObserver;
+  unsigned long ProgressObserverTag;
+
+  vtkInternals()
+    : Updating(false)
+    , CancelRequested(false)
+    , HasNewOutput(false)
+    , ProgressObserverTag(0)
+  {
+    this->ProgressObserver->SetCallback(&vtkInternals::OnProgress);
+    this->ProgressObserver->SetClientData(this);
+  }
+
+  //------------------------------------------------------------------------
+  // Invoked on the worker thread. The executive resets AbortExecute right
+  // before invoking the first progress event of an execution, so this is the
+  // earliest point where an abort request sticks.
+  static void OnProgress(vtkObject* caller, unsigned long, void* clientData, void*)
+  {
+    vtkInternals* self = static_cast<vtkInternals*>(clientData);
+    vtkAlgorithm* algorithm = vtkAlgorithm::SafeDownCast(caller);
+    if (algorithm && self->CancelRequested && !algorithm->GetAbortExecute())
+    {
+      algorithm->SetAbortExecute(1);
+    }
+  }
+
+  //------------------------------------------------------------------------
+  void Join()
+  {
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  //------------------------------------------------------------------------
+  void Run(vtkSmartPointer<vtkAlgorithm> algorithm, int port, bool deepCopy,
+    std::promise<bool> promise, CallbackType callback)
+  {
+    algorithm->Update(port);
+
+    bool completed = !this->CancelRequested && !algorithm->GetAbortExecute();
+    vtkDataObject* output = completed ? algorithm->GetOutputDataObject(port) : nullptr;
+    if (output)
+    {
+      vtkSmartPointer<vtkDataObject> copy;
+      copy.TakeReference(output->NewInstance());
+      if (deepCopy)
+      {
+        copy->DeepCopy(output);
+      }
+      else
+      {
+        copy->ShallowCopy(output);
+      }
+
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->BackBuffer = copy;
+      this->HasNewOutput = true;
+    }
+    else
+    {
+      // An aborted execution still marks its outputs as generated; make sure
+      // the next update executes again.
+      algorithm->Modified();
+      completed = false;
+    }
+
+    this->Updating = false;
+    if (callback)
+    {
+      callback(completed);
+    }
+    promise.set_value(completed);
+  }
+};
+
+vtkStandardNewMacro(vtkAsynchronousUpdater);
+
+//----------------------------------------------------------------------------
+vtkAsynchronousUpdater::vtkAsynchronousUpdater()
+  : Algorithm(nullptr)
+  , OutputPort(0)
+  , DeepCopyOutput(false)
+  , Internals(new vtkInternals())
+{
+}
+
+//----------------------------------------------------------------------------
+vtkAsynchronousUpdater::~vtkAsynchronousUpdater()
+{
+  this->Cancel();
+  this->Wait();
+  this->SetAlgorithm(nullptr);
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdater::SetAlgorithm(vtkAlgorithm* algorithm)
+{
+  if (this->Algorithm == algorithm)
+  {
+    return;
+  }
+
+  this->Wait();
+
+  if (this->Algorithm)
+  {
+    this->Algorithm->RemoveObserver(this->Internals->ProgressObserverTag);
+    this->Algorithm->UnRegister(this);
+  }
+  this->Algorithm = algorithm;
+  if (this->Algorithm)
+  {
+    this->Algorithm->Register(this);
+    this->Internals->ProgressObserverTag =
+      this->Algorithm->AddObserver(vtkCommand::ProgressEvent, this->Internals->ProgressObserver);
+  }
+
+  this->Internals->FrontBuffer = nullptr;
+  this->Internals->BackBuffer = nullptr;
+  this->Internals->HasNewOutput = false;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+std::shared_future<bool> vtkAsynchronousUpdater::UpdateAsync()
+{
+  return this->UpdateAsync(CallbackType());
+}
+
+//----------------------------------------------------------------------------
+std::shared_future<bool> vtkAsynchronousUpdater::UpdateAsync(CallbackType callback)
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->Updating)
+  {
+    return internals->Future;
+  }
+
+  std::promise<bool> promise;
+  std::shared_future<bool> future = promise.get_future().share();
+  if (!this->Algorithm)
+  {
+    vtkErrorMacro(<< "UpdateAsync: Please specify an algorithm!");
+    promise.set_value(false);
+    return future;
+  }
+  if (this->OutputPort >= this->Algorithm->GetNumberOfOutputPorts())
+  {
+    vtkErrorMacro(<< "UpdateAsync: Output port " << this->OutputPort << " is out of range.");
+    promise.set_value(false);
+    return future;
+  }
+
+  // The previous worker is done but may not have been joined yet.
+  internals->Join();
+
+  internals->CancelRequested = false;
+  internals->Updating = true;
+  internals->Future = future;
+  internals->Worker = std::thread(&vtkInternals::Run, internals,
+    vtkSmartPointer<vtkAlgorithm>(this->Algorithm), this->OutputPort, this->DeepCopyOutput,
+    std::move(promise), std::move(callback));
+  return future;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdater::Cancel()
+{
+  if (this->Internals->Updating)
+  {
+    this->Internals->CancelRequested = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkAsynchronousUpdater::Wait()
+{
+  this->Internals->Join();
+  return this->Internals->Future.valid() ? this->Internals->Future.get() : false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkAsynchronousUpdater::IsUpdating()
+{
+  return this->Internals->Updating;
+}
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkAsynchronousUpdater::GetOutput()
+{
+  vtkInternals* internals = this->Internals;
+  std::lock_guard<std::mutex> lock(internals->Mutex);
+  if (internals->HasNewOutput)
+  {
+    internals->FrontBuffer = internals->BackBuffer;
+    internals->BackBuffer = nullptr;
+    internals->HasNewOutput = false;
+  }
+  return internals->FrontBuffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkAsynchronousUpdater::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Algorithm: " << this->Algorithm << endl;
+  os << indent << "OutputPort: " << this->OutputPort << endl;
+  os << indent << "DeepCopyOutput: " << (this->DeepCopyOutput ? "On" : "Off") << endl;
+  os << indent << "Updating: " << (this->Internals->Updating ? "Yes" : "No") << endl;
+}
@@ -0,0 +1,149 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkAsynchronousUpdater.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkAsynchronousUpdater
+ * @brief    update a pipeline on a worker thread while keeping the previous
+ *           result available.
+ *
+ * @details  vtkAsynchronousUpdater runs vtkAlgorithm::Update() for one output
+ *           port of an algorithm on a background thread so that a long
+ *           running reader or filter does not block the thread driving
+ *           rendering and interaction. The output is double buffered:
+ *           GetOutput() keeps returning the result of the last completed
+ *           update until the new one has finished; the buffers are swapped by
+ *           the first GetOutput() call after completion.
+ *
+ *           A running update can be cancelled with Cancel(). Cancellation is
+ *           cooperative and relies on the algorithm honoring AbortExecute,
+ *           just like any other abort request in VTK. A cancelled update
+ *           never replaces the current output.
+ *
+ *           While an update is running the caller must not modify the
+ *           algorithm, its inputs or any upstream algorithm. The returned
+ *           output is a copy owned by this class and is never touched by the
+ *           worker thread.
+ *
+ * @sa       vtkThreadedImageWriter
+ */
+
+#ifndef vtkAsynchronousUpdater_h
+#define vtkAsynchronousUpdater_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <functional> // For std::function
+#include <future>     // For std::shared_future
+
+class vtkAlgorithm;
+class vtkDataObject;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkAsynchronousUpdater : public vtkObject
+{
+public:
+  static vtkAsynchronousUpdater* New();
+  vtkTypeMacro(vtkAsynchronousUpdater, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set/Get the algorithm to update. Changing the algorithm waits for any
+   * running update to finish and releases the current output.
+   */
+  void SetAlgorithm(vtkAlgorithm* algorithm);
+  vtkGetObjectMacro(Algorithm, vtkAlgorithm);
+  //@}
+
+  //@{
+  /**
+   * Set/Get the output port of the algorithm that is updated and buffered.
+   * Default is 0.
+   */
+  vtkSetClampMacro(OutputPort, int, 0, VTK_INT_MAX);
+  vtkGetMacro(OutputPort, int);
+  //@}
+
+  //@{
+  /**
+   * When enabled, the completed output is deep copied into the front buffer
+   * instead of shallow copied. Enable this for algorithms that modify their
+   * output arrays in place between executions. Default is off.
+   */
+  vtkSetMacro(DeepCopyOutput, bool);
+  vtkGetMacro(DeepCopyOutput, bool);
+  vtkBooleanMacro(DeepCopyOutput, bool);
+  //@}
+
+  /**
+   * Callback invoked on the worker thread once an update has completed. The
+   * argument is true when a new output is ready to be swapped in and false
+   * when the update was cancelled.
+   */
+  using CallbackType = std::function<void(bool)>;
+
+  /**
+   * Start updating the algorithm on a worker thread and return immediately.
+   * The returned future becomes ready when the update has completed and holds
+   * true if the next call to GetOutput() will return the new result.
+   *
+   * If an update is already running, no new update is started and the future
+   * of the running update is returned. Call Cancel() then Wait() first to
+   * restart with new parameters.
+   */
+  std::shared_future<bool> UpdateAsync();
+  std::shared_future<bool> UpdateAsync(CallbackType callback);
+
+  /**
+   * Request cancellation of the running update, if any. This returns
+   * immediately; use Wait() to block until the worker has stopped.
+   */
+  void Cancel();
+
+  /**
+   * Block until the running update, if any, has completed. Returns true if
+   * the last update produced a new output that has not been cancelled.
+   */
+  bool Wait();
+
+  /**
+   * Returns true while an update is running on the worker thread.
+   */
+  bool IsUpdating();
+
+  /**
+   * Returns the result of the last completed update, or nullptr if no update
+   * has completed yet. Buffers are swapped here, on the calling thread, so the
+   * returned object is never modified or released by the worker; it stays
+   * valid at least until the next call to GetOutput().
+   */
+  vtkDataObject* GetOutput();
+
+protected:
+  vtkAsynchronousUpdater();
+  ~vtkAsynchronousUpdater() override;
+
+  vtkAlgorithm* Algorithm;
+  int OutputPort;
+  bool DeepCopyOutput;
+
+private:
+  vtkAsynchronousUpdater(const vtkAsynchronousUpdater&) = delete;
+  void operator=(const vtkAsynchronousUpdater&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+};
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "vtkNumberToString.h"
 #include "vtkTypeTraits.h"
+#include <cstring>
 #include <limits>
 #include <sstream>
 #include <vtkMinimalStandardRandomSequence.h>
@@ -26,6 +27,7 @@ template <typename T>
 int TestConvert(const unsigned int samples);
 template <typename T>
 int ConvertNumericLimitsValue(const char* t, T);
+int TestConvertToBuffer();
 }
 int TestNumberToString(int, char* [])
 {
@@ -71,7 +73,7 @@ int TestNumberToString(int, char* [])
   }
 
   unsigned int samples = 10000;
-  if (TestConvert<float>(samples) || TestConvert<double>(samples))
+  if (TestConvert<float>(samples) || TestConvert<double>(samples) || TestConvertToBuffer())
   {
     return EXIT_FAILURE;
   }
@@ -212,4 +214,58 @@ int ConvertNumericLimitsValue(const char* t, T)
   }
   return status;
 }
+
+template <typename T>
+int CheckConvert(T value, const char* expected)
+{
+  char buffer[vtkNumberToString::BufferSize];
+  int length = vtkNumberToString::Convert(value, buffer);
+  if (std::string(buffer) != expected || length != static_cast<int>(strlen(expected)))
+  {
+    std::cout << "ERROR: " << expected << " converted to " << buffer << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+int TestConvertToBuffer()
+{
+  std::cout << "Testing Convert and BufferedWriter..." << std::endl;
+  int errors = CheckConvert(0.1f, "0.1");
+  errors += CheckConvert(0.1, "0.1");
+  errors += CheckConvert(-1.5e-7, "-1.5e-7");
+  errors += CheckConvert(0, "0");
+  errors += CheckConvert(static_cast<short>(-32768), "-32768");
+  errors += CheckConvert(std::numeric_limits<long long>::min(), "-9223372036854775808");
+  errors += CheckConvert(std::numeric_limits<unsigned long long>::max(), "18446744073709551615");
+
+  // Enough values to fill the buffer several times.
+  const int numValues = 1000000;
+  std::ostringstream stream;
+  {
+    vtkNumberToString::BufferedWriter writer(stream);
+    for (int i = 0; i < numValues; ++i)
+    {
+      writer.WriteNumber(i * 0.25);
+      writer.WriteText(i % 2 ? "\n" : ", ");
+    }
+  }
+  std::istringstream input(stream.str());
+  for (int i = 0; i < numValues; ++i)
+  {
+    double value;
+    char separator;
+    input >> value;
+    if (i % 2 == 0)
+    {
+      input >> separator;
+    }
+    if (!input || value != i * 0.25)
+    {
+      std::cout << "ERROR: wrong buffered value " << i << std::endl;
+      return 1;
+    }
+  }
+  return errors;
+}
 }
@@ -26,12 +26,14 @@
 #include "vtkDataArray.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
+#include "vtkNumberToString.h"
 #include "vtkObjectFactory.h"
 #include "vtkTable.h"
 #include "vtkSmartPointer.h"
 
 #include <vector>
 #include <sstream>
+#include <type_traits>
 
 vtkStandardNewMacro(vtkDelimitedTextWriter);
 //-----------------------------------------------------------------------------
@@ -100,12 +102,38 @@ bool vtkDelimitedTextWriter::OpenStream()
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// Numbers other than characters are written with the shortest representation
+// that reads back as the same value, other values through operator<<.
+template <class T>
+struct vtkDelimitedTextWriterIsNumber
+  : std::integral_constant<bool, std::is_arithmetic<T>::value && (sizeof(T) > 1)>
+{
+};
+
+template <class T>
+void vtkDelimitedTextWriterWriteValue(
+  vtkNumberToString::BufferedWriter& output, const T& value, std::true_type)
+{
+  output.WriteNumber(value);
+}
+
+template <class T>
+void vtkDelimitedTextWriterWriteValue(
+  vtkNumberToString::BufferedWriter& output, const T& value, std::false_type)
+{
+  std::ostringstream stream;
+  stream << value;
+  output.WriteText(stream.str());
+}
+
 //-----------------------------------------------------------------------------
 template <class iterT>
 void vtkDelimitedTextWriterGetDataString(
-  iterT* iter, vtkIdType tupleIndex, ostream* stream, vtkDelimitedTextWriter* writer,
-  bool* first)
+  iterT* iter, vtkIdType tupleIndex, vtkNumberToString::BufferedWriter& output,
+  vtkDelimitedTextWriter* writer, bool* first)
 {
+  typedef typename iterT::ValueType ValueType;
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex* numComps;
   for (int cc=0; cc < numComps; cc++)
@@ -114,16 +142,17 @@ void vtkDelimitedTextWriterGetDataString(
     {
       if (*first == false)
       {
-        (*stream) << writer->GetFieldDelimiter();
+        output.WriteText(writer->GetFieldDelimiter());
       }
       *first = false;
-      (*stream) << iter->GetValue(index+cc);
+      vtkDelimitedTextWriterWriteValue(output, iter->GetValue(index+cc),
+        vtkDelimitedTextWriterIsNumber<ValueType>());
     }
     else
     {
       if (*first == false)
       {
-        (*stream) << writer->GetFieldDelimiter();
+        output.WriteText(writer->GetFieldDelimiter());
       }
       *first = false;
     }
@@ -134,7 +163,7 @@ void vtkDelimitedTextWriterGetDataString(
 template<>
 void vtkDelimitedTextWriterGetDataString(
   vtkArrayIteratorTemplate<vtkStdString>* iter, vtkIdType tupleIndex,
-  ostream* stream, vtkDelimitedTextWriter* writer, bool* first)
+  vtkNumberToString::BufferedWriter& output, vtkDelimitedTextWriter* writer, bool* first)
 {
   int numComps = iter->GetNumberOfComponents();
   vtkIdType index = tupleIndex* numComps;
@@ -144,16 +173,16 @@ void vtkDelimitedTextWriterGetDataString(
     {
       if (*first == false)
       {
-        (*stream) << writer->GetFieldDelimiter();
+        output.WriteText(writer->GetFieldDelimiter());
       }
       *first = false;
-      (*stream) << writer->GetString(iter->GetValue(index+cc));
+      output.WriteText(writer->GetString(iter->GetValue(index+cc)));
     }
     else
     {
       if (*first == false)
       {
-        (*stream) << writer->GetFieldDelimiter();
+        output.WriteText(writer->GetFieldDelimiter());
       }
       *first = false;
     }
@@ -227,6 +256,8 @@ void vtkDelimitedTextWriter::WriteTable(vtkTable* table)
   }
   (*this->Stream) << "\n";
 
+  // Rows are formatted into a large buffer.
+  vtkNumberToString::BufferedWriter output(*this->Stream);
   for (vtkIdType index=0; index < numRows; index++)
   {
     first = true;
@@ -237,17 +268,18 @@ void vtkDelimitedTextWriter::WriteTable(vtkTable* table)
       {
         vtkArrayIteratorTemplateMacro(
           vtkDelimitedTextWriterGetDataString(static_cast<VTK_TT*>(iter->GetPointer()),
-            index, this->Stream, this, &first));
+            index, output, this, &first));
         case VTK_VARIANT:
         {
           vtkDelimitedTextWriterGetDataString(static_cast<vtkArrayIteratorTemplate<vtkVariant>*>(iter->GetPointer()),
-            index, this->Stream, this, &first);
+            index, output, this, &first);
           break;
         }
       }
     }
-    (*this->Stream) << "\n";
+    output.WriteChar('\n');
   }
+  output.Flush();
 
   if (this->WriteToOutputString)
   {
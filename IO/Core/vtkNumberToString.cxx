@@ -17,22 +17,88 @@
 #include "vtk_doubleconversion.h"
 #include VTK_DOUBLECONVERSION_HEADER(double-conversion.h)
 
+#include <algorithm>
 #include <sstream>
 
 namespace
 {
+// Writes to the stream when this much is buffered.
+const size_t WriterCapacity = 1 << 20;
+
 template <typename TagT>
 inline ostream& ToString(ostream& stream, const TagT& tag)
 {
-  char buf[256];
+  char buf[vtkNumberToString::BufferSize];
+  vtkNumberToString::Convert(tag.Value, buf);
+  stream << buf;
+  return stream;
+}
+}
+
+//----------------------------------------------------------------------------
+int vtkNumberToString::Convert(double val, char* buffer)
+{
   const double_conversion::DoubleToStringConverter& converter =
     double_conversion::DoubleToStringConverter::EcmaScriptConverter();
-  double_conversion::StringBuilder builder(buf, sizeof(buf));
-  builder.Reset();
-  converter.ToShortest(tag.Value, &builder);
-  stream << builder.Finalize();
-  return stream;
+  double_conversion::StringBuilder builder(buffer, BufferSize);
+  converter.ToShortest(val, &builder);
+  int length = builder.position();
+  builder.Finalize();
+  return length;
 }
+
+//----------------------------------------------------------------------------
+int vtkNumberToString::Convert(float val, char* buffer)
+{
+  const double_conversion::DoubleToStringConverter& converter =
+    double_conversion::DoubleToStringConverter::EcmaScriptConverter();
+  double_conversion::StringBuilder builder(buffer, BufferSize);
+  converter.ToShortestSingle(val, &builder);
+  int length = builder.position();
+  builder.Finalize();
+  return length;
+}
+
+//----------------------------------------------------------------------------
+vtkNumberToString::BufferedWriter::BufferedWriter(ostream& stream)
+  : Stream(stream)
+  , Data(new char[WriterCapacity])
+  , Size(0)
+  , Capacity(WriterCapacity)
+{
+}
+
+//----------------------------------------------------------------------------
+vtkNumberToString::BufferedWriter::~BufferedWriter()
+{
+  this->Flush();
+  delete[] this->Data;
+}
+
+//----------------------------------------------------------------------------
+void vtkNumberToString::BufferedWriter::WriteText(const char* text, size_t length)
+{
+  if (length > this->Capacity - this->Size)
+  {
+    this->Flush();
+    if (length > this->Capacity)
+    {
+      this->Stream.write(text, static_cast<std::streamsize>(length));
+      return;
+    }
+  }
+  std::copy(text, text + length, this->Data + this->Size);
+  this->Size += length;
+}
+
+//----------------------------------------------------------------------------
+void vtkNumberToString::BufferedWriter::Flush()
+{
+  if (this->Size > 0)
+  {
+    this->Stream.write(this->Data, static_cast<std::streamsize>(this->Size));
+    this->Size = 0;
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -28,6 +28,20 @@
  *  float a = 1.0f/3.0f;
  *  std::cout << convert(a) << std::endl;
  * @endcode
+ *
+ * Floats are written with the shortest representation that reads back as the
+ * same float, doubles with the shortest one that reads back as the same
+ * double. To write many numbers, Convert() them into a character buffer, or
+ * use a BufferedWriter, rather than formatting each one through a stream:
+ *
+ * @code{cpp}
+ *  vtkNumberToString::BufferedWriter writer(os);
+ *  for (vtkIdType i = 0; i < n; ++i)
+ *  {
+ *    writer.WriteNumber(values[i]);
+ *    writer.WriteChar(' ');
+ *  }
+ * @endcode
  */
 #ifndef vtkNumberToString_h
 #define vtkNumberToString_h
@@ -35,8 +49,11 @@
 #include "vtkIOCoreModule.h" // For export macro
 #include "vtkTypeTraits.h"
 
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <string>
+#include <type_traits>
 
 class VTKIOCORE_EXPORT vtkNumberToString
 {
@@ -60,6 +77,122 @@ public:
   }
   const TagDouble operator()(const double& val) const { return TagDouble(val); }
   const TagFloat operator()(const float& val) const { return TagFloat(val); }
+
+  /**
+   * Size of the buffers given to Convert(), enough for any number and the
+   * terminating null character.
+   */
+  enum
+  {
+    BufferSize = 32
+  };
+
+  //@{
+  /**
+   * Write @a val to @a buffer, which must hold BufferSize characters, and
+   * terminate it with a null character. Floating point values are written
+   * with the shortest representation that reads back as the same value,
+   * integers in decimal. Returns the number of characters before the null
+   * character.
+   */
+  static int Convert(double val, char* buffer);
+  static int Convert(float val, char* buffer);
+  template <typename T>
+  static int Convert(T val, char* buffer)
+  {
+    static_assert(std::is_integral<T>::value, "Convert() needs a number.");
+    typedef typename std::make_unsigned<T>::type UnsignedType;
+    UnsignedType magnitude = static_cast<UnsignedType>(val);
+    char* start = buffer;
+    if (vtkNumberToString::IsNegative(val, std::is_signed<T>()))
+    {
+      *buffer++ = '-';
+      magnitude = static_cast<UnsignedType>(0 - magnitude);
+    }
+    char digits[BufferSize];
+    int numDigits = 0;
+    do
+    {
+      digits[numDigits++] = static_cast<char>('0' + magnitude % 10);
+      magnitude = static_cast<UnsignedType>(magnitude / 10);
+    } while (magnitude != 0);
+    while (numDigits > 0)
+    {
+      *buffer++ = digits[--numDigits];
+    }
+    *buffer = '\0';
+    return static_cast<int>(buffer - start);
+  }
+  //@}
+
+  /**
+   * Formats text and numbers into a large character buffer, written to the
+   * stream when full, by Flush() and on destruction.
+   */
+  class VTKIOCORE_EXPORT BufferedWriter
+  {
+  public:
+    BufferedWriter(ostream& stream);
+    ~BufferedWriter();
+
+    /**
+     * Append a number, see vtkNumberToString::Convert().
+     */
+    template <typename T>
+    void WriteNumber(T val)
+    {
+      this->Reserve(BufferSize);
+      this->Size += static_cast<size_t>(vtkNumberToString::Convert(val, this->Data + this->Size));
+    }
+
+    //@{
+    /**
+     * Append characters.
+     */
+    void WriteChar(char c)
+    {
+      this->Reserve(1);
+      this->Data[this->Size++] = c;
+    }
+    void WriteText(const char* text, size_t length);
+    void WriteText(const char* text) { this->WriteText(text, text ? strlen(text) : 0); }
+    void WriteText(const std::string& text) { this->WriteText(text.c_str(), text.size()); }
+    //@}
+
+    /**
+     * Write the buffered characters to the stream.
+     */
+    void Flush();
+
+  private:
+    BufferedWriter(const BufferedWriter&) = delete;
+    void operator=(const BufferedWriter&) = delete;
+
+    void Reserve(size_t n)
+    {
+      if (this->Size + n > this->Capacity)
+      {
+        this->Flush();
+      }
+    }
+
+    ostream& Stream;
+    char* Data;
+    size_t Size;
+    size_t Capacity;
+  };
+
+private:
+  template <typename T>
+  static bool IsNegative(T val, std::true_type)
+  {
+    return val < 0;
+  }
+  template <typename T>
+  static bool IsNegative(T, std::false_type)
+  {
+    return false;
+  }
 };
 
 VTKIOCORE_EXPORT ostream& operator<<(ostream& stream, const vtkNumberToString::TagDouble& tag);
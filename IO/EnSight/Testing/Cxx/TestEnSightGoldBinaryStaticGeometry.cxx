@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryStaticGeometry.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a transient EnSight Gold binary case with a static geometry, a
+// vector and a symmetric tensor per node, reads two time steps of it, and
+// checks that the second step shares the points of the first one and that
+// the components of the variables, read one after the other into the
+// tuples, hold the values written.
+
+#include "vtkDataArray.h"
+#include "vtkGenericEnSightReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+// More than the number of values read at once by the reader.
+const int NumberOfNodes = 5000;
+
+// The file order of the components of a symmetric tensor (11 22 33 12 13 23)
+// for each component of the tuples (XX YY ZZ XY YZ XZ).
+const int TensorFileComponents[6] = { 0, 1, 2, 3, 5, 4 };
+
+float Value(int step, int fileComponent, int node)
+{
+  return 1000.0f * step + 10.0f * fileComponent + 0.5f * node;
+}
+
+void WriteString(std::ofstream& file, const char* s)
+{
+  char line[80] = {};
+  strncpy(line, s, 79);
+  file.write(line, 80);
+}
+
+void WriteInt(std::ofstream& file, int i)
+{
+  file.write(reinterpret_cast<const char*>(&i), sizeof(int));
+}
+
+void WriteFloat(std::ofstream& file, float f)
+{
+  file.write(reinterpret_cast<const char*>(&f), sizeof(float));
+}
+
+void WriteGeometry(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str(), ios::out | ios::binary);
+  WriteString(file, "C Binary");
+  WriteString(file, "static geometry");
+  WriteString(file, "written by TestEnSightGoldBinaryStaticGeometry");
+  WriteString(file, "node id off");
+  WriteString(file, "element id off");
+  WriteString(file, "part");
+  WriteInt(file, 1);
+  WriteString(file, "nodes");
+  WriteString(file, "coordinates");
+  WriteInt(file, NumberOfNodes);
+  for (int i = 0; i < NumberOfNodes; i++)
+  {
+    WriteFloat(file, static_cast<float>(i));
+  }
+  for (int i = 0; i < NumberOfNodes; i++)
+  {
+    WriteFloat(file, static_cast<float>(i % 7));
+  }
+  for (int i = 0; i < NumberOfNodes; i++)
+  {
+    WriteFloat(file, static_cast<float>(i % 11));
+  }
+  WriteString(file, "tetra4");
+  WriteInt(file, 1);
+  for (int i = 1; i <= 4; i++)
+  {
+    WriteInt(file, i);
+  }
+}
+
+void WriteVariable(const std::string& fileName, int step, int numComponents)
+{
+  std::ofstream file(fileName.c_str(), ios::out | ios::binary);
+  WriteString(file, "variable per node");
+  WriteString(file, "part");
+  WriteInt(file, 1);
+  WriteString(file, "coordinates");
+  for (int c = 0; c < numComponents; c++)
+  {
+    for (int i = 0; i < NumberOfNodes; i++)
+    {
+      WriteFloat(file, Value(step, c, i));
+    }
+  }
+}
+
+vtkUnstructuredGrid* GetPart(vtkGenericEnSightReader* reader)
+{
+  vtkMultiBlockDataSet* output = reader->GetOutput();
+  return output && output->GetNumberOfBlocks() > 0
+    ? vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0))
+    : nullptr;
+}
+
+bool CheckArray(vtkUnstructuredGrid* part, const char* name, int step,
+  int numComponents, const int* fileComponents)
+{
+  vtkDataArray* array = part->GetPointData()->GetArray(name);
+  if (!array || array->GetNumberOfComponents() != numComponents ||
+    array->GetNumberOfTuples() != NumberOfNodes)
+  {
+    std::cerr << "Step " << step << ": missing or wrong array " << name << "\n";
+    return false;
+  }
+  for (int i = 0; i < NumberOfNodes; i++)
+  {
+    for (int c = 0; c < numComponents; c++)
+    {
+      const int fileComponent = fileComponents ? fileComponents[c] : c;
+      if (array->GetComponent(i, c) != Value(step, fileComponent, i))
+      {
+        std::cerr << "Step " << step << ": " << name << " component " << c
+                  << " of node " << i << " is " << array->GetComponent(i, c)
+                  << " instead of " << Value(step, fileComponent, i) << "\n";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}
+
+int TestEnSightGoldBinaryStaticGeometry(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string prefix = std::string(tempDir) + "/EnSightStatic";
+  delete[] tempDir;
+
+  WriteGeometry(prefix + ".geo");
+  for (int step = 0; step < 2; step++)
+  {
+    WriteVariable(prefix + "_velocity.000" + std::to_string(step), step, 3);
+    WriteVariable(prefix + "_stress.000" + std::to_string(step), step, 6);
+  }
+  {
+    std::ofstream caseFile((prefix + ".case").c_str());
+    const std::string name = "EnSightStatic";
+    caseFile << "FORMAT\n"
+             << "type: ensight gold\n\n"
+             << "GEOMETRY\n"
+             << "model: " << name << ".geo\n\n"
+             << "VARIABLE\n"
+             << "vector per node: 1 velocity " << name << "_velocity.****\n"
+             << "tensor symm per node: 1 stress " << name << "_stress.****\n\n"
+             << "TIME\n"
+             << "time set: 1\n"
+             << "number of steps: 2\n"
+             << "filename start number: 0\n"
+             << "filename increment: 1\n"
+             << "time values: 0.0 1.0\n";
+  }
+
+  vtkNew<vtkGenericEnSightReader> reader;
+  reader->SetCaseFileName((prefix + ".case").c_str());
+  reader->UpdateTimeStep(0.0);
+  vtkSmartPointer<vtkUnstructuredGrid> first = GetPart(reader);
+  if (!first || first->GetNumberOfPoints() != NumberOfNodes || first->GetNumberOfCells() != 1)
+  {
+    std::cerr << "Wrong geometry read\n";
+    return EXIT_FAILURE;
+  }
+  bool success = CheckArray(first, "velocity", 0, 3, nullptr);
+  success &= CheckArray(first, "stress", 0, 6, TensorFileComponents);
+
+  reader->UpdateTimeStep(1.0);
+  vtkUnstructuredGrid* second = GetPart(reader);
+  if (!second || second == first)
+  {
+    std::cerr << "Wrong output for the second time step\n";
+    return EXIT_FAILURE;
+  }
+  if (second->GetPoints() != first->GetPoints())
+  {
+    std::cerr << "The static geometry was read again\n";
+    success = false;
+  }
+  success &= CheckArray(second, "velocity", 1, 3, nullptr);
+  success &= CheckArray(second, "stress", 1, 6, TensorFileComponents);
+  // The variables of the second step are not added to the first one.
+  success &= CheckArray(first, "velocity", 0, 3, nullptr);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -21,13 +21,16 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <sys/stat.h>
 #include <cctype>
 #include <string>
@@ -60,13 +63,69 @@ class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
     std::map<MapKey, MapValue> Map;
 };
 
+class vtkEnSightGoldBinaryReader::GeometryCacheInternal
+{
+public:
+  // The key of the cached geometry: the time step of a file, which must not
+  // have been modified since it was read, and the byte order it was read
+  // with.
+  std::string FileName;
+  int TimeStep = 0;
+  vtkTypeInt64 FileSize = -1;
+  vtkTypeInt64 ModifiedTime = -1;
+  int ByteOrder = 0;
+
+  // The state of the reader after reading the geometry.
+  int NumberOfGeometryParts = 0;
+  int NumberOfNewOutputs = 0;
+  int NodeIdsListed = 0;
+  int ElementIdsListed = 0;
+
+  vtkSmartPointer<vtkMultiBlockDataSet> Parts;
+
+  // Copy the parts and their names, sharing the points, cells and arrays of
+  // each part but not its attributes, so that the variables added to the
+  // copies are not added to the originals.
+  static void CopyParts(vtkMultiBlockDataSet *from, vtkMultiBlockDataSet *to)
+  {
+    to->SetNumberOfBlocks(from->GetNumberOfBlocks());
+    for (unsigned int i = 0; i < from->GetNumberOfBlocks(); i++)
+    {
+      vtkDataObject *part = from->GetBlock(i);
+      if (part)
+      {
+        vtkDataObject *copy = part->NewInstance();
+        copy->ShallowCopy(part);
+        to->SetBlock(i, copy);
+        copy->Delete();
+      }
+      if (from->HasMetaData(i))
+      {
+        to->GetMetaData(i)->Copy(from->GetMetaData(i));
+      }
+    }
+  }
+};
+
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+// Size of the buffer of the files.
+#define FILE_BUFFER_SIZE 1048576
+
+namespace
+{
+// Symmetric tensors store their last two components in the opposite order
+// of the tuples of the arrays.
+const int TensorFileComponents[6] = { 0, 1, 2, 3, 5, 4 };
+}
+
 //----------------------------------------------------------------------------
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->FileOffsets = new vtkEnSightGoldBinaryReader::FileOffsetMapInternal;
+  this->GeometryCache = new vtkEnSightGoldBinaryReader::GeometryCacheInternal;
+  this->FileBuffer = new char[FILE_BUFFER_SIZE];
 
   this->GoldIFile = nullptr;
   this->FileSize = 0;
@@ -80,6 +139,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
 {
   delete this->FileOffsets;
+  delete this->GeometryCache;
 
   if (this->GoldIFile)
   {
@@ -87,6 +147,14 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     delete this->GoldIFile;
     this->GoldIFile = nullptr;
   }
+  delete [] this->FileBuffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::ClearForNewCaseFileName()
+{
+  this->GeometryCache->Parts = nullptr;
+  this->Superclass::ClearForNewCaseFileName();
 }
 
 //----------------------------------------------------------------------------
@@ -114,10 +182,12 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = static_cast<vtkTypeUInt64>(fs.st_size);
 
+    this->GoldIFile = new ifstream;
+    this->GoldIFile->rdbuf()->pubsetbuf(this->FileBuffer, FILE_BUFFER_SIZE);
 #ifdef _WIN32
-    this->GoldIFile = new ifstream(filename, ios::in | ios::binary);
+    this->GoldIFile->open(filename, ios::in | ios::binary);
 #else
-    this->GoldIFile = new ifstream(filename, ios::in);
+    this->GoldIFile->open(filename, ios::in);
 #endif
   }
   else
@@ -263,6 +333,43 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
   int partId, realId;
   int lineRead, i;
 
+  // Reuse the parts of the last geometry read if it is the same time step
+  // of the same file.
+  GeometryCacheInternal *cache = this->GeometryCache;
+  std::string sfilename = fileName ? fileName : "";
+  if (fileName && this->FilePath)
+  {
+    sfilename = this->FilePath;
+    if (sfilename.at(sfilename.length()-1) != '/')
+    {
+      sfilename += "/";
+    }
+    sfilename += fileName;
+  }
+  // only files of file sets hold several time steps
+  const int timeStepInFile = this->UseFileSets ? timeStep : 1;
+  VTK_STAT_STRUCT fs;
+  vtkTypeInt64 fileSize = -1;
+  vtkTypeInt64 modifiedTime = -1;
+  if (fileName && !VTK_STAT_FUNC(sfilename.c_str(), &fs))
+  {
+    fileSize = static_cast<vtkTypeInt64>(fs.st_size);
+    modifiedTime = static_cast<vtkTypeInt64>(fs.st_mtime);
+  }
+  if (cache->Parts && fileSize >= 0 && cache->FileName == sfilename &&
+    cache->TimeStep == timeStepInFile && cache->FileSize == fileSize &&
+    cache->ModifiedTime == modifiedTime && cache->ByteOrder == this->ByteOrder)
+  {
+    vtkDebugMacro("reusing the geometry of " << sfilename.c_str());
+    GeometryCacheInternal::CopyParts(cache->Parts, output);
+    this->NumberOfGeometryParts = cache->NumberOfGeometryParts;
+    this->NumberOfNewOutputs = cache->NumberOfNewOutputs;
+    this->NodeIdsListed = cache->NodeIdsListed;
+    this->ElementIdsListed = cache->ElementIdsListed;
+    return 1;
+  }
+  cache->Parts = nullptr;
+
   if (!this->InitializeFile(fileName))
   {
     return 0;
@@ -436,6 +543,21 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
   }
 
+  if (fileSize >= 0)
+  {
+    cache->Parts = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    GeometryCacheInternal::CopyParts(output, cache->Parts);
+    cache->FileName = sfilename;
+    cache->TimeStep = timeStepInFile;
+    cache->FileSize = fileSize;
+    cache->ModifiedTime = modifiedTime;
+    cache->ByteOrder = this->ByteOrder;
+    cache->NumberOfGeometryParts = this->NumberOfGeometryParts;
+    cache->NumberOfNewOutputs = this->NumberOfNewOutputs;
+    cache->NodeIdsListed = this->NodeIdsListed;
+    cache->ElementIdsListed = this->ElementIdsListed;
+  }
+
   return 1;
 }
 
@@ -1136,7 +1258,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   char line[80], subLine[80];
   vtkIdType i;
   int *pointIds;
-  float *xCoords, *yCoords, *zCoords;
   vtkPoints *points = vtkPoints::New();
   vtkPolyData *pd = vtkPolyData::New();
 
@@ -1230,10 +1351,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   this->ReadInt(&this->NumberOfMeasuredPoints);
 
   pointIds = new int[this->NumberOfMeasuredPoints];
-  xCoords = new float [this->NumberOfMeasuredPoints];
-  yCoords = new float [this->NumberOfMeasuredPoints];
-  zCoords = new float [this->NumberOfMeasuredPoints];
-  points->Allocate(this->NumberOfMeasuredPoints);
   pd->Allocate(this->NumberOfMeasuredPoints);
 
   // Extract the array of point indices. Note EnSight Manual v8.2 (pp. 559,
@@ -1245,28 +1362,25 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   // The following code segment (20+ lines) serves as a fix to bug #9245.
   this->ReadIntArray( pointIds, this->NumberOfMeasuredPoints );
 
-  // Read point coordinates tuple by tuple while each tuple contains three
-  // components: (x-cord, y-cord, z-cord)
-  int  floatSize = sizeof( float );
-  for ( i = 0; i < this->NumberOfMeasuredPoints; i ++ )
-  {
-    this->GoldIFile->read(  ( char * )( xCoords + i ),  floatSize  );
-    this->GoldIFile->read(  ( char * )( yCoords + i ),  floatSize  );
-    this->GoldIFile->read(  ( char * )( zCoords + i ),  floatSize  );
-  }
+  // Point coordinates are stored tuple by tuple while each tuple contains
+  // three components: (x-cord, y-cord, z-cord), so they are read at once
+  // into the point array.
+  vtkFloatArray *coords = vtkFloatArray::New();
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(this->NumberOfMeasuredPoints);
+  this->GoldIFile->read(reinterpret_cast<char*>(coords->GetPointer(0)),
+    sizeof(float) * 3 * this->NumberOfMeasuredPoints);
 
   if ( this->ByteOrder == FILE_LITTLE_ENDIAN )
   {
-    vtkByteSwap::Swap4LERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4LERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4LERange( coords->GetPointer(0), 3 * this->NumberOfMeasuredPoints );
   }
   else
   {
-    vtkByteSwap::Swap4BERange( xCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( yCoords, this->NumberOfMeasuredPoints );
-    vtkByteSwap::Swap4BERange( zCoords, this->NumberOfMeasuredPoints );
+    vtkByteSwap::Swap4BERange( coords->GetPointer(0), 3 * this->NumberOfMeasuredPoints );
   }
+  points->SetData(coords);
+  coords->Delete();
 
   // NOTE: EnSight always employs a 1-based indexing scheme and therefore
   // 'if (this->ParticleCoordinatesByIndex)' was removed here. Otherwise
@@ -1274,7 +1388,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   // This bug was noticed while fixing bug #7453.
   for (i = 0; i < this->NumberOfMeasuredPoints; i++)
   {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
     pd->InsertNextCell(VTK_VERTEX, 1, &i);
   }
 
@@ -1284,9 +1397,6 @@ int vtkEnSightGoldBinaryReader::ReadMeasuredGeometryFile(const char* fileName,
   points->Delete();
   pd->Delete();
   delete [] pointIds;
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   if (this->GoldIFile)
   {
@@ -1306,7 +1416,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *scalars;
-  float* scalarsRead;
   vtkDataSet *output;
 
   // Initialize
@@ -1409,17 +1518,12 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       scalars = vtkFloatArray::New();
       scalars->SetNumberOfComponents(numberOfComponents);
       scalars->SetNumberOfTuples(numPts);
-      scalarsRead = new float [numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
       // Why are we setting only one component here?
       // Only one component is set because scalars are single-component arrays.
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
-      for (i = 0; i < numPts; i++)
-      {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
+      this->ReadFloatComponent(scalars->GetPointer(0), numPts, numberOfComponents, component);
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
       if (!output->GetPointData()->GetScalars())
@@ -1427,7 +1531,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
         output->GetPointData()->SetScalars(scalars);
       }
       scalars->Delete();
-      delete [] scalarsRead;
     }
     if (this->GoldIFile)
     {
@@ -1477,13 +1580,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
           GetArray(description));
       }
 
-      scalarsRead = new float[numPts];
-      this->ReadFloatArray(scalarsRead, numPts);
-
-      for (i = 0; i < numPts; i++)
-      {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
+      this->ReadFloatComponent(scalars->GetPointer(0), numPts, numberOfComponents, component);
       if (component == 0)
       {
         scalars->SetName(description);
@@ -1498,7 +1595,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       {
         output->GetPointData()->AddArray(scalars);
       }
-      delete [] scalarsRead;
     }
 
     this->GoldIFile->peek();
@@ -1527,8 +1623,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *vectors;
-  float tuple[3];
-  float *comp1, *comp2, *comp3;
   float *vectorsRead;
   vtkDataSet *output;
 
@@ -1681,19 +1775,7 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
       vectors = vtkFloatArray::New();
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        vectors->SetTuple(i, tuple);
-      }
+      this->ReadFloatComponents(vectors->GetPointer(0), numPts, 3);
       vectors->SetName(description);
       output->GetPointData()->AddArray(vectors);
       if (!output->GetPointData()->GetVectors())
@@ -1701,9 +1783,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
         output->GetPointData()->SetVectors(vectors);
       }
       vectors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
     }
 
     this->GoldIFile->peek();
@@ -1733,8 +1812,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
   char line[80];
   int partId, realId, numPts, i, lineRead;
   vtkFloatArray *tensors;
-  float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
-  float tuple[6];
   vtkDataSet *output;
 
   // Initialize
@@ -1824,37 +1901,10 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      comp4 = new float[numPts];
-      comp5 = new float[numPts];
-      comp6 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      this->ReadFloatArray(comp4, numPts);
-      this->ReadFloatArray(comp6, numPts);
-      this->ReadFloatArray(comp5, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        tuple[3] = comp4[i];
-        tuple[4] = comp5[i];
-        tuple[5] = comp6[i];
-        tensors->InsertTuple(i, tuple);
-      }
+      this->ReadFloatComponents(tensors->GetPointer(0), numPts, 6, TensorFileComponents);
       tensors->SetName(description);
       output->GetPointData()->AddArray(tensors);
       tensors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
-      delete [] comp4;
-      delete [] comp5;
-      delete [] comp6;
     }
 
     this->GoldIFile->peek();
@@ -2634,7 +2684,6 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
   int *nodeIdList;
   int numElements;
   int idx, cellId, cellType;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -2679,30 +2728,20 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints *points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
-
       if (this->NodeIdsListed)
       {
         this->GoldIFile->seekg(sizeof(int)*numPts, ios::cur);
       }
 
-      xCoords = new float[numPts];
-      yCoords = new float[numPts];
-      zCoords = new float[numPts];
-      this->ReadFloatArray(xCoords, numPts);
-      this->ReadFloatArray(yCoords, numPts);
-      this->ReadFloatArray(zCoords, numPts);
-
-      for (i = 0; i < numPts; i++)
-      {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-      }
+      vtkFloatArray *coords = vtkFloatArray::New();
+      coords->SetNumberOfComponents(3);
+      coords->SetNumberOfTuples(numPts);
+      this->ReadFloatComponents(coords->GetPointer(0), numPts, 3);
+      points->SetData(coords);
+      coords->Delete();
 
       output->SetPoints(points);
       points->Delete();
-      delete [] xCoords;
-      delete [] yCoords;
-      delete [] zCoords;
     }
     else if (strncmp(line, "point", 5) == 0)
     {
@@ -3745,7 +3784,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   int i;
   vtkPoints *points = vtkPoints::New();
   int numPts;
-  float *xCoords, *yCoords, *zCoords;
 
   this->NumberOfNewOutputs++;
 
@@ -3785,19 +3823,13 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
     return -1;
   }
   output->SetDimensions(dimensions);
-  points->Allocate(numPts);
 
-  xCoords = new float[numPts];
-  yCoords = new float[numPts];
-  zCoords = new float[numPts];
-  this->ReadFloatArray(xCoords, numPts);
-  this->ReadFloatArray(yCoords, numPts);
-  this->ReadFloatArray(zCoords, numPts);
-
-  for (i = 0; i < numPts; i++)
-  {
-    points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
-  }
+  vtkFloatArray *coords = vtkFloatArray::New();
+  coords->SetNumberOfComponents(3);
+  coords->SetNumberOfTuples(numPts);
+  this->ReadFloatComponents(coords->GetPointer(0), numPts, 3);
+  points->SetData(coords);
+  coords->Delete();
   output->SetPoints(points);
   if (iblanked)
   {
@@ -3815,9 +3847,6 @@ int vtkEnSightGoldBinaryReader::CreateStructuredGridOutput(
   }
 
   points->Delete();
-  delete [] xCoords;
-  delete [] yCoords;
-  delete [] zCoords;
 
   this->GoldIFile->peek();
   if (this->GoldIFile->eof())
@@ -3858,11 +3887,9 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
   int lineRead;
   int iblanked = 0;
   int dimensions[3];
-  int i;
   vtkFloatArray *xCoords = vtkFloatArray::New();
   vtkFloatArray *yCoords = vtkFloatArray::New();
   vtkFloatArray *zCoords = vtkFloatArray::New();
-  float *tempCoords;
   int numPts;
 
   this->NumberOfNewOutputs++;
@@ -3908,31 +3935,14 @@ int vtkEnSightGoldBinaryReader::CreateRectilinearGridOutput(
   }
 
   output->SetDimensions(dimensions);
-  xCoords->Allocate(dimensions[0]);
-  yCoords->Allocate(dimensions[1]);
-  zCoords->Allocate(dimensions[2]);
-
-  tempCoords = new float[dimensions[0]];
-  this->ReadFloatArray(tempCoords, dimensions[0]);
-  for (i = 0; i < dimensions[0]; i++)
-  {
-    xCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete [] tempCoords;
-  tempCoords = new float[dimensions[1]];
-  this->ReadFloatArray(tempCoords, dimensions[1]);
-  for (i = 0; i < dimensions[1]; i++)
-  {
-    yCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete [] tempCoords;
-  tempCoords = new float[dimensions[2]];
-  this->ReadFloatArray(tempCoords, dimensions[2]);
-  for (i = 0; i < dimensions[2]; i++)
-  {
-    zCoords->InsertNextTuple(&tempCoords[i]);
-  }
-  delete [] tempCoords;
+  xCoords->SetNumberOfTuples(dimensions[0]);
+  yCoords->SetNumberOfTuples(dimensions[1]);
+  zCoords->SetNumberOfTuples(dimensions[2]);
+
+  // the coordinates are read straight into the coordinate arrays
+  this->ReadFloatArray(xCoords->GetPointer(0), dimensions[0]);
+  this->ReadFloatArray(yCoords->GetPointer(0), dimensions[1]);
+  this->ReadFloatArray(zCoords->GetPointer(0), dimensions[2]);
   if (iblanked)
   {
     vtkWarningMacro("VTK does not handle blanking for rectilinear grids.");
@@ -4279,6 +4289,86 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
   return 1;
 }
 
+// Internal function to read a float array into one component of the
+// interleaved tuples of an array, a chunk at a time through a small buffer
+// rather than through a temporary array of all its values.
+// Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatComponent(float *tuples,
+  int numTuples, int numComponents, int component)
+{
+  if (numComponents == 1)
+  {
+    return this->ReadFloatArray(tuples, numTuples);
+  }
+  if (numTuples <= 0)
+  {
+    return 1;
+  }
+
+  char dummy[4];
+  if (this->Fortran)
+  {
+    if (!this->GoldIFile->read(dummy, 4))
+    {
+      vtkErrorMacro("Read (fortran) failed.");
+      return 0;
+    }
+  }
+
+  const int chunkSize = 4096;
+  float chunk[chunkSize];
+  float *tuple = tuples + component;
+  for (int begin = 0; begin < numTuples; begin += chunkSize)
+  {
+    const int count = std::min(chunkSize, numTuples - begin);
+    if (!this->GoldIFile->read((char*)chunk, sizeof(float)*count))
+    {
+      vtkErrorMacro("Read failed");
+      return 0;
+    }
+    if (this->ByteOrder == FILE_LITTLE_ENDIAN)
+    {
+      vtkByteSwap::Swap4LERange(chunk, count);
+    }
+    else
+    {
+      vtkByteSwap::Swap4BERange(chunk, count);
+    }
+    for (int i = 0; i < count; i++, tuple += numComponents)
+    {
+      *tuple = chunk[i];
+    }
+  }
+
+  if (this->Fortran)
+  {
+    if (!this->GoldIFile->read(dummy, 4))
+    {
+      vtkErrorMacro("Read (fortran) failed.");
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Internal function to read the float arrays of the components of an array,
+// stored one after the other, into its interleaved tuples. The component
+// read i-th goes to component order[i], if given.
+// Returns zero if there was an error.
+int vtkEnSightGoldBinaryReader::ReadFloatComponents(float *tuples,
+  int numTuples, int numComponents, const int *order)
+{
+  for (int i = 0; i < numComponents; i++)
+  {
+    if (!this->ReadFloatComponent(tuples, numTuples, numComponents,
+          order ? order[i] : i))
+    {
+      return 0;
+    }
+  }
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
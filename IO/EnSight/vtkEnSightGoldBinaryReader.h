@@ -26,6 +26,10 @@
  * array of real values) and _i (for the array if imaginary values).  Complex
  * scalar variables are stored as a single array with 2 components, real and
  * imaginary, listed in that order.
+ * The parts read from a geometry file are kept and reused as long as the
+ * same time step of the same, unmodified file is requested, so that
+ * transient cases with a static geometry only read their variables at each
+ * time step.
  * @warning
  * You must manually call Update on this reader and then connect the rest
  * of the pipeline because (due to the nature of the file format) it is
@@ -194,6 +198,23 @@ protected:
    */
   int ReadFloatArray(float *result, int numFloats);
 
+  /**
+   * Internal function to read in a float array into one component of the
+   * interleaved tuples of an array.
+   * Returns zero if there was an error.
+   */
+  int ReadFloatComponent(float *tuples, int numTuples, int numComponents,
+    int component);
+
+  /**
+   * Internal function to read in the float arrays of the components of an
+   * array, stored one after the other, into its interleaved tuples. The
+   * component read i-th goes to component order[i], if order is given.
+   * Returns zero if there was an error.
+   */
+  int ReadFloatComponents(float *tuples, int numTuples, int numComponents,
+    const int *order = nullptr);
+
   /**
    * Counts the number of timesteps in the geometry file
    * This function assumes the file is already open and returns the
@@ -239,6 +260,23 @@ protected:
   class FileOffsetMapInternal;
   FileOffsetMapInternal *FileOffsets;
 
+  /**
+   * The parts of the last geometry file read, reused as long as the same
+   * time step of the same, unmodified file is read again, so that transient
+   * cases with a static geometry only read their variables at each step.
+   */
+  class GeometryCacheInternal;
+  GeometryCacheInternal *GeometryCache;
+
+  /**
+   * Clear the geometry cache along with the part ids it refers to.
+   */
+  void ClearForNewCaseFileName() override;
+
+  // Buffer of GoldIFile, larger than the default one so that the many small
+  // reads of lines and integers do not each go to the file.
+  char *FileBuffer;
+
 private:
   int SizeOfInt;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&) = delete;
@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusPrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Plays the time steps of an Exodus file forward, backward and out of order
+// with time steps read ahead into the cache, and checks that the output
+// matches the output of a reader without reading ahead. Also checks that the
+// arrays read ahead are found in the cache instead of being read again.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkDataSet.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIReaderPrivate.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPointSet.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <vector>
+
+namespace
+{
+
+// Gives access to the number of arrays read from the file.
+class PrefetchReader : public vtkExodusIIReader
+{
+public:
+  static PrefetchReader* New();
+  vtkTypeMacro(PrefetchReader, vtkExodusIIReader);
+
+  vtkExodusIIReaderPrivate* GetPrivate() { return this->GetMetadata(); }
+};
+
+vtkStandardNewMacro(PrefetchReader);
+
+void SetUpReader(vtkExodusIIReader* reader, const char* fname)
+{
+  reader->SetFileName(fname);
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::GLOBAL, 1);
+}
+
+bool SameArray(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues() ||
+    a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    return false;
+  }
+  const int numComps = a->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetComponent(i / numComps, i % numComps) != b->GetComponent(i / numComps, i % numComps))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = a->GetArray(i);
+    if (array && !SameArray(array, b->GetArray(array->GetName())))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SameOutput(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> ait;
+  ait.TakeReference(a->NewIterator());
+  vtkSmartPointer<vtkCompositeDataIterator> bit;
+  bit.TakeReference(b->NewIterator());
+  int numLeaves = 0;
+  for (ait->InitTraversal(), bit->InitTraversal(); !ait->IsDoneWithTraversal();
+       ait->GoToNextItem(), bit->GoToNextItem())
+  {
+    if (bit->IsDoneWithTraversal())
+    {
+      return false;
+    }
+    vtkPointSet* aset = vtkPointSet::SafeDownCast(ait->GetCurrentDataObject());
+    vtkPointSet* bset = vtkPointSet::SafeDownCast(bit->GetCurrentDataObject());
+    if (!aset || !bset || !SameArray(aset->GetPoints()->GetData(), bset->GetPoints()->GetData()) ||
+      !SameAttributes(aset->GetPointData(), bset->GetPointData()) ||
+      !SameAttributes(aset->GetCellData(), bset->GetCellData()))
+    {
+      return false;
+    }
+    ++numLeaves;
+  }
+  return bit->IsDoneWithTraversal() && numLeaves > 0;
+}
+
+}
+
+int TestExodusPrefetch(int argc, char* argv[])
+{
+  char* fname = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/can.ex2");
+  if (!fname)
+  {
+    cout << "Could not obtain filename for test data.\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<PrefetchReader> reference;
+  SetUpReader(reference, fname);
+  vtkNew<PrefetchReader> reader;
+  SetUpReader(reader, fname);
+  delete[] fname;
+  reader->SetCacheSize(64);
+  reader->SetPrefetchTimeSteps(4);
+
+  const int numSteps = reader->GetNumberOfTimeSteps();
+  if (numSteps < 3)
+  {
+    std::cerr << "Expected several time steps, got " << numSteps << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Once the next time step is read ahead, requesting it reads fewer arrays
+  // from the file than without reading ahead.
+  reference->SetTimeStep(0);
+  reference->Update();
+  reader->SetTimeStep(0);
+  reader->Update();
+  reader->GetPrivate()->WaitForPrefetch();
+  const vtkIdType referenceRead = reference->GetPrivate()->GetNumberOfArraysRead();
+  const vtkIdType readerRead = reader->GetPrivate()->GetNumberOfArraysRead();
+  reference->SetTimeStep(1);
+  reference->Update();
+  reader->SetTimeStep(1);
+  reader->Update();
+  const vtkIdType referenceStepRead =
+    reference->GetPrivate()->GetNumberOfArraysRead() - referenceRead;
+  const vtkIdType readerStepRead = reader->GetPrivate()->GetNumberOfArraysRead() - readerRead;
+  if (referenceStepRead == 0 || readerStepRead >= referenceStepRead)
+  {
+    std::cerr << "Time step 1 read " << readerStepRead << " arrays from the file with "
+              << referenceStepRead << " read without reading ahead\n";
+    return EXIT_FAILURE;
+  }
+  if (!SameOutput(reference->GetOutput(), reader->GetOutput()))
+  {
+    std::cerr << "Wrong output for time step 1 read ahead\n";
+    return EXIT_FAILURE;
+  }
+
+  // Play forward, backward, and jump around while steps are read ahead.
+  std::vector<int> steps;
+  for (int step = 0; step < numSteps; ++step)
+  {
+    steps.push_back(step);
+  }
+  for (int step = numSteps - 1; step >= 0; --step)
+  {
+    steps.push_back(step);
+  }
+  steps.push_back(numSteps / 2);
+  steps.push_back(1);
+  steps.push_back(numSteps - 2);
+  steps.push_back(numSteps - 2);
+
+  for (size_t i = 0; i < steps.size(); ++i)
+  {
+    reference->SetTimeStep(steps[i]);
+    reference->Update();
+    reader->SetTimeStep(steps[i]);
+    reader->Update();
+    if (!SameOutput(reference->GetOutput(), reader->GetOutput()))
+    {
+      std::cerr << "Wrong output for time step " << steps[i] << " (request " << i << ")\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Changing the settings while reading ahead invalidates the cache as usual.
+  reader->SetTimeStep(0);
+  reader->Update();
+  reader->SetApplyDisplacements(0);
+  reference->SetApplyDisplacements(0);
+  reader->SetTimeStep(1);
+  reader->Update();
+  reference->SetTimeStep(1);
+  reference->Update();
+  if (!SameOutput(reference->GetOutput(), reader->GetOutput()))
+  {
+    std::cerr << "Wrong output after changing the displacements\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
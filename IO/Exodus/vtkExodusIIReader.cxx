@@ -55,7 +55,10 @@
 #include <map>
 #include <set>
 #include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include "vtksys/SystemTools.hxx"
 
 #include "vtksys/RegularExpression.hxx"
@@ -199,6 +202,19 @@ static const char* glomTypeNames[] = {
 // used to store pointer to ex_get_node_num_map or ex_get_elem_num_map:
 extern "C" { typedef int (*vtkExodusIIGetMapFunc)( int, int* ); }
 
+// The Exodus and netCDF libraries are not thread safe. Readers hold this
+// lock while they call them, so that a thread prefetching time steps never
+// runs concurrently with another reader.
+static std::recursive_mutex& vtkExodusIILibraryMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+// Set by the thread prefetching time steps when it starts, so that the
+// arrays it reads neither cancel it nor count as read by the reader.
+static thread_local bool vtkExodusIIInPrefetchThread = false;
+
 // --------------------------------------------------- PRIVATE CLASS DECLARATION
 #include "vtkExodusIIReaderPrivate.h"
 #include "vtkExodusIIReaderVariableCheck.h"
@@ -384,6 +400,12 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->PrefetchTimeSteps = 0;
+  this->PrefetchLastTimeStep = -1;
+  this->PrefetchRecordedTimeStep = -1;
+  this->PrefetchCancelled = false;
+  this->NumberOfArraysRead = 0;
+
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
   this->AnimateModeShapes = 1;
@@ -1707,6 +1729,9 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
 //-----------------------------------------------------------------------------
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
+  this->CancelPrefetch();
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
+
   vtkDataArray* arr;
   // Never cache points deflected for a mode shape animation... doubles don't make good keys.
   if ( this->HasModeShapes && key.ObjectType == vtkExodusIIReader::NODAL_COORDS )
@@ -1720,7 +1745,7 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
 
   if ( arr )
   {
-    //
+    this->RecordPrefetchKey( key, arr );
     return arr;
   }
 
@@ -3029,10 +3054,130 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   {
     this->Cache->Insert( key, arr );
     arr->FastDelete();
+    this->RecordPrefetchKey( key, arr );
+    if ( ! vtkExodusIIInPrefetchThread )
+    {
+      ++this->NumberOfArraysRead;
+    }
   }
   return arr;
 }
 
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::RecordPrefetchKey( const vtkExodusIICacheKey& key, vtkDataArray* arr )
+{
+  if ( this->PrefetchRecordedTimeStep >= 0 )
+  {
+    this->PrefetchKeys[key] = arr->GetActualMemorySize() / 1024.;
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkExodusIIReaderPrivate::StartPrefetch( int timeStep )
+{
+  // Read ahead in the direction the time steps are requested in.
+  int direction = ( timeStep < this->PrefetchLastTimeStep ) ? -1 : 1;
+  this->PrefetchLastTimeStep = timeStep;
+  if ( this->PrefetchTimeSteps <= 0 || this->HasModeShapes || this->Exoid < 0 )
+  {
+    return false;
+  }
+
+  // The time-varying arrays of the requested time step are read for the
+  // next time steps. They replace the least recently used arrays of the
+  // cache, so only as many time steps as fit beside all the arrays used by
+  // the requested time step are read.
+  std::vector<vtkExodusIICacheKey> keys;
+  double stepSize = 0.;
+  double usedSize = 0.;
+  std::map<vtkExodusIICacheKey,double>::iterator it;
+  for ( it = this->PrefetchKeys.begin(); it != this->PrefetchKeys.end(); ++it )
+  {
+    usedSize += it->second;
+    if ( it->first.Time == timeStep )
+    {
+      keys.push_back( it->first );
+      stepSize += it->second;
+    }
+  }
+  this->PrefetchKeys.clear();
+
+  std::vector<int> timeSteps;
+  double spaceLeft = this->CacheSize - usedSize;
+  for ( int step = timeStep + direction;
+    step >= 0 && step < this->GetNumberOfTimeSteps() &&
+    static_cast<int>( timeSteps.size() ) < this->PrefetchTimeSteps && stepSize <= spaceLeft;
+    step += direction )
+  {
+    timeSteps.push_back( step );
+    spaceLeft -= stepSize;
+  }
+  if ( keys.empty() || timeSteps.empty() )
+  {
+    return false;
+  }
+
+  this->PrefetchCancelled = false;
+  this->PrefetchThread = std::thread( &vtkExodusIIReaderPrivate::Prefetch, this,
+    std::move( keys ), std::move( timeSteps ) );
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::Prefetch(
+  std::vector<vtkExodusIICacheKey> keys, std::vector<int> timeSteps )
+{
+  vtkExodusIIInPrefetchThread = true;
+  for ( size_t i = 0; i < timeSteps.size() && ! this->PrefetchCancelled; ++i )
+  {
+    for ( size_t k = 0; k < keys.size() && ! this->PrefetchCancelled; ++k )
+    {
+      vtkExodusIICacheKey key( keys[k] );
+      key.Time = timeSteps[i];
+      this->GetCacheOrRead( key );
+    }
+  }
+  this->CloseFile();
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::CancelPrefetch()
+{
+  // Only the thread that started the prefetch thread may stop it.
+  if ( vtkExodusIIInPrefetchThread )
+  {
+    return;
+  }
+  if ( this->PrefetchThread.joinable() )
+  {
+    this->PrefetchCancelled = true;
+    this->PrefetchThread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::WaitForPrefetch()
+{
+  if ( ! vtkExodusIIInPrefetchThread && this->PrefetchThread.joinable() )
+  {
+    this->PrefetchThread.join();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::SetPrefetchTimeSteps( int numSteps )
+{
+  this->CancelPrefetch();
+  this->PrefetchTimeSteps = numSteps < 0 ? 0 : numSteps;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::Modified()
+{
+  this->CancelPrefetch();
+  this->Superclass::Modified();
+}
+
 //-----------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::GetConnTypeIndexFromConnType( int ctyp )
 {
@@ -3829,7 +3974,9 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
   }
 
   os << indent << "Array Cache:\n";
+  this->CancelPrefetch();
   this->Cache->PrintSelf( os, inden2 );
+  os << indent << "PrefetchTimeSteps: " << this->PrefetchTimeSteps << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3847,6 +3994,9 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
     return 0;
   }
 
+  this->CancelPrefetch();
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
+
   if ( this->Exoid >= 0 )
   {
     this->CloseFile();
@@ -3883,6 +4033,9 @@ int vtkExodusIIReaderPrivate::OpenFile( const char* filename )
 
 int vtkExodusIIReaderPrivate::CloseFile()
 {
+  this->CancelPrefetch();
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
+
   if ( this->Exoid >= 0 )
   {
     VTK_EXO_FUNC( ex_close( this->Exoid ), "Could not close an open file (" << this->Exoid << ")" );
@@ -4005,6 +4158,9 @@ void vtkExodusIIReaderPrivate::BuildSIL()
 //-----------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::RequestInformation()
 {
+  this->CancelPrefetch();
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
+
   int exoid = this->Exoid;
   //int itmp[5];
   vtkIdType* ids;
@@ -4500,6 +4656,14 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     vtkErrorMacro( "You must specify an output mesh" );
   }
 
+  this->CancelPrefetch();
+  std::unique_lock<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
+
+  // Record the arrays used for this time step, to read them ahead for the
+  // next ones.
+  this->PrefetchKeys.clear();
+  this->PrefetchRecordedTimeStep = this->PrefetchTimeSteps > 0 ? static_cast<int>( timeStep ) : -1;
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4583,7 +4747,13 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     }
   }
 
-  this->CloseFile();
+  // The prefetching thread closes the file once it is done.
+  this->PrefetchRecordedTimeStep = -1;
+  libraryLock.unlock();
+  if ( ! this->StartPrefetch( static_cast<int>( timeStep ) ) )
+  {
+    this->CloseFile();
+  }
 
   return 0;
 }
@@ -4769,6 +4939,7 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
 void vtkExodusIIReaderPrivate::ResetCache()
 {
+  this->CancelPrefetch();
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
   this->ClearConnectivityCaches();
@@ -4776,6 +4947,7 @@ void vtkExodusIIReaderPrivate::ResetCache()
 
 void vtkExodusIIReaderPrivate::SetCacheSize( double size )
 {
+  this->CancelPrefetch();
   if (this->CacheSize != size)
   {
     this->CacheSize = size;
@@ -4917,9 +5089,9 @@ void vtkExodusIIReaderPrivate::SetObjectStatus( int otyp, int k, int stat )
   { // no change => do nothing
     return;
   }
-  oinfop->Status = stat;
-
+  // Stop reading ahead before the status changes.
   this->Modified();
+  oinfop->Status = stat;
 }
 
 void vtkExodusIIReaderPrivate::SetUnsortedObjectStatus( int otyp, int k, int stat )
@@ -4936,9 +5108,9 @@ void vtkExodusIIReaderPrivate::SetUnsortedObjectStatus( int otyp, int k, int sta
   { // no change => do nothing
     return;
   }
-  oinfop->Status = stat;
-
+  // Stop reading ahead before the status changes.
   this->Modified();
+  oinfop->Status = stat;
 }
 
 void vtkExodusIIReaderPrivate::SetInitialObjectStatus( int objectType, const char* objName, int status )
@@ -5054,8 +5226,9 @@ void vtkExodusIIReaderPrivate::SetObjectArrayStatus( int otyp, int i, int stat )
       // no change => do nothing
       return;
     }
-    it->second[i].Status = stat;
+    // Stop reading ahead before the status changes.
     this->Modified();
+    it->second[i].Status = stat;
     // FIXME: Mark something so we know what's changed since the last RequestData?!
     // For the "global" (assembled) array, this is tricky because we really only want
     // to invalidate a range of the total array... For now, we'll just force the "global"
@@ -5311,6 +5484,7 @@ int vtkExodusIIReader::CanReadFile( const char* fname )
   int diskWordSize = 8;
   float version;
 
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
   if ( (exoid = ex_open( fname, EX_READ, &appWordSize, &diskWordSize, &version )) < 0 )
   {
     return 0;
@@ -5562,6 +5736,7 @@ int vtkExodusIIReader::RequestData(
 
 int vtkExodusIIReader::GetMaxNameLength()
 {
+  std::lock_guard<std::recursive_mutex> libraryLock( vtkExodusIILibraryMutex() );
   return ex_inquire_int(this->Metadata->Exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH);
 }
 
@@ -6513,3 +6688,13 @@ void vtkExodusIIReader::ResetCache()
 {
   this->Metadata->ResetCache();
 }
+
+void vtkExodusIIReader::SetPrefetchTimeSteps(int numSteps)
+{
+  this->Metadata->SetPrefetchTimeSteps(numSteps);
+}
+
+int vtkExodusIIReader::GetPrefetchTimeSteps()
+{
+  return this->Metadata->GetPrefetchTimeSteps();
+}
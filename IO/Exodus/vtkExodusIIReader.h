@@ -752,6 +752,21 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * Set the number of time steps read ahead into the cache once a time step
+   * is read. The arrays of the requested time step are read for the next
+   * time steps (or the previous ones, when the time steps are requested
+   * backward) on a background thread, so that playing an animation does not
+   * wait for the file. Only as many time steps as fit in the cache beside
+   * the arrays of the requested time step are read, so the cache size must
+   * be set as well. Reading ahead stops as soon as the reader is modified or
+   * updated again. The default is 0, which disables reading ahead.
+   */
+  void SetPrefetchTimeSteps(int numSteps);
+  int GetPrefetchTimeSteps();
+  //@}
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
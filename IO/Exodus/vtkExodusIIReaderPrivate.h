@@ -10,7 +10,9 @@
 #include "vtkExodusIICache.h"
 #include "vtksys/RegularExpression.hxx"
 
+#include <atomic> // for PrefetchCancelled
 #include <map>
+#include <thread> // for PrefetchThread
 #include <vector>
 
 #include "vtk_exodusII.h"
@@ -80,6 +82,37 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Set the number of time steps read ahead into the cache after each
+    * RequestData() call. The arrays read for the requested time step are
+    * read for the next time steps (or the previous ones when the time steps
+    * are requested backward) on a background thread, as long as they fit in
+    * the cache along with the arrays of the requested time step.
+    * The default is 0, which disables prefetching.
+    */
+  void SetPrefetchTimeSteps( int numSteps );
+
+  /// Get the number of time steps read ahead into the cache.
+  vtkGetMacro(PrefetchTimeSteps, int);
+
+  /** Stop reading time steps ahead and wait for the background thread.
+    * This is called before anything else uses the file or the cache,
+    * so it is only needed before accessing the cache directly.
+    */
+  void CancelPrefetch();
+
+  /** Wait for the background thread to read all the time steps ahead.
+    * This is only useful to test what was read ahead.
+    */
+  void WaitForPrefetch();
+
+  /** Get the number of arrays read from the file by RequestData(), rather
+    * than found in the cache. Arrays read ahead are not counted.
+    */
+  vtkGetMacro(NumberOfArraysRead, vtkIdType);
+
+  /// Cancel prefetching before any change of the reader settings.
+  void Modified() override;
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -640,6 +673,20 @@ protected:
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /** Remember the key and size of an array used by RequestData(), so that
+    * the arrays of the requested time step can be read for the next ones.
+    */
+  void RecordPrefetchKey( const vtkExodusIICacheKey& key, vtkDataArray* arr );
+
+  /** Start reading the recorded arrays of the time steps following
+    * \a timeStep on a background thread, which closes the file when it is
+    * done. Returns false if there is nothing to read ahead.
+    */
+  bool StartPrefetch( int timeStep );
+
+  /// Read the arrays of \a keys for each of \a timeSteps (run by PrefetchThread).
+  void Prefetch( std::vector<vtkExodusIICacheKey> keys, std::vector<int> timeSteps );
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -826,6 +873,29 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// The number of time steps to read ahead into the cache.
+  int PrefetchTimeSteps;
+
+  /// The time step requested by the previous RequestData() call.
+  int PrefetchLastTimeStep;
+
+  /// The time step requested by RequestData(), or -1 outside RequestData().
+  int PrefetchRecordedTimeStep;
+
+  /** The keys of all the arrays used by the last RequestData() call, with
+    * their size in MiB.
+    */
+  std::map<vtkExodusIICacheKey,double> PrefetchKeys;
+
+  /// The background thread reading time steps ahead, if any.
+  std::thread PrefetchThread;
+
+  /// Set to stop PrefetchThread before its next array.
+  std::atomic<bool> PrefetchCancelled;
+
+  /// The number of arrays read from the file outside PrefetchThread.
+  vtkIdType NumberOfArraysRead;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
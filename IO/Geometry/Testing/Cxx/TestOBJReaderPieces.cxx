@@ -0,0 +1,134 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderPieces.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads an OBJ file large enough to be parsed in several pieces, with
+// relative indices, continuation lines, groups and materials, and checks
+// the points, faces and cell arrays.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+#include <cstdio>
+#include <string>
+
+int TestOBJReaderPieces(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string fileName = std::string(tempDir) + "/Pieces.obj";
+  delete[] tempDir;
+
+  // Each face is written after its three vertices, with relative indices for
+  // odd faces and a continuation line for every seventh one. A group starts
+  // every 1000 faces, after the first faces, and faces alternate between
+  // two materials every 500 faces.
+  const vtkIdType numFaces = 100000;
+  const vtkIdType facesPerGroup = 1000;
+  const vtkIdType facesPerMaterial = 500;
+  FILE* file = fopen(fileName.c_str(), "w");
+  if (!file)
+  {
+    std::cerr << "Could not write " << fileName << "\n";
+    return EXIT_FAILURE;
+  }
+  fprintf(file, "# Pieces\n");
+  for (vtkIdType face = 0; face < numFaces; ++face)
+  {
+    if (face % facesPerGroup == 10)
+    {
+      fprintf(file, "g group%d\n", static_cast<int>(face / facesPerGroup));
+    }
+    if (face % facesPerMaterial == 0)
+    {
+      fprintf(file, "usemtl %s\n", (face / facesPerMaterial) % 2 ? "odd" : "even");
+    }
+    for (vtkIdType i = 3 * face; i < 3 * face + 3; ++i)
+    {
+      fprintf(file, "v %lld %lld 2.5\n", static_cast<long long>(i), -2LL * i);
+    }
+    const long long first = static_cast<long long>(3 * face + 1);
+    if (face % 2)
+    {
+      fprintf(file, face % 7 ? "f -3 -2 -1\n" : "f -3 -2 \\\n  -1\n");
+    }
+    else
+    {
+      fprintf(file, face % 7 ? "f %lld %lld %lld\n" : "f %lld %lld \\\n %lld\n", first, first + 1,
+        first + 2);
+    }
+  }
+  fclose(file);
+
+  vtkNew<vtkOBJReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != 3 * numFaces || output->GetNumberOfPolys() != numFaces)
+  {
+    std::cerr << output->GetNumberOfPoints() << " points and " << output->GetNumberOfPolys()
+              << " faces instead of " << 3 * numFaces << " and " << numFaces << "\n";
+    return EXIT_FAILURE;
+  }
+  if (std::string(reader->GetComment()) != "Pieces")
+  {
+    std::cerr << "Wrong comment: " << reader->GetComment() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkDataArray* groupIds = output->GetCellData()->GetArray("GroupIds");
+  vtkDataArray* materialIds = output->GetCellData()->GetArray("MaterialIds");
+  if (!groupIds || !materialIds)
+  {
+    std::cerr << "Missing cell arrays\n";
+    return EXIT_FAILURE;
+  }
+
+  vtkIdType npts, *pts;
+  output->GetPolys()->InitTraversal();
+  for (vtkIdType face = 0; output->GetPolys()->GetNextCell(npts, pts); ++face)
+  {
+    if (npts != 3 || pts[0] != 3 * face || pts[1] != 3 * face + 1 || pts[2] != 3 * face + 2)
+    {
+      std::cerr << "Wrong face " << face << "\n";
+      return EXIT_FAILURE;
+    }
+    double p[3];
+    output->GetPoint(pts[2], p);
+    if (p[0] != pts[2] || p[1] != -2.0 * pts[2] || p[2] != 2.5)
+    {
+      std::cerr << "Wrong point " << pts[2] << "\n";
+      return EXIT_FAILURE;
+    }
+    // The faces before the first group are in group 0.
+    const vtkIdType group = (face < 10) ? 0 : (face - 10) / facesPerGroup + 1;
+    const vtkIdType material = (face / facesPerMaterial) % 2;
+    if (groupIds->GetTuple1(face) != group || materialIds->GetTuple1(face) != material)
+    {
+      std::cerr << "Wrong group or material for face " << face << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderPolyhedraRegions.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes an OpenFOAM case with two regions meshed with a stack of hexagonal
+// prisms and a field at several time steps, and checks the polyhedra and the
+// field of each region while stepping through time with the mesh cached.
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkInformation.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int NumberOfCells = 3;
+
+bool WriteFile(const std::string& fileName, const char* className, const char* object,
+  const std::string& content)
+{
+  FILE* file = fopen(fileName.c_str(), "w");
+  if (!file)
+  {
+    std::cerr << "Could not write " << fileName << "\n";
+    return false;
+  }
+  fprintf(file, "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class %s;\n"
+                "    object %s;\n}\n%s",
+    className, object, content.c_str());
+  fclose(file);
+  return true;
+}
+
+std::string LabelList(const std::vector<int>& labels)
+{
+  std::string list = std::to_string(labels.size()) + "\n(\n";
+  for (int label : labels)
+  {
+    list += std::to_string(label) + "\n";
+  }
+  return list + ")\n";
+}
+
+// Hexagonal prisms stacked along z, with the top and bottom faces between
+// cells as internal faces.
+bool WriteMesh(const std::string& dir)
+{
+  vtkDirectory::MakeDirectory(dir.c_str());
+  std::string points = std::to_string(6 * (NumberOfCells + 1)) + "\n(\n";
+  for (int k = 0; k <= NumberOfCells; ++k)
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      const double angle = i * std::acos(-1.0) / 3.0;
+      points += "(" + std::to_string(std::cos(angle)) + " " + std::to_string(std::sin(angle)) +
+        " " + std::to_string(k) + ")\n";
+    }
+  }
+  points += ")\n";
+
+  auto id = [](int k, int i) { return 6 * k + i % 6; };
+  std::vector<std::vector<int> > faces;
+  std::vector<int> owner, neighbour;
+  for (int k = 1; k < NumberOfCells; ++k)
+  {
+    faces.push_back({ id(k, 0), id(k, 1), id(k, 2), id(k, 3), id(k, 4), id(k, 5) });
+    owner.push_back(k - 1);
+    neighbour.push_back(k);
+  }
+  faces.push_back({ id(0, 5), id(0, 4), id(0, 3), id(0, 2), id(0, 1), id(0, 0) });
+  owner.push_back(0);
+  const int top = NumberOfCells;
+  faces.push_back({ id(top, 0), id(top, 1), id(top, 2), id(top, 3), id(top, 4), id(top, 5) });
+  owner.push_back(NumberOfCells - 1);
+  for (int k = 0; k < NumberOfCells; ++k)
+  {
+    for (int i = 0; i < 6; ++i)
+    {
+      faces.push_back({ id(k + 1, i), id(k + 1, i + 1), id(k, i + 1), id(k, i) });
+      owner.push_back(k);
+    }
+  }
+  std::string faceList = std::to_string(faces.size()) + "\n(\n";
+  for (const std::vector<int>& face : faces)
+  {
+    faceList += std::to_string(face.size()) + "(";
+    for (int point : face)
+    {
+      faceList += std::to_string(point) + " ";
+    }
+    faceList += ")\n";
+  }
+  faceList += ")\n";
+
+  const std::string boundary = "1\n(\n    walls\n    {\n        type wall;\n        nFaces " +
+    std::to_string(faces.size() - neighbour.size()) + ";\n        startFace " +
+    std::to_string(neighbour.size()) + ";\n    }\n)\n";
+
+  return WriteFile(dir + "/points", "vectorField", "points", points) &&
+    WriteFile(dir + "/faces", "faceList", "faces", faceList) &&
+    WriteFile(dir + "/owner", "labelList", "owner", LabelList(owner)) &&
+    WriteFile(dir + "/neighbour", "labelList", "neighbour", LabelList(neighbour)) &&
+    WriteFile(dir + "/boundary", "polyBoundaryMesh", "boundary", boundary);
+}
+
+bool WriteField(const std::string& dir, double value)
+{
+  vtkDirectory::MakeDirectory(dir.c_str());
+  std::string field = "dimensions [0 2 -2 0 0 0 0];\ninternalField nonuniform List<scalar> " +
+    std::to_string(NumberOfCells) + "(";
+  for (int cell = 0; cell < NumberOfCells; ++cell)
+  {
+    field += std::to_string(value + cell) + " ";
+  }
+  field += ");\nboundaryField\n{\n    walls\n    {\n        type zeroGradient;\n    }\n}\n";
+  return WriteFile(dir + "/p", "volScalarField", "p", field);
+}
+
+int CheckRegion(vtkUnstructuredGrid* mesh, double value, const char* region)
+{
+  if (!mesh || mesh->GetNumberOfCells() != NumberOfCells ||
+    mesh->GetNumberOfPoints() != 6 * (NumberOfCells + 1))
+  {
+    std::cerr << region << ": wrong mesh\n";
+    return 1;
+  }
+  vtkDataArray* p = mesh->GetCellData()->GetArray("p");
+  for (vtkIdType cell = 0; cell < NumberOfCells; ++cell)
+  {
+    vtkIdType numFaces, *faces;
+    mesh->GetFaceStream(cell, numFaces, faces);
+    if (mesh->GetCellType(cell) != VTK_POLYHEDRON ||
+      mesh->GetCell(cell)->GetNumberOfPoints() != 12 ||
+      numFaces != 8)
+    {
+      std::cerr << region << ": wrong polyhedron " << cell << "\n";
+      return 1;
+    }
+    if (!p || p->GetTuple1(cell) != value + cell)
+    {
+      std::cerr << region << ": wrong field value in cell " << cell << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestOpenFOAMReaderPolyhedraRegions(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string caseDir = std::string(tempDir) + "/PolyhedraRegions";
+  delete[] tempDir;
+
+  vtkDirectory::MakeDirectory(caseDir.c_str());
+  vtkDirectory::MakeDirectory((caseDir + "/system").c_str());
+  vtkDirectory::MakeDirectory((caseDir + "/constant").c_str());
+  vtkDirectory::MakeDirectory((caseDir + "/constant/solid").c_str());
+  bool written = WriteFile(caseDir + "/system/controlDict", "dictionary", "controlDict",
+                   "startTime 0;\nendTime 2;\ndeltaT 1;\nwriteControl timeStep;\n"
+                   "writeInterval 1;\n") &&
+    WriteMesh(caseDir + "/constant/polyMesh") && WriteMesh(caseDir + "/constant/solid/polyMesh");
+  for (int time = 0; time <= 2; ++time)
+  {
+    const std::string timeDir = caseDir + "/" + std::to_string(time);
+    written = written && WriteField(timeDir, 10.0 * time) &&
+      WriteField(timeDir + "/solid", 100.0 + 10.0 * time);
+  }
+  if (!written)
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkOpenFOAMReader> reader;
+  reader->SetFileName((caseDir + "/system/controlDict").c_str());
+  reader->UpdateInformation();
+  reader->EnableAllCellArrays();
+
+  int errors = 0;
+  for (double time : { 0.0, 1.0, 2.0, 1.0 })
+  {
+    reader->UpdateTimeStep(time);
+    vtkMultiBlockDataSet* output = reader->GetOutput();
+    if (output->GetNumberOfBlocks() != 2)
+    {
+      std::cerr << "Expected two regions, got " << output->GetNumberOfBlocks() << "\n";
+      return EXIT_FAILURE;
+    }
+    for (unsigned int region = 0; region < 2; ++region)
+    {
+      vtkMultiBlockDataSet* regionBlocks =
+        vtkMultiBlockDataSet::SafeDownCast(output->GetBlock(region));
+      vtkUnstructuredGrid* internalMesh = regionBlocks
+        ? vtkUnstructuredGrid::SafeDownCast(regionBlocks->GetBlock(0))
+        : nullptr;
+      const char* name = output->GetMetaData(region)->Get(vtkCompositeDataSet::NAME());
+      const bool solid = name && std::string(name) == "solid";
+      errors += CheckRegion(internalMesh, (solid ? 100.0 : 0.0) + 10.0 * time,
+        name ? name : "unnamed region");
+    }
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads binary and ASCII STL files with the default point merging, with a
+// vtkMergePoints locator and without merging, and checks that the default
+// merging gives the output of vtkMergePoints.
+
+#include "vtkCellArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+
+namespace
+{
+
+int CompareOutputs(vtkPolyData* expected, vtkPolyData* output, const std::string& name)
+{
+  if (expected->GetNumberOfPoints() != output->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != output->GetNumberOfPolys())
+  {
+    std::cerr << name << ": " << output->GetNumberOfPoints() << " points and "
+              << output->GetNumberOfPolys() << " triangles instead of "
+              << expected->GetNumberOfPoints() << " and " << expected->GetNumberOfPolys()
+              << "\n";
+    return 1;
+  }
+  for (vtkIdType ptId = 0; ptId < expected->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], y[3];
+    expected->GetPoint(ptId, x);
+    output->GetPoint(ptId, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << name << ": wrong point " << ptId << "\n";
+      return 1;
+    }
+  }
+  vtkIdType* expectedCells = expected->GetPolys()->GetPointer();
+  vtkIdType* cells = output->GetPolys()->GetPointer();
+  for (vtkIdType i = 0; i < 4 * expected->GetNumberOfPolys(); ++i)
+  {
+    if (expectedCells[i] != cells[i])
+    {
+      std::cerr << name << ": wrong triangle " << i / 4 << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  // A sphere, with a triangle that is degenerate once its points are merged
+  // and a point at -0.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->DeepCopy(sphere->GetOutput());
+  vtkIdType p0 = input->GetPoints()->InsertNextPoint(0.0, 0.0, 0.0);
+  vtkIdType p1 = input->GetPoints()->InsertNextPoint(-0.0, 0.0, 0.0);
+  vtkIdType p2 = input->GetPoints()->InsertNextPoint(1.0, 2.0, 3.0);
+  vtkIdType p3 = input->GetPoints()->InsertNextPoint(3.0, 2.0, 1.0);
+  vtkIdType degenerate[3] = { p0, p1, p2 };
+  input->GetPolys()->InsertNextCell(3, degenerate);
+  vtkIdType valid[3] = { p1, p2, p3 };
+  input->GetPolys()->InsertNextCell(3, valid);
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  int errors = 0;
+  for (int binary = 0; binary < 2; ++binary)
+  {
+    std::string fileName = testDirectory + (binary ? "/Merging.binary.stl" : "/Merging.ascii.stl");
+    vtkNew<vtkSTLWriter> writer;
+    writer->SetInputData(input);
+    writer->SetFileName(fileName.c_str());
+    writer->SetFileType(binary ? VTK_BINARY : VTK_ASCII);
+    writer->Write();
+
+    vtkNew<vtkSTLReader> locatorReader;
+    vtkNew<vtkMergePoints> locator;
+    locatorReader->SetFileName(fileName.c_str());
+    locatorReader->SetLocator(locator);
+    locatorReader->Update();
+
+    vtkNew<vtkSTLReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    std::string name = (binary ? "Binary" : "ASCII");
+    errors += CompareOutputs(locatorReader->GetOutput(), reader->GetOutput(), name);
+    if (reader->GetOutput()->GetNumberOfPolys() != numTris - 1)
+    {
+      std::cerr << name << ": degenerate triangle not removed\n";
+      ++errors;
+    }
+
+    vtkNew<vtkSTLReader> noMergeReader;
+    noMergeReader->SetFileName(fileName.c_str());
+    noMergeReader->MergingOff();
+    noMergeReader->Update();
+    if (noMergeReader->GetOutput()->GetNumberOfPoints() != 3 * numTris ||
+      noMergeReader->GetOutput()->GetNumberOfPolys() != numTris)
+    {
+      std::cerr << name << ": wrong output without merging\n";
+      ++errors;
+    }
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
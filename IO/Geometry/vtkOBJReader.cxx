@@ -16,13 +16,21 @@
 
 #include "vtkCellArray.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include <cctype>
+#include "vtkSMPTools.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "vtkCellData.h"
 #include "vtkStringArray.h"
@@ -41,6 +49,533 @@ vtkOBJReader::~vtkOBJReader()
   this->SetComment(nullptr);
 }
 
+namespace
+{
+
+// The file is read by blocks, each block is split into pieces that are
+// parsed in parallel, and the pieces are then copied into the output arrays
+// at offsets given by the prefix sums of their sizes. Blocks and pieces end
+// at line breaks that do not follow a backslash, so that continued 'p', 'l'
+// and 'f' lines are never split.
+const size_t OBJBlockSize = 1 << 26;
+const size_t OBJPieceSize = 1 << 20;
+
+enum OBJCellKind
+{
+  OBJVerts = 0,
+  OBJLines,
+  OBJPolys,
+  OBJTCoordPolys,
+  OBJNormalPolys,
+  OBJNumberOfCellKinds
+};
+
+inline bool IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+inline bool IsBreak(const char* data, size_t pos)
+{
+  return data[pos] == '\n' && (pos == 0 || data[pos - 1] != '\\');
+}
+
+// Position after the first line break at or after pos, or end.
+size_t NextBreak(const char* data, size_t pos, size_t end)
+{
+  for (; pos < end; ++pos)
+  {
+    if (IsBreak(data, pos))
+    {
+      return pos + 1;
+    }
+  }
+  return end;
+}
+
+// Position after the last line break before end, or 0.
+size_t LastBreak(const char* data, size_t end)
+{
+  for (size_t pos = end; pos > 0; --pos)
+  {
+    if (IsBreak(data, pos - 1))
+    {
+      return pos;
+    }
+  }
+  return 0;
+}
+
+inline const char* FindLineEnd(const char* p, const char* end)
+{
+  const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+  return lineEnd ? lineEnd : end;
+}
+
+inline const char* SkipSpaces(const char* p, const char* lineEnd)
+{
+  while (p < lineEnd && IsSpace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+inline const char* SkipToken(const char* p, const char* lineEnd)
+{
+  while (p < lineEnd && !IsSpace(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+inline bool IsCommand(const char* cmd, size_t length, const char* name)
+{
+  return strlen(name) == length && strncmp(cmd, name, length) == 0;
+}
+
+// Parse a signed integer at p, as "%d" does.
+inline bool ParseIndex(const char*& p, const char* lineEnd, long long& value)
+{
+  const char* q = p;
+  const bool negative = (q < lineEnd && *q == '-');
+  if (q < lineEnd && (*q == '-' || *q == '+'))
+  {
+    ++q;
+  }
+  if (q == lineEnd || *q < '0' || *q > '9')
+  {
+    return false;
+  }
+  long long result = 0;
+  for (; q < lineEnd && *q >= '0' && *q <= '9'; ++q)
+  {
+    result = 10 * result + (*q - '0');
+  }
+  value = negative ? -result : result;
+  p = q;
+  return true;
+}
+
+// Parse up to count floats separated by whitespace, as "%f %f ..." does,
+// and return the number of floats parsed.
+inline int ParseFloats(const char* p, const char* lineEnd, float* values, int count)
+{
+  for (int i = 0; i < count; ++i)
+  {
+    p = SkipSpaces(p, lineEnd);
+    char* next;
+    if (p == lineEnd || (values[i] = strtof(p, &next), next == p))
+    {
+      return i;
+    }
+    p = next;
+  }
+  return count;
+}
+
+// Cells of one kind parsed from a piece, in the vtkCellArray layout.
+// Negative indices are relative to the number of elements read so far: they
+// are stored relative to the start of the piece, and their positions are
+// kept to add the number of elements before the piece once it is known.
+struct OBJCells
+{
+  std::vector<vtkIdType> Connectivity;
+  std::vector<size_t> Relative;
+  vtkIdType NumberOfCells = 0;
+  size_t CellStart = 0;
+
+  void StartCell()
+  {
+    this->CellStart = this->Connectivity.size();
+    this->Connectivity.push_back(0);
+    ++this->NumberOfCells;
+  }
+
+  void InsertIndex(long long index, vtkIdType numRead)
+  {
+    if (index < 0)
+    {
+      this->Relative.push_back(this->Connectivity.size());
+      this->Connectivity.push_back(static_cast<vtkIdType>(numRead + index));
+    }
+    else
+    {
+      this->Connectivity.push_back(static_cast<vtkIdType>(index - 1));
+    }
+  }
+
+  void EndCell()
+  {
+    this->Connectivity[this->CellStart] =
+      static_cast<vtkIdType>(this->Connectivity.size() - this->CellStart - 1);
+  }
+};
+
+struct OBJPiece
+{
+  const char* Begin = nullptr;
+  const char* End = nullptr;
+
+  std::vector<float> Points;
+  std::vector<float> Normals;
+  // Values of the 'vt' lines that could be parsed, and number of 'vt' lines.
+  std::vector<float> TCoords;
+  vtkIdType NumberOfTCoords = 0;
+  OBJCells Cells[OBJNumberOfCellKinds];
+  // Number of 'g' lines of the piece before each face, and in the piece.
+  std::vector<vtkIdType> FaceGroups;
+  vtkIdType NumberOfGroups = 0;
+  // 'usemtl' lines, with the index in the piece of the face that follows.
+  std::vector<std::pair<vtkIdType, std::string> > Materials;
+  vtkIdType NumberOfLines = 0;
+
+  bool HasTCoords = false;
+  bool HasNormals = false;
+  bool TCoordsSameAsVerts = true;
+  bool NormalsSameAsVerts = true;
+
+  // First error of the piece, "<Error><line><ErrorDetail>".
+  std::string Error;
+  std::string ErrorDetail;
+  vtkIdType ErrorLine = 0;
+
+  // Number of elements before the piece, set once all pieces are parsed.
+  vtkIdType PointOffset = 0;
+  vtkIdType NormalOffset = 0;
+  vtkIdType TCoordOffset = 0;
+  vtkIdType TCoordValueOffset = 0;
+  vtkIdType ConnectivityOffset[OBJNumberOfCellKinds];
+  vtkIdType FaceOffset = 0;
+  int GroupId = -1;
+};
+
+// Parses pieces of the file independently. Indices and groups are relative
+// to the start of the piece until the pieces are copied into the output.
+class OBJPieceParser
+{
+public:
+  OBJPieceParser(std::vector<OBJPiece>& pieces)
+    : Pieces(pieces)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Parse(this->Pieces[i]);
+    }
+  }
+
+private:
+  std::vector<OBJPiece>& Pieces;
+
+  static void SetError(OBJPiece& piece, vtkIdType lineNr, const char* error, const char* detail = "")
+  {
+    piece.Error = error;
+    piece.ErrorDetail = detail;
+    piece.ErrorLine = lineNr;
+  }
+
+  // Move p to the next token of an element, following backslash-newline
+  // continuations. Return false at the end of the element or on error.
+  static bool NextToken(OBJPiece& piece, const char*& p, const char*& lineEnd, vtkIdType& lineNr)
+  {
+    for (;;)
+    {
+      p = SkipSpaces(p, lineEnd);
+      if (p == lineEnd)
+      {
+        return false;
+      }
+      if (*p != '\\' || p + 1 != lineEnd || lineEnd == piece.End)
+      {
+        return true;
+      }
+      if (lineEnd + 1 == piece.End)
+      {
+        SetError(piece, lineNr, "Error reading continuation line at line ");
+        return false;
+      }
+      ++lineNr;
+      p = lineEnd + 1;
+      lineEnd = FindLineEnd(p, piece.End);
+    }
+  }
+
+  // Read the indices of a 'p' or 'l' line into a cell of the given kind.
+  static void ParseElement(OBJPiece& piece, OBJCellKind kind, vtkIdType numPoints,
+    const char*& p, const char*& lineEnd, vtkIdType& lineNr)
+  {
+    const bool isLine = (kind == OBJLines);
+    OBJCells& cells = piece.Cells[kind];
+    cells.StartCell();
+    int nVerts = 0;
+    while (NextToken(piece, p, lineEnd, lineNr))
+    {
+      long long iVert;
+      if (!ParseIndex(p, lineEnd, iVert))
+      {
+        SetError(piece, lineNr, isLine ? "Error reading 'l' at line " : "Error reading 'p' at line ");
+        return;
+      }
+      cells.InsertIndex(iVert, numPoints);
+      ++nVerts;
+      p = SkipToken(p, lineEnd);
+    }
+    if (!piece.Error.empty())
+    {
+      return;
+    }
+    if (nVerts < (isLine ? 2 : 1))
+    {
+      SetError(piece, lineNr, "Error reading file near line ",
+        isLine ? " while processing the 'l' command" : " while processing the 'p' command");
+      return;
+    }
+    cells.EndCell();
+  }
+
+  // Read the vertex, texture coordinate and normal indices of a 'f' line.
+  static void ParseFace(OBJPiece& piece, vtkIdType numPoints, vtkIdType numNormals,
+    const char*& p, const char*& lineEnd, vtkIdType& lineNr)
+  {
+    OBJCells& polys = piece.Cells[OBJPolys];
+    OBJCells& tcoordPolys = piece.Cells[OBJTCoordPolys];
+    OBJCells& normalPolys = piece.Cells[OBJNormalPolys];
+    polys.StartCell();
+    tcoordPolys.StartCell();
+    normalPolys.StartCell();
+    int nVerts = 0, nTCoords = 0, nNormals = 0;
+    while (NextToken(piece, p, lineEnd, lineNr))
+    {
+      // v, v/t, v/t/n or v//n
+      long long iVert, iTCoord = 0, iNormal = 0;
+      bool hasTCoord = false, hasNormal = false;
+      if (!ParseIndex(p, lineEnd, iVert))
+      {
+        SetError(piece, lineNr, "Error reading 'f' at line ");
+        return;
+      }
+      if (p < lineEnd && *p == '/')
+      {
+        const char* q = p + 1;
+        if (q < lineEnd && *q == '/')
+        {
+          ++q;
+          hasNormal = ParseIndex(q, lineEnd, iNormal);
+        }
+        else if (ParseIndex(q, lineEnd, iTCoord))
+        {
+          hasTCoord = true;
+          if (q < lineEnd && *q == '/')
+          {
+            ++q;
+            hasNormal = ParseIndex(q, lineEnd, iNormal);
+          }
+        }
+        p = q;
+      }
+
+      polys.InsertIndex(iVert, numPoints);
+      ++nVerts;
+      if (hasTCoord)
+      {
+        tcoordPolys.InsertIndex(iTCoord, piece.NumberOfTCoords);
+        ++nTCoords;
+        if (iTCoord != iVert)
+        {
+          piece.TCoordsSameAsVerts = false;
+        }
+      }
+      if (hasNormal)
+      {
+        normalPolys.InsertIndex(iNormal, numNormals);
+        ++nNormals;
+        if (iNormal != iVert)
+        {
+          piece.NormalsSameAsVerts = false;
+        }
+      }
+      p = SkipToken(p, lineEnd);
+    }
+    if (!piece.Error.empty())
+    {
+      return;
+    }
+
+    // count of tcoords and normals must be equal to number of vertices or zero
+    if (nVerts < 3 || (nTCoords > 0 && nTCoords != nVerts) ||
+      (nNormals > 0 && nNormals != nVerts))
+    {
+      SetError(piece, lineNr, "Error reading file near line ", " while processing the 'f' command");
+      return;
+    }
+    polys.EndCell();
+    tcoordPolys.EndCell();
+    normalPolys.EndCell();
+    piece.HasTCoords |= (nTCoords > 0);
+    piece.HasNormals |= (nNormals > 0);
+    piece.FaceGroups.push_back(piece.NumberOfGroups);
+  }
+
+  static void Parse(OBJPiece& piece)
+  {
+    vtkIdType numPoints = 0;
+    vtkIdType numNormals = 0;
+    vtkIdType lineNr = 0;
+    const char* p = piece.Begin;
+    while (p < piece.End && piece.Error.empty())
+    {
+      ++lineNr;
+      const char* lineEnd = FindLineEnd(p, piece.End);
+
+      // the first token is the command
+      const char* cmd = SkipSpaces(p, lineEnd);
+      p = SkipToken(cmd, lineEnd);
+      const size_t cmdLength = p - cmd;
+      float xyz[3];
+
+      if (IsCommand(cmd, cmdLength, "v"))
+      {
+        if (ParseFloats(p, lineEnd, xyz, 3) != 3)
+        {
+          SetError(piece, lineNr, "Error reading 'v' at line ");
+          break;
+        }
+        piece.Points.insert(piece.Points.end(), xyz, xyz + 3);
+        ++numPoints;
+      }
+      else if (IsCommand(cmd, cmdLength, "vt"))
+      {
+        // texture coordinates that cannot be parsed are counted but not
+        // stored, as indices refer to the 'vt' lines.
+        if (ParseFloats(p, lineEnd, xyz, 2) == 2)
+        {
+          piece.TCoords.insert(piece.TCoords.end(), xyz, xyz + 2);
+        }
+        ++piece.NumberOfTCoords;
+      }
+      else if (IsCommand(cmd, cmdLength, "vn"))
+      {
+        if (ParseFloats(p, lineEnd, xyz, 3) != 3)
+        {
+          SetError(piece, lineNr, "Error reading 'vn' at line ");
+          break;
+        }
+        piece.Normals.insert(piece.Normals.end(), xyz, xyz + 3);
+        piece.HasNormals = true;
+        ++numNormals;
+      }
+      else if (IsCommand(cmd, cmdLength, "f"))
+      {
+        ParseFace(piece, numPoints, numNormals, p, lineEnd, lineNr);
+      }
+      else if (IsCommand(cmd, cmdLength, "g"))
+      {
+        // group definition, only its existence is noted
+        ++piece.NumberOfGroups;
+      }
+      else if (IsCommand(cmd, cmdLength, "usemtl"))
+      {
+        const char* name = SkipSpaces(p, lineEnd);
+        if (name == lineEnd)
+        {
+          SetError(piece, lineNr, "Error reading 'usemtl' at line ");
+          break;
+        }
+        piece.Materials.emplace_back(piece.Cells[OBJPolys].NumberOfCells,
+          std::string(name, SkipToken(name, lineEnd)));
+      }
+      else if (IsCommand(cmd, cmdLength, "p"))
+      {
+        ParseElement(piece, OBJVerts, numPoints, p, lineEnd, lineNr);
+      }
+      else if (IsCommand(cmd, cmdLength, "l"))
+      {
+        ParseElement(piece, OBJLines, numPoints, p, lineEnd, lineNr);
+      }
+      p = (lineEnd < piece.End) ? lineEnd + 1 : piece.End;
+    }
+    piece.NumberOfLines = lineNr;
+  }
+};
+
+// Output arrays, and number of elements read from the previous blocks.
+struct OBJOutput
+{
+  vtkFloatArray* Points;
+  vtkFloatArray* Normals;
+  vtkFloatArray* FaceGroups;
+  std::vector<float> TCoords;
+  vtkIdTypeArray* Connectivity[OBJNumberOfCellKinds];
+  vtkIdType NumberOfCells[OBJNumberOfCellKinds];
+  vtkIdType NumberOfTCoords;
+  vtkIdType NumberOfLines;
+  int GroupId;
+};
+
+// Copies the parsed pieces into the output arrays, at their offsets.
+class OBJPieceCopier
+{
+public:
+  OBJPieceCopier(std::vector<OBJPiece>& pieces, OBJOutput& output)
+    : Pieces(pieces)
+    , Output(output)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const OBJPiece& piece = this->Pieces[i];
+      std::copy(piece.Points.begin(), piece.Points.end(),
+        this->Output.Points->GetPointer(3 * piece.PointOffset));
+      std::copy(piece.Normals.begin(), piece.Normals.end(),
+        this->Output.Normals->GetPointer(3 * piece.NormalOffset));
+      std::copy(piece.TCoords.begin(), piece.TCoords.end(),
+        this->Output.TCoords.begin() + piece.TCoordValueOffset);
+
+      for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
+      {
+        const OBJCells& cells = piece.Cells[kind];
+        vtkIdType* connectivity =
+          this->Output.Connectivity[kind]->GetPointer(piece.ConnectivityOffset[kind]);
+        std::copy(cells.Connectivity.begin(), cells.Connectivity.end(), connectivity);
+        const vtkIdType numBefore = (kind == OBJTCoordPolys)
+          ? piece.TCoordOffset
+          : ((kind == OBJNormalPolys) ? piece.NormalOffset : piece.PointOffset);
+        for (size_t pos : cells.Relative)
+        {
+          connectivity[pos] += numBefore;
+        }
+      }
+
+      // Faces before any 'g' line are in group 0, and the following groups
+      // are numbered from there.
+      if (!piece.FaceGroups.empty())
+      {
+        float* groups = this->Output.FaceGroups->GetPointer(piece.FaceOffset);
+        const vtkIdType first = piece.FaceGroups[0];
+        const vtkIdType firstGroupId = std::max<vtkIdType>(piece.GroupId + first, 0);
+        for (size_t face = 0; face < piece.FaceGroups.size(); ++face)
+        {
+          groups[face] = static_cast<float>(firstGroupId + piece.FaceGroups[face] - first);
+        }
+      }
+    }
+  }
+
+private:
+  std::vector<OBJPiece>& Pieces;
+  OBJOutput& Output;
+};
+
+}
+
 /*---------------------------------------------------------------------------*\
 
 This is only partial support for the OBJ format, which is quite complicated.
@@ -104,7 +639,6 @@ p <v_a> <v_b> ...
     indices into the vertex list
 
 \*---------------------------------------------------------------------------*/
-
 int vtkOBJReader::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **vtkNotUsed(inputVector),
@@ -172,560 +706,241 @@ int vtkOBJReader::RequestData(
 
   bool everything_ok = true; // (use of this flag avoids early return and associated memory leak)
 
-  // -- work through the file line by line, assigning into the above 7 structures as appropriate --
-
-  { // (make a local scope section to emphasise that the variables below are only used here)
+  // -- read the file by blocks, assigning into the above structures as appropriate --
 
-  const int MAX_LINE = 1024 * 256;
-  char rawLine[MAX_LINE];
-  char tcoordsName[100];
-  float xyz[3];
-  int numPoints = 0;
-  int numTCoords = 0;
-  int numNormals = 0;
-
-  // First loop to initialize the data arrays for the different set of texture coordinates
+  OBJOutput data;
+  data.Points = vtkArrayDownCast<vtkFloatArray>(points->GetData());
+  data.Normals = normals;
+  data.FaceGroups = faceScalars;
+  vtkIdTypeArray* connectivity[OBJNumberOfCellKinds];
+  vtkCellArray* cellArrays[OBJNumberOfCellKinds] = { pointElems, lineElems, polys, tcoord_polys,
+    normal_polys };
+  for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
+  {
+    connectivity[kind] = vtkIdTypeArray::New();
+    data.Connectivity[kind] = connectivity[kind];
+    data.NumberOfCells[kind] = 0;
+  }
+  data.NumberOfTCoords = 0;
+  data.NumberOfLines = 0;
+  data.GroupId = -1;
+
+  // faces before the first 'usemtl' line use the material of the last one
+  std::string tcoordsName = "TCoords";
+
+  // blocks grow up to OBJBlockSize, so that small files use a small buffer
+  std::vector<char> buffer;
+  size_t numBuffered = 0;
+  size_t readSize = OBJPieceSize;
+  bool endOfFile = false;
   bool readingFirstComment = true;
-  std::string firstComment;
-  int lineNr = 0;
-  while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
+  std::vector<OBJPiece> pieces;
+  while (everything_ok && !endOfFile)
   {
-    ++lineNr;
-    char *pLine = rawLine;
-    char *pEnd = rawLine + strlen(rawLine);
-
-    if (*(pEnd-1) != '\n' && ! feof(in))
-    {
-      vtkErrorMacro(<< "Line longer than " << MAX_LINE << ": " <<  pLine);
-      everything_ok = false;
-    }
-
-    // find the first non-whitespace character
-    while (isspace(*pLine) && pLine < pEnd) { pLine++; }
-
-    // this first non-whitespace is the command
-    const char *cmd = pLine;
-
-    if (readingFirstComment)
+    buffer.resize(numBuffered + readSize + 1);
+    const size_t numRead = fread(buffer.data() + numBuffered, 1, readSize, in);
+    numBuffered += numRead;
+    endOfFile = (numRead < readSize);
+    readSize = std::min(2 * readSize, OBJBlockSize);
+    buffer[numBuffered] = '\0';
+    const char* block = buffer.data();
+    const size_t blockSize = endOfFile ? numBuffered : LastBreak(block, numBuffered);
+
+    if (readingFirstComment && blockSize > 0)
     {
-      if (cmd[0] == '#')
+      // Comment lines include newline characters.
+      // Keep newlines between lines of multi-line comment, but
+      // remove the last newline to have a clean string when comment is single-line.
+      std::string firstComment;
+      const char* blockEnd = block + blockSize;
+      for (const char* line = block; line < blockEnd;)
       {
-        cmd++; // skip #
-        while (isspace(*cmd) && cmd < pEnd) { cmd++; } // skip whitespace at comment start
-        firstComment += cmd;
-      }
-      else
-      {
-        // This is not a comment line, real file content is started.
-        // There may be more comments in the file but we ignore those.
-        readingFirstComment = false;
-      }
-    }
-
-    // skip over non-whitespace
-    while (!isspace(*pLine) && pLine < pEnd) { pLine++; }
-
-    // terminate command
-    if (pLine < pEnd)
-    {
-      *pLine = '\0';
-      pLine++;
-    }
-
-    // if line starts by "usemtl", we're listing a new set of texture coordinates
-    if (strcmp(cmd, "usemtl") == 0)
-    {
-      // Read name of texture coordinate
-      if (sscanf(pLine, "%s", tcoordsName) == 1)
-      {
-        if (tcoords_map.find(tcoordsName) == tcoords_map.end())
+        const char* lineEnd = FindLineEnd(line, blockEnd);
+        const char* next = (lineEnd < blockEnd) ? lineEnd + 1 : blockEnd;
+        const char* cmd = SkipSpaces(line, lineEnd);
+        if (cmd == lineEnd || *cmd != '#')
         {
-          vtkFloatArray* tcoords = vtkFloatArray::New();
-          tcoords->SetNumberOfComponents(2);
-          tcoords->SetName(tcoordsName);
-          tcoords_map.emplace(tcoordsName, tcoords);
+          // This is not a comment line, real file content is started.
+          // There may be more comments in the file but we ignore those.
+          break;
         }
+        cmd = SkipSpaces(cmd + 1, next); // skip whitespace at comment start
+        firstComment.append(cmd, next);
+        line = next;
       }
-      else
-      {
-        vtkErrorMacro(<<"Error reading 'usemtl' at line " << lineNr);
-        everything_ok = false;
-      }
-    }
-    else if (strcmp(cmd, "vt") == 0)
-    {
-      // this is a tcoord, expect two floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f", xyz, xyz+1) == 2)
-      {
-        verticesTextureList.emplace_back(xyz[0], xyz[1]);
-      }
-    }
-  } // (end of first while loop)
-
-  // Comment lines include newline characters.
-  // Keep newlines between lines of multi-line comment, but
-  // remove the last newline to have a clean string when comment is single-line.
-  while (!firstComment.empty() && (firstComment.back() == '\r' || firstComment.back() == '\n'))
-  {
-    firstComment.pop_back();
-  }
-  this->SetComment(firstComment.c_str());
-
-  // If no material texture coordinates are found, add default TCoords
-  if (tcoords_map.empty())
-  {
-    vtkFloatArray *tcoords = vtkFloatArray::New();
-    tcoords->SetNumberOfComponents(2);
-    strcpy(tcoordsName, "TCoords");
-    tcoords->SetName(tcoordsName);
-    tcoords_map.emplace(tcoordsName, tcoords);
-  }
-
-  // Initialize every texture array with (-1, -1)
-  {
-    const vtkIdType nTuples = static_cast<vtkIdType>(verticesTextureList.size());
-
-    for (const auto& iter : tcoords_map)
-    {
-      vtkFloatArray* tcoords = iter.second;
-      tcoords->SetNumberOfTuples(nTuples);
-
-      for (vtkIdType i = 0; i < nTuples; ++i)
+      while (!firstComment.empty() && (firstComment.back() == '\r' || firstComment.back() == '\n'))
       {
-        tcoords->SetTuple2(i, -1.0, -1.0);
+        firstComment.pop_back();
       }
+      this->SetComment(firstComment.c_str());
+      readingFirstComment = false;
     }
-  }
-
-  // Second loop to parse points, faces, texture coordinates, normals...
-  lineNr = 0;
-  fseek(in, 0, SEEK_SET);
-  while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
-  {
-    ++lineNr;
-    char *pLine = rawLine;
-    char *pEnd = rawLine + strlen(rawLine);
-
-    // find the first non-whitespace character
-    while (isspace(*pLine) && pLine < pEnd) { pLine++; }
 
-    // this first non-whitespace is the command
-    const char *cmd = pLine;
-
-    // skip over non-whitespace
-    while (!isspace(*pLine) && pLine < pEnd) { pLine++; }
-
-    // terminate command
-    if (pLine < pEnd)
+    // split the block into pieces and parse them
+    pieces.clear();
+    for (size_t begin = 0; begin < blockSize;)
     {
-      *pLine = '\0';
-      pLine++;
+      const size_t end = (blockSize - begin > OBJPieceSize)
+        ? NextBreak(block, begin + OBJPieceSize - 1, blockSize)
+        : blockSize;
+      pieces.emplace_back();
+      pieces.back().Begin = block + begin;
+      pieces.back().End = block + end;
+      begin = end;
     }
-
-    if (strcmp(cmd, "g") == 0)
+    OBJPieceParser parser(pieces);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()), 1, parser);
+
+    // compute the offsets of the pieces, and handle the state carried from
+    // one piece to the next
+    vtkIdType numPoints = data.Points->GetNumberOfTuples();
+    vtkIdType numNormals = normals->GetNumberOfTuples();
+    vtkIdType numTCoordValues = static_cast<vtkIdType>(data.TCoords.size());
+    vtkIdType numConnectivity[OBJNumberOfCellKinds];
+    for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
     {
-      // group definition, expect 0 or more words separated by whitespace.
-      // But here we simply note its existence, without a name
-      ++groupId;
+      numConnectivity[kind] = connectivity[kind]->GetNumberOfValues();
     }
-    else if (strcmp(cmd, "v") == 0)
+    for (OBJPiece& piece : pieces)
     {
-      // vertex definition, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
+      if (!piece.Error.empty())
       {
-        points->InsertNextPoint(xyz);
-        numPoints++;
-      }
-      else
-      {
-        vtkErrorMacro(<<"Error reading 'v' at line " << lineNr);
+        vtkErrorMacro(<< piece.Error << data.NumberOfLines + piece.ErrorLine
+                      << piece.ErrorDetail);
         everything_ok = false;
+        break;
       }
-    }
-    else if (strcmp(cmd, "usemtl") == 0)
-    {
-      // material name (for texture coordinates), expect one string:
-      if (sscanf(pLine, "%s", tcoordsName) != 1)
+      piece.PointOffset = numPoints;
+      piece.NormalOffset = numNormals;
+      piece.TCoordOffset = data.NumberOfTCoords;
+      piece.TCoordValueOffset = numTCoordValues;
+      piece.FaceOffset = data.NumberOfCells[OBJPolys];
+      piece.GroupId = data.GroupId;
+      for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
       {
-        vtkErrorMacro(<<"Error reading 'usemtl' at line " << lineNr);
-        everything_ok = false;
+        piece.ConnectivityOffset[kind] = numConnectivity[kind];
+        numConnectivity[kind] += static_cast<vtkIdType>(piece.Cells[kind].Connectivity.size());
+        data.NumberOfCells[kind] += piece.Cells[kind].NumberOfCells;
       }
-      if (matNameToId.find(tcoordsName) == matNameToId.end())
+      numPoints += static_cast<vtkIdType>(piece.Points.size() / 3);
+      numNormals += static_cast<vtkIdType>(piece.Normals.size() / 3);
+      numTCoordValues += static_cast<vtkIdType>(piece.TCoords.size());
+      data.NumberOfTCoords += piece.NumberOfTCoords;
+      data.NumberOfLines += piece.NumberOfLines;
+      if (!piece.FaceGroups.empty())
       {
-        //haven't seen this material yet, keep a record of it
-        matNameToId.emplace(tcoordsName, matcnt);
-        matNames->InsertNextValue(tcoordsName);
-        matcnt++;
-      }
-      //remember that starting with current cell, we should draw with it
-      startCellToMatName[polys->GetNumberOfCells()] = tcoordsName;
-    }
-    else if (strcmp(cmd, "vt") == 0)
-    {
-      numTCoords++;
-    }
-    else if (strcmp(cmd, "vn") == 0)
-    {
-      // vertex normal, expect three floats, separated by whitespace:
-      if (sscanf(pLine, "%f %f %f", xyz, xyz+1, xyz+2) == 3)
-      {
-        normals->InsertNextTuple(xyz);
-        hasNormals = true;
-        numNormals++;
+        const vtkIdType first = piece.FaceGroups[0];
+        data.GroupId = static_cast<int>(std::max<vtkIdType>(data.GroupId + first, 0) +
+          piece.NumberOfGroups - first);
       }
       else
       {
-        vtkErrorMacro(<<"Error reading 'vn' at line " << lineNr);
-        everything_ok = false;
+        data.GroupId += static_cast<int>(piece.NumberOfGroups);
       }
-    }
-    else if (strcmp(cmd, "p") == 0)
-    {
-      // point definition, consisting of 1-based indices separated by whitespace and /
-      pointElems->InsertNextCell(0); // we don't yet know how many points are to come
 
-      int nVerts=0; // keep a count of how many there are
+      hasTCoords |= piece.HasTCoords;
+      hasNormals |= piece.HasNormals;
+      tcoords_same_as_verts &= piece.TCoordsSameAsVerts;
+      normals_same_as_verts &= piece.NormalsSameAsVerts;
 
-      while (everything_ok && pLine < pEnd)
+      for (const auto& material : piece.Materials)
       {
-        // find next non-whitespace character
-        while (isspace(*pLine) && pLine < pEnd) { pLine++; }
-
-        if (pLine < pEnd)         // there is still data left on this line
+        tcoordsName = material.second;
+        if (matNameToId.find(tcoordsName) == matNameToId.end())
         {
-          int iVert;
-          if (sscanf(pLine, "%d", &iVert) == 1)
-          {
-            if (iVert < 0)
-            {
-              pointElems->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              pointElems->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-          }
-          else if (strcmp(pLine, "\\\n") == 0)
-          {
-            // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
-            {
-              lineNr++;
-              pLine = rawLine;
-              pEnd = rawLine + strlen(rawLine);
-              continue;
-            }
-            else
-            {
-              vtkErrorMacro(<<"Error reading continuation line at line " << lineNr);
-              everything_ok = false;
-            }
-          }
-          else
-          {
-            vtkErrorMacro(<<"Error reading 'p' at line " << lineNr);
-            everything_ok = false;
-          }
-          // skip over what we just sscanf'd
-          // (find the first whitespace character)
-          while (!isspace(*pLine) && pLine < pEnd) { pLine++; }
-        }
-      }
+          //haven't seen this material yet, keep a record of it
+          matNameToId.emplace(tcoordsName, matcnt);
+          matNames->InsertNextValue(tcoordsName);
+          matcnt++;
 
-      if (nVerts < 1)
-      {
-        vtkErrorMacro
-        (
-            <<"Error reading file near line " << lineNr
-            << " while processing the 'p' command"
-        );
-        everything_ok = false;
+          vtkFloatArray* tcoords = vtkFloatArray::New();
+          tcoords->SetNumberOfComponents(2);
+          tcoords->SetName(tcoordsName.c_str());
+          tcoords_map.emplace(tcoordsName, tcoords);
+        }
+        //remember that starting with current cell, we should draw with it
+        startCellToMatName[piece.FaceOffset + material.first] = tcoordsName;
       }
-
-      // now we know how many points there were in this cell
-      pointElems->UpdateCellCount(nVerts);
     }
-    else if (strcmp(cmd, "l") == 0)
+    if (!everything_ok)
     {
-      // line definition, consisting of 1-based indices separated by whitespace and /
-      lineElems->InsertNextCell(0); // we don't yet know how many points are to come
-
-      int nVerts=0; // keep a count of how many there are
+      break;
+    }
 
-      while (everything_ok && pLine < pEnd)
-      {
-        // find next non-whitespace character
-        while (isspace(*pLine) && pLine < pEnd) { pLine++; }
+    // copy the pieces into the output arrays
+    data.Points->WritePointer(0, 3 * numPoints);
+    normals->WritePointer(0, 3 * numNormals);
+    data.TCoords.resize(numTCoordValues);
+    for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
+    {
+      connectivity[kind]->WritePointer(0, numConnectivity[kind]);
+    }
+    faceScalars->WritePointer(0, data.NumberOfCells[OBJPolys]);
+    OBJPieceCopier copier(pieces, data);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(pieces.size()), 1, copier);
 
-        if (pLine < pEnd)         // there is still data left on this line
-        {
-          int iVert, dummyInt;
-          if (sscanf(pLine, "%d/%d", &iVert, &dummyInt) == 2)
-          {
-            // we simply ignore texture information
-            if (iVert < 0)
-            {
-              lineElems->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              lineElems->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-          }
-          else if (sscanf(pLine, "%d", &iVert) == 1)
-          {
-            if (iVert < 0)
-            {
-              lineElems->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              lineElems->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-          }
-          else if (strcmp(pLine, "\\\n") == 0)
-          {
-            // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
-            {
-              lineNr++;
-              pLine = rawLine;
-              pEnd = rawLine + strlen(rawLine);
-              continue;
-            }
-            else
-            {
-              vtkErrorMacro(<<"Error reading continuation line at line " << lineNr);
-              everything_ok = false;
-            }
-          }
-          else
-          {
-            vtkErrorMacro(<<"Error reading 'l' at line " << lineNr);
-            everything_ok = false;
-          }
-          // skip over what we just sscanf'd
-          // (find the first whitespace character)
-          while (!isspace(*pLine) && pLine < pEnd) { pLine++; }
-        }
-      }
+    // keep the incomplete last line for the next block
+    std::copy(buffer.begin() + blockSize, buffer.begin() + numBuffered, buffer.begin());
+    numBuffered -= blockSize;
+  }
+  pieces.clear();
 
-      if (nVerts < 2)
-      {
-        vtkErrorMacro
-        (
-            <<"Error reading file near line " << lineNr
-            << " while processing the 'l' command"
-        );
-        everything_ok = false;
-      }
+  // we have finished with the file
+  fclose(in);
 
-      // now we know how many points there were in this cell
-      lineElems->UpdateCellCount(nVerts);
-    }
-    else if (strcmp(cmd, "f") == 0)
-    {
-      // face definition, consisting of 1-based indices separated by whitespace and /
+  for (int kind = 0; kind < OBJNumberOfCellKinds; ++kind)
+  {
+    cellArrays[kind]->SetCells(data.NumberOfCells[kind], connectivity[kind]);
+    connectivity[kind]->Delete();
+  }
+  points->Modified();
+  groupId = data.GroupId;
 
-      polys->InsertNextCell(0); // we don't yet know how many points are to come
-      tcoord_polys->InsertNextCell(0);
-      normal_polys->InsertNextCell(0);
+  // If no material texture coordinates are found, add default TCoords
+  if (tcoords_map.empty())
+  {
+    vtkFloatArray *tcoords = vtkFloatArray::New();
+    tcoords->SetNumberOfComponents(2);
+    tcoords->SetName(tcoordsName.c_str());
+    tcoords_map.emplace(tcoordsName, tcoords);
+  }
 
-      int nVerts=0, nTCoords=0, nNormals=0; // keep a count of how many of each there are
+  // Initialize every texture array with (-1, -1)
+  const vtkIdType numTCoords = static_cast<vtkIdType>(data.TCoords.size() / 2);
+  for (const auto& iter : tcoords_map)
+  {
+    vtkFloatArray* tcoords = iter.second;
+    tcoords->SetNumberOfTuples(numTCoords);
+    tcoords->FillValue(-1.0f);
+  }
 
-      while (everything_ok && pLine < pEnd)
+  // Set the texture array of the material of each face with the texture
+  // coordinates it uses
+  if (everything_ok && hasTCoords)
+  {
+    vtkFloatArray* tcoords = tcoords_map.find(tcoordsName)->second;
+    const vtkIdType* cell = tcoord_polys->GetPointer();
+    for (vtkIdType celli = 0; celli < polys->GetNumberOfCells(); ++celli)
+    {
+      if (!startCellToMatName.empty())
       {
-        // find the first non-whitespace character
-        while (isspace(*pLine) && pLine < pEnd) { pLine++; }
-
-        if (pLine < pEnd)         // there is still data left on this line
+        const auto citer = startCellToMatName.find(celli);
+        if (citer != startCellToMatName.end())
         {
-          int iVert,iTCoord,iNormal;
-          if (sscanf(pLine, "%d/%d/%d", &iVert, &iTCoord, &iNormal) == 3)
-          {
-            if (iVert < 0)
-            {
-              polys->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              polys->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-
-            // Current index is relative to last texture index
-            int iTCoordAbs = (iTCoord < 0) ? numTCoords + iTCoord : iTCoord - 1;
-            tcoord_polys->InsertCellPoint(iTCoordAbs);
-
-            // Set the current texture array with the value corresponding to the
-            // iTcoords read
-            const auto& currentTCoord = verticesTextureList[iTCoordAbs];
-            auto iter = tcoords_map.find(tcoordsName);
-            vtkFloatArray* tcArray = iter->second;
-            tcArray->SetTuple2(
-              iTCoordAbs, currentTCoord.first, currentTCoord.second);
-
-            nTCoords++;
-
-            // Current index is relative to last normal index
-            if (iNormal < 0)
-            {
-              normal_polys->InsertCellPoint(numNormals + iNormal);
-            }
-            else
-            {
-              normal_polys->InsertCellPoint(iNormal - 1);
-            }
-            nNormals++;
-            if (iTCoord != iVert)
-            {
-              tcoords_same_as_verts = false;
-            }
-            if (iNormal != iVert)
-            {
-              normals_same_as_verts = false;
-            }
-          }
-          else if (sscanf(pLine, "%d//%d", &iVert, &iNormal) == 2)
-          {
-            if (iVert < 0)
-            {
-              polys->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              polys->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-
-            // Current index is relative to last normal index
-            if (iNormal < 0)
-            {
-              normal_polys->InsertCellPoint(numNormals + iNormal);
-            }
-            else
-            {
-              normal_polys->InsertCellPoint(iNormal - 1);
-            }
-            nNormals++;
-            if (iNormal != iVert)
-              normals_same_as_verts = false;
-          }
-          else if (sscanf(pLine, "%d/%d", &iVert, &iTCoord) == 2)
-          {
-            if (iVert < 0)
-            {
-              polys->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              polys->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-
-            // Current index is relative to last texture index
-            int iTCoordAbs = (iTCoord < 0) ? numTCoords + iTCoord : iTCoord - 1;
-            tcoord_polys->InsertCellPoint(iTCoordAbs);
-
-            // Set the current texture array with the value corresponding to the
-            // iTcoords read
-            const auto& currentTCoord = verticesTextureList[iTCoordAbs];
-            tcoords_map[tcoordsName]->SetTuple2(
-              iTCoordAbs, currentTCoord.first, currentTCoord.second);
-
-            nTCoords++;
-            if (iTCoord != iVert)
-            {
-              tcoords_same_as_verts = false;
-            }
-          }
-          else if (sscanf(pLine, "%d", &iVert) == 1)
-          {
-            if (iVert < 0)
-            {
-              polys->InsertCellPoint(numPoints+iVert);
-            }
-            else
-            {
-              polys->InsertCellPoint(iVert-1);
-            }
-            nVerts++;
-          }
-          else if (strcmp(pLine, "\\\n") == 0)
-          {
-            // handle backslash-newline continuation
-            if (fgets(rawLine, MAX_LINE, in) != nullptr)
-            {
-              lineNr++;
-              pLine = rawLine;
-              pEnd = rawLine + strlen(rawLine);
-              continue;
-            }
-            else
-            {
-              vtkErrorMacro(<<"Error reading continuation line at line " << lineNr);
-              everything_ok = false;
-            }
-          }
-          else
-          {
-            vtkErrorMacro(<<"Error reading 'f' at line " << lineNr);
-            everything_ok = false;
-          }
-          // skip over what we just read
-          // (find the first whitespace character)
-          while (!isspace(*pLine) && pLine < pEnd) { pLine++; }
+          tcoords = tcoords_map.find(citer->second)->second;
         }
       }
-
-      // count of tcoords and normals must be equal to number of vertices or zero
-      if (nVerts < 3 ||
-         (nTCoords > 0 && nTCoords != nVerts) ||
-         (nNormals > 0 && nNormals != nVerts))
-      {
-        vtkErrorMacro(<<"Error reading file near line " << lineNr
-          << " while processing the 'f' command");
-        everything_ok = false;
-      }
-
-      // now we know how many points there were in this cell
-      polys->UpdateCellCount(nVerts);
-      tcoord_polys->UpdateCellCount(nTCoords);
-      normal_polys->UpdateCellCount(nNormals);
-
-      // also make a note of whether any cells have tcoords, and whether any have normals
-      if (nTCoords > 0)
-      {
-        hasTCoords = true;
-      }
-      if (nNormals > 0)
+      const vtkIdType* cellEnd = cell + *cell + 1;
+      for (++cell; cell < cellEnd; ++cell)
       {
-        hasNormals = true;
-      }
-
-      if (faceScalars && nVerts)
-      {
-        if (groupId < 0)
+        // indices of 'vt' lines that could not be parsed are skipped
+        if (*cell >= 0 && *cell < numTCoords)
         {
-          groupId = 0;
+          tcoords->SetTypedTuple(*cell, &data.TCoords[2 * *cell]);
         }
-        faceScalars->InsertNextValue(groupId);
       }
     }
-    else
-    {
-      //vtkDebugMacro(<<"Ignoring line: "<<rawLine);
-    }
-
-  } // (end of while loop)
-
-  } // (end of local scope section)
-
-  // we have finished with the file
-  fclose(in);
+  }
 
   const bool hasGroups = (groupId >= 0);
   const bool hasMaterials = (matcnt > 0);
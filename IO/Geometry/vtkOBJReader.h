@@ -18,6 +18,9 @@
  *
  * vtkOBJReader is a source object that reads Wavefront .obj
  * files. The output of this source object is polygonal data.
+ *
+ * The file is read by large blocks, split into pieces at line boundaries
+ * that are parsed in parallel with vtkSMPTools.
  * @sa
  * vtkOBJImporter
 */
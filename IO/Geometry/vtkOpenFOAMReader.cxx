@@ -84,6 +84,8 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -5868,10 +5870,12 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
   vtkIdType maxNPoints = 256; // assume max number of points per cell
   vtkIdList* cellPoints = vtkIdList::New();
   cellPoints->SetNumberOfIds(maxNPoints);
-  // assume max number of nPoints per face + points per cell
-  vtkIdType maxNPolyPoints = 1024;
-  vtkIdList* polyPoints = vtkIdList::New();
-  polyPoints->SetNumberOfIds(maxNPolyPoints);
+  // points and face stream of a polyhedron, grown as needed
+  std::vector<vtkIdType> polyCellPoints;
+  std::vector<vtkIdType> polyFacePoints;
+  // the last cell each point was added to, for removing duplicate points
+  // of polyhedra
+  std::vector<vtkIdType> pointMarks;
 
   vtkIdType nCells = (cellList == nullptr ? this->NumCells
                                        : cellList->GetNumberOfTuples());
@@ -6585,67 +6589,27 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
       }
       else // don't decompose; use VTK_POLYHEDRON
       {
-        // get first face
-        vtkTypeInt64 cellFaces0 = cellFaces[0];
-        vtkFoamLabelVectorVector::CellType baseFacePoints;
-        facePoints.GetCell(cellFaces0, baseFacePoints);
-        size_t nPoints = baseFacePoints.size();
-        size_t nPolyPoints = baseFacePoints.size() + 1;
-        if (nPoints > static_cast<size_t>(maxNPoints) ||
-            nPolyPoints > static_cast<size_t>(maxNPolyPoints))
-        {
-          vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-          cellPoints->Delete();
-          polyPoints->Delete();
-          return;
-        }
-        polyPoints->SetId(0, static_cast<vtkIdType>(baseFacePoints.size()));
-        vtkTypeInt64 faceOwnerValue =
-            GetLabelValue(this->FaceOwner, cellFaces0, use64BitLabels);
-        if (faceOwnerValue == cellId)
-        {
-          // add first face to cell points
-          for (size_t j = 0; j < baseFacePoints.size(); j++)
-          {
-            vtkTypeInt64 pointJ = baseFacePoints[j];
-            cellPoints->SetId(static_cast<vtkIdType>(j),
-                              static_cast<vtkIdType>(pointJ));
-            polyPoints->SetId(static_cast<vtkIdType>(j + 1),
-                              static_cast<vtkIdType>(pointJ));
-          }
-        }
-        else
+        // the point marks are allocated with the first polyhedron, so that
+        // meshes without polyhedra do not pay for them
+        if (pointMarks.empty())
         {
-          // if it is a _neighbor_ face flip the points
-          for (size_t j = 0; j < baseFacePoints.size(); j++)
-          {
-            vtkTypeInt64 pointJ = baseFacePoints[baseFacePoints.size() - 1 - j];
-            cellPoints->SetId(static_cast<vtkIdType>(j),
-                              static_cast<vtkIdType>(pointJ));
-            polyPoints->SetId(static_cast<vtkIdType>(j + 1),
-                              static_cast<vtkIdType>(pointJ));
-          }
+          pointMarks.assign(static_cast<size_t>(pointArray->GetNumberOfTuples()), -1);
         }
+        polyCellPoints.clear();
+        polyFacePoints.clear();
+        polyFacePoints.reserve(cellFaces.size() * 5);
 
-        // loop through faces and create a list of all points
-        // j = 1 skip baseFace
-        for (size_t j = 1; j < cellFaces.size(); j++)
+        // loop through faces and create a list of all points and the face
+        // stream; the mark of a point tells whether it has already been
+        // added to this cell
+        for (size_t j = 0; j < cellFaces.size(); j++)
         {
-          // remove duplicate points from faces
           vtkTypeInt64 cellFacesJ = cellFaces[j];
           vtkFoamLabelVectorVector::CellType faceJPoints;
           facePoints.GetCell(cellFacesJ, faceJPoints);
-          if (nPolyPoints >= static_cast<size_t>(maxNPolyPoints))
-          {
-            vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-            cellPoints->Delete();
-            polyPoints->Delete();
-            return;
-          }
-          polyPoints->SetId(static_cast<vtkIdType>(nPolyPoints++),
-                            static_cast<vtkIdType>(faceJPoints.size()));
+          polyFacePoints.push_back(static_cast<vtkIdType>(faceJPoints.size()));
           int pointI, delta; // must be signed
-          faceOwnerValue = GetLabelValue(this->FaceOwner, cellFacesJ,
+          vtkTypeInt64 faceOwnerValue = GetLabelValue(this->FaceOwner, cellFacesJ,
                                          use64BitLabels);
           if (faceOwnerValue == cellId)
           {
@@ -6660,51 +6624,30 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(
           }
           for (size_t k = 0; k < faceJPoints.size(); k++, pointI += delta)
           {
-            vtkTypeInt64 faceJPointK = faceJPoints[pointI];
-            bool foundDup = false;
-            for (vtkIdType l = 0; l < static_cast<vtkIdType>(nPoints); l++)
-            {
-              if (cellPoints->GetId(l) == faceJPointK)
-              {
-                foundDup = true;
-                break; // look no more
-              }
-            }
-            if (!foundDup)
+            const vtkIdType faceJPointK = static_cast<vtkIdType>(faceJPoints[pointI]);
+            if (faceJPointK >= static_cast<vtkIdType>(pointMarks.size()))
             {
-              if (nPoints >= static_cast<size_t>(maxNPoints))
-              {
-                vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-                cellPoints->Delete();
-                polyPoints->Delete();
-                return;
-              }
-              cellPoints->SetId(static_cast<vtkIdType>(nPoints++),
-                                static_cast<vtkIdType>(faceJPointK));
+              pointMarks.resize(static_cast<size_t>(faceJPointK) + 1, -1);
             }
-            if (nPolyPoints >= static_cast<size_t>(maxNPolyPoints))
+            if (pointMarks[faceJPointK] != cellI)
             {
-                vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-                cellPoints->Delete();
-                polyPoints->Delete();
-                return;
+              pointMarks[faceJPointK] = cellI;
+              polyCellPoints.push_back(faceJPointK);
             }
-            polyPoints->SetId(static_cast<vtkIdType>(nPolyPoints++),
-                              static_cast<vtkIdType>(faceJPointK));
+            polyFacePoints.push_back(faceJPointK);
           }
         }
 
         // create the poly cell and insert it into the mesh
         internalMesh->InsertNextCell(
-              VTK_POLYHEDRON, static_cast<vtkIdType>(nPoints),
-              cellPoints->GetPointer(0),
+              VTK_POLYHEDRON, static_cast<vtkIdType>(polyCellPoints.size()),
+              polyCellPoints.data(),
               static_cast<vtkIdType>(cellFaces.size()),
-              polyPoints->GetPointer(0));
+              polyFacePoints.data());
       }
     }
   }
   cellPoints->Delete();
-  polyPoints->Delete();
 }
 
 //-----------------------------------------------------------------------------
@@ -9235,6 +9178,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   this->CurrentReaderIndex = 0;
   this->NumberOfReaders = 0;
+  this->ReadingInParallel = false;
   this->Use64BitLabels = false;
   this->Use64BitFloats = true;
   this->Use64BitLabelsOld = false;
@@ -9495,34 +9439,66 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
   {
     ret = reader->RequestData(output, recreateInternalMesh,
         recreateBoundaryMesh, updateVariables);
-    this->Parent->CurrentReaderIndex++;
+    if (!this->Parent->ReadingInParallel)
+    {
+      this->Parent->CurrentReaderIndex++;
+    }
   }
   else
   {
+    // the regions are independent of each other, so parse them in parallel
+    std::vector<vtkOpenFOAMReaderPrivate*> regions;
     this->Readers->InitTraversal();
     while ((reader
         = vtkOpenFOAMReaderPrivate::SafeDownCast(this->Readers->GetNextItemAsObject()))
         != nullptr)
     {
-      vtkMultiBlockDataSet *subOutput = vtkMultiBlockDataSet::New();
-      if (reader->RequestData(subOutput, recreateInternalMesh,
-          recreateBoundaryMesh, updateVariables))
+      regions.push_back(reader);
+    }
+    std::vector<vtkSmartPointer<vtkMultiBlockDataSet> > subOutputs(regions.size());
+    std::vector<int> regionRets(regions.size());
+    // vtkPOpenFOAMReader may already run this reader in parallel
+    const bool setReadingInParallel = regions.size() > 1 && !this->Parent->ReadingInParallel;
+    if (setReadingInParallel)
+    {
+      this->Parent->ReadingInParallel = true;
+    }
+    vtkSMPTools::For(0, static_cast<vtkIdType>(regions.size()), 1,
+      [&](vtkIdType begin, vtkIdType end)
       {
-        vtkStdString regionName(reader->GetRegionName());
+        for (vtkIdType regionI = begin; regionI < end; regionI++)
+        {
+          subOutputs[regionI] = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+          regionRets[regionI] = regions[regionI]->RequestData(subOutputs[regionI],
+              recreateInternalMesh, recreateBoundaryMesh, updateVariables);
+        }
+      });
+    if (setReadingInParallel)
+    {
+      this->Parent->ReadingInParallel = false;
+    }
+
+    for (size_t regionI = 0; regionI < regions.size(); regionI++)
+    {
+      if (regionRets[regionI])
+      {
+        vtkStdString regionName(regions[regionI]->GetRegionName());
         if (regionName.empty())
         {
           regionName = "defaultRegion";
         }
         const int blockI = output->GetNumberOfBlocks();
-        output->SetBlock(blockI, subOutput);
+        output->SetBlock(blockI, subOutputs[regionI]);
         output->GetMetaData(blockI)->Set(vtkCompositeDataSet::NAME(), regionName.c_str());
       }
       else
       {
         ret = 0;
       }
-      subOutput->Delete();
-      this->Parent->CurrentReaderIndex++;
+      if (!this->Parent->ReadingInParallel)
+      {
+        this->Parent->CurrentReaderIndex++;
+      }
     }
   }
 
@@ -9783,6 +9759,11 @@ void vtkOpenFOAMReader::UpdateStatus()
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  // progress is not reported while reader instances run in parallel
+  if (this->Parent->ReadingInParallel)
+  {
+    return;
+  }
   this->vtkAlgorithm::UpdateProgress((static_cast<double>(this->Parent->CurrentReaderIndex)
       + amount) / static_cast<double>(this->Parent->NumberOfReaders));
 }
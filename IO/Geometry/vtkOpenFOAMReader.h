@@ -20,6 +20,9 @@
  * information and time dependent data.  The polyMesh folders contain
  * mesh information. The time folders contain transient data for the
  * cells. Each folder can contain any number of data files.
+ * Mesh regions are parsed in parallel with vtkSMPTools, and the mesh is
+ * kept across time steps while CacheMesh is on and the polyMesh does not
+ * change.
  *
  * @par Thanks:
  * Thanks to Terry Jordan of SAIC at the National Energy
@@ -394,6 +397,9 @@ protected:
   int NumberOfReaders;
   // index of the active reader
   int CurrentReaderIndex;
+  // set while reader instances run in parallel, during which progress is
+  // not reported
+  bool ReadingInParallel;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader() override;
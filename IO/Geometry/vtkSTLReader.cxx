@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,13 +27,16 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -43,6 +47,170 @@ vtkStandardNewMacro(vtkSTLReader);
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
+namespace
+{
+// Binary facets are read by blocks of this many facets.
+const vtkIdType STLFacetsPerBlock = 1 << 16;
+const size_t STLFacetSize = 50; // normal, 3 vertices, attribute byte count
+
+// Decodes the vertices of a block of binary facets. The normals and
+// attribute byte counts are ignored.
+struct DecodeFacets
+{
+  const unsigned char* Block;
+  float* Coordinates;
+  vtkIdType* Connectivity;
+  vtkIdType FirstFacet;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType facet = begin; facet < end; ++facet)
+    {
+      const vtkIdType facetId = this->FirstFacet + facet;
+      float* x = this->Coordinates + 9 * facetId;
+      memcpy(x, this->Block + facet * STLFacetSize + 12, 9 * sizeof(float));
+      vtkByteSwap::Swap4LERange(x, 9);
+      vtkIdType* cell = this->Connectivity + 4 * facetId;
+      cell[0] = 3;
+      cell[1] = 3 * facetId;
+      cell[2] = 3 * facetId + 1;
+      cell[3] = 3 * facetId + 2;
+    }
+  }
+};
+
+// Coincident points are found by sorting the points by coordinates. The keys
+// order the floats as numbers, -0 being equal to 0, and ties are broken by
+// point id so that each group of coincident points starts with the first one.
+struct PointKey
+{
+  vtkTypeUInt32 Key[3];
+  vtkIdType Id;
+
+  bool operator<(const PointKey& other) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (this->Key[i] != other.Key[i])
+      {
+        return this->Key[i] < other.Key[i];
+      }
+    }
+    return this->Id < other.Id;
+  }
+
+  bool IsCoincident(const PointKey& other) const
+  {
+    return this->Key[0] == other.Key[0] && this->Key[1] == other.Key[1] &&
+      this->Key[2] == other.Key[2];
+  }
+};
+
+inline vtkTypeUInt32 OrderedKey(float x)
+{
+  x = (x == 0.0f ? 0.0f : x);
+  vtkTypeUInt32 bits;
+  memcpy(&bits, &x, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Merges exactly coincident points, as vtkMergePoints does, and removes the
+// triangles that become degenerate. Points are numbered in the order of
+// their first use, so that the output is that of vtkMergePoints. Returns
+// false if the cells are not all triangles.
+bool MergeCoincidentPoints(vtkPoints* points, vtkCellArray* polys, vtkFloatArray* scalars,
+  vtkPoints* mergedPoints, vtkCellArray* mergedPolys, vtkFloatArray* mergedScalars)
+{
+  vtkFloatArray* coordinates = vtkFloatArray::FastDownCast(points->GetData());
+  const vtkIdType numPoints = points->GetNumberOfPoints();
+  const vtkIdType numCells = polys->GetNumberOfCells();
+  if (!coordinates || polys->GetNumberOfConnectivityEntries() != 4 * numCells)
+  {
+    return false;
+  }
+  const float* x = coordinates->GetPointer(0);
+
+  std::vector<PointKey> keys(numPoints);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        keys[ptId].Key[i] = OrderedKey(x[3 * ptId + i]);
+      }
+      keys[ptId].Id = ptId;
+    }
+  });
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  // The first point of each group represents the others.
+  std::vector<vtkIdType> pointMap(numPoints);
+  for (vtkIdType i = 0, groupStart = 0; i < numPoints; ++i)
+  {
+    if (!keys[i].IsCoincident(keys[groupStart]))
+    {
+      groupStart = i;
+    }
+    pointMap[keys[i].Id] = keys[groupStart].Id;
+  }
+  std::vector<PointKey>().swap(keys);
+
+  vtkIdType numMergedPoints = 0;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    pointMap[ptId] = (pointMap[ptId] == ptId ? numMergedPoints++ : pointMap[pointMap[ptId]]);
+  }
+
+  mergedPoints->SetDataTypeToFloat();
+  mergedPoints->SetNumberOfPoints(numMergedPoints);
+  float* mergedX = vtkFloatArray::FastDownCast(mergedPoints->GetData())->GetPointer(0);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      std::copy(x + 3 * ptId, x + 3 * ptId + 3, mergedX + 3 * pointMap[ptId]);
+    }
+  });
+
+  // Map the triangles, then keep those that are not degenerate.
+  const vtkIdType* cells = polys->GetPointer();
+  std::vector<vtkIdType> mergedCells(4 * numCells);
+  std::vector<unsigned char> keep(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      vtkIdType* cell = &mergedCells[4 * cellId];
+      cell[0] = 3;
+      for (int i = 1; i < 4; ++i)
+      {
+        cell[i] = pointMap[cells[4 * cellId + i]];
+      }
+      keep[cellId] = (cell[1] != cell[2] && cell[1] != cell[3] && cell[2] != cell[3]);
+    }
+  });
+
+  vtkIdType numMergedCells = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (keep[cellId])
+    {
+      std::copy(&mergedCells[4 * cellId], &mergedCells[4 * cellId] + 4,
+        &mergedCells[4 * numMergedCells]);
+      if (scalars)
+      {
+        mergedScalars->InsertNextValue(scalars->GetValue(cellId));
+      }
+      ++numMergedCells;
+    }
+  }
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(4 * numMergedCells);
+  std::copy(mergedCells.begin(), mergedCells.begin() + 4 * numMergedCells,
+    connectivity->GetPointer(0));
+  mergedPolys->SetCells(numMergedCells, connectivity);
+  return true;
+}
+}
+
 //------------------------------------------------------------------------------
 // Construct object with merging set to true.
 vtkSTLReader::vtkSTLReader()
@@ -168,14 +336,14 @@ int vtkSTLReader::RequestData(
   fclose(fp);
 
   // If merging is on, create hash table and merge points/triangles.
-  vtkPoints *mergedPts = newPts.Get();
-  vtkCellArray *mergedPolys = newPolys.Get();
+  vtkSmartPointer<vtkPoints> mergedPts = newPts.Get();
+  vtkSmartPointer<vtkCellArray> mergedPolys = newPolys.Get();
   vtkFloatArray *mergedScalars = newScalars;
   if (this->Merging)
   {
-    mergedPts = vtkPoints::New();
+    mergedPts = vtkSmartPointer<vtkPoints>::New();
     mergedPts->Allocate(newPts->GetNumberOfPoints() /2);
-    mergedPolys = vtkCellArray::New();
+    mergedPolys = vtkSmartPointer<vtkCellArray>::New();
     mergedPolys->Allocate(newPolys->GetSize());
     if (newScalars)
     {
@@ -183,17 +351,25 @@ int vtkSTLReader::RequestData(
       mergedScalars->Allocate(newPolys->GetSize());
     }
 
+    // Without a locator, coincident points are merged by sorting them.
+    bool merged = (this->Locator == nullptr &&
+      MergeCoincidentPoints(newPts, newPolys, newScalars, mergedPts, mergedPolys,
+        mergedScalars));
+
     vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
-    if (this->Locator == nullptr)
+    if (!merged && this->Locator == nullptr)
     {
       locator.TakeReference(this->NewDefaultLocator());
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+    if (!merged)
+    {
+      locator->InitPointInsertion(mergedPts, newPts->GetBounds());
+    }
 
     int nextCell = 0;
     vtkIdType *pts = nullptr;
     vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    for (newPolys->InitTraversal(); !merged && newPolys->GetNextCell(npts, pts);)
     {
       vtkIdType nodes[3];
       for (int i = 0; i < 3; i++)
@@ -227,10 +403,7 @@ int vtkSTLReader::RequestData(
   }
 
   output->SetPoints(mergedPts);
-  mergedPts->Delete();
-
   output->SetPolys(mergedPolys);
-  mergedPolys->Delete();
 
   if (mergedScalars)
   {
@@ -253,8 +426,6 @@ int vtkSTLReader::RequestData(
 bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
                                  vtkCellArray *newPolys)
 {
-  typedef struct { float  n[3], v1[3], v2[3], v3[3]; } facet_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -296,60 +467,42 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
       << numTris << ")");
   }
 
-  // Verify the numTris with the length of the file
+  // The number of facets is given by the length of the file
   unsigned long ulFileLength = vtksys::SystemTools::FileLength(this->FileName);
-  ulFileLength -= (80 + 4); // 80 byte - header, 4 byte - tringle count
-  ulFileLength /= 50;       // 50 byte - twelve 32-bit-floating point numbers + 2 byte for attribute byte count
-
-  if (numTris < static_cast<int>(ulFileLength))
-  {
-    numTris = static_cast<int>(ulFileLength);
-  }
+  ulFileLength -= std::min(ulFileLength, 80ul + 4); // 80 byte - header, 4 byte - tringle count
+  ulFileLength /= STLFacetSize; // twelve 32-bit-floating point numbers + 2 byte for attribute byte count
+  const vtkIdType numFacets = static_cast<vtkIdType>(ulFileLength);
 
   // now we can allocate the memory we need for this STL file
-  newPts->Allocate(numTris * 3);
-  newPolys->Allocate(numTris);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 48, 1, fp) > 0; i++)
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3 * numFacets);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(4 * numFacets);
+
+  // Facets are read by blocks and decoded in parallel.
+  std::vector<unsigned char> block(
+    static_cast<size_t>(std::min(numFacets, STLFacetsPerBlock)) * STLFacetSize);
+  DecodeFacets decode;
+  decode.Block = block.data();
+  decode.Coordinates = vtkFloatArray::FastDownCast(newPts->GetData())->GetPointer(0);
+  decode.Connectivity = connectivity->GetPointer(0);
+  for (vtkIdType first = 0; first < numFacets; first += STLFacetsPerBlock)
   {
-    unsigned short ibuff2;
-    if (fread(&ibuff2, 2, 1, fp) != 1) //read extra junk
+    vtkIdType n = std::min(STLFacetsPerBlock, numFacets - first);
+    if (fread(block.data(), STLFacetSize, static_cast<size_t>(n), fp) !=
+      static_cast<size_t>(n))
     {
       vtkErrorMacro("STLReader error reading file: " << this->FileName
-        << " Premature EOF while reading extra junk.");
+        << " Premature EOF while reading facets.");
       return false;
     }
+    decode.FirstFacet = first;
+    vtkSMPTools::For(0, n, decode);
 
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n+1);
-    vtkByteSwap::Swap4LE(facet.n+2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1+1);
-    vtkByteSwap::Swap4LE(facet.v1+2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2+1);
-    vtkByteSwap::Swap4LE(facet.v2+2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3+1);
-    vtkByteSwap::Swap4LE(facet.v3+2);
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
-
-    if ((i % 5000) == 0 && i != 0)
-    {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
-    }
+    vtkDebugMacro(<< "triangle# " << first + n);
+    this->UpdateProgress(static_cast<double>(first + n) / numFacets);
   }
+  newPolys->SetCells(numFacets, connectivity);
 
   return true;
 }
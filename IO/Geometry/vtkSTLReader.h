@@ -23,9 +23,12 @@
  *
  * .stl files are quite inefficient since they duplicate vertex
  * definitions. By setting the Merging boolean you can control whether the
- * point data is merged after reading. Merging is performed by default,
- * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * point data is merged after reading. Merging is performed by default: unless
+ * a Locator is given, coincident points are found by sorting them in
+ * parallel, which requires temporary storage proportional to the number of
+ * points. Turn Merging off to get three points per triangle as fast as
+ * possible. Binary files are read by large blocks of triangles, decoded in
+ * parallel.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
@@ -80,8 +83,9 @@ public:
 
   //@{
   /**
-   * Specify a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Specify a spatial locator for merging points. By default, no locator is
+   * used: exactly coincident points are merged by sorting them, with the
+   * same result as a vtkMergePoints locator.
    */
   void SetLocator(vtkIncrementalPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkIncrementalPointLocator);
@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNIFTIReaderExtents.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a volume as plain and compressed NIFTI files, with the slices in
+// both orders, and checks that slabs, sub-volumes and shrunk volumes read
+// from the files match the whole volume.  The plain file is also read as
+// a raw file with vtkImageReader2.
+
+#include "vtkImageData.h"
+#include "vtkImageReader2.h"
+#include "vtkMatrix4x4.h"
+#include "vtkNIFTIImageReader.h"
+#include "vtkNIFTIImageWriter.h"
+#include "vtkNew.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+
+#include <string>
+
+namespace
+{
+
+const int Dims[3] = { 128, 96, 200 };
+
+// Compare the output of a reader with the voxels of a volume, where the
+// voxel (i, j, k) of the output is the voxel (i*shrink[0], j*shrink[1],
+// k*shrink[2]) of the volume, or its mirror along y if flipY is set.
+int CompareVoxels(vtkImageData* volume, vtkImageData* output, const int shrink[3],
+  bool flipY, const std::string& name)
+{
+  int extent[6];
+  output->GetExtent(extent);
+  for (int k = extent[4]; k <= extent[5]; k++)
+  {
+    for (int j = extent[2]; j <= extent[3]; j++)
+    {
+      for (int i = extent[0]; i <= extent[1]; i++)
+      {
+        int y = j * shrink[1];
+        if (flipY)
+        {
+          y = Dims[1] - 1 - y;
+        }
+        if (output->GetScalarComponentAsDouble(i, j, k, 0) !=
+          volume->GetScalarComponentAsDouble(i * shrink[0], y, k * shrink[2], 0))
+        {
+          std::cerr << name << ": wrong voxel (" << i << ", " << j << ", " << k << ")\n";
+          return 1;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+int CheckExtents(vtkImageData* volume, vtkImageReader2* reader, bool flipY,
+  const std::string& name)
+{
+  // slabs and sub-volumes, out of order so that compressed files are read
+  // both forward and backward
+  const int extents[][6] = { { 0, 127, 0, 95, 190, 199 }, { 0, 127, 0, 95, 0, 0 },
+    { 0, 127, 0, 95, 101, 103 }, { 7, 100, 3, 90, 150, 160 }, { 0, 127, 10, 20, 40, 40 },
+    { 64, 64, 0, 95, 20, 180 } };
+  const int noShrink[3] = { 1, 1, 1 };
+  int errors = 0;
+  for (const int* extent : extents)
+  {
+    // the reader would otherwise keep the data it already has
+    reader->Modified();
+    reader->UpdateExtent(extent);
+    vtkImageData* output = reader->GetOutput();
+    int* outExtent = output->GetExtent();
+    for (int i = 0; i < 6; i++)
+    {
+      if (outExtent[i] != extent[i])
+      {
+        std::cerr << name << ": wrong extent\n";
+        return 1;
+      }
+    }
+    errors += CompareVoxels(volume, output, noShrink, flipY, name);
+  }
+  return errors;
+}
+
+}
+
+int TestNIFTIReaderExtents(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  // a volume large enough for access points to be saved in the compressed
+  // files, with a different value in every voxel
+  vtkNew<vtkImageData> volume;
+  volume->SetDimensions(Dims[0], Dims[1], Dims[2]);
+  volume->AllocateScalars(VTK_FLOAT, 1);
+  float* voxel = static_cast<float*>(volume->GetScalarPointer());
+  for (int k = 0; k < Dims[2]; k++)
+  {
+    for (int j = 0; j < Dims[1]; j++)
+    {
+      for (int i = 0; i < Dims[0]; i++)
+      {
+        *voxel++ = static_cast<float>(i + 128 * j + 12288 * k);
+      }
+    }
+  }
+
+  int errors = 0;
+  const char* extensions[] = { ".nii", ".nii.gz" };
+  for (int reversed = 0; reversed < 2; reversed++)
+  {
+    for (const char* extension : extensions)
+    {
+      const std::string fileName =
+        testDirectory + "/Extents" + (reversed ? "Reversed" : "") + extension;
+      vtkNew<vtkNIFTIImageWriter> writer;
+      writer->SetInputData(volume);
+      writer->SetFileName(fileName.c_str());
+      if (reversed)
+      {
+        vtkNew<vtkMatrix4x4> matrix;
+        writer->SetQFormMatrix(matrix);
+        writer->SetQFac(-1.0);
+      }
+      writer->Write();
+
+      vtkNew<vtkNIFTIImageReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->Update();
+      if (reader->GetQFac() != (reversed ? -1.0 : 1.0))
+      {
+        std::cerr << fileName << ": wrong QFac\n";
+        return EXIT_FAILURE;
+      }
+      errors += CheckExtents(volume, reader, false, fileName);
+
+      // every n-th voxel, for the whole volume and for a slab
+      const int shrink[3] = { 2, 3, 4 };
+      reader->SetShrinkFactors(2, 3, 4);
+      reader->Update();
+      vtkImageData* output = reader->GetOutput();
+      int* extent = output->GetExtent();
+      if (extent[1] != 63 || extent[3] != 31 || extent[5] != 49 || output->GetSpacing()[2] != 4.0)
+      {
+        std::cerr << fileName << ": wrong shrunk extent or spacing\n";
+        return EXIT_FAILURE;
+      }
+      errors += CompareVoxels(volume, output, shrink, false, fileName + " shrunk");
+      const int slab[6] = { 0, 63, 0, 31, 30, 33 };
+      reader->Modified();
+      reader->UpdateExtent(slab);
+      errors += CompareVoxels(volume, reader->GetOutput(), shrink, false, fileName + " shrunk");
+    }
+  }
+
+  // the plain file read as raw data, with rows in both orders
+  for (int lowerLeft = 0; lowerLeft < 2; lowerLeft++)
+  {
+    vtkNew<vtkImageReader2> reader;
+    reader->SetFileName((testDirectory + "/Extents.nii").c_str());
+    reader->SetFileDimensionality(3);
+    reader->SetDataScalarTypeToFloat();
+    reader->SetDataExtent(0, Dims[0] - 1, 0, Dims[1] - 1, 0, Dims[2] - 1);
+    reader->SetHeaderSize(352);
+#ifdef VTK_WORDS_BIGENDIAN
+    reader->SetDataByteOrderToBigEndian();
+#else
+    reader->SetDataByteOrderToLittleEndian();
+#endif
+    reader->SetFileLowerLeft(lowerLeft);
+    errors += CheckExtents(volume, reader, !lowerLeft, lowerLeft ? "raw" : "raw upper left");
+  }
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -27,6 +27,9 @@
 
 #include "vtksys/SystemTools.hxx"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkImageReader2);
 
 #ifdef read
@@ -717,6 +720,13 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
                            (outExtent[3]-outExtent[2]+1)/50.0);
   target++;
 
+  // rows that span the whole extent of the file are contiguous in the file
+  // and in the output, so all the rows of a slice can be read at once
+  int *dataExtent = self->GetDataExtent();
+  bool wholeRows = (outExtent[0] == dataExtent[0] &&
+                    outExtent[1] == dataExtent[1] &&
+                    outIncr[1] == pixelRead*nComponents);
+
   // read the data row by row
   if (self->GetFileDimensionality() == 3)
   {
@@ -738,6 +748,43 @@ void vtkImageReader2Update(vtkImageReader2 *self, vtkImageData *data, OT *outPtr
       }
     }
     outPtr1 = outPtr2;
+    if (wholeRows && !self->AbortExecute)
+    {
+      // the rows are contiguous in the file, read them with a single read
+      int numRows = outExtent[3] - outExtent[2] + 1;
+      self->UpdateProgress(count/(50.0*target));
+      count += numRows;
+      self->SeekFile(outExtent[0],
+                     self->GetFileLowerLeft() ? outExtent[2] : outExtent[3],
+                     idx2);
+      if ( !self->GetFile()->read((char *)outPtr1, numRows*streamRead))
+      {
+        vtkGenericWarningMacro("File operation failed. rows = " << outExtent[2]
+                               << " to " << outExtent[3]
+                               << ", Read = " << numRows*streamRead
+                               << ", FilePos = " << static_cast<vtkIdType>(self->GetFile()->tellg()));
+        return;
+      }
+      if (self->GetSwapBytes() && sizeof(OT) > 1)
+      {
+        vtkByteSwap::SwapVoidRange(outPtr1, pixelRead*nComponents*numRows, sizeof(OT));
+      }
+      // the rows of an upper left file are in reverse order
+      if (!self->GetFileLowerLeft())
+      {
+        std::vector<OT> row(pixelRead*nComponents);
+        OT *lower = outPtr1;
+        OT *upper = outPtr1 + outIncr[1]*(numRows - 1);
+        for (; lower < upper; lower += outIncr[1], upper -= outIncr[1])
+        {
+          std::copy(lower, lower + pixelRead*nComponents, row.begin());
+          std::copy(upper, upper + pixelRead*nComponents, lower);
+          std::copy(row.begin(), row.end(), upper);
+        }
+      }
+      outPtr2 += outIncr[2];
+      continue;
+    }
     for (idx1 = outExtent[2];
          !self->AbortExecute && idx1 <= outExtent[3]; ++idx1)
     {
@@ -40,11 +40,346 @@
 #include "vtk_zlib.h"
 
 #include <cctype>
+#include <cstdio>
 #include <cstring>
 #include <string>
+#include <vector>
+
+#ifdef _WIN64
+# define vtk_fseek _fseeki64
+# define vtk_ftell _ftelli64
+# define vtk_off_t __int64
+#else
+# define vtk_fseek fseek
+# define vtk_ftell ftell
+# define vtk_off_t long
+#endif
 
 vtkStandardNewMacro(vtkNIFTIImageReader);
 
+//----------------------------------------------------------------------------
+// Random access into gzip files.  While a file is decompressed, the state
+// of the decompression is saved at the end of a deflate block about every
+// SPAN bytes of decompressed data: the offset of the block in the file, the
+// bits of its first byte that belong to the previous block, and the 32k of
+// decompressed data that precede it.  Decompression can then restart from
+// the closest access point before any offset, as in zlib's zran example.
+class vtkNIFTIImageReader::GZIndexInternal
+{
+public:
+  GZIndexInternal();
+  ~GZIndexInternal();
+
+  // Open a compressed file.  The access points are kept if the file is
+  // the same, unmodified file that they were saved for.
+  bool Open(const char *filename);
+
+  // Close the file, but keep the access points.
+  void Close();
+
+  // Move forward or backward in the decompressed data.
+  bool Skip(vtkTypeInt64 offset);
+
+  // Read decompressed data, return the number of bytes read or -1.
+  int Read(void *buffer, unsigned int size);
+
+  // Whether the end of the file was reached.
+  bool Eof() { return this->AtEnd; }
+
+private:
+  static const vtkTypeInt64 SPAN = 4194304;
+  static const unsigned int WINDOW_SIZE = 32768;
+  static const unsigned int CHUNK = 16384;
+
+  struct AccessPoint
+  {
+    vtkTypeInt64 Out;
+    vtk_off_t In;
+    int Bits;
+    std::vector<unsigned char> Window;
+  };
+
+  bool Restart(const AccessPoint *point);
+  bool Inflate(unsigned char *dest, vtkTypeInt64 size);
+  bool EndMember();
+  bool FillInput();
+
+  std::string FileName;
+  vtkTypeInt64 FileSize;
+  vtkTypeInt64 FileTime;
+  std::vector<AccessPoint> Points;
+
+  FILE *File;
+  z_stream Stream;
+  bool StreamReady;
+  bool StreamRaw;
+  bool AtEnd;
+  vtkTypeInt64 Out;
+  unsigned int WindowPos;
+  unsigned char Input[CHUNK];
+  unsigned char Window[WINDOW_SIZE];
+};
+
+//----------------------------------------------------------------------------
+vtkNIFTIImageReader::GZIndexInternal::GZIndexInternal()
+{
+  this->FileSize = -1;
+  this->FileTime = -1;
+  this->File = nullptr;
+  memset(&this->Stream, 0, sizeof(this->Stream));
+  // the stream is initialized once and reset for every restart
+  this->StreamReady = (inflateInit2(&this->Stream, 47) == Z_OK);
+  this->StreamRaw = false;
+  this->AtEnd = false;
+  this->Out = -1;
+  this->WindowPos = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkNIFTIImageReader::GZIndexInternal::~GZIndexInternal()
+{
+  this->Close();
+  if (this->StreamReady)
+  {
+    inflateEnd(&this->Stream);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::Open(const char *filename)
+{
+  this->Close();
+
+  vtksys::SystemTools::Stat_t fs;
+  if (!this->StreamReady || vtksys::SystemTools::Stat(filename, &fs) != 0)
+  {
+    return false;
+  }
+
+  vtkTypeInt64 fileSize = static_cast<vtkTypeInt64>(fs.st_size);
+  vtkTypeInt64 fileTime = static_cast<vtkTypeInt64>(fs.st_mtime);
+  if (this->FileName != filename || this->FileSize != fileSize ||
+      this->FileTime != fileTime)
+  {
+    this->Points.clear();
+    this->FileName = filename;
+    this->FileSize = fileSize;
+    this->FileTime = fileTime;
+  }
+
+  this->File = fopen(filename, "rb");
+  this->Out = -1;
+  return (this->File != nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkNIFTIImageReader::GZIndexInternal::Close()
+{
+  if (this->File)
+  {
+    fclose(this->File);
+    this->File = nullptr;
+  }
+  this->Out = -1;
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::Restart(const AccessPoint *point)
+{
+  this->AtEnd = false;
+  this->Stream.avail_in = 0;
+  this->WindowPos = 0;
+  if (point == nullptr)
+  {
+    // start at the gzip header
+    this->StreamRaw = false;
+    this->Out = 0;
+    return (inflateReset2(&this->Stream, 47) == Z_OK &&
+            vtk_fseek(this->File, 0, SEEK_SET) == 0);
+  }
+
+  // raw inflate from the access point, with the window of the data that
+  // precedes it as the dictionary
+  this->StreamRaw = true;
+  this->Out = point->Out;
+  if (inflateReset2(&this->Stream, -15) != Z_OK ||
+      vtk_fseek(this->File, point->In - (point->Bits ? 1 : 0), SEEK_SET) != 0)
+  {
+    return false;
+  }
+  if (point->Bits)
+  {
+    int c = getc(this->File);
+    if (c == EOF ||
+        inflatePrime(&this->Stream, point->Bits, c >> (8 - point->Bits)) != Z_OK)
+    {
+      return false;
+    }
+  }
+  memcpy(this->Window, point->Window.data(), WINDOW_SIZE);
+  return (inflateSetDictionary(&this->Stream, this->Window, WINDOW_SIZE) == Z_OK);
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::FillInput()
+{
+  if (this->Stream.avail_in == 0)
+  {
+    this->Stream.avail_in = static_cast<uInt>(
+      fread(this->Input, 1, CHUNK, this->File));
+    this->Stream.next_in = this->Input;
+  }
+  return (this->Stream.avail_in != 0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::EndMember()
+{
+  // a raw stream stops before the 8-byte gzip trailer, skip it
+  if (this->StreamRaw)
+  {
+    for (int i = 0; i < 8; i++)
+    {
+      if (!this->FillInput())
+      {
+        return false;
+      }
+      this->Stream.next_in++;
+      this->Stream.avail_in--;
+    }
+  }
+
+  // continue with the next member of the file, if any
+  if (!this->FillInput() || this->Stream.next_in[0] != 0x1f)
+  {
+    return false;
+  }
+  this->StreamRaw = false;
+  return (inflateReset2(&this->Stream, 47) == Z_OK);
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::Inflate(
+  unsigned char *dest, vtkTypeInt64 size)
+{
+  // decompress into the window, then copy to dest if it is not null
+  while (size > 0)
+  {
+    if (!this->FillInput())
+    {
+      this->AtEnd = true;
+      return false;
+    }
+
+    unsigned int n = WINDOW_SIZE - this->WindowPos;
+    if (static_cast<vtkTypeInt64>(n) > size)
+    {
+      n = static_cast<unsigned int>(size);
+    }
+    this->Stream.next_out = this->Window + this->WindowPos;
+    this->Stream.avail_out = n;
+    int code = inflate(&this->Stream, Z_BLOCK);
+    if (code == Z_NEED_DICT || code == Z_DATA_ERROR || code == Z_MEM_ERROR)
+    {
+      return false;
+    }
+    n -= this->Stream.avail_out;
+    if (dest)
+    {
+      memcpy(dest, this->Window + this->WindowPos, n);
+      dest += n;
+    }
+    this->WindowPos = (this->WindowPos + n) % WINDOW_SIZE;
+    this->Out += n;
+    size -= n;
+
+    if (code == Z_STREAM_END)
+    {
+      if (!this->EndMember())
+      {
+        this->AtEnd = true;
+        return (size == 0);
+      }
+    }
+    else if ((this->Stream.data_type & 128) && !(this->Stream.data_type & 64) &&
+             this->Out - (this->Points.empty() ? 0 : this->Points.back().Out) >= SPAN)
+    {
+      // at the end of a block that is not the last one, save an access
+      // point with the data of the window in order
+      AccessPoint point;
+      point.Out = this->Out;
+      point.In = vtk_ftell(this->File) - this->Stream.avail_in;
+      point.Bits = this->Stream.data_type & 7;
+      point.Window.resize(WINDOW_SIZE);
+      memcpy(point.Window.data(), this->Window + this->WindowPos,
+             WINDOW_SIZE - this->WindowPos);
+      memcpy(point.Window.data() + WINDOW_SIZE - this->WindowPos,
+             this->Window, this->WindowPos);
+      this->Points.push_back(point);
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkNIFTIImageReader::GZIndexInternal::Skip(vtkTypeInt64 offset)
+{
+  vtkTypeInt64 target = (this->Out < 0 ? 0 : this->Out) + offset;
+  if (target < 0)
+  {
+    return false;
+  }
+
+  // the last access point before the target
+  const AccessPoint *point = nullptr;
+  size_t lo = 0;
+  size_t hi = this->Points.size();
+  while (lo < hi)
+  {
+    size_t mid = (lo + hi)/2;
+    if (this->Points[mid].Out <= target)
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  if (lo > 0)
+  {
+    point = &this->Points[lo - 1];
+  }
+
+  // restart if the target is behind, or if an access point is closer
+  if (this->Out < 0 || target < this->Out ||
+      (point && point->Out > this->Out))
+  {
+    if (!this->Restart(point))
+    {
+      return false;
+    }
+  }
+
+  return this->Inflate(nullptr, target - this->Out);
+}
+
+//----------------------------------------------------------------------------
+int vtkNIFTIImageReader::GZIndexInternal::Read(void *buffer, unsigned int size)
+{
+  if (this->Out < 0 && !this->Skip(0))
+  {
+    return -1;
+  }
+  vtkTypeInt64 start = this->Out;
+  if (!this->Inflate(static_cast<unsigned char *>(buffer), size) &&
+      !this->AtEnd)
+  {
+    return -1;
+  }
+  return static_cast<int>(this->Out - start);
+}
+
 //----------------------------------------------------------------------------
 vtkNIFTIImageReader::vtkNIFTIImageReader()
 {
@@ -64,6 +399,10 @@ vtkNIFTIImageReader::vtkNIFTIImageReader()
   this->SFormMatrix = nullptr;
   this->NIFTIHeader = nullptr;
   this->PlanarRGB = false;
+  this->ShrinkFactors[0] = 1;
+  this->ShrinkFactors[1] = 1;
+  this->ShrinkFactors[2] = 1;
+  this->GZIndex = new GZIndexInternal;
 }
 
 //----------------------------------------------------------------------------
@@ -81,6 +420,7 @@ vtkNIFTIImageReader::~vtkNIFTIImageReader()
   {
     this->NIFTIHeader->Delete();
   }
+  delete this->GZIndex;
 }
 
 //----------------------------------------------------------------------------
@@ -224,6 +564,8 @@ void vtkNIFTIImageReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "NIFTIHeader:" << (this->NIFTIHeader ? "\n" : " (none)\n");
   os << indent << "PlanarRGB: " << (this->PlanarRGB ? "On\n" : "Off\n");
+  os << indent << "ShrinkFactors: " << this->ShrinkFactors[0] << " "
+     << this->ShrinkFactors[1] << " " << this->ShrinkFactors[2] << "\n";
 }
 
 //----------------------------------------------------------------------------
@@ -651,15 +993,20 @@ int vtkNIFTIImageReader::RequestInformation(
   // NIFTI uses a lower-left-hand origin
   this->FileLowerLeftOn();
 
-  // dim
-  this->SetDataExtent(0, hdr2->dim[1]-1,
-                      0, hdr2->dim[2]-1,
-                      0, hdr2->dim[3]-1);
+  // dim, reduced by the shrink factors
+  int shrink[3];
+  for (int i = 0; i < 3; i++)
+  {
+    shrink[i] = (this->ShrinkFactors[i] > 1 ? this->ShrinkFactors[i] : 1);
+  }
+  this->SetDataExtent(0, (hdr2->dim[1]-1)/shrink[0],
+                      0, (hdr2->dim[2]-1)/shrink[1],
+                      0, (hdr2->dim[3]-1)/shrink[2]);
 
-  // pixdim
-  this->SetDataSpacing(hdr2->pixdim[1],
-                       hdr2->pixdim[2],
-                       hdr2->pixdim[3]);
+  // pixdim, multiplied by the shrink factors
+  this->SetDataSpacing(hdr2->pixdim[1]*shrink[0],
+                       hdr2->pixdim[2]*shrink[1],
+                       hdr2->pixdim[3]*shrink[2]);
 
   // offset is part of the transform, so set origin to zero
   this->SetDataOrigin(0.0, 0.0, 0.0);
@@ -728,6 +1075,9 @@ int vtkNIFTIImageReader::RequestInformation(
   outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(),
                this->DataExtent, 6);
 
+  // only the update extent is read from the file
+  outInfo->Set(CAN_PRODUCE_SUB_EXTENT(), 1);
+
   // copy dim for when RequestData is called
   for (int j = 0; j < 8; j++)
   {
@@ -1144,9 +1494,22 @@ int vtkNIFTIImageReader::RequestData(
 
   gzFile file = gzopen(imgname, "rb");
 
+  // read compressed files through the index of access points, so that
+  // extents can be read without decompressing from the start of the file
+  GZIndexInternal *index = nullptr;
+  if (file && !gzdirect(file))
+  {
+    gzclose(file);
+    file = nullptr;
+    if (this->GZIndex->Open(imgname))
+    {
+      index = this->GZIndex;
+    }
+  }
+
   delete [] imgname;
 
-  if (!file)
+  if (!file && !index)
   {
     return 0;
   }
@@ -1170,6 +1533,15 @@ int vtkNIFTIImageReader::RequestData(
   int outSizeY = extent[3] - extent[2] + 1;
   int outSizeZ = extent[5] - extent[4] + 1;
 
+  // every n-th voxel is read along each axis, and the voxels to the last
+  // one read along x are read as a row
+  int shrink[3];
+  for (int i = 0; i < 3; i++)
+  {
+    shrink[i] = (this->ShrinkFactors[i] > 1 ? this->ShrinkFactors[i] : 1);
+  }
+  int readSizeX = (outSizeX - 1)*shrink[0] + 1;
+
   z_off_t fileVoxelIncr = scalarSize*numComponents/vectorDim;
   z_off_t fileRowIncr = fileVoxelIncr*this->Dim[1];
   z_off_t filePlaneIncr = fileRowIncr*this->Dim[2];
@@ -1191,11 +1563,13 @@ int vtkNIFTIImageReader::RequestData(
     filePlaneIncr = fileRowIncr*this->Dim[2];
   }
 
-  // add a buffer for planar-vector to packed-vector conversion
+  // add a buffer for planar-vector to packed-vector conversion, or for
+  // picking every n-th voxel of the rows
+  bool readDirect = (vectorDim == 1 && !planarRGB && shrink[0] == 1);
   unsigned char *rowBuffer = nullptr;
-  if (vectorDim > 1 || planarRGB)
+  if (!readDirect)
   {
-    rowBuffer = new unsigned char[outSizeX*fileVoxelIncr];
+    rowBuffer = new unsigned char[readSizeX*fileVoxelIncr];
   }
 
   // special increment to reverse the slices if needed
@@ -1229,15 +1603,23 @@ int vtkNIFTIImageReader::RequestData(
     static_cast<vtkIdType>(0.02*planarSize*outSizeY*outSizeZ*vectorDim) + 1;
   vtkIdType count = 0;
 
+  // the first slice to read from the file, counted from the last slice
+  // if the slices are in reverse order
+  z_off_t fileSlice = extent[4]*shrink[2];
+  if (this->GetQFac() < 0)
+  {
+    fileSlice = this->Dim[3] - 1 - extent[5]*shrink[2];
+  }
+
   // seek to the start of the data
   z_off_t offset = static_cast<z_off_t>(this->GetHeaderSize());
-  offset += extent[0]*fileVoxelIncr;
-  offset += extent[2]*fileRowIncr;
-  offset += extent[4]*fileSliceIncr;
+  offset += extent[0]*shrink[0]*fileVoxelIncr;
+  offset += extent[2]*shrink[1]*fileRowIncr;
+  offset += fileSlice*fileSliceIncr;
 
   // read the data one row at a time, do planar-to-packed conversion
   // of vector components if NIFTI file has a vector dimension
-  int rowSize = fileVoxelIncr/scalarSize*outSizeX;
+  int rowSize = fileVoxelIncr/scalarSize*readSizeX;
   int t = 0; // counter for time
   int c = 0; // counter for vector components
   int j = 0; // counter for rows
@@ -1251,11 +1633,12 @@ int vtkNIFTIImageReader::RequestData(
   {
     if (offset)
     {
-      int rval = gzseek(file, offset, SEEK_CUR);
-      if (rval == -1)
+      bool rval = (index ? index->Skip(offset) :
+                   gzseek(file, offset, SEEK_CUR) != -1);
+      if (!rval)
       {
         errorCode = vtkErrorCode::FileFormatError;
-        if (gzeof(file))
+        if (index ? index->Eof() : gzeof(file))
         {
           errorCode = vtkErrorCode::PrematureEndOfFileError;
         }
@@ -1263,17 +1646,18 @@ int vtkNIFTIImageReader::RequestData(
       }
     }
 
-    if (vectorDim == 1 && !planarRGB)
+    if (readDirect)
     {
       // read directly into the output instead of into a buffer
       rowBuffer = ptr;
     }
 
-    int code = gzread(file, rowBuffer, rowSize*scalarSize);
+    int code = (index ? index->Read(rowBuffer, rowSize*scalarSize) :
+                gzread(file, rowBuffer, rowSize*scalarSize));
     if (code != rowSize*scalarSize)
     {
       errorCode = vtkErrorCode::FileFormatError;
-      if (gzeof(file))
+      if (index ? index->Eof() : gzeof(file))
       {
         errorCode = vtkErrorCode::PrematureEndOfFileError;
       }
@@ -1285,7 +1669,7 @@ int vtkNIFTIImageReader::RequestData(
       vtkByteSwap::SwapVoidRange(rowBuffer, rowSize, scalarSize);
     }
 
-    if (vectorDim == 1 && !planarRGB)
+    if (readDirect)
     {
       // advance the pointer to the next row
       ptr += outSizeX*numComponents*scalarSize;
@@ -1296,6 +1680,7 @@ int vtkNIFTIImageReader::RequestData(
       // write vector plane to packed vector component
       unsigned char *tmpPtr = rowBuffer;
       z_off_t skipOther = scalarSize*numComponents - fileVoxelIncr;
+      z_off_t skipShrink = (shrink[0] - 1)*fileVoxelIncr;
       for (int i = 0; i < outSizeX; i++)
       {
         // write one vector component of one voxel
@@ -1303,6 +1688,8 @@ int vtkNIFTIImageReader::RequestData(
         do { *ptr++ = *tmpPtr++; } while (--n);
         // skip past the other components
         ptr += skipOther;
+        // skip past the voxels that are not read
+        tmpPtr += skipShrink;
       }
     }
 
@@ -1313,11 +1700,11 @@ int vtkNIFTIImageReader::RequestData(
 
     // offset to skip unread sections of the file, for when
     // the update extent is less than the whole extent
-    offset = fileRowIncr - outSizeX*fileVoxelIncr;
+    offset = shrink[1]*fileRowIncr - readSizeX*fileVoxelIncr;
     if (++j == outSizeY)
     {
       j = 0;
-      offset += filePlaneIncr - outSizeY*fileRowIncr;
+      offset += filePlaneIncr - outSizeY*shrink[1]*fileRowIncr;
       // back up for next plane (R, G, or B) if planar mode
       ptr -= planarOffset;
       if (++p == planarSize)
@@ -1325,10 +1712,11 @@ int vtkNIFTIImageReader::RequestData(
         p = 0;
         ptr += planarEndOffset; // advance to start of next slice
         ptr -= 2*sliceOffset; // for reverse slice order
+        offset += (shrink[2] - 1)*fileSliceIncr; // skip unread slices
         if (++k == outSizeZ)
         {
           k = 0;
-          offset += fileVectorIncr - outSizeZ*fileSliceIncr;
+          offset += fileVectorIncr - outSizeZ*shrink[2]*fileSliceIncr;
           if (++t == timeDim)
           {
             t = 0;
@@ -1354,12 +1742,19 @@ int vtkNIFTIImageReader::RequestData(
     }
   }
 
-  if (vectorDim > 1 || planarRGB)
+  if (!readDirect)
   {
     delete [] rowBuffer;
   }
 
-  gzclose(file);
+  if (index)
+  {
+    index->Close();
+  }
+  else
+  {
+    gzclose(file);
+  }
 
   if (errorCode)
   {
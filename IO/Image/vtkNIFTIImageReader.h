@@ -25,6 +25,14 @@
  * first image in the time series will be read, but the TimeAsVector
  * flag can be set to read the time steps as vector components.  Files in
  * Analyze 7.5 format are also supported by this reader.
+ *
+ * Only the requested update extent is read from the file, so that a slab
+ * of a large volume can be read on its own.  For files ending in .gz, the
+ * state of the decompression is saved at regular intervals of the file
+ * while it is read, so that later requests for other extents of the same
+ * file restart the decompression close to the extent rather than at the
+ * start of the file.  The ShrinkFactors can be set to read every n-th
+ * voxel along each axis, for example to quickly show a preview.
  * @par Thanks:
  * This class was contributed to VTK by the Calgary Image Processing and
  * Analysis Centre (CIPAC).
@@ -90,6 +98,16 @@ public:
   vtkBooleanMacro(TimeAsVector, bool);
   //@}
 
+  //@{
+  /**
+   * Read every n-th voxel along each axis (default: 1, 1, 1).  The output
+   * extent is reduced and the spacing multiplied by these factors, and the
+   * first voxel of each axis is always read.  The voxels are not averaged.
+   */
+  vtkGetVector3Macro(ShrinkFactors, int);
+  vtkSetVector3Macro(ShrinkFactors, int);
+  //@}
+
   /**
    * Get the time dimension that was stored in the NIFTI header.
    */
@@ -258,6 +276,17 @@ protected:
    */
   bool PlanarRGB;
 
+  /**
+   * The factors by which each axis is subsampled.
+   */
+  int ShrinkFactors[3];
+
+  /**
+   * Access points into the compressed file that was most recently read.
+   */
+  class GZIndexInternal;
+  GZIndexInternal *GZIndex;
+
 private:
   vtkNIFTIImageReader(const vtkNIFTIImageReader&) = delete;
   void operator=(const vtkNIFTIImageReader&) = delete;
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLASReaderSubsampling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads a LAS file in pieces, with every other point, inside bounds and by
+// voxels, and checks the points read against the points of the whole file.
+
+#include "vtkLASReader.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+int TestLASReaderSubsampling(int argc, char* argv[])
+{
+  char* fileName = vtkTestUtilities::ExpandDataFileName(argc, argv, "Data/test_1.las");
+  vtkNew<vtkLASReader> reader;
+  reader->SetFileName(fileName);
+  delete[] fileName;
+  reader->Update();
+  vtkNew<vtkPolyData> whole;
+  whole->DeepCopy(reader->GetOutput());
+  const vtkIdType numPoints = whole->GetNumberOfPoints();
+  if (numPoints < 10 || whole->GetNumberOfVerts() != numPoints)
+  {
+    std::cerr << "Expected points with one vertex each\n";
+    return EXIT_FAILURE;
+  }
+
+  // The pieces hold all the points, in order.
+  const int numPieces = 3;
+  vtkIdType point = 0;
+  for (int piece = 0; piece < numPieces; piece++)
+  {
+    reader->UpdatePiece(piece, numPieces, 0);
+    vtkPolyData* output = reader->GetOutput();
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++, point++)
+    {
+      double p[3], q[3];
+      output->GetPoint(i, p);
+      whole->GetPoint(point, q);
+      if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2] ||
+        output->GetPointData()->GetArray("intensity")->GetTuple1(i) !=
+          whole->GetPointData()->GetArray("intensity")->GetTuple1(point))
+      {
+        std::cerr << "Wrong point " << i << " in piece " << piece << "\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (point != numPoints)
+  {
+    std::cerr << "The pieces hold " << point << " points instead of " << numPoints << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Every other point, whatever the pieces.
+  reader->SetOnRatio(2);
+  point = 0;
+  for (int piece = 0; piece < numPieces; piece++)
+  {
+    reader->UpdatePiece(piece, numPieces, 0);
+    vtkPolyData* output = reader->GetOutput();
+    for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++, point += 2)
+    {
+      double p[3], q[3];
+      output->GetPoint(i, p);
+      whole->GetPoint(point, q);
+      if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+      {
+        std::cerr << "Wrong point " << i << " in piece " << piece << " with OnRatio 2\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (point != 2 * ((numPoints + 1) / 2))
+  {
+    std::cerr << "Wrong number of points with OnRatio 2\n";
+    return EXIT_FAILURE;
+  }
+  reader->SetOnRatio(1);
+
+  // The points inside the lower half of the bounds.
+  double bounds[6];
+  whole->GetBounds(bounds);
+  bounds[1] = (bounds[0] + bounds[1]) / 2;
+  vtkIdType numInside = 0;
+  for (vtkIdType i = 0; i < numPoints; i++)
+  {
+    double q[3];
+    whole->GetPoint(i, q);
+    numInside += q[0] <= bounds[1] ? 1 : 0;
+  }
+  reader->SetReadBounds(bounds);
+  reader->UseReadBoundsOn();
+  reader->UpdatePiece(0, 1, 0);
+  vtkPolyData* output = reader->GetOutput();
+  if (output->GetNumberOfPoints() != numInside || output->GetBounds()[1] > bounds[1])
+  {
+    std::cerr << output->GetNumberOfPoints() << " points inside the bounds instead of "
+              << numInside << "\n";
+    return EXIT_FAILURE;
+  }
+  reader->UseReadBoundsOff();
+
+  // At most one point per voxel, the first one read, so that the points are
+  // a subsequence of the points of the file.
+  reader->SetVoxelSize((bounds[1] - bounds[0]) / 4);
+  reader->Update();
+  output = reader->GetOutput();
+  point = 0;
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); i++, point++)
+  {
+    double p[3], q[3];
+    output->GetPoint(i, p);
+    for (whole->GetPoint(point, q); point < numPoints - 1 &&
+         (p[0] != q[0] || p[1] != q[1] || p[2] != q[2]);
+         whole->GetPoint(++point, q))
+    {
+    }
+    if (p[0] != q[0] || p[1] != q[1] || p[2] != q[2])
+    {
+      std::cerr << "Point " << i << " read with voxels is not in the file\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (output->GetNumberOfPoints() == 0 || output->GetNumberOfPoints() >= numPoints)
+  {
+    std::cerr << "Wrong number of points with voxels: " << output->GetNumberOfPoints() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
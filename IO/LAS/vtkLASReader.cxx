@@ -16,29 +16,55 @@
 #include "vtkLASReader.h"
 
 #include <vtkCellArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkInformation.h>
 #include <vtkInformationVector.h>
+#include <vtkMath.h>
 #include <vtkNew.h>
 #include <vtkObjectFactory.h>
 #include <vtkPoints.h>
 #include <vtkPointData.h>
 #include <vtkPolyData.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkUnsignedShortArray.h>
-#include <vtkVertexGlyphFilter.h>
 
 #include <liblas/liblas.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fstream>
+#include <functional>
 #include <iostream>
-#include <valarray>
+#include <unordered_set>
 
 vtkStandardNewMacro(vtkLASReader)
 
+namespace
+{
+// The indices of a voxel, hashed rather than combined into a single
+// number, which would overflow for small voxels in large files.
+typedef std::array<vtkTypeUInt64, 3> VoxelIndex;
+
+struct VoxelIndexHash
+{
+  std::size_t operator()(const VoxelIndex& voxel) const
+  {
+    return std::hash<vtkTypeUInt64>()(
+      voxel[0] * 73856093u ^ voxel[1] * 19349663u ^ voxel[2] * 83492791u);
+  }
+};
+}
+
 
 //----------------------------------------------------------------------------
 vtkLASReader::vtkLASReader()
 {
   this->FileName = nullptr;
+  vtkMath::UninitializeBounds(this->ReadBounds);
+  this->UseReadBounds = 0;
+  this->OnRatio = 1;
+  this->VoxelSize = 0.0;
 
   this->SetNumberOfInputPorts(0);
   this->SetNumberOfOutputPorts(1);
@@ -50,6 +76,16 @@ vtkLASReader::~vtkLASReader()
   delete[] this->FileName;
 }
 
+//----------------------------------------------------------------------------
+int vtkLASReader::RequestInformation(vtkInformation* vtkNotUsed(request),
+                                     vtkInformationVector** vtkNotUsed(inputVector),
+                                     vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 int vtkLASReader::RequestData(vtkInformation* vtkNotUsed(request),
                                    vtkInformationVector** vtkNotUsed(request),
@@ -61,6 +97,11 @@ int vtkLASReader::RequestData(vtkInformation* vtkNotUsed(request),
   // Get the output
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
+  int piece = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER()) : 0;
+  int numPieces = outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES())
+    ? outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()) : 1;
+
   // Open LAS File for reading
   std::ifstream ifs;
   ifs.open(this->FileName, std::ios_base::binary | std::ios_base::in);
@@ -75,21 +116,15 @@ int vtkLASReader::RequestData(vtkInformation* vtkNotUsed(request),
   liblas::ReaderFactory readerFactory;
   liblas::Reader reader = readerFactory.CreateWithStream(ifs);
 
-  vtkNew<vtkPolyData> pointsPolyData;
-  this->ReadPointRecordData(reader, pointsPolyData);
+  this->ReadPointRecordData(reader, output, piece, numPieces);
   ifs.close();
 
-  // Convert points to verts in output polydata
-  vtkNew<vtkVertexGlyphFilter> vertexFilter;
-  vertexFilter->SetInputData(pointsPolyData);
-  vertexFilter->Update();
-  output->ShallowCopy(vertexFilter->GetOutput());
-
   return VTK_OK;
 }
 
 //----------------------------------------------------------------------------
-void vtkLASReader::ReadPointRecordData(liblas::Reader &reader, vtkPolyData* pointsPolyData)
+void vtkLASReader::ReadPointRecordData(liblas::Reader &reader, vtkPolyData* pointsPolyData,
+                                       int piece, int numPieces)
 {
   vtkNew<vtkPoints> points;
   // scalars associated with points
@@ -104,72 +139,151 @@ void vtkLASReader::ReadPointRecordData(liblas::Reader &reader, vtkPolyData* poin
   intensity->SetNumberOfComponents(1);
 
   liblas::Header header = liblas::Header(reader.GetHeader());
-  std::valarray<double> scale = {
-    header.GetScaleX(), header.GetScaleY(), header.GetScaleZ()
-  };
-  std::valarray<double> offset = {
-    header.GetOffsetX(), header.GetOffsetY(), header.GetOffsetZ()
-  };
   liblas::PointFormatName pointFormat = header.GetDataFormatId();
-  int pointRecordsCount = header.GetPointRecordsCount();
+  const bool hasColor = pointFormat == liblas::ePointFormat2 ||
+    pointFormat == liblas::ePointFormat3 || pointFormat == liblas::ePointFormat5;
+  const bool hasClassification = pointFormat == liblas::ePointFormat0 ||
+    pointFormat == liblas::ePointFormat1;
 
-  for ( int i= 0; i < pointRecordsCount && reader.ReadNextPoint(); i++)
+  // The share of the point records of this piece.
+  const vtkIdType pointRecordsCount = static_cast<vtkIdType>(header.GetPointRecordsCount());
+  vtkIdType start = 0;
+  vtkIdType end = pointRecordsCount;
+  if (numPieces > 1 && piece >= 0 && piece < numPieces)
   {
+    start = pointRecordsCount * piece / numPieces;
+    end = pointRecordsCount * (piece + 1) / numPieces;
+  }
+  else if (piece != 0)
+  {
+    start = end;
+  }
+
+  // Nothing to read when the bounds of the file are outside of ReadBounds.
+  const double fileBounds[6] = { header.GetMinX(), header.GetMaxX(), header.GetMinY(),
+    header.GetMaxY(), header.GetMinZ(), header.GetMaxZ() };
+  const double* bounds = this->ReadBounds;
+  if (this->UseReadBounds &&
+    (fileBounds[0] > bounds[1] || fileBounds[1] < bounds[0] || fileBounds[2] > bounds[3] ||
+      fileBounds[3] < bounds[2] || fileBounds[4] > bounds[5] || fileBounds[5] < bounds[4]))
+  {
+    start = end;
+  }
+
+  // The first record of the piece read with OnRatio.
+  const vtkIdType onRatio = this->OnRatio;
+  const vtkIdType first = (start + onRatio - 1) / onRatio * onRatio;
+  if (first < end && !reader.Seek(static_cast<std::size_t>(first)))
+  {
+    vtkErrorMacro(<< "Unable to seek to point record " << first << " of " << this->FileName);
+    start = end;
+  }
+
+  // Without spatial filtering, the number of points is known beforehand.
+  const vtkIdType maxNumberOfPoints = first < end ? (end - first - 1) / onRatio + 1 : 0;
+  const bool voxels = this->VoxelSize > 0.0;
+  if (!this->UseReadBounds && !voxels)
+  {
+    points->Allocate(maxNumberOfPoints);
+    intensity->Allocate(maxNumberOfPoints);
+    if (hasColor)
+    {
+      color->Allocate(3 * maxNumberOfPoints);
+    }
+    else if (hasClassification)
+    {
+      classification->Allocate(maxNumberOfPoints);
+    }
+  }
+
+  // The voxels are indexed from the minimum of the bounds of the file, with
+  // at most VTK_TYPE_INT64_MAX voxels along each axis.
+  std::unordered_set<VoxelIndex, VoxelIndexHash> filledVoxels;
+  double voxelDims[3] = { 1.0, 1.0, 1.0 };
+  if (voxels)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      voxelDims[j] = std::min(
+        std::floor((fileBounds[2 * j + 1] - fileBounds[2 * j]) / this->VoxelSize) + 1.0,
+        static_cast<double>(VTK_TYPE_INT64_MAX));
+    }
+  }
+
+  for (vtkIdType i = first; i < end && reader.ReadNextPoint(); i++)
+  {
+    if ((i - first) % onRatio)
+    {
+      continue;
+    }
     liblas::Point const& p = reader.GetPoint();
-    std::valarray<double> lasPoint = {
-      p.GetX(), p.GetY(), p.GetZ()
-    };
-    points->InsertNextPoint(&lasPoint[0]);
-    //std::valarray<double> point = lasPoint * scale + offset;
-    // We have seen a file where the scaled points were much smaller than the offset
-    // So, all points ended up in the same place.
-    std::valarray<double> point = lasPoint * scale;
-    switch(pointFormat)
+    const double point[3] = { p.GetX(), p.GetY(), p.GetZ() };
+    if (this->UseReadBounds &&
+      (point[0] < bounds[0] || point[0] > bounds[1] || point[1] < bounds[2] ||
+        point[1] > bounds[3] || point[2] < bounds[4] || point[2] > bounds[5]))
     {
-    case liblas::ePointFormat2:
-    case liblas::ePointFormat3:
-    case liblas::ePointFormat5:
+      continue;
+    }
+    if (voxels)
+    {
+      VoxelIndex voxel;
+      for (int j = 0; j < 3; j++)
       {
-        unsigned short c[3];
-        c[0] = p.GetColor().GetRed();
-        c[1] = p.GetColor().GetGreen();
-        c[2] = p.GetColor().GetBlue();
-        color->InsertNextTypedTuple(c);
-        intensity->InsertNextValue(p.GetIntensity());
+        // Points outside of the bounds of the header go to its border voxels.
+        double index = std::floor((point[j] - fileBounds[2 * j]) / this->VoxelSize);
+        index = !(index > 0.0) ? 0.0 : (index >= voxelDims[j] ? voxelDims[j] - 1.0 : index);
+        voxel[j] = static_cast<vtkTypeUInt64>(index);
       }
-      break;
+      if (!filledVoxels.insert(voxel).second)
+      {
+        continue;
+      }
+    }
 
-    case liblas::ePointFormat0:
-    case liblas::ePointFormat1:
+    points->InsertNextPoint(point);
+    intensity->InsertNextValue(p.GetIntensity());
+    if (hasColor)
+    {
+      unsigned short c[3];
+      c[0] = p.GetColor().GetRed();
+      c[1] = p.GetColor().GetGreen();
+      c[2] = p.GetColor().GetBlue();
+      color->InsertNextTypedTuple(c);
+    }
+    else if (hasClassification)
+    {
       classification->InsertNextValue(p.GetClassification().GetClass());
-      intensity->InsertNextValue(p.GetIntensity());
-      break;
-
-    case liblas::ePointFormatUnknown:
-    default:
-      intensity->InsertNextValue(p.GetIntensity());
-      break;
     }
   }
+  points->Squeeze();
+  intensity->Squeeze();
+  color->Squeeze();
+  classification->Squeeze();
+
+  // One vertex per point, built directly rather than with
+  // vtkVertexGlyphFilter to avoid copying the points.
+  const vtkIdType numberOfPoints = points->GetNumberOfPoints();
+  vtkNew<vtkIdTypeArray> vertices;
+  vertices->SetNumberOfValues(2 * numberOfPoints);
+  vtkIdType* vertex = vertices->GetPointer(0);
+  for (vtkIdType i = 0; i < numberOfPoints; i++)
+  {
+    *vertex++ = 1;
+    *vertex++ = i;
+  }
+  vtkNew<vtkCellArray> verts;
+  verts->SetCells(numberOfPoints, vertices);
 
   pointsPolyData->SetPoints(points);
+  pointsPolyData->SetVerts(verts);
   pointsPolyData->GetPointData()->AddArray(intensity);
-  switch(pointFormat)
+  if (hasColor)
   {
-  case liblas::ePointFormat2:
-  case liblas::ePointFormat3:
-  case liblas::ePointFormat5:
     pointsPolyData->GetPointData()->AddArray(color);
-    break;
-
-  case liblas::ePointFormat0:
-  case liblas::ePointFormat1:
+  }
+  else if (hasClassification)
+  {
     pointsPolyData->GetPointData()->AddArray(classification);
-    break;
-
-  case liblas::ePointFormatUnknown:
-  default:
-    break;
   }
 }
 
@@ -178,5 +292,11 @@ void vtkLASReader::PrintSelf(ostream &os, vtkIndent indent)
 {
   Superclass::PrintSelf(os, indent);
   os << "vtkLASReader" << std::endl;
-  os << "Filename: " << this->FileName << std::endl;
+  os << "Filename: " << (this->FileName ? this->FileName : "(none)") << std::endl;
+  os << indent << "ReadBounds: " << this->ReadBounds[0] << " " << this->ReadBounds[1] << " "
+     << this->ReadBounds[2] << " " << this->ReadBounds[3] << " " << this->ReadBounds[4] << " "
+     << this->ReadBounds[5] << std::endl;
+  os << indent << "UseReadBounds: " << this->UseReadBounds << std::endl;
+  os << indent << "OnRatio: " << this->OnRatio << std::endl;
+  os << indent << "VoxelSize: " << this->VoxelSize << std::endl;
 }
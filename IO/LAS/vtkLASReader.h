@@ -23,6 +23,13 @@
  * "classification": vtkUnsignedCharArray (optional)
  * "color": vtkUnsignedShortArray (optional)
  *
+ * Points can be filtered while they are read, so that large files need not
+ * fit in memory: only points inside ReadBounds are kept when UseReadBounds
+ * is on, only every OnRatio'th point record is read, and the first point of
+ * each voxel of size VoxelSize is kept when VoxelSize is positive. The
+ * reader also handles piece requests by reading an equal share of the point
+ * records for each piece, so that the file can be streamed through the
+ * pipeline. Voxels are subsampled within each piece.
  *
  * @sa
  * vtkPolyData
@@ -56,10 +63,48 @@ public:
   vtkSetStringMacro(FileName);
   vtkGetStringMacro(FileName);
 
+  //@{
+  /**
+   * Only read the points inside ReadBounds (xmin, xmax, ymin, ymax, zmin,
+   * zmax) when UseReadBounds is on. Off by default.
+   */
+  vtkSetVector6Macro(ReadBounds, double);
+  vtkGetVector6Macro(ReadBounds, double);
+  vtkSetMacro(UseReadBounds, vtkTypeBool);
+  vtkGetMacro(UseReadBounds, vtkTypeBool);
+  vtkBooleanMacro(UseReadBounds, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Only read every OnRatio'th point record of the file. The records are
+   * counted from the start of the file, so that the same points are read
+   * whatever the number of pieces. 1 by default, which reads every point.
+   */
+  vtkSetClampMacro(OnRatio, int, 1, VTK_INT_MAX);
+  vtkGetMacro(OnRatio, int);
+  //@}
+
+  //@{
+  /**
+   * When positive, only keep the first point read in each cubic voxel of
+   * this size, the voxels starting at the minimum of the bounds of the
+   * file. 0 by default, which keeps every point.
+   */
+  vtkSetClampMacro(VoxelSize, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(VoxelSize, double);
+  //@}
+
 protected:
   vtkLASReader();
   virtual ~vtkLASReader();
 
+  /**
+   * Announce that pieces of the point records can be read
+   */
+  int RequestInformation(vtkInformation* request, vtkInformationVector** inputVector,
+                         vtkInformationVector* outputVector) override;
+
   /**
    * Core implementation of the data set reader
    */
@@ -67,11 +112,17 @@ protected:
                   vtkInformationVector* outputVector) override;
 
   /**
-   * Read point record data i.e. position and visualisation data
+   * Read point record data i.e. position and visualisation data, for the
+   * given piece of the point records
    */
-  void ReadPointRecordData(liblas::Reader &reader, vtkPolyData* pointsPolyData);
+  void ReadPointRecordData(liblas::Reader &reader, vtkPolyData* pointsPolyData,
+                           int piece = 0, int numPieces = 1);
 
   char* FileName;
+  double ReadBounds[6];
+  vtkTypeBool UseReadBounds;
+  int OnRatio;
+  double VoxelSize;
 };
 
 #endif // vtkLASReader_h
@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIParsing.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reads ASCII legacy files with and without ParallelASCIIParsing and checks
+// that the values are those of strtod/strtof, including values that are not
+// parsed by the fast path. Also checks that ASCII files written by
+// vtkPolyDataWriter read back as the same values.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataReader.h"
+#include "vtkPolyDataWriter.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const char* const TOKENS[] = { "0", "-0", "+3", ".5", "5.", "0.1", "1e5", "1E-5", "2.5e+3",
+  "123456789012345678901234567890", "0.000000000000000000000000000123",
+  "1.7976931348623157e308", "2.2250738585072014e-308", "4.9e-324", "1e-310",
+  "9007199254740993", "3.14159265358979323846264338327950288", "1e22", "1e23", "-1e-22",
+  "0.30000000000000004", "16777217", "1e-45" };
+const int NUMBER_OF_TOKENS = sizeof(TOKENS) / sizeof(TOKENS[0]);
+
+std::string Header(vtkIdType numPoints)
+{
+  std::ostringstream os;
+  os << "# vtk DataFile Version 4.2\nASCII parsing\nASCII\nDATASET POLYDATA\nPOINTS "
+     << numPoints << " double\n";
+  return os.str();
+}
+
+vtkPolyData* Read(const std::string& content, bool parallel, vtkPolyDataReader* reader)
+{
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(content);
+  reader->SetParallelASCIIParsing(parallel);
+  reader->Update();
+  return reader->GetOutput();
+}
+
+// Tokens that need the slow path, as point coordinates and as float scalars.
+int TestTokens(bool parallel)
+{
+  const vtkIdType numPoints = NUMBER_OF_TOKENS;
+  std::ostringstream os;
+  os << Header(numPoints);
+  for (int i = 0; i < NUMBER_OF_TOKENS; ++i)
+  {
+    os << TOKENS[i] << " 0\t" << TOKENS[NUMBER_OF_TOKENS - 1 - i] << (i % 2 ? "\r\n" : " ");
+  }
+  os << "\nPOINT_DATA " << numPoints << "\nSCALARS values float\nLOOKUP_TABLE default\n";
+  for (int i = 0; i < NUMBER_OF_TOKENS; ++i)
+  {
+    os << TOKENS[i] << "\n";
+  }
+
+  vtkNew<vtkPolyDataReader> reader;
+  vtkPolyData* output = Read(os.str(), parallel, reader);
+  vtkDataArray* values = output->GetPointData()->GetScalars();
+  if (output->GetNumberOfPoints() != numPoints || !values ||
+    values->GetNumberOfTuples() != numPoints)
+  {
+    std::cerr << "Tokens: wrong output\n";
+    return 1;
+  }
+  int errors = 0;
+  for (int i = 0; i < NUMBER_OF_TOKENS; ++i)
+  {
+    double p[3];
+    output->GetPoint(i, p);
+    double x = strtod(TOKENS[i], nullptr);
+    double z = strtod(TOKENS[NUMBER_OF_TOKENS - 1 - i], nullptr);
+    float v = strtof(TOKENS[i], nullptr);
+    if (p[0] != x || p[1] != 0.0 || p[2] != z || static_cast<float>(values->GetTuple1(i)) != v)
+    {
+      std::cerr << "Tokens: wrong value for " << TOKENS[i] << "\n";
+      ++errors;
+    }
+  }
+  return errors;
+}
+
+// A file spanning several blocks of the stream, with integers and cells
+// after the points.
+int TestLargeFile()
+{
+  const vtkIdType numPoints = 200000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  std::vector<double> coordinates(3 * numPoints);
+  for (double& x : coordinates)
+  {
+    random->Next();
+    x = random->GetRangeValue(-1e3, 1e3);
+  }
+
+  std::ostringstream os;
+  os << Header(numPoints);
+  char buffer[32];
+  for (vtkIdType i = 0; i < 3 * numPoints; ++i)
+  {
+    snprintf(buffer, sizeof(buffer), "%.17g", coordinates[i]);
+    os << buffer << (i % 9 == 8 ? "\n" : " ");
+  }
+  const vtkIdType numLines = numPoints - 1;
+  os << "\nLINES " << numLines << " " << 3 * numLines << "\n";
+  for (vtkIdType i = 0; i < numLines; ++i)
+  {
+    os << "2 " << i << " " << i + 1 << "\n";
+  }
+  os << "POINT_DATA " << numPoints << "\nSCALARS ids int\nLOOKUP_TABLE default\n";
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    os << -i << (i % 10 == 9 ? "\n" : " ");
+  }
+  const std::string content = os.str();
+
+  int errors = 0;
+  for (int parallel = 0; parallel < 2; ++parallel)
+  {
+    vtkNew<vtkPolyDataReader> reader;
+    vtkPolyData* output = Read(content, parallel != 0, reader);
+    vtkDataArray* ids = output->GetPointData()->GetScalars();
+    if (output->GetNumberOfPoints() != numPoints || output->GetNumberOfLines() != numLines ||
+      !ids || ids->GetNumberOfTuples() != numPoints)
+    {
+      std::cerr << "Large file: wrong output, parallel " << parallel << "\n";
+      ++errors;
+      continue;
+    }
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      double p[3];
+      output->GetPoint(i, p);
+      if (p[0] != coordinates[3 * i] || p[1] != coordinates[3 * i + 1] ||
+        p[2] != coordinates[3 * i + 2] || ids->GetTuple1(i) != -i)
+      {
+        std::cerr << "Large file: wrong point " << i << ", parallel " << parallel << "\n";
+        ++errors;
+        break;
+      }
+    }
+    vtkIdType npts, *pts;
+    output->GetLines()->InitTraversal();
+    for (vtkIdType i = 0; output->GetLines()->GetNextCell(npts, pts); ++i)
+    {
+      if (npts != 2 || pts[0] != i || pts[1] != i + 1)
+      {
+        std::cerr << "Large file: wrong line " << i << ", parallel " << parallel << "\n";
+        ++errors;
+        break;
+      }
+    }
+  }
+  return errors;
+}
+
+// Floats and doubles written to ASCII files round trip exactly.
+int TestRoundTrip()
+{
+  const vtkIdType numPoints = 10000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+  vtkNew<vtkFloatArray> floats;
+  floats->SetName("floats");
+  floats->SetNumberOfComponents(3);
+  floats->SetNumberOfTuples(numPoints);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("doubles");
+  doubles->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      random->Next();
+      floats->SetTypedComponent(i, c, static_cast<float>(random->GetRangeValue(-1.0, 1.0)));
+    }
+    random->Next();
+    doubles->SetValue(i, random->GetRangeValue(-1e-5, 1e5) * (i % 7 ? 1.0 : 1e300));
+  }
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  points->SetData(floats);
+  polyData->SetPoints(points);
+  polyData->GetPointData()->AddArray(doubles);
+
+  vtkNew<vtkPolyDataWriter> writer;
+  writer->SetInputData(polyData);
+  writer->SetFileTypeToASCII();
+  writer->WriteToOutputStringOn();
+  writer->Write();
+
+  vtkNew<vtkPolyDataReader> reader;
+  vtkPolyData* output = Read(writer->GetOutputStdString(), false, reader);
+  vtkDataArray* readFloats = output->GetPoints() ? output->GetPoints()->GetData() : nullptr;
+  vtkDataArray* readDoubles = output->GetPointData()->GetArray("doubles");
+  if (!readFloats || readFloats->GetNumberOfTuples() != numPoints || !readDoubles ||
+    readDoubles->GetNumberOfTuples() != numPoints)
+  {
+    std::cerr << "Round trip: wrong output\n";
+    return 1;
+  }
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+    {
+      if (static_cast<float>(readFloats->GetComponent(i, c)) != floats->GetTypedComponent(i, c))
+      {
+        std::cerr << "Round trip: wrong float " << i << "\n";
+        return 1;
+      }
+    }
+    if (readDoubles->GetComponent(i, 0) != doubles->GetValue(i))
+    {
+      std::cerr << "Round trip: wrong double " << i << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestLegacyASCIIParsing(int, char*[])
+{
+  int errors = TestTokens(false);
+  errors += TestTokens(true);
+  errors += TestLargeFile();
+  errors += TestRoundTrip();
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
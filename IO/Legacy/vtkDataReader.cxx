@@ -43,6 +43,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -59,7 +60,11 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <cctype>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
@@ -68,6 +73,412 @@
 // so it would be nice to put this in a common file.
 static int my_getline(istream& stream, vtkStdString &output, char delim='\n');
 
+namespace
+{
+// Number parsing for ASCII files, without the overhead of the stream
+// operators. A token is a sequence of non-whitespace characters; parsing
+// fails unless the whole token is a number.
+inline bool IsSpace(int c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+inline bool IsDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+template <typename T>
+bool ParseNumber(const char* begin, const char* end, T& value, std::false_type)
+{
+  bool negative = false;
+  if (begin != end && (*begin == '-' || *begin == '+'))
+  {
+    negative = (*begin == '-');
+    ++begin;
+  }
+  if (begin == end)
+  {
+    return false;
+  }
+  unsigned long long magnitude = 0;
+  for (; begin != end; ++begin)
+  {
+    if (!IsDigit(*begin))
+    {
+      return false;
+    }
+    magnitude = 10 * magnitude + static_cast<unsigned long long>(*begin - '0');
+  }
+  // Small types are read as int and then cast, as with operator>>.
+  value = negative ? static_cast<T>(-static_cast<long long>(magnitude)) : static_cast<T>(magnitude);
+  return true;
+}
+
+// Decimal numbers with a short mantissa and a small exponent are exactly
+// rounded with a single multiplication or division (Clinger's fast path);
+// the others, including nan and inf, are parsed by strtod/strtof.
+template <typename T>
+struct FloatParsing;
+
+template <>
+struct FloatParsing<float>
+{
+  static const unsigned long long MaxMantissa = 1ull << 24;
+  static const int MaxExponent = 10;
+  static float Parse(const char* str, char** end) { return strtof(str, end); }
+};
+
+template <>
+struct FloatParsing<double>
+{
+  static const unsigned long long MaxMantissa = 1ull << 53;
+  static const int MaxExponent = 22;
+  static double Parse(const char* str, char** end) { return strtod(str, end); }
+};
+
+template <typename T>
+bool ParseNumber(const char* begin, const char* end, T& value, std::true_type)
+{
+  static const T powersOf10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  const char* p = begin;
+  bool negative = false;
+  if (p != end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+  unsigned long long mantissa = 0;
+  int numDigits = 0; // significant digits in mantissa
+  int exponent = 0;
+  bool exact = true;
+  bool hasDigits = false;
+  for (; p != end && IsDigit(*p); ++p)
+  {
+    hasDigits = true;
+    if (numDigits < 19)
+    {
+      mantissa = 10 * mantissa + static_cast<unsigned long long>(*p - '0');
+      numDigits += (mantissa != 0);
+    }
+    else
+    {
+      exact = false;
+    }
+  }
+  if (p != end && *p == '.')
+  {
+    for (++p; p != end && IsDigit(*p); ++p)
+    {
+      hasDigits = true;
+      if (numDigits < 19)
+      {
+        mantissa = 10 * mantissa + static_cast<unsigned long long>(*p - '0');
+        numDigits += (mantissa != 0);
+        --exponent;
+      }
+      else
+      {
+        exact = false;
+      }
+    }
+  }
+  if (hasDigits && p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p != end && (*p == '-' || *p == '+'))
+    {
+      negativeExponent = (*p == '-');
+      ++p;
+    }
+    int e = 0;
+    bool hasExponentDigits = false;
+    for (; p != end && IsDigit(*p); ++p)
+    {
+      hasExponentDigits = true;
+      e = (e < 100000 ? 10 * e + (*p - '0') : e);
+    }
+    exact = exact && hasExponentDigits;
+    exponent += (negativeExponent ? -e : e);
+  }
+
+  if (hasDigits && exact && p == end && mantissa <= FloatParsing<T>::MaxMantissa &&
+    exponent >= -FloatParsing<T>::MaxExponent && exponent <= FloatParsing<T>::MaxExponent)
+  {
+    T result = static_cast<T>(mantissa);
+    result = (exponent < 0 ? result / powersOf10[-exponent] : result * powersOf10[exponent]);
+    value = (negative ? -result : result);
+    return true;
+  }
+
+  // Slow path
+  std::string token(begin, end);
+  char* parsedEnd;
+  value = FloatParsing<T>::Parse(token.c_str(), &parsedEnd);
+  return !token.empty() && parsedEnd == token.c_str() + token.size();
+}
+
+template <typename T>
+bool ParseToken(const char* begin, const char* end, T& value)
+{
+  return ParseNumber(begin, end, value, typename std::is_floating_point<T>::type());
+}
+
+// Read the next value directly from the stream buffer.
+template <typename T>
+int ReadASCIIValue(istream* is, T* value)
+{
+  if (!*is)
+  {
+    return 0;
+  }
+  std::streambuf* buffer = is->rdbuf();
+  typedef std::char_traits<char> traits;
+  int c = buffer->sgetc();
+  while (c != traits::eof() && IsSpace(c))
+  {
+    c = buffer->snextc();
+  }
+  char token[256];
+  size_t length = 0;
+  while (c != traits::eof() && !IsSpace(c) && length < sizeof(token))
+  {
+    token[length++] = static_cast<char>(c);
+    c = buffer->snextc();
+  }
+  if (c == traits::eof())
+  {
+    is->setstate(std::ios::eofbit);
+  }
+  if (length == 0 || length == sizeof(token) || !ParseToken(token, token + length, *value))
+  {
+    is->setstate(std::ios::failbit);
+    return 0;
+  }
+  return 1;
+}
+
+// Parse up to maxValues values from [begin, end), which must not end in
+// the middle of a token. Returns the number of values parsed, or -1 if a
+// token is not a number, and sets stop after the last token parsed.
+template <typename T>
+vtkIdType ParseASCIIRange(
+  const char* begin, const char* end, T* data, vtkIdType maxValues, const char** stop)
+{
+  vtkIdType numValues = 0;
+  const char* p = begin;
+  while (numValues < maxValues)
+  {
+    while (p != end && IsSpace(*p))
+    {
+      ++p;
+    }
+    if (p == end)
+    {
+      break;
+    }
+    const char* tokenEnd = p;
+    while (tokenEnd != end && !IsSpace(*tokenEnd))
+    {
+      ++tokenEnd;
+    }
+    if (!ParseToken(p, tokenEnd, data[numValues]))
+    {
+      *stop = p;
+      return -1;
+    }
+    ++numValues;
+    p = tokenEnd;
+  }
+  *stop = p;
+  return numValues;
+}
+
+// Parses the pieces of a block in two parallel passes: count the tokens of
+// each piece to know where its values go, then parse them.
+template <typename T>
+struct ParallelASCIIParser
+{
+  const char* Begin;
+  std::vector<const char*> PieceStarts; // one more than the pieces
+  std::vector<vtkIdType> Offsets;       // first value of each piece
+  std::vector<const char*> Stops;
+  std::vector<unsigned char> Failed;
+  T* Data;
+  vtkIdType MaxValues;
+
+  void Split(const char* begin, const char* end, size_t numPieces)
+  {
+    this->Begin = begin;
+    this->PieceStarts.assign(1, begin);
+    for (size_t i = 1; i < numPieces; ++i)
+    {
+      const char* p = begin + (end - begin) * i / numPieces;
+      p = std::max(p, this->PieceStarts.back());
+      while (p != end && !IsSpace(*p))
+      {
+        ++p;
+      }
+      this->PieceStarts.push_back(p);
+    }
+    this->PieceStarts.push_back(end);
+    this->Offsets.assign(numPieces + 1, 0);
+    this->Stops.assign(numPieces, end);
+    this->Failed.assign(numPieces, 0);
+  }
+
+  size_t GetNumberOfPieces() const { return this->PieceStarts.size() - 1; }
+
+  void Count(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType piece = first; piece < last; ++piece)
+    {
+      vtkIdType count = 0;
+      bool inToken = false;
+      for (const char* p = this->PieceStarts[piece]; p != this->PieceStarts[piece + 1]; ++p)
+      {
+        bool space = IsSpace(*p);
+        count += (!space && !inToken);
+        inToken = !space;
+      }
+      this->Offsets[piece + 1] = count;
+    }
+  }
+
+  void Parse(vtkIdType first, vtkIdType last)
+  {
+    for (vtkIdType piece = first; piece < last; ++piece)
+    {
+      vtkIdType offset = this->Offsets[piece];
+      if (offset >= this->MaxValues)
+      {
+        continue;
+      }
+      vtkIdType numValues = std::min(this->Offsets[piece + 1], this->MaxValues) - offset;
+      if (ParseASCIIRange(this->PieceStarts[piece], this->PieceStarts[piece + 1],
+            this->Data + offset, numValues, &this->Stops[piece]) != numValues)
+      {
+        this->Failed[piece] = 1;
+      }
+    }
+  }
+
+  vtkIdType Execute(T* data, vtkIdType maxValues, const char** stop)
+  {
+    const vtkIdType numPieces = static_cast<vtkIdType>(this->GetNumberOfPieces());
+    vtkSMPTools::For(
+      0, numPieces, [this](vtkIdType first, vtkIdType last) { this->Count(first, last); });
+    for (vtkIdType piece = 0; piece < numPieces; ++piece)
+    {
+      this->Offsets[piece + 1] += this->Offsets[piece];
+    }
+    this->Data = data;
+    this->MaxValues = maxValues;
+    vtkSMPTools::For(
+      0, numPieces, [this](vtkIdType first, vtkIdType last) { this->Parse(first, last); });
+
+    vtkIdType numValues = std::min(this->Offsets[numPieces], maxValues);
+    for (vtkIdType piece = 0; piece < numPieces; ++piece)
+    {
+      if (this->Failed[piece])
+      {
+        return -1;
+      }
+      if (this->Offsets[piece + 1] >= numValues)
+      {
+        // Last piece with values
+        *stop = this->Stops[piece];
+        return numValues;
+      }
+    }
+    *stop = this->PieceStarts[numPieces];
+    return numValues;
+  }
+};
+
+const std::streamsize ASCIIBlockSize = 1 << 22;
+const size_t ASCIIPieceSize = 1 << 16;
+
+// Read numValues values from large blocks of the stream. The stream is
+// positioned after the last value read, so that reading can go on with the
+// stream operators.
+template <typename T>
+int ReadASCIIValues(istream* is, T* data, vtkIdType numValues, bool parallel)
+{
+  std::streampos start = is->tellg();
+  if (start == std::streampos(-1))
+  {
+    // Not seekable: read the values one at a time.
+    for (vtkIdType i = 0; i < numValues; ++i)
+    {
+      if (!ReadASCIIValue(is, data + i))
+      {
+        return 0;
+      }
+    }
+    return 1;
+  }
+
+  std::vector<char> block;
+  ParallelASCIIParser<T> parser;
+  vtkIdType numRead = 0;
+  while (numRead < numValues)
+  {
+    block.resize(static_cast<size_t>(ASCIIBlockSize));
+    is->read(block.data(), ASCIIBlockSize);
+    std::streamsize blockSize = is->gcount();
+    bool atEnd = (blockSize < ASCIIBlockSize);
+    is->clear();
+    if (blockSize == 0)
+    {
+      is->setstate(std::ios::eofbit | std::ios::failbit);
+      return 0;
+    }
+
+    const char* begin = block.data();
+    const char* end = begin + blockSize;
+    if (!atEnd)
+    {
+      // The next block starts with the token cut at the end of this one.
+      while (end != begin && !IsSpace(end[-1]))
+      {
+        --end;
+      }
+      if (end == begin)
+      {
+        is->setstate(std::ios::failbit);
+        return 0;
+      }
+    }
+
+    const char* stop = end;
+    vtkIdType n;
+    size_t numPieces = static_cast<size_t>(end - begin) / ASCIIPieceSize;
+    if (parallel && numPieces > 1)
+    {
+      parser.Split(begin, end, numPieces);
+      n = parser.Execute(data + numRead, numValues - numRead, &stop);
+    }
+    else
+    {
+      n = ParseASCIIRange(begin, end, data + numRead, numValues - numRead, &stop);
+    }
+    if (n < 0 || (n == 0 && atEnd))
+    {
+      is->setstate(std::ios::failbit);
+      return 0;
+    }
+    numRead += n;
+    start += static_cast<std::streamoff>(stop - begin);
+    is->seekg(start);
+  }
+  return 1;
+}
+}
+
 vtkStandardNewMacro(vtkDataReader);
 
 vtkCxxSetObjectMacro(vtkDataReader, InputArray, vtkCharArray);
@@ -126,6 +537,7 @@ vtkDataReader::vtkDataReader()
   this->ReadAllColorScalars = 0;
   this->ReadAllTCoords = 0;
   this->ReadAllFields = 0;
+  this->ParallelASCIIParsing = 0;
   this->FileMajorVersion = 0;
   this->FileMinorVersion = 0;
 
@@ -296,132 +708,126 @@ int vtkDataReader::ReadString(char result[256])
   return 1;
 }
 
-// Internal function to read in an integer value.
+// Internal function to read in a value.
 // Returns zero if there was an error.
 int vtkDataReader::Read(char *result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-
-  *result = (char) intData;
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned char *result)
 {
-  int intData;
-  *this->IS >> intData;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-
-  *result = (unsigned char) intData;
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(short *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned short *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(int *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned int *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(unsigned long long *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(float *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
 }
 
 int vtkDataReader::Read(double *result)
 {
-  *this->IS >> *result;
-  if (this->IS->fail())
-  {
-    return 0;
-  }
-  return 1;
+  return ReadASCIIValue(this->IS, result);
+}
+
+int vtkDataReader::ReadValues(char *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(unsigned char *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(short *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(unsigned short *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(int *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(unsigned int *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(long *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(unsigned long *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(long long *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(unsigned long long *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(float *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
+}
+
+int vtkDataReader::ReadValues(double *data, vtkIdType n)
+{
+  return ReadASCIIValues(this->IS, data, n, this->ParallelASCIIParsing != 0);
 }
 
 size_t vtkDataReader::Peek(char *str, size_t n)
@@ -1496,19 +1902,11 @@ int vtkReadBinaryData(istream *IS, T *data, vtkIdType numTuples, vtkIdType numCo
 template <class T>
 int vtkReadASCIIData(vtkDataReader *self, T *data, vtkIdType numTuples, vtkIdType numComp)
 {
-  vtkIdType i, j;
-
-  for (i=0; i<numTuples; i++)
+  if ( !self->ReadValues(data, numTuples * numComp) )
   {
-    for (j=0; j<numComp; j++)
-    {
-      if ( !self->Read(data++) )
-      {
-        vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
-          "datasize with declaration.");
-        return 0;
-      }
-    }
+    vtkGenericWarningMacro(<<"Error reading ascii data. Possible mismatch of "
+      "datasize with declaration.");
+    return 0;
   }
   return 1;
 }
@@ -3154,7 +3552,6 @@ int vtkDataReader::ReadLutData(vtkDataSetAttributes *a)
 int vtkDataReader::ReadCells(vtkIdType size, int *data)
 {
   char line[256];
-  int i;
 
   if ( this->FileType == VTK_BINARY)
   {
@@ -3172,15 +3569,12 @@ int vtkDataReader::ReadCells(vtkIdType size, int *data)
   }
   else // ascii
   {
-    for (i=0; i<size; i++)
+    if (!this->ReadValues(data, size))
     {
-      if (!this->Read(data+i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
-                      << (fname?fname:"(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<<"Error reading ascii cell data!" << " for file: "
+                    << (fname?fname:"(Null FileName)"));
+      return 0;
     }
   }
 
@@ -3814,6 +4208,8 @@ void vtkDataReader::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << indent << "ReadAllFields: "
      << (this->ReadAllFields ? "On" : "Off") << "\n";
+  os << indent << "ParallelASCIIParsing: "
+     << (this->ParallelASCIIParsing ? "On" : "Off") << "\n";
 
   os << indent << "InputStringLength: " << this->InputStringLength << endl;
 }
@@ -308,6 +308,16 @@ public:
   vtkBooleanMacro(ReadAllFields,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Enable parsing the large numeric sections of ASCII files with several
+   * threads. Off by default.
+   */
+  vtkSetMacro(ParallelASCIIParsing,vtkTypeBool);
+  vtkGetMacro(ParallelASCIIParsing,vtkTypeBool);
+  vtkBooleanMacro(ParallelASCIIParsing,vtkTypeBool);
+  //@}
+
   /**
    * Open a vtk data file. Returns zero if error.
    */
@@ -413,6 +423,27 @@ public:
   int Read(double *);
   //@}
 
+  //@{
+  /**
+   * Internal function to read in @a n values of an ASCII file. The values
+   * are parsed from large blocks of the stream, in parallel if
+   * ParallelASCIIParsing is on, which is much faster than calling Read() for
+   * each value. Returns zero if there was an error.
+   */
+  int ReadValues(char *data, vtkIdType n);
+  int ReadValues(unsigned char *data, vtkIdType n);
+  int ReadValues(short *data, vtkIdType n);
+  int ReadValues(unsigned short *data, vtkIdType n);
+  int ReadValues(int *data, vtkIdType n);
+  int ReadValues(unsigned int *data, vtkIdType n);
+  int ReadValues(long *data, vtkIdType n);
+  int ReadValues(unsigned long *data, vtkIdType n);
+  int ReadValues(long long *data, vtkIdType n);
+  int ReadValues(unsigned long long *data, vtkIdType n);
+  int ReadValues(float *data, vtkIdType n);
+  int ReadValues(double *data, vtkIdType n);
+  //@}
+
   /**
    * Read @a n character from the stream into @a str, then reset the stream
    * position. Returns the number of characters actually read.
@@ -553,6 +584,7 @@ protected:
   vtkTypeBool ReadAllColorScalars;
   vtkTypeBool ReadAllTCoords;
   vtkTypeBool ReadAllFields;
+  vtkTypeBool ParallelASCIIParsing;
   int FileMajorVersion;
   int FileMinorVersion;
 
@@ -43,6 +43,7 @@
 #include "vtkLookupTable.h"
 #include "vtkMath.h"
 #include "vtkNew.h"
+#include "vtkNumberToString.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -965,29 +966,26 @@ int vtkDataWriter::WriteRowData(ostream *fp, vtkTable *t)
 
 namespace
 {
-// Template to handle writing data in ascii or binary
-// We could change the format into C++ io standard ...
+// Template to handle writing data in ascii or binary. Ascii values are
+// written with the shortest representation that reads back as the same value.
 template <class T>
 void vtkWriteDataArray(ostream *fp, T *data, int fileType,
-                       const char *format, vtkIdType num, vtkIdType numComp)
+                       vtkIdType num, vtkIdType numComp)
 {
-  vtkIdType i, j, idx, sizeT;
-  char str[1024];
+  vtkIdType idx, sizeT;
 
   sizeT = sizeof(T);
 
   if ( fileType == VTK_ASCII )
   {
-    for (j=0; j<num; j++)
+    vtkNumberToString::BufferedWriter writer(*fp);
+    for (idx=0; idx<num*numComp; idx++)
     {
-      for (i=0; i<numComp; i++)
+      writer.WriteNumber(data[idx]);
+      writer.WriteChar(' ');
+      if ( !((idx+1)%9) )
       {
-        idx = i + j*numComp;
-        snprintf (str, sizeof(str), format, *data++); *fp << str;
-        if ( !((idx+1)%9) )
-        {
-          *fp << "\n";
-        }
+        writer.WriteChar('\n');
       }
     }
   }
@@ -1047,7 +1045,6 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
 
   bool isAOSArray = data->HasStandardMemoryLayout();
 
-  char* outputFormat = new char[10];
   switch (dataType)
   {
     case VTK_BIT:
@@ -1091,11 +1088,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "char"); *fp << str;
       char *s=GetArrayRawPointer(
         data, static_cast<vtkCharArray *>(data)->GetPointer(0), isAOSArray);
-#if VTK_TYPE_CHAR_IS_SIGNED
-      vtkWriteDataArray(fp, s, this->FileType, "%hhd ", num, numComp);
-#else
-      vtkWriteDataArray(fp, s, this->FileType, "%hhu ", num, numComp);
-#endif
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1108,7 +1101,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "signed_char"); *fp << str;
       signed char *s=GetArrayRawPointer(
         data, static_cast<vtkSignedCharArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%hhd ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1121,7 +1114,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "unsigned_char"); *fp << str;
       unsigned char *s=GetArrayRawPointer(
         data, static_cast<vtkUnsignedCharArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%hhu ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1134,7 +1127,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "short"); *fp << str;
       short *s=GetArrayRawPointer(
         data, static_cast<vtkShortArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%hd ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1147,7 +1140,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "unsigned_short"); *fp << str;
       unsigned short *s=GetArrayRawPointer(
         data, static_cast<vtkUnsignedShortArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%hu ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1160,7 +1153,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "int"); *fp << str;
       int *s=GetArrayRawPointer(
         data, static_cast<vtkIntArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%d ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1173,7 +1166,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "unsigned_int"); *fp << str;
       unsigned int *s=GetArrayRawPointer(
         data, static_cast<vtkUnsignedIntArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%u ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1186,7 +1179,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "long"); *fp << str;
       long *s=GetArrayRawPointer(
         data, static_cast<vtkLongArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%ld ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1199,7 +1192,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "unsigned_long"); *fp << str;
       unsigned long *s=GetArrayRawPointer(
         data, static_cast<vtkUnsignedLongArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%lu ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1212,9 +1205,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "vtktypeint64"); *fp << str;
       long long *s=GetArrayRawPointer(
         data, static_cast<vtkTypeInt64Array *>(data)->GetPointer(0), isAOSArray);
-      strcpy(outputFormat, vtkTypeTraits<long long>::ParseFormat());
-      strcat(outputFormat, " ");
-      vtkWriteDataArray(fp, s, this->FileType, outputFormat, num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1227,9 +1218,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "vtktypeuint64"); *fp << str;
       unsigned long long *s=GetArrayRawPointer(
         data, static_cast<vtkTypeUInt64Array *>(data)->GetPointer(0), isAOSArray);
-      strcpy(outputFormat, vtkTypeTraits<unsigned long long>::ParseFormat());
-      strcat(outputFormat, " ");
-      vtkWriteDataArray(fp, s, this->FileType, outputFormat, num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1242,7 +1231,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "float"); *fp << str;
       float *s=GetArrayRawPointer(
         data, static_cast<vtkFloatArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%g ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1255,7 +1244,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
       snprintf (str, sizeof(str), format, "double"); *fp << str;
       double *s=GetArrayRawPointer(
         data, static_cast<vtkDoubleArray *>(data)->GetPointer(0), isAOSArray);
-      vtkWriteDataArray(fp, s, this->FileType, "%.11lg ", num, numComp);
+      vtkWriteDataArray(fp, s, this->FileType, num, numComp);
       if (!isAOSArray)
       {
         delete [] s;
@@ -1291,7 +1280,7 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
           }
         }
       }
-      vtkWriteDataArray(fp, &intArray[0], this->FileType, "%d ", num, numComp);
+      vtkWriteDataArray(fp, &intArray[0], this->FileType, num, numComp);
     }
     break;
 
@@ -1426,11 +1415,9 @@ int vtkDataWriter::WriteArray(ostream *fp, int dataType, vtkAbstractArray *data,
     {
       vtkErrorMacro(<<"Type currently not supported");
       *fp << "NULL_ARRAY" << endl;
-      delete[] outputFormat;
       return 0;
     }
   }
-  delete[] outputFormat;
 
   // Write out metadata if it exists:
   vtkInformation *info = data->GetInformation();
@@ -1977,9 +1964,8 @@ int vtkDataWriter::WriteInformation(std::ostream *fp, vtkInformation *info)
     if ((dKey = vtkInformationDoubleKey::SafeDownCast(key)))
     {
       writeInfoHeader(fp, key);
-      // "%lg" is used to write double array data in ascii, using the same
-      // precision here.
-      snprintf(buffer, sizeof(buffer), "%lg", dKey->Get(info));
+      // Written as double array data in ascii.
+      vtkNumberToString::Convert(dKey->Get(info), buffer);
       *fp << buffer << "\n";
     }
     else if ((dvKey = vtkInformationDoubleVectorKey::SafeDownCast(key)))
@@ -1994,9 +1980,8 @@ int vtkDataWriter::WriteInformation(std::ostream *fp, vtkInformation *info)
       double *data = dvKey->Get(info);
       for (int i = 0; i < length; ++i)
       {
-        // "%lg" is used to write double array data in ascii, using the same
-        // precision here.
-        snprintf(buffer, sizeof(buffer), "%lg", data[i]);
+        // Written as double array data in ascii.
+        vtkNumberToString::Convert(data[i], buffer);
         *fp << buffer << " ";
       }
       *fp << "\n";
@@ -2181,16 +2166,19 @@ int vtkDataWriter::WriteCells(ostream *fp, vtkCellArray *cells, const char *labe
     vtkIdType j;
     vtkIdType *pts = nullptr;
     vtkIdType npts = 0;
+    vtkNumberToString::BufferedWriter writer(*fp);
     for (cells->InitTraversal(); cells->GetNextCell(npts,pts); )
     {
       // currently writing vtkIdType as int
-      *fp << static_cast<int>(npts) << " ";
+      writer.WriteNumber(static_cast<int>(npts));
+      writer.WriteChar(' ');
       for (j=0; j<npts; j++)
       {
         // currently writing vtkIdType as int
-        *fp << static_cast<int>(pts[j]) << " ";
+        writer.WriteNumber(static_cast<int>(pts[j]));
+        writer.WriteChar(' ');
       }
-      *fp << "\n";
+      writer.WriteChar('\n');
     }
   }
   else
@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinaryBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Writes a mesh with more vertices and faces than a block of elements as
+// little endian, big endian and ASCII PLY files, and checks that the binary
+// files read back as the mesh, and the ASCII file as the same faces and
+// colors. Also checks that a truncated binary file is reported as an error.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+
+void AddColors(vtkDataSetAttributes* data, vtkIdType numTuples)
+{
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("Colors");
+  colors->SetNumberOfComponents(4);
+  colors->SetNumberOfTuples(numTuples);
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    colors->SetTypedTuple(i, std::array<unsigned char, 4>{ { static_cast<unsigned char>(i % 256),
+                               static_cast<unsigned char>(i % 7), 3, static_cast<unsigned char>(i % 101) } }
+                               .data());
+  }
+  data->AddArray(colors);
+}
+
+int CompareArrays(vtkDataArray* expected, vtkDataArray* array, const std::string& name)
+{
+  if (!array || array->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    array->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    std::cerr << name << ": missing or wrong size\n";
+    return 1;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfValues(); ++i)
+  {
+    const int comps = expected->GetNumberOfComponents();
+    if (array->GetComponent(i / comps, i % comps) != expected->GetComponent(i / comps, i % comps))
+    {
+      std::cerr << name << ": wrong value " << i << "\n";
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int CompareOutput(vtkPolyData* input, vtkPolyData* output, bool exactPoints, const std::string& name)
+{
+  int errors = 0;
+  if (exactPoints)
+  {
+    errors += CompareArrays(input->GetPoints()->GetData(), output->GetPoints()->GetData(),
+      name + " points");
+    errors += CompareArrays(input->GetPointData()->GetTCoords(),
+      output->GetPointData()->GetTCoords(), name + " texture coordinates");
+  }
+  else if (output->GetNumberOfPoints() != input->GetNumberOfPoints())
+  {
+    std::cerr << name << ": wrong number of points\n";
+    ++errors;
+  }
+  errors += CompareArrays(input->GetPolys()->GetData(), output->GetPolys()->GetData(),
+    name + " faces");
+  errors += CompareArrays(input->GetPointData()->GetArray("Colors"),
+    output->GetPointData()->GetArray("RGBA"), name + " point colors");
+  errors += CompareArrays(input->GetCellData()->GetArray("Colors"),
+    output->GetCellData()->GetArray("RGBA"), name + " cell colors");
+  return errors;
+}
+
+}
+
+int TestPLYReaderBinaryBlocks(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(300);
+  sphere->SetPhiResolution(300);
+  sphere->Update();
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(sphere->GetOutput()->GetPoints());
+  input->SetPolys(sphere->GetOutput()->GetPolys());
+  const vtkIdType numPoints = input->GetNumberOfPoints();
+  vtkNew<vtkFloatArray> tcoords;
+  tcoords->SetName("TCoords");
+  tcoords->SetNumberOfComponents(2);
+  tcoords->SetNumberOfTuples(numPoints);
+  for (vtkIdType i = 0; i < numPoints; ++i)
+  {
+    tcoords->SetTuple2(i, static_cast<double>(i) / numPoints, 1.0 - static_cast<double>(i) / 3);
+  }
+  input->GetPointData()->SetTCoords(tcoords);
+  AddColors(input->GetPointData(), numPoints);
+  AddColors(input->GetCellData(), input->GetNumberOfCells());
+
+  int errors = 0;
+  const char* names[] = { "little endian", "big endian", "ASCII" };
+  for (int mode = 0; mode < 3; ++mode)
+  {
+    const std::string fileName = testDirectory + "/BinaryBlocks" + std::to_string(mode) + ".ply";
+    vtkNew<vtkPLYWriter> writer;
+    writer->SetFileName(fileName.c_str());
+    writer->SetInputData(input);
+    writer->SetArrayName("Colors");
+    writer->EnableAlphaOn();
+    if (mode == 2)
+    {
+      writer->SetFileTypeToASCII();
+    }
+    else
+    {
+      writer->SetFileTypeToBinary();
+      writer->SetDataByteOrder(mode == 0 ? VTK_LITTLE_ENDIAN : VTK_BIG_ENDIAN);
+    }
+    writer->Write();
+
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    errors += CompareOutput(input, reader->GetOutput(), mode != 2, names[mode]);
+  }
+
+  // A binary file ending in the middle of its elements.
+  const std::string truncatedName = testDirectory + "/BinaryBlocksTruncated.ply";
+  {
+    std::ifstream file((testDirectory + "/BinaryBlocks0.ply").c_str(), ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::ofstream truncated(truncatedName.c_str(), ios::binary);
+    truncated.write(contents.data(), contents.size() / 2);
+  }
+  vtkSmartPointer<vtkTest::ErrorObserver> errorObserver =
+    vtkSmartPointer<vtkTest::ErrorObserver>::New();
+  vtkNew<vtkPLYReader> reader;
+  reader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  reader->SetFileName(truncatedName.c_str());
+  reader->Update();
+  errors += errorObserver->CheckErrorMessage("Could not read the");
+
+  return errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -52,10 +52,12 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkMath.h"
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <cassert>
 #include <limits>
+#include <utility>
 
 /* memory allocation */
 #define myalloc(mem_size) vtkPLY::my_alloc((mem_size), __LINE__, __FILE__)
@@ -94,7 +96,7 @@ static const int ply_type_size[] = {
   0,
   1, 2, 4, 1, 2, 4,
   1, 2, 4, 1, 2, 4,
-  4, 4, 8
+  4, 4, 8, 8
 };
 
 #define NO_OTHER_PROPS  (-1)
@@ -1015,6 +1017,148 @@ void vtkPLY::ply_get_element(PlyFile *plyfile, void *elem_ptr)
 }
 
 
+/******************************************************************************
+Read a block of elements from a binary file. This is equivalent to count
+calls to ply_get_element() storing consecutive structures of elem_size bytes
+from elem_ptr, but the file is read by large blocks and the items are decoded
+from memory. The items of the lists are not allocated for each element: they
+are appended to list_items, and the list pointers stored in the structures
+point into list_items, so they must not be freed and are valid until
+list_items is modified.
+
+Entry:
+  plyfile    - file identifier
+  elem_ptr   - pointer to count structures of elem_size bytes
+  elem_size  - size of the structures
+  count      - number of elements to read
+  list_items - storage for the items of the lists, may be nullptr if no list
+               property is requested
+
+Exit:
+  returns PLY_OKAY, or PLY_ERROR if the file is not binary, if properties
+  not requested by the user must be stored or if the file ends too early
+******************************************************************************/
+
+int vtkPLY::ply_get_element_block(
+  PlyFile *plyfile,
+  void *elem_ptr,
+  int elem_size,
+  int count,
+  std::vector<char> *list_items
+)
+{
+  PlyElement *elem = plyfile->which_elem;
+  if (plyfile->file_type == PLY_ASCII || elem == nullptr ||
+      elem->other_offset != NO_OTHER_PROPS)
+    return (PLY_ERROR);
+
+  /* bytes read from the file, those after the last element are given back */
+  const size_t block_size = 1 << 20;
+  std::vector<char> buffer;
+  size_t begin = 0;
+  size_t end = 0;
+  bool at_end = false;
+  auto fill = [&](size_t n) {
+    if (end - begin >= n)
+      return true;
+    memmove (buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    while (end < n && !at_end) {
+      const size_t size = std::max(block_size, n - end);
+      buffer.resize(end + size);
+      const size_t nread = fread (buffer.data() + end, 1, size, plyfile->fp);
+      end += nread;
+      at_end = (nread < size);
+    }
+    return end >= n;
+  };
+
+  /* list pointers are set once all items are stored, as list_items grows */
+  std::vector<std::pair<char **, size_t> > lists;
+
+  int status = PLY_OKAY;
+  char *elem_data = (char *) elem_ptr;
+  for (int i = 0; i < count && status == PLY_OKAY; i++, elem_data += elem_size) {
+    for (int j = 0; j < elem->nprops; j++) {
+      PlyProperty *prop = elem->props[j];
+      int store_it = elem->store_prop[j];
+      int int_val;
+      unsigned int uint_val;
+      double double_val;
+
+      if (prop->is_list) {       /* a list */
+        const size_t count_size = ply_type_size[prop->count_external];
+        if (!fill (count_size)) {
+          status = PLY_ERROR;
+          break;
+        }
+        decode_binary_item (buffer.data() + begin, plyfile->file_type,
+                            prop->count_external, &int_val, &uint_val, &double_val);
+        begin += count_size;
+        if (store_it)
+          store_item (elem_data + prop->count_offset, prop->count_internal,
+                      int_val, uint_val, double_val);
+
+        const int list_count = int_val;
+        char **store_array = (char **) (elem_data + prop->offset);
+        if (store_it)
+          *store_array = nullptr;
+        if (list_count <= 0)
+          continue;
+
+        const size_t item_size = ply_type_size[prop->external_type];
+        if (!fill (item_size * list_count)) {
+          status = PLY_ERROR;
+          break;
+        }
+        if (store_it && list_items) {
+          const size_t internal_size = ply_type_size[prop->internal_type];
+          const size_t offset = list_items->size();
+          list_items->resize(offset + internal_size * list_count);
+          lists.emplace_back(store_array, offset);
+          char *item = list_items->data() + offset;
+          for (int k = 0; k < list_count; k++) {
+            decode_binary_item (buffer.data() + begin + k * item_size, plyfile->file_type,
+                                prop->external_type, &int_val, &uint_val, &double_val);
+            store_item (item, prop->internal_type, int_val, uint_val, double_val);
+            item += internal_size;
+          }
+        }
+        begin += item_size * list_count;
+      }
+      else {                     /* not a list */
+        const size_t item_size = ply_type_size[prop->external_type];
+        if (!fill (item_size)) {
+          status = PLY_ERROR;
+          break;
+        }
+        if (store_it) {
+          decode_binary_item (buffer.data() + begin, plyfile->file_type,
+                              prop->external_type, &int_val, &uint_val, &double_val);
+          store_item (elem_data + prop->offset, prop->internal_type,
+                      int_val, uint_val, double_val);
+        }
+        begin += item_size;
+      }
+    }
+  }
+
+  for (const auto& list : lists)
+    *list.first = list_items->data() + list.second;
+
+  if (status != PLY_OKAY)
+  {
+    vtkGenericWarningMacro ("PLY error reading file."
+                            << " Premature EOF while reading " << elem->name << " elements.");
+  }
+  else if (end > begin)
+    fseek (plyfile->fp, -static_cast<long>(end - begin), SEEK_CUR);
+
+  return (status);
+}
+
+
 /******************************************************************************
 Extract the comments from the header information of a PLY file.
 
@@ -2305,19 +2449,55 @@ void vtkPLY::get_binary_item(
   unsigned int *uint_val,
   double *double_val
 )
+{
+  if (type <= PLY_START_TYPE || type >= PLY_END_TYPE) {
+    fprintf (stderr, "get_binary_item: bad type = %d\n", type);
+    assert (0);
+    return;
+  }
+
+  char item[8];
+  if (fread (item, ply_type_size[type], 1, plyfile->fp) != 1)
+  {
+    vtkGenericWarningMacro ("PLY error reading file."
+                            << " Premature EOF while reading " << type_names[type] << ".");
+    fclose (plyfile->fp);
+    return;
+  }
+  decode_binary_item (item, plyfile->file_type, type, int_val, uint_val, double_val);
+}
+
+
+/******************************************************************************
+Get the value of an item read from a binary file, and place the result
+into an integer, an unsigned integer and a double.
+
+Entry:
+  item      - bytes of the item, as stored in the file
+  file_type - file type, giving the byte order of the item
+  type      - data type of the item
+
+Exit:
+  int_val    - integer value
+  uint_val   - unsigned integer value
+  double_val - double-precision floating point value
+******************************************************************************/
+
+void vtkPLY::decode_binary_item(
+  const char *item,
+  int file_type,
+  int type,
+  int *int_val,
+  unsigned int *uint_val,
+  double *double_val
+)
 {
   switch (type) {
     case PLY_CHAR:
     case PLY_INT8:
-      {
-      vtkTypeInt8 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading char.");
-        fclose (plyfile->fp);
-        return;
-      }
+    {
+      vtkTypeInt8 value;
+      memcpy (&value, item, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2328,14 +2508,8 @@ void vtkPLY::get_binary_item(
     case PLY_UCHAR:
     case PLY_UINT8:
     {
-      vtkTypeUInt8 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading uchar or uint8.");
-        fclose (plyfile->fp);
-        return;
-      }
+      vtkTypeUInt8 value;
+      memcpy (&value, item, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2346,15 +2520,9 @@ void vtkPLY::get_binary_item(
     case PLY_SHORT:
     case PLY_INT16:
     {
-      vtkTypeInt16 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading short.");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeInt16 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap2BE(&value) :
         vtkByteSwap::Swap2LE(&value);
 
@@ -2367,15 +2535,9 @@ void vtkPLY::get_binary_item(
     case PLY_USHORT:
     case PLY_UINT16:
     {
-      vtkTypeUInt16 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading ushort.");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeUInt16 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap2BE(&value) :
         vtkByteSwap::Swap2LE(&value);
 
@@ -2388,15 +2550,9 @@ void vtkPLY::get_binary_item(
     case PLY_INT:
     case PLY_INT32:
     {
-      vtkTypeInt32 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading int or int32.");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeInt32 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
 
@@ -2409,15 +2565,9 @@ void vtkPLY::get_binary_item(
     case PLY_UINT:
     case PLY_UINT32:
     {
-      vtkTypeUInt32 value = 0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading uint");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeUInt32 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
 
@@ -2430,15 +2580,9 @@ void vtkPLY::get_binary_item(
     case PLY_FLOAT:
     case PLY_FLOAT32:
     {
-      vtkTypeFloat32 value = 0.0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading float of float32.");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeFloat32 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap4BE(&value) :
         vtkByteSwap::Swap4LE(&value);
 
@@ -2453,15 +2597,9 @@ void vtkPLY::get_binary_item(
     case PLY_DOUBLE:
     case PLY_FLOAT64:
     {
-      vtkTypeFloat64 value = 0.0;
-      if (fread (&value, sizeof(value), 1, plyfile->fp) != 1)
-      {
-        vtkGenericWarningMacro ("PLY error reading file."
-                                << " Premature EOF while reading double.");
-        fclose (plyfile->fp);
-        return;
-      }
-      plyfile->file_type == PLY_BINARY_BE ?
+      vtkTypeFloat64 value;
+      memcpy (&value, item, sizeof(value));
+      file_type == PLY_BINARY_BE ?
         vtkByteSwap::Swap8BE(&value) :
         vtkByteSwap::Swap8LE(&value);
 
@@ -2472,7 +2610,7 @@ void vtkPLY::get_binary_item(
     }
       break;
     default:
-      fprintf (stderr, "get_binary_item: bad type = %d\n", type);
+      fprintf (stderr, "decode_binary_item: bad type = %d\n", type);
       assert (0);
   }
 }
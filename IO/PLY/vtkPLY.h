@@ -68,6 +68,8 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkIOPLYModule.h" // For export macro
 #include "vtkObject.h"
 
+#include <vector> // For ply_get_element_block
+
 #define PLY_ASCII      1        /* ascii PLY file */
 #define PLY_BINARY_BE  2        /* binary PLY file, big endian */
 #define PLY_BINARY_LE  3        /* binary PLY file, little endian */
@@ -182,6 +184,7 @@ public:
   static void ply_get_property(PlyFile *, const char *, PlyProperty *);
   static PlyOtherProp *ply_get_other_properties(PlyFile *, const char *, int);
   static void ply_get_element(PlyFile *, void *);
+  static int ply_get_element_block(PlyFile *, void *, int, int, std::vector<char> *);
   static char **ply_get_comments(PlyFile *, int *);
   static char **ply_get_obj_info(PlyFile *, int *);
   static void ply_close(PlyFile *);
@@ -213,6 +216,7 @@ public:
   static double get_item_value(const char *, int);
   static void get_ascii_item(const char *, int, int *, unsigned int *, double *);
   static void get_binary_item(PlyFile *, int, int *, unsigned int *, double *);
+  static void decode_binary_item(const char *, int, int, int *, unsigned int *, double *);
   static void ascii_get_element(PlyFile *, char *);
   static void binary_get_element(PlyFile *, char *);
   static void *my_alloc(size_t, int, const char *);
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstring>
 #include <vector>
 
 vtkStandardNewMacro(vtkPLYReader);
@@ -130,6 +131,67 @@ typedef struct _plyFace {
   unsigned char ntexcoord;   // number of texcoord in list
   float *texcoord;             // texcoord list
 } plyFace;
+
+/**
+ * Return the elements of the current element type of a PLY file one after
+ * the other. Elements of binary files are read by blocks, and their lists
+ * point into a buffer of the reader: they must be freed only when
+ * ListsMustBeFreed() returns true. Next() returns nullptr if a block could
+ * not be read.
+ */
+template <typename T>
+class ElementReader
+{
+public:
+  ElementReader(PlyFile* ply, int numElems)
+    : Ply(ply)
+    , NumberOfElements(numElems)
+    , NumberOfRead(0)
+    , Binary(ply->file_type != PLY_ASCII)
+    , Elements(this->Binary ? std::max(std::min(numElems, BlockSize), 1) : 1)
+    , Current(this->Elements.size())
+  {
+  }
+
+  T* Next()
+  {
+    if (this->Current == this->Elements.size())
+    {
+      if (this->Binary)
+      {
+        const int count = std::min(
+          this->NumberOfElements - this->NumberOfRead, static_cast<int>(this->Elements.size()));
+        memset(this->Elements.data(), 0, this->Elements.size() * sizeof(T));
+        this->ListItems.clear();
+        if (vtkPLY::ply_get_element_block(this->Ply, this->Elements.data(),
+              static_cast<int>(sizeof(T)), count, &this->ListItems) == PLY_ERROR)
+        {
+          return nullptr;
+        }
+        this->NumberOfRead += count;
+      }
+      else
+      {
+        vtkPLY::ply_get_element(this->Ply, this->Elements.data());
+      }
+      this->Current = 0;
+    }
+    return &this->Elements[this->Current++];
+  }
+
+  bool ListsMustBeFreed() const { return !this->Binary; }
+
+private:
+  static const int BlockSize = 1 << 16;
+
+  PlyFile* Ply;
+  int NumberOfElements;
+  int NumberOfRead;
+  bool Binary;
+  std::vector<T> Elements;
+  size_t Current;
+  std::vector<char> ListItems;
+};
 }
 
 int vtkPLYReader::RequestData(
@@ -394,10 +456,18 @@ int vtkPLYReader::RequestData(
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
+      ElementReader<plyVertex> vertices(ply, numPts);
       for (int j=0; j < numPts; j++)
       {
-        vtkPLY::ply_get_element (ply, (void *) &vertex);
+        const plyVertex* vertexPtr = vertices.Next();
+        if (!vertexPtr)
+        {
+          vtkErrorMacro(<<"Could not read the vertices of " << this->FileName);
+          pts->Delete();
+          vtkPLY::ply_close (ply);
+          return 0;
+        }
+        const plyVertex& vertex = *vertexPtr;
         pts->SetPoint (j, vertex.x);
         if ( texCoordsPointsAvailable )
         {
@@ -441,7 +511,7 @@ int vtkPLYReader::RequestData(
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->Allocate(polys->EstimateSize(numPolys,3),numPolys/2);
-      plyFace face;
+      ElementReader<plyFace> faces(ply, numPolys);
       vtkIdType vtkVerts[256];
 
       // Get the face properties
@@ -483,12 +553,22 @@ int vtkPLYReader::RequestData(
       for (int j=0; j < numPolys; j++)
       {
         //grab and element from the file
-        vtkPLY::ply_get_element (ply, (void *) &face);
+        plyFace* facePtr = faces.Next();
+        if (!facePtr)
+        {
+          vtkErrorMacro(<<"Could not read the faces of " << this->FileName);
+          vtkPLY::ply_close (ply);
+          return 0;
+        }
+        plyFace& face = *facePtr;
         for (int k=0; k < face.nverts; k++)
         {
           vtkVerts[k] = face.verts[k];
         }
-        free(face.verts); // allocated in vtkPLY::ascii/binary_get_element
+        if (faces.ListsMustBeFreed())
+        {
+          free(face.verts); // allocated in vtkPLY::ascii_get_element
+        }
 
         cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
         if ( intensityAvailable )
@@ -623,7 +703,10 @@ int vtkPLYReader::RequestData(
                             << " different than number of points "
                             << face.nverts);
           }
-          free(face.texcoord);
+          if (faces.ListsMustBeFreed())
+          {
+            free(face.texcoord);
+          }
         }
         polys->InsertNextCell(cell);
       }
@@ -30,11 +30,14 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
@@ -336,6 +339,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     // append->AppendFieldDataOn();
 
     vtkOpenFOAMReader *reader;
+    std::vector<vtkOpenFOAMReader*> readers;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
     while ((reader
@@ -352,21 +356,39 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       }
       if (reader->MakeMetaDataAtTimeStep(false))
       {
-        append->AddInputConnection(reader->GetOutputPort());
+        readers.push_back(reader);
       }
     }
 
     this->GatherMetaData();
 
-    if (append->GetNumberOfInputConnections(0) == 0)
+    if (readers.empty())
     {
       output->Initialize();
       ret = 0;
     }
     else
     {
-      // reader->RequestInformation() and RequestData() are called
-      // for all reader instances without setting UPDATE_TIME_STEPS
+      // the processor subdirectories are independent of each other, so
+      // bring the readers up to date in parallel before appending them
+      this->Superclass::ReadingInParallel = readers.size() > 1;
+      vtkSMPTools::For(0, static_cast<vtkIdType>(readers.size()), 1,
+        [&readers](vtkIdType begin, vtkIdType end)
+        {
+          for (vtkIdType readerI = begin; readerI < end; readerI++)
+          {
+            readers[readerI]->Update();
+          }
+        });
+      this->Superclass::ReadingInParallel = false;
+
+      for (vtkOpenFOAMReader* upToDate : readers)
+      {
+        append->AddInputConnection(upToDate->GetOutputPort());
+      }
+      // reader->RequestInformation() and RequestData() have been called
+      // for all reader instances without setting UPDATE_TIME_STEPS, so
+      // the append filter only executes the readers that failed again
       append->Update();
       output->ShallowCopy(append->GetOutput());
     }
@@ -16,6 +16,7 @@
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkCellType.h"
 #include "vtkCellIterator.h"
 #include "vtkErrorCode.h"
 #include "vtkInformation.h"
@@ -106,9 +107,12 @@ void vtkXMLUnstructuredGridWriter::WriteInlinePiece(vtkIndent indent)
   this->SetProgressRange(progressRange, 1, fractions);
 
   // Write the cell specifications.
-  if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input))
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid && grid->GetSingleCellType() == VTK_EMPTY_CELL)
   {
     // This is a bit more efficient and avoids iteration over all cells.
+    // Grids with a single cell type use the cell iterator, so that writing
+    // them does not create their cell types array.
     this->WriteCellsInline("Cells", grid->GetCells(), grid->GetCellTypesArray(),
                            grid->GetFaces(), grid->GetFaceLocations(), indent);
   }
@@ -163,7 +167,8 @@ void vtkXMLUnstructuredGridWriter::WriteAppendedPiece(int index,
     return;
   }
 
-  if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input))
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid && grid->GetSingleCellType() == VTK_EMPTY_CELL)
   {
     this->WriteCellsAppended("Cells", grid->GetCellTypesArray(),
                              grid->GetFaces(),
@@ -215,7 +220,8 @@ void vtkXMLUnstructuredGridWriter::WriteAppendedPieceData(int index)
   this->SetProgressRange(progressRange, 1, fractions);
 
   // Write the cell specification arrays.
-  if (vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input))
+  vtkUnstructuredGrid *grid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (grid && grid->GetSingleCellType() == VTK_EMPTY_CELL)
   {
     this->WriteCellsAppendedData(grid->GetCells(), grid->GetCellTypesArray(),
                                  grid->GetFaces(), grid->GetFaceLocations(),
@@ -1560,14 +1560,10 @@ int vtkXMLWriter::WriteBinaryDataBlock(unsigned char* in_data,
   {
     // If we are converting vtkIdType to 32-bit integer data, the data
     // are already in the byte swap buffer because we share the
-    // conversion buffer.  Otherwise, we need to copy the data before
-    // byte swapping.
-    if (data != this->ByteSwapBuffer)
-    {
-      memcpy(this->ByteSwapBuffer, data, numWords*wordSize);
-      data = this->ByteSwapBuffer;
-    }
-    this->PerformByteSwap(this->ByteSwapBuffer, numWords, wordSize);
+    // conversion buffer.  Otherwise, the data are byte swapped while
+    // they are copied to the byte swap buffer.
+    this->PerformByteSwap(data, this->ByteSwapBuffer, numWords, wordSize);
+    data = this->ByteSwapBuffer;
   }
 
   // Now pass the data to the next write phase.
@@ -1599,15 +1595,21 @@ int vtkXMLWriter::WriteBinaryDataBlock(unsigned char* in_data,
 void vtkXMLWriter::PerformByteSwap(void* data, size_t numWords,
                                    size_t wordSize)
 {
-  char* ptr = static_cast<char*>(data);
+  this->PerformByteSwap(data, data, numWords, wordSize);
+}
+
+//----------------------------------------------------------------------------
+void vtkXMLWriter::PerformByteSwap(const void* in, void* out, size_t numWords,
+                                   size_t wordSize)
+{
   if (this->ByteOrder == vtkXMLWriter::BigEndian)
   {
     switch (wordSize)
     {
-      case 1: break;
-      case 2: vtkByteSwap::Swap2BERange(ptr, numWords); break;
-      case 4: vtkByteSwap::Swap4BERange(ptr, numWords); break;
-      case 8: vtkByteSwap::Swap8BERange(ptr, numWords); break;
+      case 1: if (in != out) { memcpy(out, in, numWords); } break;
+      case 2: vtkByteSwap::SwapCopy2BERange(in, out, numWords); break;
+      case 4: vtkByteSwap::SwapCopy4BERange(in, out, numWords); break;
+      case 8: vtkByteSwap::SwapCopy8BERange(in, out, numWords); break;
       default:
         vtkErrorMacro("Unsupported data type size " << wordSize);
     }
@@ -1616,10 +1618,10 @@ void vtkXMLWriter::PerformByteSwap(void* data, size_t numWords,
   {
     switch (wordSize)
     {
-      case 1: break;
-      case 2: vtkByteSwap::Swap2LERange(ptr, numWords); break;
-      case 4: vtkByteSwap::Swap4LERange(ptr, numWords); break;
-      case 8: vtkByteSwap::Swap8LERange(ptr, numWords); break;
+      case 1: if (in != out) { memcpy(out, in, numWords); } break;
+      case 2: vtkByteSwap::SwapCopy2LERange(in, out, numWords); break;
+      case 4: vtkByteSwap::SwapCopy4LERange(in, out, numWords); break;
+      case 8: vtkByteSwap::SwapCopy8LERange(in, out, numWords); break;
       default:
         vtkErrorMacro("Unsupported data type size " << wordSize);
     }
@@ -2160,59 +2162,61 @@ bool vtkXMLWriter::WriteInformation(vtkInformation *info, vtkIndent indent)
 // This method is provided so that the specialization code for certain types
 // can be minimal.
 template <class T>
-inline ostream& vtkXMLWriteAsciiValue(ostream& os, const T& value)
+inline void vtkXMLWriteAsciiValue(vtkNumberToString::BufferedWriter& os, const T& value)
 {
-  vtkNumberToString convert;
-  os << convert(value);
-  return os;
+  os.WriteNumber(value);
 }
 
 //----------------------------------------------------------------------------
 template<>
-inline ostream& vtkXMLWriteAsciiValue(ostream& os, const char &c)
+inline void vtkXMLWriteAsciiValue(vtkNumberToString::BufferedWriter& os, const char &c)
 {
-  os << short(c);
-  return os;
+  os.WriteNumber(short(c));
 }
 
 //----------------------------------------------------------------------------
 template<>
-inline ostream& vtkXMLWriteAsciiValue(ostream& os, const unsigned char &c)
+inline void vtkXMLWriteAsciiValue(vtkNumberToString::BufferedWriter& os, const unsigned char &c)
 {
-  os << static_cast<unsigned short>(c);
-  return os;
+  os.WriteNumber(static_cast<unsigned short>(c));
 }
 
 //----------------------------------------------------------------------------
 template<>
-inline ostream& vtkXMLWriteAsciiValue(ostream& os, const signed char &c)
+inline void vtkXMLWriteAsciiValue(vtkNumberToString::BufferedWriter& os, const signed char &c)
 {
-  os << short(c);
-  return os;
+  os.WriteNumber(short(c));
 }
 
 //----------------------------------------------------------------------------
 template<>
-inline ostream& vtkXMLWriteAsciiValue(ostream& os, const vtkStdString& str)
+inline void vtkXMLWriteAsciiValue(vtkNumberToString::BufferedWriter& os, const vtkStdString& str)
 {
   vtkStdString::const_iterator iter;
   for (iter = str.begin(); iter != str.end(); ++iter)
   {
     vtkXMLWriteAsciiValue(os, *iter);
-    os << " ";
+    os.WriteChar(' ');
   }
   char delim = 0x0;
-  return vtkXMLWriteAsciiValue(os, delim);
+  vtkXMLWriteAsciiValue(os, delim);
 }
 
 //----------------------------------------------------------------------------
+// Values are formatted into a large buffer, floating point values with the
+// shortest representation that reads back as the same value.
 template <class iterT>
-int vtkXMLWriteAsciiData(ostream& os, iterT* iter, vtkIndent indent)
+int vtkXMLWriteAsciiData(ostream& stream, iterT* iter, vtkIndent indent)
 {
   if (!iter)
   {
     return 0;
   }
+  std::ostringstream indentStream;
+  indentStream << indent;
+  const std::string indentString = indentStream.str();
+
+  vtkNumberToString::BufferedWriter os(stream);
   size_t columns = 6;
   size_t length = iter->GetNumberOfTuples() *
     iter->GetNumberOfComponents();
@@ -2222,27 +2226,28 @@ int vtkXMLWriteAsciiData(ostream& os, iterT* iter, vtkIndent indent)
   vtkIdType index = 0;
   for (size_t r = 0; r < rows; ++r)
   {
-    os << indent;
+    os.WriteText(indentString);
     vtkXMLWriteAsciiValue(os, iter->GetValue(index++));
     for (size_t c = 1; c < columns; ++c)
     {
-      os << " ";
+      os.WriteChar(' ');
       vtkXMLWriteAsciiValue(os, iter->GetValue(index++));
     }
-    os << "\n";
+    os.WriteChar('\n');
   }
   if (lastRowLength > 0)
   {
-    os << indent;
+    os.WriteText(indentString);
     vtkXMLWriteAsciiValue(os, iter->GetValue(index++));
     for (size_t c = 1; c < lastRowLength; ++c)
     {
-      os << " " ;
-    vtkXMLWriteAsciiValue(os, iter->GetValue(index++));
+      os.WriteChar(' ');
+      vtkXMLWriteAsciiValue(os, iter->GetValue(index++));
     }
-    os << "\n";
+    os.WriteChar('\n');
   }
-  return os ? 1 : 0;
+  os.Flush();
+  return stream ? 1 : 0;
 }
 
 //----------------------------------------------------------------------------
@@ -473,6 +473,7 @@ protected:
   // Internal utility methods.
   int WriteBinaryDataBlock(unsigned char* in_data, size_t numWords, int wordType);
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
+  void PerformByteSwap(const void* in, void* out, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
   int WriteCompressionHeader();
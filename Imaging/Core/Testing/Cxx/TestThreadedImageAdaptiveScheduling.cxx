@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestThreadedImageAdaptiveScheduling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkThreadedImageAlgorithm::AdaptiveScheduling
+// .SECTION Description
+// Runs a reslice restricted to a stencil and a median filter on a small
+// volume with static and with adaptive scheduling, and checks that both give
+// the same output. The second adaptive execution schedules the pieces by the
+// costs measured during the first one. TimeThreadedImageAdaptiveScheduling
+// measures the execution times on a larger volume.
+
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkImageReslice.h"
+#include "vtkImageStencilData.h"
+#include "vtkImplicitFunctionToImageStencil.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSphere.h"
+#include "vtkThreadedImageAlgorithm.h"
+
+namespace
+{
+
+bool SameScalars(const char* name, vtkImageData* expected, vtkImageData* result)
+{
+  vtkDataArray* a = expected->GetPointData()->GetScalars();
+  vtkDataArray* b = result->GetPointData()->GetScalars();
+  if (!a || !b || a->GetNumberOfValues() != b->GetNumberOfValues())
+  {
+    std::cerr << name << ": outputs differ in size." << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfValues(); ++i)
+  {
+    if (a->GetVariantValue(i) != b->GetVariantValue(i))
+    {
+      std::cerr << name << ": outputs differ at value " << i << "." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareScheduling(const char* name, vtkThreadedImageAlgorithm* filter)
+{
+  filter->SetEnableSMP(true);
+  filter->SetAdaptiveScheduling(false);
+  filter->Update();
+  vtkNew<vtkImageData> expected;
+  expected->DeepCopy(filter->GetOutputDataObject(0));
+
+  bool success = true;
+  filter->SetAdaptiveScheduling(true);
+  for (int i = 0; i < 2; ++i)
+  {
+    filter->Modified();
+    filter->Update();
+    success &= SameScalars(
+      name, expected, vtkImageData::SafeDownCast(filter->GetOutputDataObject(0)));
+  }
+  return success;
+}
+
+} // end anon namespace
+
+int TestThreadedImageAdaptiveScheduling(int, char*[])
+{
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 23, 0, 23, 0, 23);
+  source->Update();
+
+  // A stencil covering one corner of the volume.
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.0, 0.0, 0.0);
+  sphere->SetRadius(15.0);
+  vtkNew<vtkImplicitFunctionToImageStencil> stencil;
+  stencil->SetInput(sphere);
+  stencil->SetInformationInput(source->GetOutput());
+  stencil->Update();
+
+  vtkNew<vtkImageReslice> reslice;
+  reslice->SetInputConnection(source->GetOutputPort());
+  reslice->SetStencilData(stencil->GetOutput());
+  reslice->SetInterpolationModeToCubic();
+  reslice->SetResliceAxesDirectionCosines(
+    0.8, 0.6, 0.0, -0.6, 0.8, 0.0, 0.0, 0.0, 1.0);
+
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputConnection(source->GetOutputPort());
+  median->SetKernelSize(3, 3, 3);
+
+  bool success = CompareScheduling("ResliceStencil", reslice);
+  success &= CompareScheduling("Median3D", median);
+
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
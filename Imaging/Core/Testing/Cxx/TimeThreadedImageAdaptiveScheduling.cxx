@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeThreadedImageAdaptiveScheduling.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Benchmark of vtkThreadedImageAlgorithm::AdaptiveScheduling
+// .SECTION Description
+// Runs imaging filters with unevenly distributed cost (a reslice restricted
+// to a stencil covering one corner of the volume, and a median filter) with
+// static and with adaptive scheduling and reports the execution times.
+// This benchmark is not run by ctest: run it with
+//   vtkImagingCoreCxxTests TimeThreadedImageAdaptiveScheduling
+// TestThreadedImageAdaptiveScheduling checks the results on a small volume.
+
+#include "vtkImageData.h"
+#include "vtkImageMedian3D.h"
+#include "vtkImageReslice.h"
+#include "vtkImageStencilData.h"
+#include "vtkImplicitFunctionToImageStencil.h"
+#include "vtkNew.h"
+#include "vtkRTAnalyticSource.h"
+#include "vtkSMPTools.h"
+#include "vtkSphere.h"
+#include "vtkThreadedImageAlgorithm.h"
+#include "vtkTimerLog.h"
+
+#include <string>
+
+namespace
+{
+
+const int NUMBER_OF_RUNS = 3;
+
+// Execute the filter a few times, the adaptive executions after the first
+// one use the piece costs measured by the previous execution.
+double TimeFilter(vtkThreadedImageAlgorithm* filter, bool adaptive)
+{
+  filter->SetEnableSMP(true);
+  filter->SetAdaptiveScheduling(adaptive);
+  filter->Update();
+
+  vtkNew<vtkTimerLog> timer;
+  double total = 0.0;
+  for (int i = 0; i < NUMBER_OF_RUNS; ++i)
+  {
+    filter->Modified();
+    timer->StartTimer();
+    filter->Update();
+    timer->StopTimer();
+    total += timer->GetElapsedTime();
+  }
+  return total / NUMBER_OF_RUNS;
+}
+
+void Benchmark(const std::string& name, vtkThreadedImageAlgorithm* filter)
+{
+  double staticTime = TimeFilter(filter, false);
+  double adaptiveTime = TimeFilter(filter, true);
+  cout << "<DartMeasurement name=\"" << name << "Static-s\" type=\"numeric/double\">"
+       << staticTime << "</DartMeasurement>\n";
+  cout << "<DartMeasurement name=\"" << name << "Adaptive-s\" type=\"numeric/double\">"
+       << adaptiveTime << "</DartMeasurement>\n";
+}
+
+} // end anon namespace
+
+int TimeThreadedImageAdaptiveScheduling(int, char*[])
+{
+  std::cout << "Threads: " << vtkSMPTools::GetEstimatedNumberOfThreads() << std::endl;
+
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(0, 127, 0, 127, 0, 127);
+  source->Update();
+
+  // A stencil covering one corner of the volume, so that most of the
+  // reslice work is done by a few of the statically split pieces.
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.0, 0.0, 0.0);
+  sphere->SetRadius(80.0);
+  vtkNew<vtkImplicitFunctionToImageStencil> stencil;
+  stencil->SetInput(sphere);
+  stencil->SetInformationInput(source->GetOutput());
+  stencil->Update();
+
+  vtkNew<vtkImageReslice> reslice;
+  reslice->SetInputConnection(source->GetOutputPort());
+  reslice->SetStencilData(stencil->GetOutput());
+  reslice->SetInterpolationModeToCubic();
+  reslice->SetResliceAxesDirectionCosines(
+    0.8, 0.6, 0.0, -0.6, 0.8, 0.0, 0.0, 0.0, 1.0);
+
+  vtkNew<vtkImageMedian3D> median;
+  median->SetInputConnection(source->GetOutputPort());
+  median->SetKernelSize(5, 5, 5);
+
+  Benchmark("ResliceStencil", reslice);
+  Benchmark("Median3D", median);
+
+  return EXIT_SUCCESS;
+}